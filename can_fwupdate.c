@@ -0,0 +1,398 @@
+//
+// Streaming firmware update over CAN.
+//
+
+#include "can_fwupdate.h"
+
+#ifdef NIGHTCAN_FW_UPDATE
+
+#include <string.h>
+
+// generated names for the protocol packets
+#define FWUPDATE_META_ID META_DATA_FOR_WRITE_MEMORY_FIRMWARE_UPDATE_256B_MAX_ID
+#define FWUPDATE_META_LEN_BYTE \
+    META_DATA_FOR_WRITE_MEMORY_FIRMWARE_UPDATE_256B_MAX_FIELD_4_BYTE
+#define FWUPDATE_META_CRC_BYTE \
+    META_DATA_FOR_WRITE_MEMORY_FIRMWARE_UPDATE_256B_MAX_FIELD_5_BYTE
+#define FWUPDATE_META_NODE_BYTE \
+    META_DATA_FOR_WRITE_MEMORY_FIRMWARE_UPDATE_256B_MAX_FIELD_6_BYTE
+#define FWUPDATE_DATA_ID WRITE_MEMORY_DATA_FIRMWARE_UPDATE_ID
+
+#if defined(STM32H733xx)
+#define FLASH_WORD_SIZE (FLASH_NB_32BITWORD_IN_FLASHWORD * 4U)
+#define FLASH_ERASE_UNIT FLASH_SECTOR_SIZE
+#define FLASH_UNIT_BASE FLASH_BANK1_BASE
+#elif defined(STM32L496xx)
+#define FLASH_WORD_SIZE 8U
+#define FLASH_ERASE_UNIT FLASH_PAGE_SIZE
+#define FLASH_UNIT_BASE FLASH_BASE
+#endif
+
+#define ACK_PACKETS 4  // acks can pile up in the TX queue, don't coalesce them
+
+typedef enum {
+    SLOT_FREE = 0,
+    SLOT_FILLING,
+    SLOT_READY,
+} FwUpdateSlotState;
+
+typedef enum {
+    ERASE_IDLE = 0,
+    ERASE_BUSY,    // HAL_FLASHEx_Erase_IT running, the flash IRQ ends it
+    ERASE_FAILED,  // the last one errored, not acked yet
+} FwUpdateEraseState;
+
+typedef struct {
+    uint8_t data[CAN_FWUPDATE_CHUNK_SIZE];
+    uint32_t address;
+    uint16_t length;    // bytes the meta frame announced
+    uint16_t received;  // bytes so far
+    uint16_t written;   // bytes programmed so far
+    uint16_t crc;       // expected CRC from the meta frame
+    uint8_t frames;     // data frames so far
+    FwUpdateSlotState state;
+} FwUpdateSlot;
+
+static NightCANInstance *fw_instance = NULL;
+static uint8_t fw_node_id;
+static uint32_t fw_region_start;
+static uint32_t fw_region_end;
+
+// ping-pong buffers: one fills from the bus while the other gets written
+static FwUpdateSlot slots[2];
+static int8_t filling = -1;      // slot receiving data, -1 if none
+static uint8_t ready_queue[2];   // READY slots in the order they completed
+static uint8_t ready_count = 0;
+static bool reset_pending = false;
+
+// one bit per erase unit of the region, set once it's been erased
+static uint8_t erased[CAN_FWUPDATE_MAX_ERASE_UNITS / 8];
+static uint32_t first_unit;
+static volatile FwUpdateEraseState erase_state = ERASE_IDLE;
+static uint32_t erase_bit;  // unit being erased, as its bit in erased[]
+
+static NightCANPacket ack_packets[ACK_PACKETS];
+static uint8_t ack_next = 0;
+
+/**
+ * CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF), a nibble at a time.
+ */
+static uint16_t crc16_ccitt(const uint8_t *data, uint32_t len) {
+    static const uint16_t table[16] = {
+        0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+        0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF};
+    uint16_t crc = 0xFFFF;
+    for (uint32_t i = 0; i < len; i++) {
+        crc = (uint16_t)((crc << 4) ^ table[(crc >> 12) ^ (data[i] >> 4)]);
+        crc = (uint16_t)((crc << 4) ^ table[(crc >> 12) ^ (data[i] & 0x0F)]);
+    }
+    return crc;
+}
+
+static void send_ack(uint8_t status, uint32_t address, uint8_t frames) {
+    NightCANPacket *ack = &ack_packets[ack_next];
+    ack_next = (ack_next + 1) % ACK_PACKETS;
+
+    ack->data[FIRMWARE_UPDATE_ACK_FIELD_0_BYTE] = fw_node_id;
+    ack->data[FIRMWARE_UPDATE_ACK_FIELD_1_BYTE] = status;
+    CAN_writeIntOrdered(uint32_t, ack, FIRMWARE_UPDATE_ACK_FIELD_2_BYTE,
+                        address, CAN_BIG_ENDIAN);
+    ack->data[FIRMWARE_UPDATE_ACK_FIELD_6_BYTE] = frames;
+
+    // goes out even with the bus silenced, only CAN_Service holds off
+    CAN_AddTxPacket(fw_instance, ack);
+}
+
+static void free_slot(int8_t idx) {
+    slots[idx].state = SLOT_FREE;
+    if (filling == idx) filling = -1;
+}
+
+/**
+ * Meta frame: start receiving a new chunk into a free buffer.
+ */
+static void on_meta(const uint8_t *data, uint8_t len) {
+    // meta frames from before the target node byte existed aren't for us
+    if (len <= FWUPDATE_META_NODE_BYTE) return;
+    if (data[FWUPDATE_META_NODE_BYTE] != fw_node_id) return;
+
+    uint32_t address;
+    CAN_copyOrdered(&address, data, sizeof(address), CAN_BIG_ENDIAN);
+    if (address == CAN_FWUPDATE_ADDR_RESET) {
+        reset_pending = true;
+        return;
+    }
+
+    uint16_t length = data[FWUPDATE_META_LEN_BYTE]
+                          ? data[FWUPDATE_META_LEN_BYTE]
+                          : CAN_FWUPDATE_CHUNK_SIZE;
+    uint16_t crc;
+    CAN_copyOrdered(&crc, data + FWUPDATE_META_CRC_BYTE, sizeof(crc),
+                    CAN_BIG_ENDIAN);
+
+    // the last chunk never finished, frames went missing
+    if (filling >= 0) {
+        send_ack(CAN_FWUPDATE_ACK_RESEND, slots[filling].address,
+                 slots[filling].frames);
+        free_slot(filling);
+    }
+
+    if (address % FLASH_WORD_SIZE != 0 || address < fw_region_start ||
+        address + length > fw_region_end) {
+        send_ack(CAN_FWUPDATE_ACK_REJECTED, address, 0);
+        return;
+    }
+
+    int8_t idx = (slots[0].state == SLOT_FREE)   ? 0
+                 : (slots[1].state == SLOT_FREE) ? 1
+                                                 : -1;
+    if (idx < 0) {
+        send_ack(CAN_FWUPDATE_ACK_BUSY, address, 0);
+        return;
+    }
+
+    FwUpdateSlot *slot = &slots[idx];
+    // pad with the erased value so the last flash word can be written whole
+    memset(slot->data, 0xFF, sizeof(slot->data));
+    slot->address = address;
+    slot->length = length;
+    slot->received = 0;
+    slot->written = 0;
+    slot->crc = crc;
+    slot->frames = 0;
+    slot->state = SLOT_FILLING;
+    filling = idx;
+}
+
+/**
+ * Data frame: append to the chunk being received, check it when complete.
+ */
+static void on_data(const uint8_t *data, uint8_t len) {
+    if (filling < 0) return;
+    FwUpdateSlot *slot = &slots[filling];
+
+    uint16_t room = slot->length - slot->received;
+    uint8_t take = (len > room) ? (uint8_t)room : len;
+    memcpy(slot->data + slot->received, data, take);
+    slot->received += take;
+    slot->frames++;
+
+    if (slot->received < slot->length) return;
+
+    if (crc16_ccitt(slot->data, slot->length) != slot->crc) {
+        send_ack(CAN_FWUPDATE_ACK_RESEND, slot->address, slot->frames);
+        free_slot(filling);
+        return;
+    }
+
+    slot->state = SLOT_READY;
+    ready_queue[ready_count++] = (uint8_t)filling;
+    filling = -1;
+    send_ack(CAN_FWUPDATE_ACK_RECEIVED, slot->address, slot->frames);
+}
+
+void can_fwupdate_on_frame(NightCANInstance *instance, uint32_t id,
+                           uint8_t len, const uint8_t *data) {
+    if (!fw_instance || instance != fw_instance) return;
+
+    if (id == FWUPDATE_META_ID) {
+        on_meta(data, len);
+    } else if (id == FWUPDATE_DATA_ID) {
+        on_data(data, len);
+    }
+}
+
+/**
+ * Bit in erased[] of the sector/page holding address, -1 if the region is
+ * bigger than erased[] covers.
+ */
+static int32_t unit_bit(uint32_t address) {
+    uint32_t bit = (address - FLASH_UNIT_BASE) / FLASH_ERASE_UNIT - first_unit;
+    return (bit < CAN_FWUPDATE_MAX_ERASE_UNITS) ? (int32_t)bit : -1;
+}
+
+static bool unit_erased(uint32_t bit) {
+    return erased[bit / 8] & (1U << (bit % 8));
+}
+
+/**
+ * Starts erasing a sector/page in the background. It takes up to ~2s for an
+ * H7 sector, so can_fwupdate_periodic only starts it and goes back to the
+ * main loop (CAN keeps running, chunks keep arriving into the free buffer);
+ * the flash interrupt marks it done. Flash stays unlocked until then.
+ * @return false if it couldn't be started.
+ */
+static bool start_erase(uint32_t bit) {
+    uint32_t unit = first_unit + bit;
+    FLASH_EraseInitTypeDef erase;
+#if defined(STM32H733xx)
+    erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+    erase.Banks = FLASH_BANK_1;
+    erase.Sector = unit;
+    erase.NbSectors = 1;
+    erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+#elif defined(STM32L496xx)
+    erase.TypeErase = FLASH_TYPEERASE_PAGES;
+    erase.Banks = (unit < FLASH_BANK_SIZE / FLASH_PAGE_SIZE) ? FLASH_BANK_1
+                                                             : FLASH_BANK_2;
+    erase.Page = unit % (FLASH_BANK_SIZE / FLASH_PAGE_SIZE);
+    erase.NbPages = 1;
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+#endif
+
+    erase_bit = bit;
+    erase_state = ERASE_BUSY;
+    HAL_FLASH_Unlock();
+    if (HAL_FLASHEx_Erase_IT(&erase) != HAL_OK) {
+        erase_state = ERASE_IDLE;
+        HAL_FLASH_Lock();
+        return false;
+    }
+    return true;
+}
+
+// --- HAL Flash Callbacks ---
+// These override the HAL's weak definitions, so don't define them again in the
+// application when NIGHTCAN_FW_UPDATE is on. Only the erase uses the IT API,
+// programming is the blocking one, so any end of operation is the erase.
+
+void HAL_FLASH_EndOfOperationCallback(uint32_t ReturnValue) {
+    (void)ReturnValue;
+    if (erase_state != ERASE_BUSY) return;
+    erased[erase_bit / 8] |= (uint8_t)(1U << (erase_bit % 8));
+    erase_state = ERASE_IDLE;
+    HAL_FLASH_Lock();
+}
+
+void HAL_FLASH_OperationErrorCallback(uint32_t ReturnValue) {
+    (void)ReturnValue;
+    if (erase_state != ERASE_BUSY) return;
+    erase_state = ERASE_FAILED;
+    HAL_FLASH_Lock();
+}
+
+/**
+ * Programs one flash word and reads it back.
+ */
+static bool program_word(uint32_t address, const uint8_t *data) {
+#if defined(STM32H733xx)
+    if (HAL_FLASH_Program(FLASH_TYPEPROGRAM_FLASHWORD, address,
+                          (uint32_t)(uintptr_t)data) != HAL_OK) {
+        return false;
+    }
+    // don't compare against a stale cached copy of the erased word
+    SCB_InvalidateDCache_by_Addr((void *)(uintptr_t)address, FLASH_WORD_SIZE);
+#elif defined(STM32L496xx)
+    uint64_t word;
+    memcpy(&word, data, sizeof(word));
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+    if (HAL_FLASH_Program(FLASH_TYPEPROGRAM_DOUBLEWORD, address, word) !=
+        HAL_OK) {
+        return false;
+    }
+#endif
+
+    return memcmp((const void *)(uintptr_t)address, data, FLASH_WORD_SIZE) == 0;
+}
+
+void can_fwupdate_init(NightCANInstance *instance, uint8_t node_id,
+                       uint32_t region_start, uint32_t region_end) {
+    fw_instance = instance;
+    fw_node_id = node_id;
+    fw_region_start = region_start;
+    fw_region_end = region_end;
+    first_unit = (region_start - FLASH_UNIT_BASE) / FLASH_ERASE_UNIT;
+
+    memset(slots, 0, sizeof(slots));
+    memset(erased, 0, sizeof(erased));
+    erase_state = ERASE_IDLE;
+    filling = -1;
+    ready_count = 0;
+    reset_pending = false;
+
+    for (int i = 0; i < ACK_PACKETS; i++) {
+        ack_packets[i] =
+            CAN_create_packet(FIRMWARE_UPDATE_ACK_ID, 0, FIRMWARE_UPDATE_ACK_DLC);
+    }
+
+    // the background erase finishes in the flash interrupt
+    HAL_NVIC_EnableIRQ(FLASH_IRQn);
+}
+
+static void finish_slot(uint8_t idx, bool ok) {
+    FwUpdateSlot *slot = &slots[idx];
+    send_ack(ok ? CAN_FWUPDATE_ACK_WRITTEN : CAN_FWUPDATE_ACK_FLASH_ERROR,
+             slot->address, slot->frames);
+    free_slot(idx);
+    ready_queue[0] = ready_queue[1];
+    ready_count--;
+}
+
+void can_fwupdate_periodic() {
+    if (!fw_instance) return;
+
+    // nothing can be programmed while an erase is running
+    if (erase_state == ERASE_BUSY) return;
+    bool erase_failed = (erase_state == ERASE_FAILED);
+    erase_state = ERASE_IDLE;
+
+    if (ready_count > 0) {
+        uint8_t idx = ready_queue[0];
+        FwUpdateSlot *slot = &slots[idx];
+
+        // a failed erase fails the chunk waiting on it, one started early
+        // for some other chunk is just tried again when that one needs it
+        if (erase_failed &&
+            unit_bit(slot->address + slot->written) == (int32_t)erase_bit) {
+            finish_slot(idx, false);
+            return;
+        }
+
+        bool ok = true;
+        HAL_FLASH_Unlock();
+        for (int n = 0; n < CAN_FWUPDATE_WORDS_PER_CALL &&
+                        slot->written < slot->length;
+             n++) {
+            uint32_t address = slot->address + slot->written;
+            int32_t bit = unit_bit(address);
+            if (bit < 0) {
+                ok = false;
+                break;
+            }
+            if (!unit_erased((uint32_t)bit)) {
+                // the rest of this chunk waits for the erase
+                HAL_FLASH_Lock();
+                if (!start_erase((uint32_t)bit)) finish_slot(idx, false);
+                return;
+            }
+            if (!program_word(address, slot->data + slot->written)) {
+                ok = false;
+                break;
+            }
+            slot->written += FLASH_WORD_SIZE;
+        }
+        HAL_FLASH_Lock();
+
+        if (!ok || slot->written >= slot->length) finish_slot(idx, ok);
+        return;
+    }
+
+    // get the sector the next chunk is going to already erasing while its
+    // frames are still coming in
+    if (filling >= 0) {
+        int32_t bit = unit_bit(slots[filling].address);
+        if (bit >= 0 && !unit_erased((uint32_t)bit)) start_erase((uint32_t)bit);
+    }
+
+    if (reset_pending && filling < 0) {
+        send_ack(CAN_FWUPDATE_ACK_RESETTING, CAN_FWUPDATE_ADDR_RESET, 0);
+        HAL_Delay(10);  // let it get on the bus
+        HAL_NVIC_SystemReset();
+    }
+}
+
+bool can_fwupdate_busy() {
+    return filling >= 0 || ready_count > 0 || erase_state == ERASE_BUSY;
+}
+
+#endif
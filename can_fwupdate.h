@@ -0,0 +1,88 @@
+//
+// Streaming firmware update over CAN.
+//
+
+#ifndef LONGHORN_LIBRARY_2025_CAN_FWUPDATE_H
+#define LONGHORN_LIBRARY_2025_CAN_FWUPDATE_H
+
+#include "night_can.h"
+
+/* To enable: define NIGHTCAN_FW_UPDATE in the main.h file */
+#ifdef NIGHTCAN_FW_UPDATE
+
+/*
+ * Protocol (IDs from night_can_ids.h):
+ *  0x031 meta  Pi -> *   address (4 bytes, MSB first), chunk length (0 = 256),
+ *                        CRC-16/CCITT of the chunk (MSB first), target node
+ *  0x004 data  Pi -> *   the chunk, 8 bytes per frame, straight after its meta
+ *  0x032 ack   node -> Pi  node, status, address (MSB first), frames received
+ *
+ * Only the node named in the meta frame listens and answers, so the rest of
+ * the bus can stay silenced (BUS_ENABLE_DISABLE) during the update. Chunks land
+ * in one of two RAM buffers, the other one gets programmed from
+ * can_fwupdate_periodic, so the Pi can send the next chunk as soon as it sees
+ * RECEIVED instead of waiting on flash.
+ * A meta frame with address CAN_FWUPDATE_ADDR_RESET resets the board once
+ * everything queued is written. scripts/can_fwupdate.py is the Pi's side.
+ *
+ * This only writes the region and checks each chunk's CRC and read back,
+ * nothing in this library validates the image as a whole or boots it: the
+ * reset goes back to whatever is at the start of flash, and the ROM
+ * bootloader (boot_to_dfu) is USB DFU, it never looks at the region. So the
+ * region has to be where a board's own bootloader at the start of flash
+ * checks for and jumps to an image. Without one, don't point it at the
+ * running application, a failed update leaves the board without one.
+ *
+ * On L4 only 3 frames fit in a bxCAN FIFO, so use NIGHTCAN_RX_INTERRUPT or
+ * the 32 frame burst of a chunk will overrun it.
+ *
+ * Sectors/pages are erased in the background (HAL_FLASHEx_Erase_IT), the
+ * first time a chunk lands in one, so the main loop and CAN keep running
+ * through it. That needs the FLASH global interrupt on in CubeMX (its
+ * handler calls HAL_FLASH_IRQHandler), and this defines the HAL flash
+ * callbacks. On the single bank H733 code fetched from flash that misses the
+ * caches still waits for the erase, so keep the update region on the other
+ * bank where there is one (L4).
+ */
+
+#define CAN_FWUPDATE_CHUNK_SIZE 256
+#define CAN_FWUPDATE_ADDR_RESET 0xFFFFFFFFU
+#define CAN_FWUPDATE_WORDS_PER_CALL 2    // flash words programmed per periodic
+#define CAN_FWUPDATE_MAX_ERASE_UNITS 512  // sectors/pages the region can span
+
+// ack status byte
+#define CAN_FWUPDATE_ACK_RECEIVED 0     // chunk passed its CRC, queued for flash
+#define CAN_FWUPDATE_ACK_WRITTEN 1      // chunk programmed and read back OK
+#define CAN_FWUPDATE_ACK_RESEND 2       // CRC mismatch / frames missing
+#define CAN_FWUPDATE_ACK_BUSY 3         // both buffers taken, resend the meta
+#define CAN_FWUPDATE_ACK_REJECTED 4     // outside the region or misaligned
+#define CAN_FWUPDATE_ACK_FLASH_ERROR 5  // erase/program/verify failed
+#define CAN_FWUPDATE_ACK_RESETTING 6    // everything written, resetting now
+
+/**
+ * Set up the updater for this board.
+ * @param instance CAN instance the update arrives on (and acks go out on)
+ * @param node_id this board's node number, matched against the meta frame
+ * @param region_start first flash address the updater may write
+ * @param region_end one past the last flash address it may write
+ */
+void can_fwupdate_init(NightCANInstance *instance, uint8_t node_id,
+                       uint32_t region_start, uint32_t region_end);
+
+/**
+ * Programs queued chunks into flash, a few flash words per call. Call every
+ * loop alongside CAN_periodic.
+ */
+void can_fwupdate_periodic();
+
+/**
+ * @return true while a chunk is being received or waiting to be written
+ */
+bool can_fwupdate_busy();
+
+/* Called by the CAN driver for every 0x031/0x004 frame, not for user code */
+void can_fwupdate_on_frame(NightCANInstance *instance, uint32_t id,
+                           uint8_t len, const uint8_t *data);
+
+#endif
+#endif  // LONGHORN_LIBRARY_2025_CAN_FWUPDATE_H
@@ -0,0 +1,82 @@
+#include "can_log.h"
+
+#include <string.h>
+
+_Static_assert(sizeof(CanLogHeader) == 32, "CAN log header layout");
+_Static_assert(sizeof(CanLogRecord) == CAN_LOG_RECORD_SIZE(true),
+               "CAN log record layout");
+_Static_assert(sizeof(CanLogTrailer) == 24 + CAN_LOG_ID_BITS / 8,
+               "CAN log trailer layout");
+
+static void trailer_reset(CanLogTrailer *trailer) {
+    memset(trailer, 0, sizeof(*trailer));
+    memcpy(trailer->magic, "NCBK", 4);
+}
+
+bool can_log_open(CanLogWriter *log, CanLogWriteFn write, void *ctx, bool fd,
+                  uint64_t start_unix_us) {
+    if (!log || !write) return false;
+
+    memset(log, 0, sizeof(*log));
+    log->write = write;
+    log->ctx = ctx;
+    log->record_size = CAN_LOG_RECORD_SIZE(fd);
+    trailer_reset(&log->_trailer);
+
+    CanLogHeader header = {
+        .magic = {'N', 'C', 'L', 'G'},
+        .version = CAN_LOG_VERSION,
+        .record_size = log->record_size,
+        .block_records = CAN_LOG_BLOCK_RECORDS,
+        .start_unix_us = start_unix_us,
+    };
+    return write(ctx, &header, sizeof(header));
+}
+
+bool can_log_frame(CanLogWriter *log, uint64_t time_us, uint32_t id,
+                   uint8_t flags, uint8_t bus, uint8_t len,
+                   const uint8_t *data) {
+    if (!log || !log->write) return false;
+    if (log->frames && time_us < log->_last_us) {
+        // readers binary search on time, so the order has to hold
+        time_us = log->_last_us;
+        log->late++;
+    }
+
+    uint32_t max_len = log->record_size - CAN_LOG_RECORD_HEADER_SIZE;
+    if (len > max_len) len = (uint8_t)max_len;
+
+    CanLogRecord record = {
+        .time_us = time_us,
+        .id = id,
+        .flags = (uint8_t)(flags | ((id > 0x7FF) ? CAN_LOG_FLAG_EXT : 0)),
+        .len = len,
+        .bus = bus,
+    };
+    if (len && data) memcpy(record.data, data, len);
+
+    if (!log->write(log->ctx, &record, log->record_size)) {
+        log->write_fails++;
+        return false;
+    }
+
+    CanLogTrailer *trailer = &log->_trailer;
+    if (trailer->records == 0) trailer->first_us = time_us;
+    trailer->last_us = time_us;
+    uint32_t bit = can_log_id_bit(id);
+    trailer->ids[bit / 8] |= (uint8_t)(1U << (bit % 8));
+    log->_last_us = time_us;
+    log->frames++;
+
+    if (++trailer->records == CAN_LOG_BLOCK_RECORDS) {
+        if (!log->write(log->ctx, trailer, sizeof(*trailer))) {
+            // everything after would be off by a trailer and readers find
+            // blocks by their offset, so the log ends here instead
+            log->write_fails++;
+            log->write = NULL;
+            return false;
+        }
+        trailer_reset(trailer);
+    }
+    return true;
+}
@@ -0,0 +1,127 @@
+//
+// Binary CAN log format and its writer.
+//
+// A log is a 32 byte header followed by fixed size frame records in time
+// order, so a reader can map the file and treat it as an array (see
+// scripts/can_log.py). Every CAN_LOG_BLOCK_RECORDS records are followed by
+// a block trailer with the block's time range and a bitmap of the IDs in
+// it. Blocks are all the same size, so a reader finds any block by its
+// number, binary searches the trailers for a time and skips blocks without
+// an ID without touching their records. Nothing is written at the end: a
+// log cut short (power lost, card pulled) is fine up to its last record,
+// the last block just has no trailer yet.
+//
+// All fields are little endian.
+//   header:  magic "NCLG", u16 version, u16 record size, u32 records per
+//            block, u32 reserved, u64 start time (unix us, 0 if unknown),
+//            u64 reserved
+//   record:  u64 time_us, u32 id, u8 flags (CAN_LOG_FLAG_*, the telemetry
+//            stream's bits), u8 len, u8 bus, u8 reserved, then 8 data bytes
+//            (64 in an FD log, which has the bigger record size)
+//   trailer: magic "NCBK", u32 records, u64 first time_us, u64 last time_us,
+//            256 byte ID bitmap (bit can_log_id_bit(id) set for every ID)
+//
+
+#ifndef LONGHORN_LIBRARY_2025_CAN_LOG_H
+#define LONGHORN_LIBRARY_2025_CAN_LOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define CAN_LOG_VERSION 1
+#define CAN_LOG_BLOCK_RECORDS 256
+#define CAN_LOG_ID_BITS 2048  // size of a trailer's ID bitmap
+
+#define CAN_LOG_FLAG_TX 0x01   // sent by the board that logged it
+#define CAN_LOG_FLAG_EXT 0x02  // 29 bit ID
+#define CAN_LOG_FLAG_FD 0x04   // CAN FD frame
+#define CAN_LOG_FLAG_BRS 0x08  // FD frame with bit rate switching
+
+typedef struct __attribute__((packed)) {
+    char magic[4];  // "NCLG"
+    uint16_t version;
+    uint16_t record_size;    // sizeof a record, 24 classic or 80 FD
+    uint32_t block_records;  // records between trailers
+    uint32_t reserved;
+    uint64_t start_unix_us;
+    uint64_t reserved2;
+} CanLogHeader;
+
+typedef struct __attribute__((packed)) {
+    uint64_t time_us;
+    uint32_t id;
+    uint8_t flags;
+    uint8_t len;
+    uint8_t bus;  // which of the logger's buses it was on
+    uint8_t reserved;
+    uint8_t data[64];  // only the first 8 are written in a classic log
+} CanLogRecord;
+
+#define CAN_LOG_RECORD_HEADER_SIZE 16
+#define CAN_LOG_RECORD_SIZE(fd) (CAN_LOG_RECORD_HEADER_SIZE + ((fd) ? 64 : 8))
+
+typedef struct __attribute__((packed)) {
+    char magic[4];  // "NCBK"
+    uint32_t records;
+    uint64_t first_us;
+    uint64_t last_us;
+    uint8_t ids[CAN_LOG_ID_BITS / 8];
+} CanLogTrailer;
+
+/**
+ * Where an ID goes in the trailer bitmap: standard IDs get their own bit,
+ * extended ones are folded in (so a set bit means "maybe").
+ */
+static inline uint32_t can_log_id_bit(uint32_t id) {
+    if (id <= 0x7FF) return id;
+    return (id ^ (id >> 11) ^ (id >> 22)) & (CAN_LOG_ID_BITS - 1);
+}
+
+/**
+ * Output of a writer. Under CAN_SetLog it can be called from an interrupt
+ * with interrupts masked, so it shouldn't touch the card itself: copy into
+ * a RAM buffer and f_write that to the SD card file from the main loop.
+ * @return false if it couldn't take the bytes (the buffer is full).
+ */
+typedef bool (*CanLogWriteFn)(void *ctx, const void *data, uint32_t len);
+
+typedef struct {
+    CanLogWriteFn write;
+    void *ctx;
+    uint16_t record_size;
+
+    uint32_t frames;       // records written
+    uint32_t write_fails;  // records the output didn't take
+    uint32_t late;         // records stamped later than they said, see
+                           // can_log_frame
+
+    // --- Internal writer state (do not modify directly) ---
+    CanLogTrailer _trailer;  // of the block being filled
+    uint64_t _last_us;
+} CanLogWriter;
+
+/**
+ * Starts a log by writing its header.
+ * @param fd true to keep 64 data bytes per record (FD frames), false for 8.
+ * @param start_unix_us Wall clock time at time_us 0 if the board knows it,
+ * else 0.
+ * @return false if the header couldn't be written.
+ */
+bool can_log_open(CanLogWriter *log, CanLogWriteFn write, void *ctx, bool fd,
+                  uint64_t start_unix_us);
+
+/**
+ * Appends a frame. Times in a log never go back, so a frame older than the
+ * last one (a received frame read out after something was sent) is stamped
+ * with the last time instead and counted in late. Data longer than the
+ * log's records is cut short. If a block trailer can't be written the log
+ * stops there (write is cleared), so the file stays readable up to it; open
+ * it again to carry on in a new one.
+ * @param flags CAN_LOG_FLAG_* bits, EXT is added for IDs above 0x7FF.
+ * @return false if it wasn't written (or the log stopped with it).
+ */
+bool can_log_frame(CanLogWriter *log, uint64_t time_us, uint32_t id,
+                   uint8_t flags, uint8_t bus, uint8_t len,
+                   const uint8_t *data);
+
+#endif  // LONGHORN_LIBRARY_2025_CAN_LOG_H
@@ -1,8 +1,39 @@
 #include "led.h"
 
+#ifndef LED_DMA_SECTION
+#define LED_DMA_SECTION
+#endif
+
+#define LED_MAX_CHANNELS 3
+#define LED_MAX_REPEAT 256  // the repetition counter is 8 bits on most timers
+
+static TIM_TypeDef *ledtim;
+static TIM_HandleTypeDef *ledhtim;
+static int channels;
+static uint32_t update_hz;
+
+// the running effect, CCR1..channels per frame (CCR1 = blue, CCR2 = red,
+// CCR3 = green)
+static uint32_t led_frames[LED_MAX_FRAMES * LED_MAX_CHANNELS] LED_DMA_SECTION
+    __attribute__((aligned(32)));
+static bool dma_running;
+
+// the same table stepped from led_effect_service when the DMA can't
+static uint32_t sw_frame_count;  // 0 while nothing is stepped here
+static uint32_t sw_frame;
+static uint32_t sw_step_ms;
+static uint32_t sw_next_ms;
+
+// perceived brightness ramp (gamma 2.2), breathing goes up and down it
+static const uint8_t led_gamma[32] = {
+    0,  0,  1,  1,  3,  5,  7,  10, 13,  17,  21,  26,  32,  38,  44,  52,
+    60, 68, 77, 87, 97, 108, 120, 132, 145, 159, 173, 188, 204, 220, 237, 255,
+};
+
 void led_init(TIM_TypeDef *tim1, TIM_HandleTypeDef *htim, int timchs) {
     ledtim = tim1;
-    channels = timchs;
+    ledhtim = htim;
+    channels = (timchs > LED_MAX_CHANNELS) ? LED_MAX_CHANNELS : timchs;
 
     HAL_TIM_PWM_Start(htim, TIM_CHANNEL_1);
 
@@ -23,15 +54,21 @@ static void led_setInt(uint8_t r, uint8_t g, uint8_t b) {
 }
 
 void led_set(float r, float g, float b) {
+    led_effect_stop();
     led_setInt((uint8_t)(r * 255), (uint8_t)(g * 255), (uint8_t)(b * 255));
 }
 
-void led_off() { led_setInt(0, 0, 0); }
+void led_off() {
+    led_effect_stop();
+    led_setInt(0, 0, 0);
+}
 
 void led_rainbow(float deltaTime) {
     static uint8_t r = 255, g = 0, b = 0;
     static float timer = 0;
 
+    led_effect_stop();
+
     uint32_t count;
     timer += deltaTime * 3.0f * 255.0f;
     if (timer > 3.0f) {
@@ -57,4 +94,142 @@ void led_rainbow(float deltaTime) {
     }
 
     led_setInt(r / 4, g / 2, b / 2);
-}
\ No newline at end of file
+}
+
+// --- Effects ---
+
+void led_effects_init(uint32_t hz) { update_hz = hz; }
+
+/* Stores one frame of the table, in led_setInt's channel order */
+static void frame_put(uint32_t frame, uint8_t r, uint8_t g, uint8_t b) {
+    uint32_t *ccr = &led_frames[frame * (uint32_t)channels];
+    ccr[0] = b;
+    if (channels > 1) ccr[1] = r;
+    if (channels > 2) ccr[2] = g;
+}
+
+static void frame_write(uint32_t frame) {
+    const uint32_t *ccr = &led_frames[frame * (uint32_t)channels];
+    ledtim->CCR1 = ccr[0];
+    if (channels > 1) ledtim->CCR2 = ccr[1];
+    if (channels > 2) ledtim->CCR3 = ccr[2];
+}
+
+static uint32_t burst_length(void) {
+    switch (channels) {
+        case 1: return TIM_DMABURSTLENGTH_1TRANSFER;
+        case 2: return TIM_DMABURSTLENGTH_2TRANSFERS;
+        default: return TIM_DMABURSTLENGTH_3TRANSFERS;
+    }
+}
+
+/**
+ * Plays the first frame_count frames of led_frames over and over, each for
+ * step_ms. By DMA if the timer allows it, else from led_effect_service.
+ */
+static bool effect_start(uint32_t frame_count, uint32_t step_ms) {
+    if (step_ms == 0) step_ms = 1;
+
+#ifdef STM32H7
+    // the DMA reads RAM, not the D-cache
+    SCB_CleanDCache_by_Addr(led_frames, (int32_t)sizeof(led_frames));
+#endif
+
+    uint32_t repeat = update_hz * step_ms / 1000U;
+    if (ledhtim && repeat >= 1 && repeat <= LED_MAX_REPEAT &&
+        IS_TIM_REPETITION_COUNTER_INSTANCE(ledtim)) {
+        ledtim->RCR = repeat - 1;
+        ledtim->EGR = TIM_EGR_UG;  // take the new RCR now, not a cycle later
+        if (HAL_TIM_DMABurst_MultiWriteStart(
+                ledhtim, TIM_DMABASE_CCR1, TIM_DMA_UPDATE, led_frames,
+                burst_length(), frame_count * (uint32_t)channels) == HAL_OK) {
+            dma_running = true;
+            return true;
+        }
+        ledtim->RCR = 0;
+    }
+
+    sw_frame_count = frame_count;
+    sw_frame = 0;
+    sw_step_ms = step_ms;
+    sw_next_ms = HAL_GetTick() + step_ms;
+    frame_write(0);
+    return false;
+}
+
+bool led_effect_rainbow(uint32_t period_ms) {
+    if (channels <= 0) return false;
+    led_effect_stop();
+
+    // red -> green -> blue -> red, at led_rainbow's brightness per colour
+    const uint32_t seg = LED_MAX_FRAMES / 3;
+    for (uint32_t i = 0; i < seg; i++) {
+        uint8_t up = (uint8_t)(i * 255U / seg);
+        uint8_t down = (uint8_t)(255U - up);
+        frame_put(i, down / 4, up / 2, 0);
+        frame_put(seg + i, 0, down / 2, up / 2);
+        frame_put(2 * seg + i, up / 4, 0, down / 2);
+    }
+
+    return effect_start(3 * seg, period_ms / (3 * seg));
+}
+
+bool led_effect_breathe(float r, float g, float b, uint32_t period_ms) {
+    if (channels <= 0) return false;
+    led_effect_stop();
+
+    const uint32_t steps = sizeof(led_gamma);  // each way
+    uint8_t r8 = (uint8_t)(r * 255), g8 = (uint8_t)(g * 255),
+            b8 = (uint8_t)(b * 255);
+    for (uint32_t i = 0; i < steps; i++) {
+        uint32_t level = led_gamma[i];
+        uint8_t rl = (uint8_t)(r8 * level / 255U);
+        uint8_t gl = (uint8_t)(g8 * level / 255U);
+        uint8_t bl = (uint8_t)(b8 * level / 255U);
+        frame_put(i, rl, gl, bl);
+        frame_put(2 * steps - 1 - i, rl, gl, bl);
+    }
+
+    return effect_start(2 * steps, period_ms / (2 * steps));
+}
+
+bool led_effect_blink_code(float r, float g, float b, uint8_t count) {
+    if (channels <= 0 || count == 0 || count > LED_MAX_BLINKS) return false;
+    led_effect_stop();
+
+    uint8_t r8 = (uint8_t)(r * 255), g8 = (uint8_t)(g * 255),
+            b8 = (uint8_t)(b * 255);
+    uint32_t frame = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        frame_put(frame++, r8, g8, b8);
+        frame_put(frame++, 0, 0, 0);
+    }
+    for (uint32_t i = 0; i < 3; i++) {
+        frame_put(frame++, 0, 0, 0);  // gap after the last blink + 3 = pause
+    }
+
+    return effect_start(frame, LED_BLINK_STEP_MS);
+}
+
+void led_effect_stop() {
+    if (dma_running) {
+        HAL_TIM_DMABurst_WriteStop(ledhtim, TIM_DMA_UPDATE);
+        ledtim->RCR = 0;
+        dma_running = false;
+    }
+    sw_frame_count = 0;
+}
+
+void led_effect_service() {
+    if (sw_frame_count == 0) return;
+
+    uint32_t now = HAL_GetTick();
+    if ((int32_t)(now - sw_next_ms) < 0) return;
+
+    sw_next_ms += sw_step_ms;
+    if ((int32_t)(now - sw_next_ms) >= 0) {
+        sw_next_ms = now + sw_step_ms;  // fell behind, don't try to catch up
+    }
+    if (++sw_frame >= sw_frame_count) sw_frame = 0;
+    frame_write(sw_frame);
+}
@@ -1,15 +1,31 @@
 #ifndef LONGHORN_LIBRARY_2025_LED_H
 #define LONGHORN_LIBRARY_2025_LED_H
 
+#include <stdbool.h>
+
 #include "tim.h"
 
-static TIM_TypeDef *ledtim;
-static int channels;
+// --- Effects ---
+// An effect (rainbow, breathing, blink code) is rendered once into a table
+// of CCR values and then streamed into the LED timer by DMA: a circular DMA
+// burst on the timer's update event writes CCR1..n, and the repetition
+// counter holds each frame for its step. Nothing runs in the main loop.
+// That needs, in CubeMX, a timer with a repetition counter (TIM1/8/15/16/17)
+// and a DMA stream on its update request (TIMx_UP) in circular mode with
+// word sized memory and peripheral data. On any other timer (or when a step
+// is too long for the counter) led_effect_service steps the same table from
+// the main loop instead, one compare per call.
+// The table is a static in led.c; on the H7 the DMA can't reach the DTCM, so
+// if .bss lives there define LED_DMA_SECTION to put it somewhere it can,
+// e.g. __attribute__((section(".RAM_D2"))).
+#define LED_MAX_FRAMES 96        // frames an effect can have
+#define LED_BLINK_STEP_MS 250    // length of one blink / gap of a blink code
+#define LED_MAX_BLINKS ((LED_MAX_FRAMES - 4) / 2)
 
 void led_init(TIM_TypeDef *tim, TIM_HandleTypeDef *htim, int channels);
 
 /**
- * Set debug LED to given RGB value (0-1 scale).
+ * Set debug LED to given RGB value (0-1 scale). Stops any effect.
  * @param r red
  * @param g green
  * @param b blue
@@ -17,7 +33,7 @@ void led_init(TIM_TypeDef *tim, TIM_HandleTypeDef *htim, int channels);
 void led_set(float r, float g, float b);
 
 /**
- * Turn off debug LED.
+ * Turn off debug LED. Stops any effect.
  */
 void led_off();
 
@@ -27,4 +43,46 @@ void led_off();
  */
 void led_rainbow(float deltaTime);
 
+/**
+ * Lets the effects use the DMA. Call after led_init.
+ * @param update_hz The LED timer's update (PWM period) rate as set up in
+ * CubeMX, what the repetition counter divides down to the frame rate. 0
+ * keeps the effects on led_effect_service.
+ */
+void led_effects_init(uint32_t update_hz);
+
+/**
+ * Cycles through the colours, like led_rainbow but without the CPU.
+ * @param period_ms Time for one full cycle (1500 matches led_rainbow).
+ * @return true if it runs by DMA, false if it needs led_effect_service.
+ */
+bool led_effect_rainbow(uint32_t period_ms);
+
+/**
+ * Fades a colour (0-1 scale) in and out.
+ * @param period_ms Time for one fade in and out.
+ * @return true if it runs by DMA, false if it needs led_effect_service.
+ */
+bool led_effect_breathe(float r, float g, float b, uint32_t period_ms);
+
+/**
+ * Blinks a colour (0-1 scale) count times, pauses and repeats, to show a
+ * fault code. Blinks and gaps are LED_BLINK_STEP_MS, the pause is 4 of them.
+ * @param count Number of blinks, 1 to LED_MAX_BLINKS.
+ * @return true if it runs by DMA, false if it needs led_effect_service (or
+ * if count is out of range, then nothing changes).
+ */
+bool led_effect_blink_code(float r, float g, float b, uint8_t count);
+
+/**
+ * Stops the running effect, the LED keeps its current colour.
+ */
+void led_effect_stop();
+
+/**
+ * Steps an effect that couldn't be given to the DMA. Call every loop, it
+ * returns straight away if there's nothing to do.
+ */
+void led_effect_service();
+
 #endif  // LONGHORN_LIBRARY_2025_LED_H
@@ -15,6 +15,7 @@
 #include "timer.h"
 #include "usb_vcp.h"
 #include "dfu.h"
+#include "can_fwupdate.h"
 
 // --- Static Variables for Instance Management ---
 
@@ -30,6 +31,52 @@ static uint32_t night_active_instances = 0;
 uint32_t tx_mailbox;
 #endif
 
+// --- Clock ---
+/**
+ * @brief The driver's millisecond clock. HAL_GetTick() by default, or the DWT
+ * timebase from timer.c with NIGHTCAN_DWT_TIMEBASE, which keeps counting
+ * while interrupts are masked.
+ */
+static inline uint32_t can_now_ms(void) {
+#ifdef NIGHTCAN_DWT_TIMEBASE
+    return (uint32_t)(lib_timer_now_us() / 1000);
+#else
+    return lib_timer_elapsed_ms();
+#endif
+}
+
+// --- TX Queue Locking ---
+// the TX queue is shared with the TX complete ISR when NIGHTCAN_TX_INTERRUPT
+// is on (and with the RX ISRs of gateway sources forwarding into it), so mask
+// interrupts around the (short) heap updates
+#if defined(NIGHTCAN_TX_INTERRUPT) || \
+    (defined(NIGHTCAN_GATEWAY) && defined(NIGHTCAN_RX_INTERRUPT))
+#define NIGHTCAN_TX_QUEUE_SHARED
+#endif
+
+static inline uint32_t tx_queue_lock(void) {
+#ifdef NIGHTCAN_TX_QUEUE_SHARED
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+#else
+    return 0;
+#endif
+}
+
+static inline void tx_queue_unlock(uint32_t primask) {
+#ifdef NIGHTCAN_TX_QUEUE_SHARED
+    __set_PRIMASK(primask);
+#else
+    (void)primask;
+#endif
+}
+
+// sent frames get copied to the telemetry stream / log, see tx_sent
+#if defined(NIGHTCAN_TELEMETRY) || defined(NIGHTCAN_LOG)
+#define NIGHTCAN_TX_MIRROR
+#endif
+
 // --- Private Helper Functions ---
 
 /**
@@ -47,158 +94,1143 @@ static NightCANInstance *find_instance(NIGHTCAN_HANDLE_TYPEDEF *hcan) {
             return night_can_instances[i];
         }
     }
-    return NULL;
+    return NULL;
+}
+
+#ifndef NIGHTCAN_STATIC_CONFIG
+/**
+ * @brief Checks if the receive buffer for a specific instance is full.
+ * @param instance Pointer to the driver instance.
+ * @retval true if full, false otherwise.
+ */
+static bool is_rx_buffer_full(NightCANInstance *instance) {
+    return instance->rx_buffer_count == CAN_RX_BUFFER_SIZE;
+}
+#endif
+
+/**
+ * @brief Checks if the receive buffer for a specific instance is empty.
+ * @param instance Pointer to the driver instance.
+ * @retval true if empty, false otherwise.
+ */
+static bool is_rx_buffer_empty(NightCANInstance *instance) {
+    return instance->rx_buffer_count == 0;
+}
+
+#ifdef NIGHTCAN_SOA_INBOXES
+// where each field of inbox idx lives: its own array in the instance. All of
+// these are lvalues.
+#define INBOX_ID(instance, idx) ((instance)->rx_ids[idx])
+#define INBOX_DLC(instance, idx) ((instance)->rx_dlc[idx])
+#define INBOX_DATA(instance, idx) ((instance)->rx_data[idx])
+#define INBOX_TIMEOUT_MS(instance, idx) ((instance)->rx_timeout_ms[idx])
+#define INBOX_TIMESTAMP_MS(instance, idx) ((instance)->rx_timestamp_ms[idx])
+#define INBOX_TIMESTAMP_US(instance, idx) ((instance)->rx_timestamp_us[idx])
+#ifdef NIGHTCAN_SEQLOCK
+#define INBOX_SLOTS(instance, idx) ((instance)->rx_slots[idx])
+#define INBOX_SEQ(instance, idx) ((instance)->rx_seq[idx])
+#define INBOX_CONSUMED_SEQ(instance, idx) ((instance)->rx_consumed_seq[idx])
+#endif
+
+static inline bool inbox_is_timed_out(NightCANInstance *instance,
+                                      uint32_t idx) {
+    return (instance->rx_flags[idx] & CAN_INBOX_TIMED_OUT) != 0;
+}
+
+static inline void inbox_set_timed_out(NightCANInstance *instance,
+                                       uint32_t idx) {
+    instance->rx_flags[idx] |= CAN_INBOX_TIMED_OUT;
+}
+
+/**
+ * @brief Marks inbox idx recent and no longer timed out.
+ * @retval Whether it was timed out.
+ */
+static inline bool inbox_mark_received(NightCANInstance *instance,
+                                       uint32_t idx) {
+    bool recovered = inbox_is_timed_out(instance, idx);
+    instance->rx_flags[idx] = CAN_INBOX_RECENT;
+    return recovered;
+}
+
+static inline void inbox_notify_timeout(NightCANInstance *instance,
+                                        uint32_t idx, bool timed_out) {
+    if (instance->timeout_callback) {
+        instance->timeout_callback(instance, (NightCANInbox)idx, timed_out);
+    }
+}
+#else
+/**
+ * @brief Inbox number idx of the instance.
+ */
+static inline NightCANReceivePacket *rx_inbox(NightCANInstance *instance,
+                                              uint32_t idx) {
+#ifdef NIGHTCAN_STATIC_CONFIG
+    return &instance->rx_inboxes[idx];
+#else
+    return instance->rx_buffer[idx];
+#endif
+}
+
+#define INBOX_ID(instance, idx) (rx_inbox((instance), (idx))->id)
+#define INBOX_DLC(instance, idx) (rx_inbox((instance), (idx))->dlc)
+#define INBOX_DATA(instance, idx) (rx_inbox((instance), (idx))->data)
+#define INBOX_TIMEOUT_MS(instance, idx) (rx_inbox((instance), (idx))->timeout_ms)
+#define INBOX_TIMESTAMP_MS(instance, idx) \
+    (rx_inbox((instance), (idx))->timestamp_ms)
+#define INBOX_TIMESTAMP_US(instance, idx) \
+    (rx_inbox((instance), (idx))->timestamp_us)
+#ifdef NIGHTCAN_SEQLOCK
+#define INBOX_SLOTS(instance, idx) (rx_inbox((instance), (idx))->_slots)
+#define INBOX_SEQ(instance, idx) (rx_inbox((instance), (idx))->_seq)
+#define INBOX_CONSUMED_SEQ(instance, idx) \
+    (rx_inbox((instance), (idx))->_consumed_seq)
+#endif
+
+static inline bool inbox_is_timed_out(NightCANInstance *instance,
+                                      uint32_t idx) {
+    return rx_inbox(instance, idx)->is_timed_out;
+}
+
+static inline void inbox_set_timed_out(NightCANInstance *instance,
+                                       uint32_t idx) {
+    rx_inbox(instance, idx)->is_timed_out = true;
+}
+
+/**
+ * @brief Marks inbox idx recent and no longer timed out.
+ * @retval Whether it was timed out.
+ */
+static inline bool inbox_mark_received(NightCANInstance *instance,
+                                       uint32_t idx) {
+    NightCANReceivePacket *packet = rx_inbox(instance, idx);
+    bool recovered = packet->is_timed_out;
+    packet->is_recent = true;
+    packet->is_timed_out = false;
+    return recovered;
+}
+
+static inline void inbox_notify_timeout(NightCANInstance *instance,
+                                        uint32_t idx, bool timed_out) {
+    if (instance->timeout_callback) {
+        instance->timeout_callback(rx_inbox(instance, idx), timed_out);
+    }
+}
+#endif
+
+#ifdef NIGHTCAN_STATIC_CONFIG
+/**
+ * @brief Finds the inbox for an ID in the generated, sorted board table.
+ * @retval The index, or -1 if the board doesn't receive it.
+ */
+static int32_t rx_index_lookup(NightCANInstance *instance, uint32_t id) {
+    uint32_t lo = 0;
+    uint32_t hi = instance->rx_buffer_count;
+
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+#ifdef NIGHTCAN_SOA_INBOXES
+        uint32_t mid_id = instance->rx_ids[mid];  // same order, but in RAM
+#else
+        uint32_t mid_id = night_can_board_rx[mid].id;
+#endif
+        if (mid_id == id) return (int32_t)mid;
+        if (mid_id < id) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return -1;
+}
+#else
+/**
+ * @brief Home slot of an ID in the instance's lookup table (Fibonacci
+ * hashing, so clustered IDs like 0x0A0..0x0AC still spread out).
+ */
+static inline uint32_t rx_index_hash(uint32_t id) {
+    return (id * 2654435761U) >> (32 - CAN_RX_INDEX_BITS);
+}
+
+/**
+ * @brief Finds the rx_buffer index registered for an ID.
+ * @retval The index, or -1 if nothing is registered for it.
+ */
+static int32_t rx_index_lookup(NightCANInstance *instance, uint32_t id) {
+    uint32_t slot = rx_index_hash(id);
+
+    // linear probe until we hit the ID or an empty slot. The table is never
+    // more than half full so this is usually one or two probes.
+    for (uint32_t probes = 0; probes < CAN_RX_INDEX_SIZE; probes++) {
+        uint8_t entry = instance->rx_index[slot];
+        if (entry == 0) return -1;
+
+        if (INBOX_ID(instance, entry - 1) == id) {
+            // this is the correct packet, we can update the data on this.
+            return entry - 1;
+        }
+        slot = (slot + 1) & (CAN_RX_INDEX_SIZE - 1);
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Inserts inbox buffer_idx into the ID lookup table.
+ */
+static void rx_index_insert(NightCANInstance *instance, uint32_t id,
+                            uint32_t buffer_idx) {
+    uint32_t slot = rx_index_hash(id);
+    while (instance->rx_index[slot] != 0) {
+        slot = (slot + 1) & (CAN_RX_INDEX_SIZE - 1);
+    }
+    instance->rx_index[slot] = (uint8_t)(buffer_idx + 1);
+}
+#endif
+
+#ifndef NIGHTCAN_SOA_INBOXES
+NightCANReceivePacket *get_packet_from_id(NightCANInstance *instance,
+                                          uint32_t id) {
+    int32_t idx = rx_index_lookup(instance, id);
+    return (idx < 0) ? NULL : rx_inbox(instance, idx);
+}
+#endif
+
+
+/**
+ * @brief Wrap-safe "deadline a is earlier than deadline b" on the ms clock.
+ */
+static inline bool time_before(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) < 0;
+}
+
+/**
+ * @brief Moves timeout_heap[idx] towards the root until the heap holds again.
+ */
+static void timeout_heap_sift_up(NightCANInstance *instance, uint32_t idx) {
+    NightCANTimeoutEntry *heap = instance->timeout_heap;
+    NightCANTimeoutEntry entry = heap[idx];
+
+    while (idx > 0) {
+        uint32_t parent = (idx - 1) / 2;
+        if (!time_before(entry.deadline_ms, heap[parent].deadline_ms)) break;
+        heap[idx] = heap[parent];
+        idx = parent;
+    }
+    heap[idx] = entry;
+}
+
+/**
+ * @brief Moves timeout_heap[idx] towards the leaves until the heap holds again.
+ */
+static void timeout_heap_sift_down(NightCANInstance *instance, uint32_t idx) {
+    NightCANTimeoutEntry *heap = instance->timeout_heap;
+    uint32_t count = instance->timeout_heap_count;
+    NightCANTimeoutEntry entry = heap[idx];
+
+    for (;;) {
+        uint32_t child = 2 * idx + 1;
+        if (child >= count) break;
+
+        if (child + 1 < count &&
+            time_before(heap[child + 1].deadline_ms, heap[child].deadline_ms)) {
+            child++;
+        }
+        if (!time_before(heap[child].deadline_ms, entry.deadline_ms)) break;
+        heap[idx] = heap[child];
+        idx = child;
+    }
+    heap[idx] = entry;
+}
+
+/**
+ * @brief Starts watching inbox rx_idx for a timeout.
+ */
+static void timeout_heap_arm(NightCANInstance *instance, uint32_t rx_idx) {
+    uint32_t timeout_ms = INBOX_TIMEOUT_MS(instance, rx_idx);
+    if (timeout_ms == 0 || instance->timeout_armed[rx_idx]) return;
+
+    uint32_t idx = instance->timeout_heap_count++;
+    instance->timeout_heap[idx].deadline_ms =
+        INBOX_TIMESTAMP_MS(instance, rx_idx) + timeout_ms;
+    instance->timeout_heap[idx].rx_idx = (uint8_t)rx_idx;
+    instance->timeout_armed[rx_idx] = true;
+    timeout_heap_sift_up(instance, idx);
+}
+
+/**
+ * @brief Drops the earliest entry off the timeout heap.
+ */
+static void timeout_heap_pop(NightCANInstance *instance) {
+    instance->timeout_armed[instance->timeout_heap[0].rx_idx] = false;
+
+    instance->timeout_heap_count--;
+    if (instance->timeout_heap_count > 0) {
+        instance->timeout_heap[0] =
+            instance->timeout_heap[instance->timeout_heap_count];
+        timeout_heap_sift_down(instance, 0);
+    }
+}
+
+// send_frame flags, and what a received frame was (NightCANFrame.flags)
+#define TX_FRAME_EXT 0x01U  // 29-bit ID
+#define TX_FRAME_RTR 0x02U  // remote frame (bxCAN only)
+#define TX_FRAME_FD 0x04U   // FD format
+#define TX_FRAME_BRS 0x08U  // FD with bit rate switching
+
+/**
+ * @brief Pulls the identifier out of a HAL receive header.
+ */
+static inline uint32_t rx_header_id(NIGHTCAN_RX_HANDLETYPEDEF *rx_header) {
+#ifdef STM32L496xx
+    return (rx_header->IDE == CAN_ID_STD) ? rx_header->StdId
+                                          : rx_header->ExtId;
+#elif defined(STM32H733xx)
+    return rx_header->Identifier;
+#endif
+}
+
+/**
+ * @brief The TX_FRAME_* bits (EXT, FD, BRS) of a received frame.
+ */
+static inline uint8_t rx_header_flags(NIGHTCAN_RX_HANDLETYPEDEF *rx_header) {
+#ifdef STM32L496xx
+    return (rx_header->IDE == CAN_ID_EXT) ? TX_FRAME_EXT : 0;
+#elif defined(STM32H733xx)
+    uint8_t flags = 0;
+    if (rx_header->IdType == FDCAN_EXTENDED_ID) flags |= TX_FRAME_EXT;
+    if (rx_header->FDFormat == FDCAN_FD_CAN) flags |= TX_FRAME_FD;
+    if (rx_header->BitRateSwitch == FDCAN_BRS_ON) flags |= TX_FRAME_BRS;
+    return flags;
+#endif
+}
+
+/**
+ * @brief Pulls the payload length (bytes) out of a HAL receive header.
+ */
+static inline uint8_t rx_header_len(NIGHTCAN_RX_HANDLETYPEDEF *rx_header) {
+#ifdef STM32L496xx
+    uint32_t len = rx_header->DLC;
+    return (len > 8) ? 8 : (uint8_t)len;
+#elif defined(STM32H733xx)
+    return CAN_dlc_to_len((uint8_t)rx_header->DataLength,
+                          rx_header->FDFormat == FDCAN_FD_CAN);
+#endif
+}
+
+#if defined(STM32H733xx)
+#define NIGHTCAN_TSC_PRESCALER FDCAN_TIMESTAMP_PRESC_1  // TSCC.TCP CAN_Init sets
+
+/**
+ * @brief Rate the timestamp counter runs at: one tick per nominal bit time
+ * (the bit timing CubeMX gave the FDCAN) times the TSC prescaler.
+ * @param tsc_prescaler FDCAN_TIMESTAMP_PRESC_* it's programmed with.
+ * @return Ticks per second, 0 if the bit timing isn't set up.
+ */
+static uint32_t tsc_rate_hz(FDCAN_HandleTypeDef *hfdcan,
+                            uint32_t tsc_prescaler) {
+    uint32_t kernel_hz = HAL_RCCEx_GetPeriphCLKFreq(RCC_PERIPHCLK_FDCAN);
+    uint32_t bit_tq =
+        1U + hfdcan->Init.NominalTimeSeg1 + hfdcan->Init.NominalTimeSeg2;
+    uint32_t tick_clocks = hfdcan->Init.NominalPrescaler * bit_tq *
+                           ((tsc_prescaler >> 16) + 1U);  // TCP is n - 1
+    return tick_clocks ? kernel_hz / tick_clocks : 0;
+}
+#endif
+
+/**
+ * @brief A matching pair of readings of the FDCAN timestamp counter and the
+ * timer.c clock, taken right before a FIFO is emptied.
+ */
+typedef struct {
+    uint64_t now_us;
+    uint16_t tsc;
+    uint32_t tsc_hz;
+} RxTimeRef;
+
+static inline void rx_time_sample(NightCANInstance *instance, RxTimeRef *ref) {
+#if defined(STM32H733xx)
+    ref->tsc = (uint16_t)HAL_FDCAN_GetTimestampCounter(instance->hcan);
+    ref->tsc_hz = instance->tsc_hz;
+#else
+    ref->tsc = 0;
+#endif
+    ref->now_us = lib_timer_now_us();
+}
+
+/**
+ * @brief Arrival time of a frame on the lib_timer_now_us clock. On H7 this
+ * works back from the frame's hardware timestamp (anything still in the FIFO
+ * arrived less than one 16-bit TSC wrap ago, 65ms at 1Mbps), everywhere else
+ * it's the time the FIFO was read.
+ */
+static inline uint64_t rx_time_of(const RxTimeRef *ref, uint16_t rx_tsc) {
+#if defined(STM32H733xx)
+    uint16_t age_ticks = (uint16_t)(ref->tsc - rx_tsc);
+    uint64_t age_us = ((uint64_t)age_ticks * 1000000U) / ref->tsc_hz;
+    return ref->now_us - age_us;
+#else
+    (void)rx_tsc;
+    return ref->now_us;
+#endif
+}
+
+/**
+ * @brief Pulls the hardware timestamp out of a HAL receive header.
+ */
+static inline uint16_t rx_header_tsc(NIGHTCAN_RX_HANDLETYPEDEF *rx_header) {
+#if defined(STM32H733xx)
+    return (uint16_t)rx_header->RxTimestamp;
+#else
+    (void)rx_header;
+    return 0;
+#endif
+}
+
+#ifdef NIGHTCAN_STATS
+#define STATS_INC(instance, field) ((instance)->stats.field++)
+
+/**
+ * @brief Folds one arrival into the inbox's gap min/max/jitter.
+ */
+static void stats_record_rx(NightCANRxStats *st, uint64_t rx_time_us) {
+    // the low 32 bits of the us clock wrap after ~71 minutes, gaps are
+    // differences so that's fine
+    uint32_t now_us = (uint32_t)rx_time_us;
+
+    if (st->rx_count > 0) {
+        uint32_t gap_us = now_us - st->_last_rx_us;
+
+        if (st->rx_count == 1 || gap_us < st->gap_min_us) st->gap_min_us = gap_us;
+        if (gap_us > st->gap_max_us) st->gap_max_us = gap_us;
+
+        if (st->rx_count > 1) {
+            uint32_t d = (gap_us > st->_last_gap_us) ? gap_us - st->_last_gap_us
+                                                     : st->_last_gap_us - gap_us;
+            // J += (|D| - J) / 16
+            st->jitter_us =
+                (uint32_t)((int32_t)st->jitter_us +
+                           ((int32_t)d - (int32_t)st->jitter_us) / 16);
+        }
+        st->_last_gap_us = gap_us;
+    }
+
+    st->rx_count++;
+    st->_last_rx_us = now_us;
+}
+
+/**
+ * @brief Bins how long one CAN_periodic call took.
+ */
+static void stats_record_loop(NightCANInstance *instance, uint32_t cycles) {
+    NightCANStats *st = &instance->stats;
+    uint32_t us = lib_timer_cycles_to_us(cycles);
+
+    if (st->loop_count == 0 || us < st->loop_min_us) st->loop_min_us = us;
+    if (us > st->loop_max_us) st->loop_max_us = us;
+    st->loop_count++;
+
+    uint32_t bucket = (us == 0) ? 0 : 32 - __builtin_clz(us);
+    if (bucket >= CAN_STATS_LOOP_BUCKETS) bucket = CAN_STATS_LOOP_BUCKETS - 1;
+    st->loop_hist[bucket]++;
+}
+#else
+#define STATS_INC(instance, field) ((void)0)
+#endif
+
+#ifdef NIGHTCAN_SEQLOCK
+// --- Tear-Free Inbox Copies ---
+// Each inbox keeps its latest frame twice. _seq counts frames and the latest
+// one is in slot (seq & 1), so the receive path always writes the slot
+// readers aren't being pointed at and then moves seq on. A reader that
+// started before that still has a whole frame in front of it, it only has to
+// retry if a second frame came in (and took its slot) during the copy. So
+// neither side ever waits for the other, whichever runs at higher priority.
+
+/**
+ * @brief Puts the frame just stored in inbox idx into its spare slot and
+ * makes that the current one.
+ */
+static inline void inbox_publish(NightCANInstance *instance, uint32_t idx,
+                                 const uint8_t *data, uint8_t len) {
+    uint32_t next = INBOX_SEQ(instance, idx) + 1;
+    NightCANRxSlot *slot = &INBOX_SLOTS(instance, idx)[next & 1];
+
+    memcpy(slot->data, data, len);
+    slot->timestamp_ms = INBOX_TIMESTAMP_MS(instance, idx);
+    slot->timestamp_us = INBOX_TIMESTAMP_US(instance, idx);
+
+    // the slot has to be complete before readers get pointed at it
+    __DMB();
+    INBOX_SEQ(instance, idx) = next;
+}
+
+/**
+ * @brief Reader side of inbox_publish, see CAN_snapshot.
+ */
+static bool snapshot_read(const NightCANRxSlot *slots,
+                          const volatile uint32_t *seq, uint32_t *consumed,
+                          NightCANSnapshot *out) {
+    uint32_t start;
+    for (;;) {
+        start = *seq;
+        __DMB();
+        const NightCANRxSlot *slot = &slots[start & 1];
+        memcpy(out->data, slot->data, CAN_MAX_DATA_LEN);
+        out->timestamp_ms = slot->timestamp_ms;
+        out->timestamp_us = slot->timestamp_us;
+        __DMB();
+        // one new frame went into the other slot, two could have reused ours
+        if (*seq - start < 2) break;
+    }
+
+    out->frames = start - *consumed;
+    out->missed = (out->frames > 1) ? out->frames - 1 : 0;
+    *consumed = start;
+    return out->frames != 0;
+}
+#endif
+
+#ifdef NIGHTCAN_HISTORY
+// --- Signal History ---
+
+static const uint8_t history_signal_size[] = {
+    [CAN_SIGNAL_U8] = 1,  [CAN_SIGNAL_I8] = 1,  [CAN_SIGNAL_U16] = 2,
+    [CAN_SIGNAL_I16] = 2, [CAN_SIGNAL_U32] = 4, [CAN_SIGNAL_I32] = 4,
+    [CAN_SIGNAL_F32] = 4,
+};
+
+/**
+ * @brief Reads a history's signal out of a payload, scaled.
+ */
+static float history_decode(const NightCANHistory *history,
+                            const uint8_t *data) {
+    const uint8_t *src = data + history->start_byte;
+    uint8_t order = history->order;
+    float raw;
+
+    switch (history->type) {
+        case CAN_SIGNAL_U8: raw = (float)src[0]; break;
+        case CAN_SIGNAL_I8: raw = (float)(int8_t)src[0]; break;
+        case CAN_SIGNAL_U16: {
+            uint16_t v;
+            CAN_copyOrdered(&v, src, 2, order);
+            raw = (float)v;
+            break;
+        }
+        case CAN_SIGNAL_I16: {
+            int16_t v;
+            CAN_copyOrdered(&v, src, 2, order);
+            raw = (float)v;
+            break;
+        }
+        case CAN_SIGNAL_U32: {
+            uint32_t v;
+            CAN_copyOrdered(&v, src, 4, order);
+            raw = (float)v;
+            break;
+        }
+        case CAN_SIGNAL_I32: {
+            int32_t v;
+            CAN_copyOrdered(&v, src, 4, order);
+            raw = (float)v;
+            break;
+        }
+        default: {
+            CAN_copyOrdered(&raw, src, 4, order);
+            break;
+        }
+    }
+
+    return raw * history->precision;
+}
+
+/**
+ * @brief Feeds a received frame to the histories on inbox idx.
+ */
+static void history_record(NightCANInstance *instance, uint32_t idx,
+                           uint8_t len, const uint8_t *data,
+                           uint64_t rx_time_us) {
+    for (NightCANHistory *history = instance->rx_history[idx]; history;
+         history = history->_next) {
+        if (history->start_byte + history_signal_size[history->type] > len) {
+            continue;  // short frame, the signal isn't in it
+        }
+
+        float value;
+        if (history->mode == CAN_HISTORY_AVERAGE) {
+            history->_sum += history_decode(history, data);
+            if (++history->_pending < history->factor) continue;
+            value = history->_sum / (float)history->factor;
+            history->_sum = 0.0f;
+            history->_pending = 0;
+        } else {
+            // the first frame of each group is the one kept, so a fresh
+            // history has a sample as soon as anything arrives
+            bool keep = (history->_pending == 0);
+            if (++history->_pending >= history->factor) history->_pending = 0;
+            if (!keep) continue;
+            value = history_decode(history, data);
+        }
+
+        history->values[history->_head] = value;
+        history->timestamps_us[history->_head] = rx_time_us;
+        if (++history->_head == history->capacity) history->_head = 0;
+        if (history->_count < history->capacity) history->_count++;
+    }
+}
+#endif
+
+#ifdef NIGHTCAN_GATEWAY
+// with the TX path below
+static bool gateway_forward(NightCANInstance *instance, uint32_t id,
+                            uint8_t len, const uint8_t *data);
+#endif
+
+/**
+ * @brief Updates the data in the RX buffer for an ID
+ * @param instance Pointer to the driver instance.
+ * @param id Identifier of the received frame.
+ * @param len Number of payload bytes received.
+ * @param rx_data Pointer to the received data payload.
+ * @param rx_time_us When the frame arrived, on the lib_timer_now_us clock.
+ */
+static void update_rx_buffer(NightCANInstance *instance, uint32_t id,
+                             uint8_t flags, uint8_t len, const uint8_t *rx_data,
+                             uint64_t rx_time_us) {
+    STATS_INC(instance, rx_frames);
+
+#ifdef NIGHTCAN_TELEMETRY
+    // before any filtering, the capture should show everything on the bus
+    uint8_t telemetry_flags = 0;
+    if (flags & TX_FRAME_EXT) telemetry_flags |= USB_TELEMETRY_FLAG_EXT;
+    if (flags & TX_FRAME_FD) telemetry_flags |= USB_TELEMETRY_FLAG_FD;
+    if (flags & TX_FRAME_BRS) telemetry_flags |= USB_TELEMETRY_FLAG_BRS;
+    usb_telemetry_can((uint32_t)rx_time_us, id, telemetry_flags, len, rx_data);
+#endif
+
+#ifdef NIGHTCAN_LOG
+    if (instance->log) {
+        uint32_t primask = tx_queue_lock();  // see log_tx
+        uint8_t log_flags = 0;
+        if (flags & TX_FRAME_EXT) log_flags |= CAN_LOG_FLAG_EXT;
+        if (flags & TX_FRAME_FD) log_flags |= CAN_LOG_FLAG_FD;
+        if (flags & TX_FRAME_BRS) log_flags |= CAN_LOG_FLAG_BRS;
+        can_log_frame(instance->log, rx_time_us, id, log_flags,
+                      instance->log_bus, len, rx_data);
+        tx_queue_unlock(primask);
+    }
+#endif
+
+#if defined(NIGHTCAN_GATEWAY) && !defined(NIGHTCAN_RX_INTERRUPT)
+    // (the RX ISR already did this in interrupt mode)
+    bool routed = gateway_forward(instance, id, len, rx_data);
+#endif
+
+    if(id == BOOTLOAD_PACKET) {
+        boot_to_dfu();
+        return;
+    }
+
+#ifdef NIGHTCAN_FW_UPDATE
+    // a chunk comes in as a burst of frames with the same ID, they can't go
+    // through an inbox that only keeps the latest one
+    if (id == META_DATA_FOR_WRITE_MEMORY_FIRMWARE_UPDATE_256B_MAX_ID ||
+        id == WRITE_MEMORY_DATA_FIRMWARE_UPDATE_ID) {
+        can_fwupdate_on_frame(instance, id, len, rx_data);
+        return;
+    }
+#endif
+
+    if(id == BUS_ENABLE_DISABLE_ID) {
+        instance->bus_silence = (BUS_ENABLE_DISABLE_FIELD_0_TYPE) rx_data[BUS_ENABLE_DISABLE_FIELD_0_BYTE]; // updates
+        return;                                                                                             // bus silence
+    }
+
+    int32_t idx = rx_index_lookup(instance, id);
+
+    // error, there is no packet given with this ID
+    if (idx < 0) {
+#if defined(NIGHTCAN_GATEWAY) && !defined(NIGHTCAN_RX_INTERRUPT)
+        if (routed) return;  // it was only here to pass through
+#endif
+        STATS_INC(instance, rx_unknown_id);
+        return;
+    }
+
+#ifdef NIGHTCAN_STATS
+    stats_record_rx(&instance->rx_stats[idx], rx_time_us);
+#endif
+
+    INBOX_TIMESTAMP_MS(instance, idx) =
+        can_now_ms();  // Use HAL tick for timestamp
+    INBOX_TIMESTAMP_US(instance, idx) = rx_time_us;
+
+    // the heap entry still holds the old deadline, check_timeouts pushes it
+    // back when it gets there instead of us re-sorting on every frame.
+    // Only a packet that had fallen off the heap needs arming again.
+    bool recovered = inbox_mark_received(instance, idx);
+    timeout_heap_arm(instance, idx);
+    if (recovered) inbox_notify_timeout(instance, idx, false);
+
+    // only what arrived: past len rx_data is whatever the RX buffer held
+    // before, so a frame shorter than the inbox leaves zeros there instead
+    uint8_t dlc = INBOX_DLC(instance, idx);
+    uint8_t inbox_len = (dlc > CAN_MAX_DATA_LEN) ? CAN_MAX_DATA_LEN : dlc;
+    uint8_t len_to_copy = (len < inbox_len) ? len : inbox_len;
+    memcpy(INBOX_DATA(instance, idx), rx_data, len_to_copy);
+    memset(INBOX_DATA(instance, idx) + len_to_copy, 0, inbox_len - len_to_copy);
+#ifdef NIGHTCAN_SEQLOCK
+    inbox_publish(instance, idx, INBOX_DATA(instance, idx), inbox_len);
+#endif
+#ifdef NIGHTCAN_HISTORY
+    history_record(instance, idx, len, rx_data, rx_time_us);
+#endif
+}
+
+#ifdef NIGHTCAN_RX_INTERRUPT
+/**
+ * @brief Copies one decoded frame into the RX ring (ISR side). Drops and
+ * counts it if the ring is full.
+ */
+static inline void rx_ring_push(NightCANInstance *instance, uint32_t id,
+                                uint8_t flags, uint8_t len,
+                                const uint8_t *data, uint64_t rx_time_us) {
+#ifdef NIGHTCAN_GATEWAY
+    gateway_forward(instance, id, len, data);
+#endif
+
+    uint32_t head = instance->rx_ring_head;
+    uint32_t used = head - instance->rx_ring_tail;
+    if (used >= CAN_RX_RING_SIZE) {
+        instance->rx_ring_drops++;
+        return;
+    }
+
+    NightCANFrame *frame = &instance->rx_ring[head & (CAN_RX_RING_SIZE - 1)];
+    frame->id = id;
+    frame->flags = flags;
+    frame->len = len;
+    frame->timestamp_us = rx_time_us;
+#ifdef NIGHTCAN_FD
+    memcpy(frame->data, data, len);
+#else
+    memcpy(frame->data, data, 8);
+#endif
+
+    // make sure the slot contents land before the consumer can see them
+    __DMB();
+    instance->rx_ring_head = head + 1;
+
+    if (used + 1 > instance->rx_ring_high_water) {
+        instance->rx_ring_high_water = used + 1;
+    }
+}
+#endif
+
+#if defined(STM32H733xx) && defined(NIGHTCAN_RX_MSGRAM)
+// --- FDCAN Message RAM Fast Path ---
+// Rx FIFO element layout (RM0468 "Rx FIFO element"):
+//   R0: [31] ESI, [30] XTD, [29] RTR, [28:0] ID (standard ID in [28:18])
+//   R1: [31] ANMF, [30:24] FIDX, [21] FDF, [20] BRS, [19:16] DLC, [15:0] RXTS
+//   R2..: payload, little-endian words
+#define FDCAN_ELEMENT_XTD (1U << 30)
+#define FDCAN_ELEMENT_FDF (1U << 21)  // R1: frame was FD format
+#define FDCAN_ELEMENT_BRS (1U << 20)  // R1: FD with bit rate switching
+
+/**
+ * @brief Drains an Rx FIFO by decoding elements straight out of message RAM,
+ * skipping HAL_FDCAN_GetRxMessage (which rebuilds a full header and copies
+ * the payload into a bounce buffer per frame). The fill level and get index
+ * are read once, and the whole batch is released with a single write to the
+ * acknowledge register. Assumes the FIFO runs in blocking mode (the CubeMX
+ * default), not overwrite.
+ * @param to_ring true from the RX ISR (frames go to the ring), false when
+ * polling (frames go straight into their inbox).
+ */
+static void fdcan_drain_msgram(NightCANInstance *instance, uint32_t fifo,
+                               bool to_ring) {
+    FDCAN_HandleTypeDef *hfdcan = instance->hcan;
+    uint32_t status, base, element_words, element_count;
+    volatile uint32_t *ack;
+
+    if (fifo == FDCAN_RX_FIFO0) {
+        status = hfdcan->Instance->RXF0S;
+        base = hfdcan->msgRam.RxFIFO0SA;
+        element_words = hfdcan->Init.RxFifo0ElmtSize;  // FDCAN_DATA_BYTES_x
+        element_count = hfdcan->Init.RxFifo0ElmtsNbr;  // is the size in words
+        ack = &hfdcan->Instance->RXF0A;
+    } else {
+        status = hfdcan->Instance->RXF1S;
+        base = hfdcan->msgRam.RxFIFO1SA;
+        element_words = hfdcan->Init.RxFifo1ElmtSize;
+        element_count = hfdcan->Init.RxFifo1ElmtsNbr;
+        ack = &hfdcan->Instance->RXF1A;
+    }
+
+    // F0FL/F1FL and F0GI/F1GI sit at the same positions in both registers
+    uint32_t fill = status & FDCAN_RXF0S_F0FL;
+    uint32_t idx = (status & FDCAN_RXF0S_F0GI) >> FDCAN_RXF0S_F0GI_Pos;
+    uint32_t last = idx;
+    if (fill == 0 || element_count == 0) return;
+
+    RxTimeRef time_ref;
+    rx_time_sample(instance, &time_ref);
+
+    for (uint32_t n = 0; n < fill; n++) {
+        const volatile uint32_t *element =
+            (const volatile uint32_t *)(uintptr_t)(base + idx * element_words * 4U);
+        uint32_t r0 = element[0];
+        uint32_t r1 = element[1];
+
+        uint32_t id = (r0 & FDCAN_ELEMENT_XTD) ? (r0 & 0x1FFFFFFFU)
+                                               : ((r0 >> 18) & 0x7FFU);
+        uint8_t len = CAN_dlc_to_len((uint8_t)((r1 >> 16) & 0xFU),
+                                     (r1 & FDCAN_ELEMENT_FDF) != 0);
+        uint8_t flags = 0;
+        if (r0 & FDCAN_ELEMENT_XTD) flags |= TX_FRAME_EXT;
+        if (r1 & FDCAN_ELEMENT_FDF) flags |= TX_FRAME_FD;
+        if (r1 & FDCAN_ELEMENT_BRS) flags |= TX_FRAME_BRS;
+
+        // message RAM only wants word accesses, so take the payload into
+        // registers and let the sink do the one real copy
+#ifdef NIGHTCAN_FD
+        uint32_t payload[CAN_MAX_DATA_LEN / 4];
+        uint32_t words = (len + 3U) / 4U;
+        if (words > element_words - 2) {
+            // element smaller than the dlc says, only hand on what's there
+            words = element_words - 2;
+            len = (uint8_t)(words * 4U);
+        }
+        for (uint32_t w = 0; w < words; w++) payload[w] = element[2 + w];
+#else
+        uint32_t payload[2] = {element[2], element[3]};
+#endif
+        uint64_t rx_time_us = rx_time_of(&time_ref, (uint16_t)(r1 & 0xFFFFU));
+
+#ifdef NIGHTCAN_RX_INTERRUPT
+        if (to_ring) {
+            rx_ring_push(instance, id, flags, len, (const uint8_t *)payload,
+                         rx_time_us);
+        } else
+#endif
+        {
+            update_rx_buffer(instance, id, flags, len,
+                             (const uint8_t *)payload, rx_time_us);
+        }
+
+        last = idx;
+        idx = (idx + 1 == element_count) ? 0 : idx + 1;
+    }
+
+    // acknowledging an index frees it and everything before it
+    *ack = last;
+}
+#endif
+
+#ifdef NIGHTCAN_RX_INTERRUPT
+/**
+ * @brief Moves everything currently in a hardware FIFO into the instance's RX
+ * ring. Runs in interrupt context: bounded by the fill level read on entry and
+ * never waits on the main loop, if the ring is full the frame is dropped and
+ * counted.
+ */
+static void rx_ring_fill_from_fifo(NightCANInstance *instance, uint32_t fifo) {
+#if defined(STM32H733xx) && defined(NIGHTCAN_RX_MSGRAM)
+    fdcan_drain_msgram(instance, fifo, true);
+    return;
+#endif
+
+    NIGHTCAN_RX_HANDLETYPEDEF rx_header;
+#if defined(STM32H733xx)
+    uint32_t fill_level = HAL_FDCAN_GetRxFifoFillLevel(instance->hcan, fifo);
+#elif defined(STM32L496xx)
+    uint32_t fill_level = HAL_CAN_GetRxFifoFillLevel(instance->hcan, fifo);
+#endif
+    RxTimeRef time_ref;
+    rx_time_sample(instance, &time_ref);
+
+    while (fill_level > 0) {
+        uint32_t head = instance->rx_ring_head;
+        uint32_t used = head - instance->rx_ring_tail;
+        NightCANFrame scratch;
+        // if there's no room we still have to pop the FIFO or the interrupt
+        // fires again right away
+        NightCANFrame *frame =
+            (used < CAN_RX_RING_SIZE)
+                ? &instance->rx_ring[head & (CAN_RX_RING_SIZE - 1)]
+                : &scratch;
+
+#if defined(STM32H733xx)
+        if (HAL_FDCAN_GetRxMessage(instance->hcan, fifo, &rx_header,
+                                   frame->data) != HAL_OK) {
+            break;
+        }
+#elif defined(STM32L496xx)
+        if (HAL_CAN_GetRxMessage(instance->hcan, fifo, &rx_header,
+                                 frame->data) != HAL_OK) {
+            break;
+        }
+#endif
+        fill_level--;
+
+        frame->id = rx_header_id(&rx_header);
+        frame->flags = rx_header_flags(&rx_header);
+        frame->len = rx_header_len(&rx_header);
+#ifdef NIGHTCAN_GATEWAY
+        // straight out of the slot the HAL copied it into, ring full or not
+        gateway_forward(instance, frame->id, frame->len, frame->data);
+#endif
+
+        if (frame == &scratch) {
+            instance->rx_ring_drops++;
+            continue;
+        }
+
+        frame->timestamp_us = rx_time_of(&time_ref, rx_header_tsc(&rx_header));
+
+        // make sure the slot contents land before the consumer can see them
+        __DMB();
+        instance->rx_ring_head = head + 1;
+
+        if (used + 1 > instance->rx_ring_high_water) {
+            instance->rx_ring_high_water = used + 1;
+        }
+    }
 }
 
 /**
- * @brief Checks if the receive buffer for a specific instance is full.
- * @param instance Pointer to the driver instance.
- * @retval true if full, false otherwise.
+ * @brief Sorts every frame the ISR has queued into the user inboxes. Only
+ * ever called from the main loop (the single consumer).
  */
-static bool is_rx_buffer_full(NightCANInstance *instance) {
-    return instance->rx_buffer_count == CAN_RX_BUFFER_SIZE;
+static void rx_ring_drain(NightCANInstance *instance) {
+    uint32_t tail = instance->rx_ring_tail;
+    uint32_t head = instance->rx_ring_head;
+    __DMB();
+
+    while (tail != head) {
+        NightCANFrame *frame = &instance->rx_ring[tail & (CAN_RX_RING_SIZE - 1)];
+        update_rx_buffer(instance, frame->id, frame->flags, frame->len,
+                         frame->data, frame->timestamp_us);
+        tail++;
+    }
+
+    // hand the slots back to the ISR
+    __DMB();
+    instance->rx_ring_tail = tail;
 }
+#endif
 
 /**
- * @brief Checks if the receive buffer for a specific instance is empty.
- * @param instance Pointer to the driver instance.
- * @retval true if empty, false otherwise.
+ * @brief Moves tx_schedule[idx] towards the root until the heap holds again.
  */
-static bool is_rx_buffer_empty(NightCANInstance *instance) {
-    return instance->rx_buffer_count == 0;
-}
-
-NightCANReceivePacket *get_packet_from_id(NightCANInstance *instance,
-                                          uint32_t id) {
-    for (int i = 0; i < instance->rx_buffer_count; i++) {
-        if (id == instance->rx_buffer[i]->id) {
-            // this is the correct packet, we can update the data on this.
-            return instance->rx_buffer[i];
+static void tx_heap_sift_up(NightCANInstance *instance, uint32_t idx) {
+    NightCANPacket **heap = instance->tx_schedule;
+    NightCANPacket *packet = heap[idx];
+
+    while (idx > 0) {
+        uint32_t parent = (idx - 1) / 2;
+        if (!time_before(packet->_next_tx_time_ms,
+                         heap[parent]->_next_tx_time_ms)) {
+            break;
         }
+        heap[idx] = heap[parent];
+        idx = parent;
     }
-
-    return NULL;
+    heap[idx] = packet;
 }
 
-
 /**
- * @brief Updates the data in the RX buffer for an ID
- * @param instance Pointer to the driver instance.
- * @param rx_header Pointer to the received message header.
- * @param rx_data Pointer to the received data payload.
+ * @brief Moves tx_schedule[idx] towards the leaves until the heap holds again.
  */
-static void update_rx_buffer(NightCANInstance *instance,
-                             NIGHTCAN_RX_HANDLETYPEDEF *rx_header,
-                             uint8_t *rx_data) {
-
-#ifdef STM32L496xx
-    uint8_t temp_id = (rx_header->IDE == CAN_ID_STD) ? rx_header->StdId : rx_header->ExtId;
-
-    if(temp_id == BOOTLOAD_PACKET) {
-        boot_to_dfu();
-        return;
+static void tx_heap_sift_down(NightCANInstance *instance, uint32_t idx) {
+    NightCANPacket **heap = instance->tx_schedule;
+    uint32_t count = instance->tx_schedule_count;
+    NightCANPacket *packet = heap[idx];
+
+    for (;;) {
+        uint32_t child = 2 * idx + 1;
+        if (child >= count) break;
+
+        // pick the earlier of the two children
+        if (child + 1 < count &&
+            time_before(heap[child + 1]->_next_tx_time_ms,
+                        heap[child]->_next_tx_time_ms)) {
+            child++;
+        }
+        if (!time_before(heap[child]->_next_tx_time_ms,
+                         packet->_next_tx_time_ms)) {
+            break;
+        }
+        heap[idx] = heap[child];
+        idx = child;
     }
+    heap[idx] = packet;
+}
 
-
-    if(temp_id == BUS_ENABLE_DISABLE_ID) {
-        instance->bus_silence = (BUS_ENABLE_DISABLE_FIELD_0_TYPE) rx_data[BUS_ENABLE_DISABLE_FIELD_0_BYTE]; // updates
-        return;                                                                                             // bus silence
+static uint32_t gcd_u32(uint32_t a, uint32_t b) {
+    while (b) {
+        uint32_t t = a % b;
+        a = b;
+        b = t;
     }
+    return a;
+}
 
-    NightCANReceivePacket *packet = get_packet_from_id(
-        instance,
-        (rx_header->IDE == CAN_ID_STD) ? rx_header->StdId : rx_header->ExtId);
-#elif defined(STM32H733xx)
-    if(rx_header->Identifier == BOOTLOAD_PACKET) {
-        boot_to_dfu();
-        return;
-    }
+/**
+ * @brief Picks the phase (ms offset mod interval) for a new periodic packet
+ * that collides least with what is already scheduled. Two packets with
+ * intervals I and J and phases a and b ever land on the same tick iff
+ * a == b (mod gcd(I, J)), and then they do so gcd(I, J) / (I * J) of the
+ * time, so that's the cost we add up per candidate offset.
+ */
+static uint32_t tx_pick_phase(NightCANInstance *instance, uint32_t interval) {
+    uint32_t slots = (interval < CAN_TX_STAGGER_MAX_SLOTS)
+                         ? interval
+                         : CAN_TX_STAGGER_MAX_SLOTS;
+    // candidates spread over the whole interval, not bunched at its start
+    uint32_t step = interval / slots;
+    uint32_t best_phase = 0;
+    uint32_t best_cost = UINT32_MAX;
+
+    for (uint32_t phase = 0; phase < slots * step; phase += step) {
+        uint32_t cost = 0;
+        for (uint32_t i = 0; i < instance->tx_schedule_count; i++) {
+            NightCANPacket *other = instance->tx_schedule[i];
+            uint32_t g = gcd_u32(interval, other->tx_interval_ms);
+            if ((other->_next_tx_time_ms % g) == (phase % g)) {
+                // scaled by 1024 to keep it integer, interval is common to
+                // every term so it drops out
+                cost += (g * 1024U) / other->tx_interval_ms;
+            }
+        }
 
-    if(rx_header->Identifier == BUS_ENABLE_DISABLE_ID) {
-        instance->bus_silence = (BUS_ENABLE_DISABLE_FIELD_0_TYPE) rx_data[BUS_ENABLE_DISABLE_FIELD_0_BYTE]; // updates
-        return;                                                                                             // bus silence
+        if (cost < best_cost) {
+            best_cost = cost;
+            best_phase = phase;
+            if (cost == 0) break;  // can't do better than never colliding
+        }
     }
 
-    // -- uncomment below for CAN dump --
-    // char hex_str[8 * 5 + 1]; // "0xHH " ×8 + null terminator = 41 chars
-    // char *p = hex_str;
-    //
-    // for (int i = 0; i < rx_header->DataLength; i++) {
-    //     p += sprintf(p, "0x%02x ", rx_data[i]);
-    // }
-    // usb_printf("[%#03x] %s", rx_header->Identifier, hex_str);
-    // -- end --
+    return best_phase;
+}
 
-    NightCANReceivePacket *packet =
-        get_packet_from_id(instance, rx_header->Identifier);
+#ifdef NIGHTCAN_LOG
+/**
+ * @brief Sends a frame that hardware accepted to the instance's log.
+ */
+static void log_tx(NightCANInstance *instance, uint64_t time_us, uint32_t id,
+                   uint32_t tx_flags, uint8_t len, const uint8_t *data) {
+    if (!instance->log) return;
+
+    uint8_t flags = CAN_LOG_FLAG_TX;
+    if (tx_flags & TX_FRAME_EXT) flags |= CAN_LOG_FLAG_EXT;
+    if (tx_flags & TX_FRAME_FD) flags |= CAN_LOG_FLAG_FD;
+    if (tx_flags & TX_FRAME_BRS) flags |= CAN_LOG_FLAG_BRS;
+
+    // the same ISRs that can send can also race the RX side for the log
+    uint32_t primask = tx_queue_lock();
+    can_log_frame(instance->log, time_us, id, flags, instance->log_bus, len,
+                  data);
+    tx_queue_unlock(primask);
+}
 #endif
 
-    // error, there is no packet given with this ID
-    if (!packet) return;
-
-    packet->timestamp_ms =
-        lib_timer_elapsed_ms();  // Use HAL tick for timestamp
-    packet->is_recent = true;
+#ifdef NIGHTCAN_TELEMETRY
+/**
+ * @brief Mirrors a frame the hardware accepted to the USB telemetry stream.
+ */
+static void telemetry_tx(uint64_t time_us, uint32_t id, uint32_t tx_flags,
+                         uint8_t len, const uint8_t *data) {
+    uint8_t flags = USB_TELEMETRY_FLAG_TX;
+    if (tx_flags & TX_FRAME_EXT) flags |= USB_TELEMETRY_FLAG_EXT;
+    if (tx_flags & TX_FRAME_FD) flags |= USB_TELEMETRY_FLAG_FD;
+    if (tx_flags & TX_FRAME_BRS) flags |= USB_TELEMETRY_FLAG_BRS;
+    usb_telemetry_can((uint32_t)time_us, id, flags, len, data);
+}
+#endif
 
-    uint8_t len_to_copy = (packet->dlc > 8) ? 8 : packet->dlc;
-    memcpy(packet->data, rx_data, len_to_copy);
+#ifdef NIGHTCAN_TX_MIRROR
+/**
+ * @brief Mirrors a frame the hardware accepted at time_us. Called once the
+ * TX queue lock is dropped, encoding a telemetry record is too much work to
+ * do with interrupts masked.
+ */
+static void tx_sent(NightCANInstance *instance, uint64_t time_us, uint32_t id,
+                    uint32_t flags, uint8_t len, const uint8_t *data) {
+#ifdef NIGHTCAN_TELEMETRY
+    telemetry_tx(time_us, id, flags, len, data);
+#endif
+#ifdef NIGHTCAN_LOG
+    log_tx(instance, time_us, id, flags, len, data);
+#else
+    (void)instance;
+#endif
 }
+#endif
 
 /**
- * @brief Sends a CAN packet immediately using HAL for a specific instance.
+ * @brief Hands one frame to the hardware. The payload goes from data
+ * straight into the TX mailbox / message RAM. The caller mirrors it with
+ * tx_sent if it went out.
  * @param instance Pointer to the driver instance.
- * @param packet Pointer to the NightCANPacket to send.
+ * @param id CAN identifier.
+ * @param flags TX_FRAME_* bits.
+ * @param len Payload length in bytes.
+ * @param data Payload.
  * @retval CANDriverStatus status code.
  */
-static CANDriverStatus send_immediate(NightCANInstance *instance,
-                                      NightCANPacket *packet) {
-    if (!instance || !instance->initialized || !packet) {
-        return CAN_INSTANCE_NULL;  // Or CAN_INVALID_PARAM
-    }
-
-    if (!instance->hcan) {
-        return CAN_ERROR;
-    }
-
+static CANDriverStatus send_frame(NightCANInstance *instance, uint32_t id,
+                                  uint32_t flags, uint8_t len,
+                                  const uint8_t *data) {
     NIGHTCAN_TX_HANDLETYPEDEF tx_header;
 
 #ifdef STM32L496xx
     // Prepare the HAL transmit header from our packet structure
-    tx_header.DLC = packet->dlc;
-    tx_header.RTR = packet->rtr;
-    tx_header.IDE = packet->ide;
-    if (packet->ide == CAN_ID_STD) {
-        tx_header.StdId = packet->id;
+    tx_header.DLC = len;
+    tx_header.RTR = (flags & TX_FRAME_RTR) ? CAN_RTR_REMOTE : CAN_RTR_DATA;
+    tx_header.IDE = (flags & TX_FRAME_EXT) ? CAN_ID_EXT : CAN_ID_STD;
+    if (tx_header.IDE == CAN_ID_STD) {
+        tx_header.StdId = id;
     } else {
-        tx_header.ExtId = packet->id;
+        tx_header.ExtId = id;
     }
 #elif defined(STM32H733xx)
     // fro fdcan in h7 chip wahooo
-    tx_header.DataLength = packet->dlc;
-    tx_header.IdType = packet->ide;
-    tx_header.Identifier = packet->id;
-    tx_header.IdType = FDCAN_STANDARD_ID;      // Standard ID type
+    tx_header.DataLength = CAN_len_to_dlc(len);
+    tx_header.Identifier = id;
+    tx_header.IdType =
+        (flags & TX_FRAME_EXT) ? FDCAN_EXTENDED_ID : FDCAN_STANDARD_ID;
     tx_header.TxFrameType = FDCAN_DATA_FRAME;  // Data frame
     tx_header.ErrorStateIndicator = FDCAN_ESI_ACTIVE;
-    tx_header.BitRateSwitch = FDCAN_BRS_OFF;
-    tx_header.FDFormat = FDCAN_CLASSIC_CAN;
+    tx_header.BitRateSwitch =
+        (flags & TX_FRAME_BRS) ? FDCAN_BRS_ON : FDCAN_BRS_OFF;
+    tx_header.FDFormat = (flags & TX_FRAME_FD) ? FDCAN_FD_CAN : FDCAN_CLASSIC_CAN;
     tx_header.TxEventFifoControl =
         FDCAN_NO_TX_EVENTS;  // No Tx events stored by default
 #endif
 
     // --- Platform-Specific HAL Calls ---
 #if defined(STM32H733xx)  // Use the specific define from can_driver.h
-    HAL_StatusTypeDef hal_status =
-        HAL_FDCAN_AddMessageToTxFifoQ(instance->hcan, &tx_header, packet->data);
+    // the HAL reports a full FIFO as HAL_ERROR, tell it apart from a real one
+    if (HAL_FDCAN_GetTxFifoFreeLevel(instance->hcan) == 0) {
+        STATS_INC(instance, tx_busy);
+        return CAN_BUSY;
+    }
+
+    HAL_StatusTypeDef hal_status = HAL_FDCAN_AddMessageToTxFifoQ(
+        instance->hcan, &tx_header, (uint8_t *)data);
 #elif defined(STM32L496xx)  // Use the specific define from can_driver.h
                             // Check available mailboxes before attempting to
                             // send
     if (HAL_CAN_GetTxMailboxesFreeLevel(instance->hcan) == 0) {
+        STATS_INC(instance, tx_busy);
         return CAN_BUSY;  // No free mailboxes
     }
 
     HAL_StatusTypeDef hal_status = HAL_CAN_AddTxMessage(
-        instance->hcan, &tx_header, packet->data, &tx_mailbox);
+        instance->hcan, &tx_header, (uint8_t *)data, &tx_mailbox);
 #else
 #error "Ay follow the notion"
     return CAN_ERROR;  // Should not reach here if header check passed
@@ -206,13 +1238,414 @@ static CANDriverStatus send_immediate(NightCANInstance *instance,
 
     // return the status of the HAl but with our CAN wrapper
     if (hal_status == HAL_OK) {
+        STATS_INC(instance, tx_frames);
         return CAN_OK;
     } else if (hal_status == HAL_BUSY) {
+        STATS_INC(instance, tx_busy);
         return CAN_BUSY;
     } else {
+        STATS_INC(instance, tx_errors);
+        return CAN_ERROR;
+    }
+}
+
+/**
+ * @brief TX_FRAME_* flags a packet goes out with.
+ */
+static inline uint32_t packet_tx_flags(const NightCANPacket *packet) {
+    uint32_t flags = 0;
+#ifdef STM32L496xx
+    if (packet->ide == CAN_ID_EXT) flags |= TX_FRAME_EXT;
+    if (packet->rtr == CAN_RTR_REMOTE) flags |= TX_FRAME_RTR;
+#else
+    if (packet->id > 0x7FF) flags |= TX_FRAME_EXT;
+#endif
+#ifdef NIGHTCAN_FD
+    if (packet->fd) flags |= TX_FRAME_FD;
+    if (packet->brs) flags |= TX_FRAME_BRS;
+#endif
+    return flags;
+}
+
+/**
+ * @brief Sends a CAN packet immediately using HAL for a specific instance.
+ * @param instance Pointer to the driver instance.
+ * @param packet Pointer to the NightCANPacket to send.
+ * @retval CANDriverStatus status code.
+ */
+static CANDriverStatus send_immediate(NightCANInstance *instance,
+                                      NightCANPacket *packet) {
+    if (!instance || !instance->initialized || !packet) {
+        return CAN_INSTANCE_NULL;  // Or CAN_INVALID_PARAM
+    }
+
+    if (!instance->hcan) {
         return CAN_ERROR;
     }
+
+    return send_frame(instance, packet->id, packet_tx_flags(packet),
+                      packet->dlc, packet->data);
+}
+
+/**
+ * @brief Priority order of the TX queue: lower ID first, then oldest first.
+ */
+static inline bool tx_entry_before(const NightCANTxEntry *a,
+                                   const NightCANTxEntry *b) {
+    if (a->frame.id != b->frame.id) return a->frame.id < b->frame.id;
+    return (int32_t)(a->seq - b->seq) < 0;
+}
+
+static void tx_queue_sift_up(NightCANInstance *instance, uint32_t idx) {
+    NightCANTxEntry *heap = instance->tx_queue;
+    NightCANTxEntry entry = heap[idx];
+
+    while (idx > 0) {
+        uint32_t parent = (idx - 1) / 2;
+        if (!tx_entry_before(&entry, &heap[parent])) break;
+        heap[idx] = heap[parent];
+        idx = parent;
+    }
+    heap[idx] = entry;
+}
+
+static void tx_queue_sift_down(NightCANInstance *instance, uint32_t idx) {
+    NightCANTxEntry *heap = instance->tx_queue;
+    uint32_t count = instance->tx_queue_count;
+    NightCANTxEntry entry = heap[idx];
+
+    for (;;) {
+        uint32_t child = 2 * idx + 1;
+        if (child >= count) break;
+        if (child + 1 < count && tx_entry_before(&heap[child + 1], &heap[child])) {
+            child++;
+        }
+        if (!tx_entry_before(&heap[child], &entry)) break;
+        heap[idx] = heap[child];
+        idx = child;
+    }
+    heap[idx] = entry;
+}
+
+/**
+ * @brief Takes entry idx out of the queue. Caller holds the queue lock.
+ */
+static void tx_queue_remove_at(NightCANInstance *instance, uint32_t idx) {
+    uint32_t last = --instance->tx_queue_count;
+    if (idx == last) return;
+
+    instance->tx_queue[idx] = instance->tx_queue[last];
+    tx_queue_sift_up(instance, idx);
+    tx_queue_sift_down(instance, idx);
+}
+
+/**
+ * @brief Queues a copy of the packet. If an older copy from the same source
+ * is still waiting it just gets the new payload. When the queue is full the
+ * lowest priority frame is evicted (if the new one outranks it), so telemetry
+ * can never push out something like the torque command. Caller holds the
+ * queue lock.
+ * @param source The user packet this is a copy of, or NULL for frames that
+ * aren't (forwarded ones), which coalesce by ID instead.
+ * @retval CAN_OK if queued, CAN_BUFFER_FULL if the frame was dropped.
+ */
+static CANDriverStatus tx_queue_push(NightCANInstance *instance,
+                                     const NightCANPacket *packet,
+                                     NightCANPacket *source) {
+    for (uint32_t i = 0; i < instance->tx_queue_count; i++) {
+        NightCANTxEntry *waiting = &instance->tx_queue[i];
+        if (source ? (waiting->source == source)
+                   : (!waiting->source && waiting->frame.id == packet->id)) {
+            memcpy(instance->tx_queue[i].frame.data, packet->data,
+                   CAN_MAX_DATA_LEN);
+            instance->tx_queue[i].frame.dlc = packet->dlc;
+#ifdef NIGHTCAN_FD
+            instance->tx_queue[i].frame.fd = packet->fd;
+            instance->tx_queue[i].frame.brs = packet->brs;
+#endif
+            return CAN_OK;
+        }
+    }
+
+    if (instance->tx_queue_count >= CAN_TX_QUEUE_SIZE) {
+        // the lowest priority entry is one of the leaves
+        uint32_t worst = CAN_TX_QUEUE_SIZE / 2;
+        for (uint32_t i = worst + 1; i < CAN_TX_QUEUE_SIZE; i++) {
+            if (tx_entry_before(&instance->tx_queue[worst],
+                                &instance->tx_queue[i])) {
+                worst = i;
+            }
+        }
+
+        instance->tx_queue_dropped++;
+        if (packet->id >= instance->tx_queue[worst].frame.id) {
+            return CAN_BUFFER_FULL;  // new one is the least important
+        }
+        tx_queue_remove_at(instance, worst);
+    }
+
+    uint32_t idx = instance->tx_queue_count++;
+    NightCANTxEntry *entry = &instance->tx_queue[idx];
+    entry->frame = *packet;
+    entry->source = source;
+    entry->enqueue_time_ms = can_now_ms();
+    entry->seq = instance->tx_queue_seq++;
+    tx_queue_sift_up(instance, idx);
+
+    instance->tx_queue_enqueued++;
+    if (instance->tx_queue_count > instance->tx_queue_high_water) {
+        instance->tx_queue_high_water = instance->tx_queue_count;
+    }
+    return CAN_OK;
+}
+
+/**
+ * @brief Hands queued frames to the hardware, highest priority first, until
+ * the queue is empty or the hardware is full again. Safe from both the main
+ * loop and the TX complete ISR.
+ */
+static void tx_queue_drain(NightCANInstance *instance) {
+    // one frame per lock, so the sent frame can be mirrored unmasked
+    for (;;) {
+        uint32_t primask = tx_queue_lock();
+        NightCANTxEntry *entry = &instance->tx_queue[0];
+        if (instance->tx_queue_count == 0 ||
+            send_immediate(instance, &entry->frame) != CAN_OK) {
+            tx_queue_unlock(primask);
+            return;
+        }
+
+        uint32_t waited = can_now_ms() - entry->enqueue_time_ms;
+        instance->tx_queue_time_total_ms += waited;
+        if (waited > instance->tx_queue_time_max_ms) {
+            instance->tx_queue_time_max_ms = waited;
+        }
+
+#ifdef NIGHTCAN_TX_MIRROR
+        uint64_t sent_us = lib_timer_now_us();
+        NightCANPacket sent = entry->frame;
+#endif
+        tx_queue_remove_at(instance, 0);
+        tx_queue_unlock(primask);
+
+#ifdef NIGHTCAN_TX_MIRROR
+        tx_sent(instance, sent_us, sent.id, packet_tx_flags(&sent), sent.dlc,
+                sent.data);
+#endif
+    }
+}
+
+/**
+ * @brief Sends a packet, or queues it if the hardware is busy or something
+ * more important is already waiting.
+ * @retval CAN_OK if it was sent or queued, CAN_BUFFER_FULL if dropped,
+ * CAN_ERROR if the HAL refused it for anything but a full FIFO.
+ */
+static CANDriverStatus transmit(NightCANInstance *instance,
+                                NightCANPacket *packet) {
+    uint32_t primask = tx_queue_lock();
+    CANDriverStatus status;
+
+    // only go straight to the hardware if nothing is waiting, otherwise we'd
+    // jump ahead of queued frames
+    if (instance->tx_queue_count == 0) {
+        status = send_immediate(instance, packet);
+        if (status == CAN_OK) {
+#ifdef NIGHTCAN_TX_MIRROR
+            uint64_t sent_us = lib_timer_now_us();
+            tx_queue_unlock(primask);
+            tx_sent(instance, sent_us, packet->id, packet_tx_flags(packet),
+                    packet->dlc, packet->data);
+#else
+            tx_queue_unlock(primask);
+#endif
+            return CAN_OK;
+        }
+        if (status != CAN_BUSY) {
+            // a HAL error (bus-off, bad config) or a bad packet, queueing
+            // would only retry it on every completion
+            tx_queue_unlock(primask);
+            return status;
+        }
+    }
+
+    status = tx_queue_push(instance, packet, packet);
+    tx_queue_unlock(primask);
+
+    // the hardware may have room for the front of the queue already
+    if (status == CAN_OK) tx_queue_drain(instance);
+    return status;
+}
+
+// --- On-Change Transmission ---
+
+/**
+ * @brief If a packet's data differs from what it last went out with. Done a
+ * 64-bit word at a time, so a classic frame is a single compare.
+ */
+static inline bool tx_data_changed(const NightCANPacket *packet) {
+    uint32_t words = (packet->dlc + 7U) / 8U;
+    if (words > CAN_MAX_DATA_LEN / 8) words = CAN_MAX_DATA_LEN / 8;
+
+    for (uint32_t w = 0; w < words; w++) {
+        uint64_t now, last;
+        memcpy(&now, packet->data + w * 8, 8);
+        memcpy(&last, packet->_last_tx_data + w * 8, 8);
+        if (now != last) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Bookkeeping after a packet went to transmit().
+ */
+static inline void tx_mark_sent(NightCANPacket *packet, uint32_t now) {
+    packet->_last_tx_time_ms = now;
+    if (packet->tx_on_change) {
+        memcpy(packet->_last_tx_data, packet->data, CAN_MAX_DATA_LEN);
+    }
+}
+
+/**
+ * @brief Puts a tx_on_change packet on the watch list and sends it so the
+ * receivers start out with its current data.
+ * @retval CAN_OK (also if it was already watched), CAN_BUFFER_FULL.
+ */
+static CANDriverStatus tx_watch_add(NightCANInstance *instance,
+                                    NightCANPacket *packet) {
+    for (uint32_t i = 0; i < instance->tx_watch_count; i++) {
+        if (instance->tx_watch[i] == packet) return CAN_OK;
+    }
+    if (instance->tx_watch_count >= CAN_TX_WATCH_SIZE) return CAN_BUFFER_FULL;
+
+    instance->tx_watch[instance->tx_watch_count++] = packet;
+    transmit(instance, packet);
+    tx_mark_sent(packet, can_now_ms());
+    return CAN_OK;
+}
+
+/**
+ * @brief Takes tx_watch[idx] off the watch list (order doesn't matter).
+ */
+static void tx_watch_remove(NightCANInstance *instance, uint32_t idx) {
+    uint32_t last = --instance->tx_watch_count;
+    instance->tx_watch[idx] = instance->tx_watch[last];
+    instance->tx_watch[last] = NULL;
+}
+
+#ifdef NIGHTCAN_GATEWAY
+/**
+ * @brief transmit() for a frame that isn't a NightCANPacket: it goes to the
+ * hardware straight from data, and only gets copied if it has to wait.
+ * @retval CAN_OK if it was sent or queued.
+ */
+static CANDriverStatus transmit_frame(NightCANInstance *instance, uint32_t id,
+                                      uint32_t flags, uint8_t len,
+                                      const uint8_t *data) {
+    uint32_t primask = tx_queue_lock();
+    CANDriverStatus status = CAN_BUSY;
+
+    if (instance->tx_queue_count == 0) {
+        status = send_frame(instance, id, flags, len, data);
+        if (status != CAN_BUSY) {
+#ifdef NIGHTCAN_TX_MIRROR
+            uint64_t sent_us = lib_timer_now_us();
+            tx_queue_unlock(primask);
+            if (status == CAN_OK) {
+                tx_sent(instance, sent_us, id, flags, len, data);
+            }
+#else
+            tx_queue_unlock(primask);
+#endif
+            return status;  // sent, or failing for a reason waiting won't fix
+        }
+    }
+
+    NightCANPacket packet = {.id = id, .dlc = len};
+#ifdef STM32L496xx
+    packet.ide = (flags & TX_FRAME_EXT) ? CAN_ID_EXT : CAN_ID_STD;
+#endif
+#ifdef NIGHTCAN_FD
+    packet.fd = (flags & TX_FRAME_FD) != 0;
+    packet.brs = (flags & TX_FRAME_BRS) != 0;
+#endif
+    memcpy(packet.data, data, len > CAN_MAX_DATA_LEN ? CAN_MAX_DATA_LEN : len);
+    status = tx_queue_push(instance, &packet, NULL);
+    tx_queue_unlock(primask);
+
+    if (status == CAN_OK) tx_queue_drain(instance);
+    return status;
+}
+
+/**
+ * @brief Sends a frame received on instance out on every route that matches
+ * it. Runs wherever the frame was read out of the hardware (the RX ISR with
+ * NIGHTCAN_RX_INTERRUPT).
+ * @retval true if any route matched.
+ */
+static bool gateway_forward(NightCANInstance *instance, uint32_t id,
+                            uint8_t len, const uint8_t *data) {
+    bool matched = false;
+    uint32_t flags = (id > 0x7FF) ? TX_FRAME_EXT : 0;
+    if (len > 8) flags |= TX_FRAME_FD | TX_FRAME_BRS;
+
+    for (uint32_t i = 0; i < instance->route_count; i++) {
+        NightCANRoute *route = &instance->routes[i];
+        if (((id ^ route->id) & route->mask) != 0) continue;
+        matched = true;
+
+        NightCANInstance *dest = route->dest;
+        if (!dest->initialized || dest->bus_silence) continue;
+
+        uint32_t now = can_now_ms();
+        if (route->min_interval_ms != 0 && route->_has_forwarded &&
+            now - route->_last_forward_ms < route->min_interval_ms) {
+            route->_skipped++;
+            continue;
+        }
+
+        if (transmit_frame(dest, id, flags, len, data) == CAN_OK) {
+            route->_last_forward_ms = now;
+            route->_has_forwarded = true;
+            route->_forwarded++;
+        } else {
+            route->_dropped++;
+        }
+    }
+
+    return matched;
+}
+#endif
+
+#ifdef NIGHTCAN_STATIC_CONFIG
+/**
+ * @brief Sets up every inbox and TX packet of the generated board config:
+ * inboxes start armed for their timeout, packets with an interval go on the
+ * schedule at the phase the generator picked.
+ */
+static void board_config_load(NightCANInstance *instance) {
+    uint32_t now = can_now_ms();
+
+    instance->rx_buffer_count = NIGHTCAN_BOARD_RX_COUNT;
+    for (uint32_t i = 0; i < NIGHTCAN_BOARD_RX_COUNT; i++) {
+        INBOX_ID(instance, i) = night_can_board_rx[i].id;
+        INBOX_DLC(instance, i) = night_can_board_rx[i].dlc;
+        INBOX_TIMEOUT_MS(instance, i) = night_can_board_rx[i].timeout_ms;
+        INBOX_TIMESTAMP_MS(instance, i) = now;
+        timeout_heap_arm(instance, i);
+    }
+    instance->rx_filters_dirty = true;
+
+    for (uint32_t i = 0; i < NIGHTCAN_BOARD_TX_COUNT; i++) {
+        const NightCANTxConfig *config = &night_can_board_tx[i];
+        NightCANPacket *packet = &instance->tx_packets[i];
+        *packet = CAN_create_packet(config->id, config->interval_ms,
+                                    config->dlc);
+        packet->tx_phase_ms = config->phase_ms;
+        if (packet->tx_interval_ms != 0) CAN_AddTxPacket(instance, packet);
+    }
 }
+#endif
 
 // --- Public API Functions ---
 
@@ -242,7 +1675,18 @@ CANDriverStatus CAN_Init(NightCANInstance *instance,
     night_can_instances[night_active_instances++] = instance;
 
 #if defined(STM32H733xx)
-
+    // free-running timestamp counter, one tick per nominal bit, stamped into
+    // every received frame so we know when it actually arrived
+    instance->tsc_hz = tsc_rate_hz(instance->hcan, NIGHTCAN_TSC_PRESCALER);
+    if (instance->tsc_hz == 0 ||
+        HAL_FDCAN_ConfigTimestampCounter(instance->hcan,
+                                         NIGHTCAN_TSC_PRESCALER) != HAL_OK ||
+        HAL_FDCAN_EnableTimestampCounter(instance->hcan,
+                                         FDCAN_TIMESTAMP_INTERNAL) != HAL_OK) {
+        night_active_instances--;
+        night_can_instances[night_active_instances] = NULL;
+        return CAN_ERROR;
+    }
 #elif defined(STM32L496xx)
     // to set up filter, bascially only using this on L4
     NIGHTCAN_FILTERTYPEDEF sFilterConfig;
@@ -286,6 +1730,47 @@ CANDriverStatus CAN_Init(NightCANInstance *instance,
 #endif
 
     instance->initialized = true;
+
+#ifdef NIGHTCAN_STATIC_CONFIG
+    board_config_load(instance);
+#endif
+
+#ifdef NIGHTCAN_RX_INTERRUPT
+    // frames get pulled off the hardware as soon as they land
+#if defined(STM32H733xx)
+    if (HAL_FDCAN_ActivateNotification(
+            instance->hcan,
+            FDCAN_IT_RX_FIFO0_NEW_MESSAGE | FDCAN_IT_RX_FIFO0_MESSAGE_LOST |
+                FDCAN_IT_RX_FIFO1_NEW_MESSAGE | FDCAN_IT_RX_FIFO1_MESSAGE_LOST,
+            0) != HAL_OK) {
+        return CAN_ERROR;
+    }
+#elif defined(STM32L496xx)
+    if (HAL_CAN_ActivateNotification(instance->hcan,
+                                     CAN_IT_RX_FIFO0_MSG_PENDING |
+                                         CAN_IT_RX_FIFO1_MSG_PENDING) !=
+        HAL_OK) {
+        return CAN_ERROR;
+    }
+#endif
+#endif
+
+#ifdef NIGHTCAN_TX_INTERRUPT
+    // refill the hardware from the queue as soon as a frame goes out
+#if defined(STM32H733xx)
+    if (HAL_FDCAN_ActivateNotification(
+            instance->hcan, FDCAN_IT_TX_COMPLETE | FDCAN_IT_TX_FIFO_EMPTY,
+            0xFFFFFFFFU) != HAL_OK) {
+        return CAN_ERROR;
+    }
+#elif defined(STM32L496xx)
+    if (HAL_CAN_ActivateNotification(instance->hcan, CAN_IT_TX_MAILBOX_EMPTY) !=
+        HAL_OK) {
+        return CAN_ERROR;
+    }
+#endif
+#endif
+
     return CAN_OK;
 }
 
@@ -299,13 +1784,26 @@ CANDriverStatus CAN_AddTxPacket(NightCANInstance *instance,
     if (!instance || !instance->initialized) return CAN_INSTANCE_NULL;
     if (!packet) return CAN_INVALID_PARAM;
 
+#ifdef NIGHTCAN_FD
+    // only FD frames carry more than 8 bytes
+    if (packet->dlc > (packet->fd ? CAN_MAX_DATA_LEN : 8)) {
+        return CAN_INVALID_PARAM;
+    }
+#else
     if (packet->dlc > 8) {
         return CAN_INVALID_PARAM;
     }
+#endif
+
+    if (packet->tx_on_change) {
+        CANDriverStatus status = tx_watch_add(instance, packet);
+        // without an interval there's no heartbeat to schedule
+        if (status != CAN_OK || packet->tx_interval_ms == 0) return status;
+    }
 
     // 0 interval means its nota scheduled packet
     if (packet->tx_interval_ms == 0) {
-        return send_immediate(instance, packet);
+        return transmit(instance, packet);
     } else {
         // check if we have space to schedule this (we should be fine).
         if (instance->tx_schedule_count >= CAN_TX_SCHEDULE_SIZE) {
@@ -321,15 +1819,51 @@ CANDriverStatus CAN_AddTxPacket(NightCANInstance *instance,
             }
         }
 
-        // add this shire to the scheudle.
-        packet->_last_tx_time_ms = lib_timer_elapsed_ms();
+        // add this shire to the scheudle. first send is about one interval
+        // out, lined up on its phase so same-rate packets don't all come due
+        // on the same tick.
+        uint32_t interval = packet->tx_interval_ms;
+        uint32_t phase = (packet->tx_phase_ms == CAN_TX_PHASE_AUTO)
+                             ? tx_pick_phase(instance, interval)
+                             : packet->tx_phase_ms % interval;
+        uint32_t first = can_now_ms() + interval;
+
+        packet->_last_tx_time_ms = can_now_ms();
+        packet->_next_tx_time_ms =
+            first + (phase + interval - (first % interval)) % interval;
         packet->_is_scheduled = true;
 
         instance->tx_schedule[instance->tx_schedule_count++] = packet;
+        tx_heap_sift_up(instance, instance->tx_schedule_count - 1);
         return CAN_OK;
     }
 }
 
+/**
+ * @brief Takes a packet off the periodic schedule heap only (an on-change
+ * packet stays watched).
+ * @return false if it wasn't on it.
+ */
+static bool tx_schedule_remove(NightCANInstance *instance,
+                               NightCANPacket *packet) {
+    for (uint32_t i = 0; i < instance->tx_schedule_count; i++) {
+        if (instance->tx_schedule[i] == packet) {
+            packet->_is_scheduled = false;
+
+            // move the last heap entry into the hole and restore the heap
+            uint32_t last = --instance->tx_schedule_count;
+            instance->tx_schedule[i] = instance->tx_schedule[last];
+            instance->tx_schedule[last] = NULL;
+            if (i < last) {
+                tx_heap_sift_up(instance, i);
+                tx_heap_sift_down(instance, i);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
 /**
  * @brief Removes a previously scheduled periodic packet from the transmission
  * schedule for a specific instance.
@@ -340,26 +1874,31 @@ CANDriverStatus CAN_RemoveScheduledTxPacket(NightCANInstance *instance,
     if (!instance || !instance->initialized) return CAN_INSTANCE_NULL;
     if (!packet) return CAN_INVALID_PARAM;
 
-    // look for packetm if we find it, send scheudled to false and remove from
-    // the transmit queue
-    for (uint32_t i = 0; i < instance->tx_schedule_count; i++) {
-        if (instance->tx_schedule[i] == packet) {
-            instance->tx_schedule[i]->_is_scheduled = false;
-
-            // shift everything over
-            for (uint32_t j = i; j < instance->tx_schedule_count - 1; j++) {
-                instance->tx_schedule[j] = instance->tx_schedule[j + 1];
-            }
-
-            instance->tx_schedule[--instance->tx_schedule_count] = NULL;
-            return CAN_OK;
+    bool watched = false;
+    for (uint32_t i = 0; i < instance->tx_watch_count; i++) {
+        if (instance->tx_watch[i] == packet) {
+            tx_watch_remove(instance, i);
+            watched = true;
+            break;
         }
     }
 
+    // look for packetm if we find it, send scheudled to false and remove from
+    // the transmit queue
+    if (tx_schedule_remove(instance, packet)) return CAN_OK;
+
     // packet not found in instance's schedule
-    return CAN_NOT_FOUND;
+    return watched ? CAN_OK : CAN_NOT_FOUND;
 }
 
+#ifdef NIGHTCAN_SOA_INBOXES
+NightCANInbox CAN_FindInbox(NightCANInstance *instance, uint32_t id) {
+    if (!instance || is_rx_buffer_empty(instance)) return CAN_INBOX_NONE;
+
+    int32_t idx = rx_index_lookup(instance, id);
+    return (idx < 0) ? CAN_INBOX_NONE : (NightCANInbox)idx;
+}
+#else
 /**
  * @brief Retrieves a packet with a specific ID.
  */
@@ -372,14 +1911,9 @@ NightCANReceivePacket *CAN_GetReceivedPacket(NightCANInstance *instance,
         return NULL;
     }
 
-    for (int i = 0; i < instance->rx_buffer_count; i++) {
-        if (instance->rx_buffer[i]->id == id) {
-            return instance->rx_buffer[i];
-        }
-    }
-    // Copy data from the instance's buffer at the tail position
-    return NULL;
+    return get_packet_from_id(instance, id);
 }
+#endif
 
 NightCANInstance CAN_new_instance() {
     NightCANInstance instance = {};
@@ -388,27 +1922,39 @@ NightCANInstance CAN_new_instance() {
 
 /**
  * @brief Polls the hardware FIFOs for received messages and moves them to the
- * driver's buffer.
+ * driver's buffer. With NIGHTCAN_RX_INTERRUPT this drains the ISR ring instead.
  */
 CANDriverStatus CAN_PollReceive(NightCANInstance *instance) {
     if (!instance || !instance->initialized) return CAN_INSTANCE_NULL;
     if (!instance->hcan) return CAN_ERROR;
 
+#ifdef NIGHTCAN_RX_INTERRUPT
+    // the ISR already pulled frames off the hardware, just sort them
+    rx_ring_drain(instance);
+#else
     // --- Platform specific polling ---
-#if defined(STM32H733xx)
+#if defined(STM32H733xx) && defined(NIGHTCAN_RX_MSGRAM)
+    fdcan_drain_msgram(instance, FDCAN_RX_FIFO0, false);
+    fdcan_drain_msgram(instance, FDCAN_RX_FIFO1, false);
+#elif defined(STM32H733xx)
     uint32_t fill_level0 =
         HAL_FDCAN_GetRxFifoFillLevel(instance->hcan, FDCAN_RX_FIFO0);
     uint32_t fill_level1 =
         HAL_FDCAN_GetRxFifoFillLevel(instance->hcan, FDCAN_RX_FIFO1);
     FDCAN_RxHeaderTypeDef rx_header;
-    uint8_t rx_data[8];
+    uint8_t rx_data[CAN_MAX_DATA_LEN];
+    RxTimeRef time_ref;
+    rx_time_sample(instance, &time_ref);
 
     // Poll FIFO 0
     while (fill_level0 > 0) {
         if (HAL_FDCAN_GetRxMessage(instance->hcan, FDCAN_RX_FIFO0, &rx_header,
                                    rx_data) == HAL_OK) {
 
-            update_rx_buffer(instance, &rx_header, rx_data);
+            update_rx_buffer(instance, rx_header_id(&rx_header),
+                             rx_header_flags(&rx_header),
+                             rx_header_len(&rx_header), rx_data,
+                             rx_time_of(&time_ref, rx_header_tsc(&rx_header)));
         } else {
             // Error getting message from FIFO0, break out of loop so we don't
             // have error
@@ -426,7 +1972,10 @@ CANDriverStatus CAN_PollReceive(NightCANInstance *instance) {
     while (fill_level1 > 0) {
         if (HAL_FDCAN_GetRxMessage(instance->hcan, FDCAN_RX_FIFO1, &rx_header,
                                    rx_data) == HAL_OK) {
-            update_rx_buffer(instance, &rx_header, rx_data);
+            update_rx_buffer(instance, rx_header_id(&rx_header),
+                             rx_header_flags(&rx_header),
+                             rx_header_len(&rx_header), rx_data,
+                             rx_time_of(&time_ref, rx_header_tsc(&rx_header)));
         } else {
             // Error getting message from FIFO1
             break;
@@ -442,13 +1991,18 @@ CANDriverStatus CAN_PollReceive(NightCANInstance *instance) {
     uint32_t fill_level1 =
         HAL_CAN_GetRxFifoFillLevel(instance->hcan, CAN_RX_FIFO1);
     CAN_RxHeaderTypeDef rx_header;
-    uint8_t rx_data[8];
+    uint8_t rx_data[CAN_MAX_DATA_LEN];
+    RxTimeRef time_ref;
+    rx_time_sample(instance, &time_ref);
 
     // Poll FIFO 0
     while (fill_level0 > 0) {
         if (HAL_CAN_GetRxMessage(instance->hcan, CAN_RX_FIFO0, &rx_header,
                                  rx_data) == HAL_OK) {
-            update_rx_buffer(instance, &rx_header, rx_data);
+            update_rx_buffer(instance, rx_header_id(&rx_header),
+                             rx_header_flags(&rx_header),
+                             rx_header_len(&rx_header), rx_data,
+                             rx_time_of(&time_ref, rx_header_tsc(&rx_header)));
         } else {
             break;  // Error
         }
@@ -461,7 +2015,10 @@ CANDriverStatus CAN_PollReceive(NightCANInstance *instance) {
     while (fill_level1 > 0) {
         if (HAL_CAN_GetRxMessage(instance->hcan, CAN_RX_FIFO1, &rx_header,
                                  rx_data) == HAL_OK) {
-            update_rx_buffer(instance, &rx_header, rx_data);
+            update_rx_buffer(instance, rx_header_id(&rx_header),
+                             rx_header_flags(&rx_header),
+                             rx_header_len(&rx_header), rx_data,
+                             rx_time_of(&time_ref, rx_header_tsc(&rx_header)));
         } else {
             break;  // Error
         }
@@ -473,6 +2030,7 @@ CANDriverStatus CAN_PollReceive(NightCANInstance *instance) {
 #error "Ay follow the notion!"
     return CAN_ERROR;
 #endif
+#endif  // NIGHTCAN_RX_INTERRUPT
 
     return CAN_OK;
 }
@@ -484,24 +2042,165 @@ CANDriverStatus CAN_PollReceive(NightCANInstance *instance) {
 void check_timeouts(NightCANInstance *instance) {
     if(!instance || instance->bus_silence) return; // if bus silence, nothing times out
 
-    for (int i = 0; i < instance->rx_buffer_count; i++) {
-        NightCANReceivePacket *packet = instance->rx_buffer[i];
-        // if the ms is defined, then we can check for timeouts, otherwise
-        // assume there's no timeouts
-        if (packet->timeout_ms != 0 &&
-            packet->timeout_ms <
-                lib_timer_elapsed_ms() - packet->timestamp_ms) {
-            packet->is_timed_out = true;
+    uint32_t now = can_now_ms();
+
+    // only the earliest deadlines are looked at. Anything that arrived since
+    // it was armed just gets its deadline moved out and goes back in.
+    while (instance->timeout_heap_count > 0) {
+        NightCANTimeoutEntry *top = &instance->timeout_heap[0];
+        if (!time_before(top->deadline_ms, now)) break;
+
+        uint32_t rx_idx = top->rx_idx;
+        uint32_t timeout_ms = INBOX_TIMEOUT_MS(instance, rx_idx);
+        if (timeout_ms == 0) {
+            // timeout switched off since it was armed
+            timeout_heap_pop(instance);
+            continue;
+        }
+
+        uint32_t deadline = INBOX_TIMESTAMP_MS(instance, rx_idx) + timeout_ms;
+        if (!time_before(deadline, now)) {
+            top->deadline_ms = deadline;
+            timeout_heap_sift_down(instance, 0);
+            continue;
+        }
+
+        // really timed out, it stays off the heap until a frame shows up
+        timeout_heap_pop(instance);
+        if (!inbox_is_timed_out(instance, rx_idx)) {
+            STATS_INC(instance, timeouts_raised);
+            inbox_set_timed_out(instance, rx_idx);
+            inbox_notify_timeout(instance, rx_idx, true);
         }
     }
 }
 
+#ifdef NIGHTCAN_GATEWAY
+CANDriverStatus CAN_SetRoutes(NightCANInstance *source, NightCANRoute *routes,
+                              uint32_t count) {
+    if (!source) return CAN_INSTANCE_NULL;
+    if (!routes) count = 0;
+    if (count > CAN_MAX_ROUTES) return CAN_BUFFER_FULL;
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (!routes[i].dest || routes[i].dest == source) {
+            return CAN_INVALID_PARAM;
+        }
+        routes[i]._has_forwarded = false;
+    }
+
+    source->routes = routes;
+    source->route_count = count;
+    source->rx_filters_dirty = true;
+    return CAN_OK;
+}
+#endif
+
+#ifdef NIGHTCAN_LOG
+void CAN_SetLog(NightCANInstance *instance, CanLogWriter *log, uint8_t bus) {
+    if (!instance) return;
+    instance->log = log;
+    instance->log_bus = bus;
+}
+#endif
+
+#ifdef NIGHTCAN_HISTORY
+NightCANHistory CAN_create_history(uint8_t start_byte, NightCANSignalType type,
+                                   uint8_t order, float precision,
+                                   NightCANHistoryMode mode, uint16_t factor,
+                                   float *values, uint64_t *timestamps_us,
+                                   uint32_t capacity) {
+    NightCANHistory history = {.start_byte = start_byte, .type = type,
+                               .order = order, .precision = precision,
+                               .mode = mode, .factor = factor ? factor : 1,
+                               .values = values, .timestamps_us = timestamps_us,
+                               .capacity = capacity};
+    return history;
+}
+
+CANDriverStatus CAN_AttachHistory(NightCANInstance *instance, uint32_t id,
+                                  NightCANHistory *history) {
+    if (!instance) return CAN_INSTANCE_NULL;
+    if (!history || !history->values || !history->timestamps_us ||
+        history->capacity == 0 || (uint32_t)history->type > CAN_SIGNAL_F32 ||
+        history->start_byte + history_signal_size[history->type] >
+            CAN_MAX_DATA_LEN) {
+        return CAN_INVALID_PARAM;
+    }
+
+    int32_t idx = rx_index_lookup(instance, id);
+    if (idx < 0) return CAN_NOT_FOUND;
+
+    if (history->factor == 0) history->factor = 1;
+    CAN_history_clear(history);
+    history->_next = instance->rx_history[idx];
+    instance->rx_history[idx] = history;
+    return CAN_OK;
+}
+
+uint32_t CAN_history_spans(const NightCANHistory *history, uint32_t n,
+                           NightCANSpan spans[2]) {
+    if (!history || !spans) return 0;
+
+    uint32_t count = CAN_history_count(history);
+    if (n > count) n = count;
+    if (n == 0) return 0;
+
+    // the oldest of the n wanted and how far it is from the end of the arrays
+    uint32_t first = (history->_head >= n)
+                         ? history->_head - n
+                         : history->_head + history->capacity - n;
+    uint32_t to_end = history->capacity - first;
+
+    spans[0].values = &history->values[first];
+    spans[0].timestamps_us = &history->timestamps_us[first];
+    if (n <= to_end) {
+        spans[0].count = n;
+        return 1;
+    }
+
+    spans[0].count = to_end;
+    spans[1].values = history->values;
+    spans[1].timestamps_us = history->timestamps_us;
+    spans[1].count = n - to_end;
+    return 2;
+}
+
+void CAN_history_clear(NightCANHistory *history) {
+    if (!history) return;
+    history->_head = 0;
+    history->_count = 0;
+    history->_pending = 0;
+    history->_sum = 0.0f;
+}
+#endif
+
+void CAN_SetTimeoutCallback(NightCANInstance *instance,
+                            NightCANTimeoutCallback callback) {
+    if (!instance) return;
+    instance->timeout_callback = callback;
+}
+
 void CAN_periodic(NightCANInstance *instance) {
     if (!instance || !instance->initialized) return;
 
+#ifdef NIGHTCAN_STATS
+    uint32_t start_cycles = lib_timer_cycles();
+#endif
+
+#ifdef NIGHTCAN_AUTO_FILTER
+    if (instance->rx_filters_dirty) {
+        CAN_ApplyReceiveFilters(instance);
+    }
+#endif
+
     CAN_Service(instance);
     CAN_PollReceive(instance);
     check_timeouts(instance);
+
+#ifdef NIGHTCAN_STATS
+    stats_record_loop(instance, lib_timer_cycles() - start_cycles);
+#endif
 }
 
 /**
@@ -515,31 +2214,152 @@ void CAN_Service(NightCANInstance *instance) {
 
     if(instance->bus_silence) return; // no sending messages while silenced.
 
-    uint32_t current_time_ms = lib_timer_elapsed_ms();
+    // anything still waiting from last time goes first
+    tx_queue_drain(instance);
 
-    // go through every scheduled packet and send it
-    for (uint32_t i = 0; i < instance->tx_schedule_count; i++) {
-        NightCANPacket *packet = instance->tx_schedule[i];
+    uint32_t current_time_ms = can_now_ms();
+
+    // due packets the queue refused, put back on the heap with their deadline
+    // unchanged once everything else due got its turn
+    NightCANPacket *retry[CAN_TX_SCHEDULE_SIZE];
+    uint32_t retry_count = 0;
+
+    // pop packets off the front of the heap until the earliest one isn't due
+    // yet, so an idle call is a single comparison
+    while (instance->tx_schedule_count > 0) {
+        NightCANPacket *packet = instance->tx_schedule[0];
 
-        // make sure packet exists and that it is shceudled to be sent (should
-        // be), also make sure that this one is nto a one time send packet (if
-        // ms interval is 0, it is meant ot only be sent once (crazy right?)) ⛺︎
-        if (packet && packet->_is_scheduled && packet->tx_interval_ms > 0) {
-            // make sure that we have waiited long enough
-            if ((current_time_ms - packet->_last_tx_time_ms) >=
-                packet->tx_interval_ms) {
-                if (send_immediate(instance, packet) == CAN_OK) {
-                    // Update last transmission time on successful send
-                    packet->_last_tx_time_ms = current_time_ms;
-                }
+        if (time_before(current_time_ms, packet->_next_tx_time_ms)) {
+            break;
+        }
+
+        if (packet->tx_interval_ms == 0) {
+            // interval was cleared after scheduling, it isn't periodic
+            // anymore. an on-change one keeps going out on change (0 is
+            // "only send on change"), so only the heap lets go of it
+            if (packet->tx_on_change) {
+                tx_schedule_remove(instance, packet);
+            } else {
+                CAN_RemoveScheduledTxPacket(instance, packet);
             }
+            continue;
+        }
+
+        if (packet->tx_on_change &&
+            time_before(current_time_ms,
+                        packet->_last_tx_time_ms + packet->tx_interval_ms)) {
+            // went out on a change since this was set, the longest quiet
+            // time counts from then
+            packet->_next_tx_time_ms =
+                packet->_last_tx_time_ms + packet->tx_interval_ms;
+            tx_heap_sift_down(instance, 0);
+            continue;
+        }
+
+        CANDriverStatus status = transmit(instance, packet);
+        if (status == CAN_BUFFER_FULL) {
+            // hardware and queue are full of more important frames. a lower
+            // ID further down the heap can still get in, so take this one
+            // off the heap and keep going
+            uint32_t last = --instance->tx_schedule_count;
+            instance->tx_schedule[0] = instance->tx_schedule[last];
+            instance->tx_schedule[last] = NULL;
+            if (last > 0) tx_heap_sift_down(instance, 0);
+            retry[retry_count++] = packet;
+            continue;
+        }
+
+        // anything else that failed (a HAL error, a bad packet) won't get
+        // better on a retry, that slot is just lost
+        if (status == CAN_OK) {
+            tx_mark_sent(packet, current_time_ms);
+#ifdef NIGHTCAN_STATS
+            uint32_t late = current_time_ms - packet->_next_tx_time_ms;
+            packet->_tx_count++;
+            packet->_tx_late_total_ms += late;
+            if (late > packet->_tx_late_max_ms) packet->_tx_late_max_ms = late;
+#endif
+        }
+
+        // advance by the interval (not from now) so the phase doesn't drift
+        // by however late this loop was
+        packet->_next_tx_time_ms += packet->tx_interval_ms;
+        if (!time_before(current_time_ms, packet->_next_tx_time_ms)) {
+            // more than a whole period behind (stall, bus silence), skip the
+            // missed slots instead of bursting them out, still on phase
+            uint32_t behind = current_time_ms - packet->_next_tx_time_ms;
+            packet->_next_tx_time_ms +=
+                (behind / packet->tx_interval_ms + 1) * packet->tx_interval_ms;
+        }
+
+        tx_heap_sift_down(instance, 0);
+    }
+
+    // still due, so they're first in line next call
+    for (uint32_t r = 0; r < retry_count; r++) {
+        instance->tx_schedule[instance->tx_schedule_count++] = retry[r];
+        tx_heap_sift_up(instance, instance->tx_schedule_count - 1);
+    }
+
+    // on-change packets, an unchanged one costs one compare
+    uint32_t i = 0;
+    while (i < instance->tx_watch_count) {
+        NightCANPacket *packet = instance->tx_watch[i];
+        if (!packet->tx_on_change) {
+            // switched back to plain periodic / one-shot
+            tx_watch_remove(instance, i);
+            continue;
+        }
+        i++;
+
+        if (!tx_data_changed(packet) ||
+            time_before(current_time_ms,
+                        packet->_last_tx_time_ms + packet->tx_min_interval_ms)) {
+            continue;
         }
+        // the watch list isn't in priority order, so a refused one doesn't
+        // say anything about the rest. its _last_tx_data stays as it was,
+        // so it's still changed next call and tried again
+        if (transmit(instance, packet) != CAN_OK) continue;
+        tx_mark_sent(packet, current_time_ms);
+#ifdef NIGHTCAN_STATS
+        packet->_tx_count++;
+#endif
     }
 }
 
+#ifdef NIGHTCAN_SOA_INBOXES
+#ifdef NIGHTCAN_SEQLOCK
+bool CAN_inbox_snapshot(NightCANInstance *instance, NightCANInbox inbox,
+                        NightCANSnapshot *out) {
+    if (!instance || !out || inbox >= instance->rx_buffer_count) return false;
+
+    bool fresh = snapshot_read(INBOX_SLOTS(instance, inbox),
+                               &INBOX_SEQ(instance, inbox),
+                               &INBOX_CONSUMED_SEQ(instance, inbox), out);
+    instance->rx_flags[inbox] &= (uint8_t)~CAN_INBOX_RECENT;
+    return fresh;
+}
+#endif
+#else
 void CAN_consume_packet(NightCANReceivePacket *packet) {
     packet->is_recent = false;
+#ifdef NIGHTCAN_SEQLOCK
+    packet->_consumed_seq = packet->_seq;
+#endif
+}
+
+#ifdef NIGHTCAN_SEQLOCK
+bool CAN_snapshot(NightCANReceivePacket *packet, NightCANSnapshot *out) {
+    if (!packet || !out) return false;
+
+    bool fresh = snapshot_read(packet->_slots, &packet->_seq,
+                               &packet->_consumed_seq, out);
+    packet->is_recent = false;
+    return fresh;
 }
+#endif
+#endif
 
 /**
  * Creates a packet to be used by the driver. Use this to set up the packet,
@@ -554,6 +2374,7 @@ NightCANPacket CAN_create_packet(uint32_t id, uint32_t interval_ms,
                                  uint8_t dlc) {
     NightCANPacket packet = {
             .tx_interval_ms = interval_ms,
+            .tx_phase_ms = 0,
             .id = id,
             .dlc = dlc,
             .data = {0}
@@ -562,6 +2383,10 @@ NightCANPacket CAN_create_packet(uint32_t id, uint32_t interval_ms,
 #ifdef STM32L496xx
     packet.ide = id > 0x7FF ? CAN_ID_EXT : CAN_ID_STD;
 #endif
+#ifdef NIGHTCAN_FD
+    packet.fd = dlc > 8;
+    packet.brs = packet.fd;
+#endif
 
     return packet;
 };
@@ -575,11 +2400,35 @@ NightCANPacket CAN_create_packet(uint32_t id, uint32_t interval_ms,
  * @param dlc
  * @return
  */
+#if defined(NIGHTCAN_SOA_INBOXES) && !defined(NIGHTCAN_STATIC_CONFIG)
+NightCANInbox CAN_AddInbox(NightCANInstance *instance, uint32_t id,
+                           uint32_t timeout_ms, uint8_t dlc) {
+    if (!instance) return CAN_INBOX_NONE;
+
+    int32_t existing = rx_index_lookup(instance, id);
+    if (existing >= 0) return (NightCANInbox)existing;
+    if (is_rx_buffer_full(instance)) return CAN_INBOX_NONE;
+
+    uint32_t idx = instance->rx_buffer_count++;
+    INBOX_ID(instance, idx) = id;
+    INBOX_DLC(instance, idx) = dlc;
+    INBOX_TIMEOUT_MS(instance, idx) = timeout_ms;
+    INBOX_TIMESTAMP_MS(instance, idx) = can_now_ms();
+    INBOX_TIMESTAMP_US(instance, idx) = 0;
+    instance->rx_flags[idx] = 0;
+    memset(INBOX_DATA(instance, idx), 0, CAN_MAX_DATA_LEN);
+
+    rx_index_insert(instance, id, idx);
+    instance->rx_filters_dirty = true;
+    timeout_heap_arm(instance, idx);
+    return (NightCANInbox)idx;
+}
+#elif !defined(NIGHTCAN_STATIC_CONFIG)
 NightCANReceivePacket CAN_create_receive_packet(uint32_t id,
                                                 uint32_t timeout_ms,
                                                 uint8_t dlc) {
     NightCANReceivePacket packet = {.id = id, .timeout_ms = timeout_ms, .dlc = dlc,
-                                    .timestamp_ms = lib_timer_elapsed_ms(), .is_recent = false};
+                                    .timestamp_ms = can_now_ms(), .is_recent = false};
     return packet;
 };
 
@@ -591,9 +2440,31 @@ void CAN_addReceivePacket(NightCANInstance *instance,
         return;
     }
 
-    // add to the buffer and increment 🥰
+    // add to the buffer and index it, then increment 🥰
+    rx_index_insert(instance, packet->id, instance->rx_buffer_count);
     instance->rx_buffer[instance->rx_buffer_count++] = packet;
+    instance->rx_filters_dirty = true;
+    timeout_heap_arm(instance, instance->rx_buffer_count - 1);
+}
+#else
+NightCANPacket *CAN_GetTxPacket(NightCANInstance *instance, uint32_t id) {
+    if (!instance || !instance->initialized) return NULL;
+
+    uint32_t lo = 0;
+    uint32_t hi = NIGHTCAN_BOARD_TX_COUNT;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        uint32_t mid_id = night_can_board_tx[mid].id;
+        if (mid_id == id) return &instance->tx_packets[mid];
+        if (mid_id < id) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return NULL;
 }
+#endif
 
 /**
  * @brief Configures an additional CAN filter for a specific instance.
@@ -635,6 +2506,339 @@ CANDriverStatus CAN_ConfigFilter(NightCANInstance *instance,
     return CAN_OK;
 }
 
+#ifdef NIGHTCAN_GATEWAY
+#define CAN_MAX_FILTER_IDS (CAN_RX_BUFFER_SIZE + 4 + CAN_MAX_ROUTES)
+
+/**
+ * @brief Whether a route only matches one ID, so it can share an ID list
+ * filter instead of needing a mask filter of its own.
+ */
+static inline bool route_is_exact(const NightCANRoute *route) {
+    return (route->mask & 0x1FFFFFFFU) == 0x1FFFFFFFU;
+}
+
+/**
+ * @brief Gathers the (id, mask) pairs of the masked routes. A route goes in
+ * the standard list if it can match an ID up to 0x7FF and in the extended
+ * one if it can match a bigger one, so the filters pass exactly what
+ * gateway_forward would.
+ */
+static void collect_filter_masks(NightCANInstance *instance,
+                                 uint32_t std_masks[][2], uint32_t *std_count,
+                                 uint32_t ext_masks[][2], uint32_t *ext_count) {
+    *std_count = 0;
+    *ext_count = 0;
+
+    for (uint32_t i = 0; i < instance->route_count; i++) {
+        const NightCANRoute *route = &instance->routes[i];
+        if (route_is_exact(route)) continue;
+
+        const uint32_t high = 0x1FFFF800U;  // ID bits only extended IDs have
+        if ((route->id & route->mask & high) == 0) {
+            std_masks[*std_count][0] = route->id & 0x7FFU;
+            std_masks[(*std_count)++][1] = route->mask & 0x7FFU;
+        }
+        if (((~route->mask | route->id) & high) != 0) {
+            ext_masks[*ext_count][0] = route->id & 0x1FFFFFFFU;
+            ext_masks[(*ext_count)++][1] = route->mask & 0x1FFFFFFFU;
+        }
+    }
+}
+#else
+#define CAN_MAX_FILTER_IDS (CAN_RX_BUFFER_SIZE + 4)
+#endif
+
+/**
+ * @brief Gathers every ID this instance needs to hear, split into standard and
+ * extended.
+ */
+static void collect_filter_ids(NightCANInstance *instance, uint32_t *std_ids,
+                               uint32_t *std_count, uint32_t *ext_ids,
+                               uint32_t *ext_count) {
+    *std_count = 0;
+    *ext_count = 0;
+
+    uint32_t extra[4];
+    uint32_t extra_count = 0;
+    extra[extra_count++] = BUS_ENABLE_DISABLE_ID;
+    if (bootload_inited) extra[extra_count++] = BOOTLOAD_PACKET;
+#ifdef NIGHTCAN_FW_UPDATE
+    extra[extra_count++] = META_DATA_FOR_WRITE_MEMORY_FIRMWARE_UPDATE_256B_MAX_ID;
+    extra[extra_count++] = WRITE_MEMORY_DATA_FIRMWARE_UPDATE_ID;
+#endif
+
+    for (uint32_t i = 0; i < instance->rx_buffer_count + extra_count; i++) {
+        uint32_t id = (i < instance->rx_buffer_count)
+                          ? INBOX_ID(instance, i)
+                          : extra[i - instance->rx_buffer_count];
+        if (id > 0x7FF) {
+            ext_ids[(*ext_count)++] = id;
+        } else {
+            std_ids[(*std_count)++] = id;
+        }
+    }
+
+#ifdef NIGHTCAN_GATEWAY
+    // single-ID routes, the list filters may carry an ID twice but that's
+    // only a wasted slot
+    for (uint32_t i = 0; i < instance->route_count; i++) {
+        const NightCANRoute *route = &instance->routes[i];
+        if (!route_is_exact(route)) continue;
+        if (route->id > 0x7FF) {
+            ext_ids[(*ext_count)++] = route->id;
+        } else {
+            std_ids[(*std_count)++] = route->id;
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Programs the hardware acceptance filters from the registered IDs.
+ */
+CANDriverStatus CAN_ApplyReceiveFilters(NightCANInstance *instance) {
+    if (!instance || !instance->initialized || !instance->hcan)
+        return CAN_INSTANCE_NULL;
+
+    uint32_t std_ids[CAN_MAX_FILTER_IDS], ext_ids[CAN_MAX_FILTER_IDS];
+    uint32_t std_count, ext_count;
+    collect_filter_ids(instance, std_ids, &std_count, ext_ids, &ext_count);
+
+    uint32_t std_mask_count = 0, ext_mask_count = 0;
+#ifdef NIGHTCAN_GATEWAY
+    uint32_t std_masks[CAN_MAX_ROUTES][2], ext_masks[CAN_MAX_ROUTES][2];
+    collect_filter_masks(instance, std_masks, &std_mask_count, ext_masks,
+                         &ext_mask_count);
+#endif
+
+    // don't keep retrying every loop if it doesn't fit, the next inbox
+    // registration will mark it dirty again
+    instance->rx_filters_dirty = false;
+
+#if defined(STM32H733xx)
+    // two IDs per dual filter element, then one classic (mask) element per
+    // masked route
+    if ((std_count + 1) / 2 + std_mask_count > instance->hcan->Init.StdFiltersNbr ||
+        (ext_count + 1) / 2 + ext_mask_count > instance->hcan->Init.ExtFiltersNbr) {
+        return CAN_BUFFER_FULL;
+    }
+
+    // the global filter can only change while the controller is stopped
+    if (HAL_FDCAN_Stop(instance->hcan) != HAL_OK) return CAN_ERROR;
+
+    NIGHTCAN_FILTERTYPEDEF sFilterConfig;
+    CANDriverStatus status = CAN_OK;
+    for (uint32_t pass = 0; pass < 2 && status == CAN_OK; pass++) {
+        uint32_t *ids = pass ? ext_ids : std_ids;
+        uint32_t count = pass ? ext_count : std_count;
+        uint32_t slots = pass ? instance->hcan->Init.ExtFiltersNbr
+                              : instance->hcan->Init.StdFiltersNbr;
+#ifdef NIGHTCAN_GATEWAY
+        uint32_t dual_elements = (count + 1) / 2;
+        uint32_t mask_count = pass ? ext_mask_count : std_mask_count;
+#endif
+
+        for (uint32_t element = 0; element < slots; element++) {
+            uint32_t first = element * 2;
+            sFilterConfig.IdType = pass ? FDCAN_EXTENDED_ID : FDCAN_STANDARD_ID;
+            sFilterConfig.FilterIndex = element;
+            sFilterConfig.FilterType = FDCAN_FILTER_DUAL;
+            sFilterConfig.FilterConfig =
+                (first < count) ? FDCAN_FILTER_TO_RXFIFO0 : FDCAN_FILTER_DISABLE;
+            // pad an odd count by matching the same ID twice
+            sFilterConfig.FilterID1 = (first < count) ? ids[first] : 0;
+            sFilterConfig.FilterID2 =
+                (first + 1 < count) ? ids[first + 1] : sFilterConfig.FilterID1;
+#ifdef NIGHTCAN_GATEWAY
+            uint32_t mask_idx = element - dual_elements;
+            if (element >= dual_elements && mask_idx < mask_count) {
+                const uint32_t *pair = pass ? ext_masks[mask_idx]
+                                            : std_masks[mask_idx];
+                sFilterConfig.FilterType = FDCAN_FILTER_MASK;
+                sFilterConfig.FilterConfig = FDCAN_FILTER_TO_RXFIFO0;
+                sFilterConfig.FilterID1 = pair[0];
+                sFilterConfig.FilterID2 = pair[1];
+            }
+#endif
+
+            if (HAL_FDCAN_ConfigFilter(instance->hcan, &sFilterConfig) != HAL_OK) {
+                status = CAN_ERROR;
+                break;
+            }
+        }
+    }
+
+    if (status == CAN_OK &&
+        HAL_FDCAN_ConfigGlobalFilter(instance->hcan, FDCAN_REJECT, FDCAN_REJECT,
+                                     FDCAN_REJECT_REMOTE,
+                                     FDCAN_REJECT_REMOTE) != HAL_OK) {
+        status = CAN_ERROR;
+    }
+
+    if (HAL_FDCAN_Start(instance->hcan) != HAL_OK) return CAN_ERROR;
+    return status;
+#elif defined(STM32L496xx)
+    // 16-bit list mode fits 4 standard IDs per bank, 32-bit list mode fits 2
+    // extended IDs per bank
+    uint32_t std_banks = (std_count + 3) / 4;
+    uint32_t ext_banks = (ext_count + 1) / 2;
+    // masked routes: 16-bit mask mode fits 2 standard (id, mask) pairs per
+    // bank, 32-bit mask mode one extended pair
+    uint32_t std_mask_banks = (std_mask_count + 1) / 2;
+    uint32_t ext_mask_banks = ext_mask_count;
+    uint32_t first_bank = 0;
+#ifdef CAN2
+    // CAN2 owns the banks from SlaveStartFilterBank up
+    if (instance->hcan->Instance == CAN2) first_bank = 14;
+#endif
+    if (std_banks + ext_banks + std_mask_banks + ext_mask_banks > 14) {
+        return CAN_BUFFER_FULL;
+    }
+
+    NIGHTCAN_FILTERTYPEDEF sFilterConfig;
+    sFilterConfig.FilterFIFOAssignment = CAN_RX_FIFO0;
+    sFilterConfig.FilterMode = CAN_FILTERMODE_IDLIST;
+    sFilterConfig.FilterActivation = ENABLE;
+    sFilterConfig.SlaveStartFilterBank = 14;
+
+    uint32_t bank = 0;
+    for (; bank < std_banks; bank++) {
+        uint32_t slot[4];
+        for (uint32_t k = 0; k < 4; k++) {
+            uint32_t i = bank * 4 + k;
+            // pad the last bank by repeating its first ID
+            slot[k] = ((i < std_count) ? std_ids[i] : std_ids[bank * 4]) << 5;
+        }
+        sFilterConfig.FilterBank = first_bank + bank;
+        sFilterConfig.FilterScale = CAN_FILTERSCALE_16BIT;
+        sFilterConfig.FilterIdHigh = slot[0];
+        sFilterConfig.FilterIdLow = slot[1];
+        sFilterConfig.FilterMaskIdHigh = slot[2];
+        sFilterConfig.FilterMaskIdLow = slot[3];
+        if (HAL_CAN_ConfigFilter(instance->hcan, &sFilterConfig) != HAL_OK) {
+            return CAN_ERROR;
+        }
+    }
+
+    for (uint32_t e = 0; e < ext_banks; e++, bank++) {
+        uint32_t reg[2];
+        for (uint32_t k = 0; k < 2; k++) {
+            uint32_t i = e * 2 + k;
+            uint32_t id = (i < ext_count) ? ext_ids[i] : ext_ids[e * 2];
+            reg[k] = (id << 3) | CAN_ID_EXT;  // EXID in [31:3], IDE set
+        }
+        sFilterConfig.FilterBank = first_bank + bank;
+        sFilterConfig.FilterScale = CAN_FILTERSCALE_32BIT;
+        sFilterConfig.FilterIdHigh = reg[0] >> 16;
+        sFilterConfig.FilterIdLow = reg[0] & 0xFFFF;
+        sFilterConfig.FilterMaskIdHigh = reg[1] >> 16;
+        sFilterConfig.FilterMaskIdLow = reg[1] & 0xFFFF;
+        if (HAL_CAN_ConfigFilter(instance->hcan, &sFilterConfig) != HAL_OK) {
+            return CAN_ERROR;
+        }
+    }
+
+#ifdef NIGHTCAN_GATEWAY
+    sFilterConfig.FilterMode = CAN_FILTERMODE_IDMASK;
+    for (uint32_t m = 0; m < std_mask_banks; m++, bank++) {
+        // filter 0 is the high halves, filter 1 the low ones. IDE is part of
+        // the mask so extended frames never match, pad with the first pair.
+        const uint32_t *a = std_masks[m * 2];
+        const uint32_t *b =
+            (m * 2 + 1 < std_mask_count) ? std_masks[m * 2 + 1] : a;
+        sFilterConfig.FilterBank = first_bank + bank;
+        sFilterConfig.FilterScale = CAN_FILTERSCALE_16BIT;
+        sFilterConfig.FilterIdHigh = a[0] << 5;
+        sFilterConfig.FilterMaskIdHigh = (a[1] << 5) | 0x08U;
+        sFilterConfig.FilterIdLow = b[0] << 5;
+        sFilterConfig.FilterMaskIdLow = (b[1] << 5) | 0x08U;
+        if (HAL_CAN_ConfigFilter(instance->hcan, &sFilterConfig) != HAL_OK) {
+            return CAN_ERROR;
+        }
+    }
+
+    for (uint32_t m = 0; m < ext_mask_banks; m++, bank++) {
+        uint32_t id_reg = (ext_masks[m][0] << 3) | CAN_ID_EXT;
+        uint32_t mask_reg = (ext_masks[m][1] << 3) | CAN_ID_EXT;
+        sFilterConfig.FilterBank = first_bank + bank;
+        sFilterConfig.FilterScale = CAN_FILTERSCALE_32BIT;
+        sFilterConfig.FilterIdHigh = id_reg >> 16;
+        sFilterConfig.FilterIdLow = id_reg & 0xFFFF;
+        sFilterConfig.FilterMaskIdHigh = mask_reg >> 16;
+        sFilterConfig.FilterMaskIdLow = mask_reg & 0xFFFF;
+        if (HAL_CAN_ConfigFilter(instance->hcan, &sFilterConfig) != HAL_OK) {
+            return CAN_ERROR;
+        }
+    }
+#endif
+
+    // switch off whatever was left over from a bigger set (or the default
+    // accept-all bank from CAN_Init if we had nothing to program)
+    sFilterConfig.FilterActivation = DISABLE;
+    uint32_t banks_used = bank;
+    for (; bank < instance->rx_filter_banks_used || (bank == 0); bank++) {
+        sFilterConfig.FilterBank = first_bank + bank;
+        if (HAL_CAN_ConfigFilter(instance->hcan, &sFilterConfig) != HAL_OK) {
+            return CAN_ERROR;
+        }
+    }
+    instance->rx_filter_banks_used = (uint8_t)banks_used;
+    return CAN_OK;
+#else
+#error "Ay follow the notion!"
+    return CAN_ERROR;
+#endif
+}
+
+#ifdef NIGHTCAN_STATS
+CANDriverStatus CAN_GetStats(NightCANInstance *instance,
+                             NightCANStatsSnapshot *out) {
+    if (!instance || !out) return CAN_INSTANCE_NULL;
+
+    // the RX/TX ISRs bump these too, keep them out while we copy
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    out->totals = instance->stats;
+
+    out->rx_count = instance->rx_buffer_count;
+    for (uint32_t i = 0; i < instance->rx_buffer_count; i++) {
+        out->rx[i] = instance->rx_stats[i];
+        out->rx[i].id = INBOX_ID(instance, i);
+    }
+
+    out->tx_count = instance->tx_schedule_count;
+    for (uint32_t i = 0; i < instance->tx_schedule_count; i++) {
+        NightCANPacket *packet = instance->tx_schedule[i];
+        out->tx[i].id = packet->id;
+        out->tx[i].tx_count = packet->_tx_count;
+        out->tx[i].late_max_ms = packet->_tx_late_max_ms;
+        out->tx[i].late_total_ms = packet->_tx_late_total_ms;
+    }
+
+    __set_PRIMASK(primask);
+    return CAN_OK;
+}
+
+void CAN_ResetStats(NightCANInstance *instance) {
+    if (!instance) return;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    memset(&instance->stats, 0, sizeof(instance->stats));
+    memset(instance->rx_stats, 0, sizeof(instance->rx_stats));
+    for (uint32_t i = 0; i < instance->tx_schedule_count; i++) {
+        NightCANPacket *packet = instance->tx_schedule[i];
+        packet->_tx_count = 0;
+        packet->_tx_late_max_ms = 0;
+        packet->_tx_late_total_ms = 0;
+    }
+
+    __set_PRIMASK(primask);
+}
+#endif
+
 void CAN_bootload_init(uint8_t BOOTLOAD_PACKET_ID) {
     if (bootload_inited) return;
 
@@ -642,3 +2846,88 @@ void CAN_bootload_init(uint8_t BOOTLOAD_PACKET_ID) {
     bootload_inited = true;
 }
 
+#ifdef NIGHTCAN_RX_INTERRUPT
+// --- HAL Receive Callbacks ---
+// These override the HAL's weak definitions, so don't define them again in the
+// application when NIGHTCAN_RX_INTERRUPT is on.
+
+#if defined(STM32H733xx)
+void HAL_FDCAN_RxFifo0Callback(FDCAN_HandleTypeDef *hfdcan,
+                               uint32_t RxFifo0ITs) {
+    NightCANInstance *instance = find_instance(hfdcan);
+    if (!instance) return;
+
+    if (RxFifo0ITs & FDCAN_IT_RX_FIFO0_MESSAGE_LOST) {
+        instance->rx_fifo_overruns++;
+    }
+    rx_ring_fill_from_fifo(instance, FDCAN_RX_FIFO0);
+}
+
+void HAL_FDCAN_RxFifo1Callback(FDCAN_HandleTypeDef *hfdcan,
+                               uint32_t RxFifo1ITs) {
+    NightCANInstance *instance = find_instance(hfdcan);
+    if (!instance) return;
+
+    if (RxFifo1ITs & FDCAN_IT_RX_FIFO1_MESSAGE_LOST) {
+        instance->rx_fifo_overruns++;
+    }
+    rx_ring_fill_from_fifo(instance, FDCAN_RX_FIFO1);
+}
+#elif defined(STM32L496xx)
+void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan) {
+    NightCANInstance *instance = find_instance(hcan);
+    if (!instance) return;
+
+    // overrun flag is rc_w1, clear it once we've counted it
+    if (hcan->Instance->RF0R & CAN_RF0R_FOVR0) {
+        instance->rx_fifo_overruns++;
+        hcan->Instance->RF0R = CAN_RF0R_FOVR0;
+    }
+    rx_ring_fill_from_fifo(instance, CAN_RX_FIFO0);
+}
+
+void HAL_CAN_RxFifo1MsgPendingCallback(CAN_HandleTypeDef *hcan) {
+    NightCANInstance *instance = find_instance(hcan);
+    if (!instance) return;
+
+    if (hcan->Instance->RF1R & CAN_RF1R_FOVR1) {
+        instance->rx_fifo_overruns++;
+        hcan->Instance->RF1R = CAN_RF1R_FOVR1;
+    }
+    rx_ring_fill_from_fifo(instance, CAN_RX_FIFO1);
+}
+#endif
+#endif  // NIGHTCAN_RX_INTERRUPT
+
+#ifdef NIGHTCAN_TX_INTERRUPT
+// --- HAL Transmit Callbacks ---
+// Same deal as the RX ones: these replace the HAL weak definitions.
+
+#if defined(STM32H733xx)
+void HAL_FDCAN_TxBufferCompleteCallback(FDCAN_HandleTypeDef *hfdcan,
+                                        uint32_t BufferIndexes) {
+    NightCANInstance *instance = find_instance(hfdcan);
+    if (instance) tx_queue_drain(instance);
+}
+
+void HAL_FDCAN_TxFifoEmptyCallback(FDCAN_HandleTypeDef *hfdcan) {
+    NightCANInstance *instance = find_instance(hfdcan);
+    if (instance) tx_queue_drain(instance);
+}
+#elif defined(STM32L496xx)
+void HAL_CAN_TxMailbox0CompleteCallback(CAN_HandleTypeDef *hcan) {
+    NightCANInstance *instance = find_instance(hcan);
+    if (instance) tx_queue_drain(instance);
+}
+
+void HAL_CAN_TxMailbox1CompleteCallback(CAN_HandleTypeDef *hcan) {
+    NightCANInstance *instance = find_instance(hcan);
+    if (instance) tx_queue_drain(instance);
+}
+
+void HAL_CAN_TxMailbox2CompleteCallback(CAN_HandleTypeDef *hcan) {
+    NightCANInstance *instance = find_instance(hcan);
+    if (instance) tx_queue_drain(instance);
+}
+#endif
+#endif  // NIGHTCAN_TX_INTERRUPT
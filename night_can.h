@@ -27,9 +27,13 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>  // memcpy for the payload accessors
 
 #include "main.h"  // Include if NIGHTCAN_HANDLE_TYPEDEF needs it
 #include "night_can_ids.h"
+#ifdef NIGHTCAN_LOG
+#include "can_log.h"
+#endif
 
 // --- Select the target STM32 series ---
 // Define ONE of these (or similar) in your project's preprocessor settings:
@@ -57,9 +61,113 @@
 #endif
 
 // --- Configuration ---
+// Define NIGHTCAN_RX_INTERRUPT (e.g. in main.h) to receive from the FIFO
+// interrupts instead of polling. The driver then owns the HAL RX FIFO
+// callbacks, and CAN_PollReceive only drains the ring the ISR fills.
+// Define NIGHTCAN_RX_MSGRAM (H7 only) to decode received frames straight out
+// of FDCAN message RAM in one batch per FIFO instead of one
+// HAL_FDCAN_GetRxMessage call per frame. Works with or without
+// NIGHTCAN_RX_INTERRUPT.
+// Define NIGHTCAN_AUTO_FILTER to have CAN_periodic reprogram the hardware
+// acceptance filters from the registered inboxes whenever that set changes
+// (see CAN_ApplyReceiveFilters).
+// Define NIGHTCAN_STATS to keep per-ID receive, TX lateness and loop time
+// statistics, read out with CAN_GetStats (needs lib_timer_init for the cycle
+// counter).
+// Define NIGHTCAN_DWT_TIMEBASE to run the driver's millisecond clock
+// (timestamps, timeouts, the TX schedule) off the timer.c DWT timebase instead
+// of HAL_GetTick(). It starts at lib_timer_init rather than at boot.
+// Define NIGHTCAN_FD (H7 only) for CAN FD: payloads grow to 64 bytes and
+// packets can be sent as FD frames with bit rate switching. The FDCAN has to
+// be set up for FD with BRS (FrameFormat = FDCAN_FRAME_FD_BRS) and 64 byte
+// RX/TX elements in CubeMX.
+// Define NIGHTCAN_TELEMETRY (with USB_VCP) to copy every received and sent
+// frame to the USB binary telemetry stream (usb_telemetry_enable turns it on,
+// scripts/can_telemetry.py reads it). Timestamps come from lib_timer_now_us.
+// Define NIGHTCAN_TX_INTERRUPT to refill the hardware from the software TX
+// queue in the HAL TX complete callbacks (which the driver then owns) instead
+// of only from CAN_Service.
+// Define NIGHTCAN_STATIC_CONFIG and NIGHTCAN_BOARD_<NODE> (e.g.
+// NIGHTCAN_BOARD_VCU) to take the board's inboxes and TX packets from the
+// tables scripts/CAN_header_gen.py generates into night_can_boards.c instead
+// of registering them at startup. CAN_Init sets them all up, the driver owns
+// their storage (get at it with CAN_GetReceivedPacket / CAN_GetTxPacket), and
+// the RX lookup is a binary search of the sorted table in flash. The buffer
+// and schedule sizes below become exactly what the board needs, and
+// CAN_create_receive_packet / CAN_addReceivePacket go away.
+// Define NIGHTCAN_SOA_INBOXES to have the driver own the inboxes itself, one
+// array per field (IDs, payloads, timestamps, flags) inside the instance, so
+// matching an ID and the timeout scan walk contiguous memory instead of
+// chasing pointers into user globals. Inboxes are then NightCANInbox handles
+// (CAN_AddInbox / CAN_FindInbox and the CAN_inbox_* accessors) instead of
+// NightCANReceivePacket pointers, and the timeout callback gets the handle.
+// Nothing else is touched through a pointer, so the whole instance can go in
+// the H7 DTCM by giving its definition a section the linker script puts
+// there (e.g. __attribute__((section(".dtcm_data")))). Combines with
+// NIGHTCAN_STATIC_CONFIG.
+// Define NIGHTCAN_SEQLOCK to give every inbox a frame counter and two
+// payload slots the receive path alternates between, so CAN_snapshot (and
+// CAN_inbox_snapshot) can get a consistent copy from any context (another
+// task, an ISR) without locking, plus how many frames it missed. Reading
+// data directly stays fine from the context that runs CAN_PollReceive.
+// Define NIGHTCAN_HISTORY to keep the last N samples of chosen signals in
+// rings filled by the receive path (see CAN_AttachHistory), for filters and
+// derivative estimates that need more than the latest frame.
+// Define NIGHTCAN_LOG to record every received and sent frame into a
+// can_log.h binary log (see CAN_SetLog), e.g. on an SD card.
+// Define NIGHTCAN_GATEWAY to forward frames between instances from a routing
+// table (see CAN_SetRoutes). Forwarding happens where the frame is read out
+// of the hardware, so with NIGHTCAN_RX_INTERRUPT it runs in the RX ISR and
+// the TX queue is then always guarded by disabling interrupts.
+#ifdef NIGHTCAN_STATIC_CONFIG
+#include "night_can_boards.h"
+#define CAN_RX_BUFFER_SIZE \
+    (NIGHTCAN_BOARD_RX_COUNT > 0 ? NIGHTCAN_BOARD_RX_COUNT : 1)
+#define CAN_TX_SCHEDULE_SIZE \
+    (NIGHTCAN_BOARD_TX_PERIODIC_COUNT > 0 ? NIGHTCAN_BOARD_TX_PERIODIC_COUNT : 1)
+#define CAN_BOARD_TX_SIZE \
+    (NIGHTCAN_BOARD_TX_COUNT > 0 ? NIGHTCAN_BOARD_TX_COUNT : 1)
+#define CAN_TX_WATCH_SIZE CAN_BOARD_TX_SIZE
+#else
 #define CAN_RX_BUFFER_SIZE 32    // Size of the receiving buffer per instance
 #define CAN_TX_SCHEDULE_SIZE 16  // Max number of scheduled packets per instance
+#define CAN_TX_WATCH_SIZE 16     // Max number of on-change packets per instance
+#endif
 #define MAX_CAN_INSTANCES 2      // Maximum number of CAN instances supported
+#define CAN_RX_RING_SIZE 64       // Frames the RX ISR can queue, power of two
+#define CAN_TX_PHASE_AUTO 0xFFFFFFFFU  // tx_phase_ms: let the driver stagger it
+#define CAN_TX_STAGGER_MAX_SLOTS 32    // Offsets tried when auto-staggering
+#define CAN_TX_QUEUE_SIZE 16  // Frames held in software while the HW is full
+#define CAN_STATS_LOOP_BUCKETS 16  // log2(us) buckets of the loop histogram
+#define CAN_MAX_ROUTES 16  // Gateway routes per source instance
+
+#if defined(NIGHTCAN_TELEMETRY) && !defined(USB_VCP)
+#error "NIGHTCAN_TELEMETRY needs USB_VCP"
+#endif
+
+#ifdef NIGHTCAN_FD
+#if !defined(STM32H733xx)
+#error "NIGHTCAN_FD needs the H7 FDCAN"
+#endif
+#define CAN_MAX_DATA_LEN 64  // Largest payload, bytes
+#else
+#define CAN_MAX_DATA_LEN 8
+#endif
+
+// the lookup table stores (rx_buffer index + 1) in a byte and relies on
+// staying at most half full so probe chains stay short
+#define CAN_RX_INDEX_BITS 6      // log2 of the ID lookup table size per instance
+#define CAN_RX_INDEX_SIZE (1U << CAN_RX_INDEX_BITS)
+#if CAN_RX_BUFFER_SIZE > 254
+#error "CAN_RX_BUFFER_SIZE must fit in the uint8_t ID lookup table"
+#endif
+#if !defined(NIGHTCAN_STATIC_CONFIG) && \
+    CAN_RX_INDEX_SIZE < (2 * CAN_RX_BUFFER_SIZE)
+#error "CAN_RX_INDEX_SIZE must be at least twice CAN_RX_BUFFER_SIZE"
+#endif
+#if (CAN_RX_RING_SIZE & (CAN_RX_RING_SIZE - 1)) != 0
+#error "CAN_RX_RING_SIZE must be a power of two"
+#endif
 
 // --- Type Definitions ---
 
@@ -70,15 +178,58 @@ typedef struct NightCANPacket {
     uint32_t id;  // CAN Identifier (Standard or Extended)
     uint8_t ide;  // Identifier Type: CAN_ID_STD or CAN_ID_EXT
     uint8_t rtr;  // Remote Transmission Request: CAN_RTR_DATA or CAN_RTR_REMOTE
-    uint8_t dlc;  // Data Length Code (0-8 bytes)
-    uint8_t data[8];          // Payload data
+    uint8_t dlc;  // Payload length in bytes (0-8, or 0-64 for FD frames)
+    uint8_t data[CAN_MAX_DATA_LEN];  // Payload data
+#ifdef NIGHTCAN_FD
+    bool fd;   // send as an FD frame (needed for dlc > 8)
+    bool brs;  // switch to the data bit rate for the payload (FD only)
+#endif
     uint32_t tx_interval_ms;  // Transmission interval in milliseconds (0 for
                               // one-shot)
+    uint32_t tx_phase_ms;  // Offset within the interval this packet goes out
+                           // at (mod tx_interval_ms, 0 by default), or
+                           // CAN_TX_PHASE_AUTO to spread it away from the
+                           // rest of the schedule
+    bool tx_on_change;  // send whenever data differs from what went out last,
+                        // tx_interval_ms is then the longest it stays quiet
+                        // (0 to only send on change)
+    uint32_t tx_min_interval_ms;  // on change: shortest gap between sends, a
+                                  // change inside it goes out when it's over
     // --- Internal driver state (do not modify directly) ---
     uint32_t _last_tx_time_ms;  // Timestamp of the last transmission
+    uint32_t _next_tx_time_ms;  // Deadline of the next transmission
     bool _is_scheduled;  // Flag indicating if the packet is in the schedule
+    bool _is_watched;    // on the instance's on-change list
+    uint8_t _last_tx_data[CAN_MAX_DATA_LEN];  // data as of the last send
+#ifdef NIGHTCAN_STATS
+    uint32_t _tx_count;          // scheduled transmissions handed to the driver
+    uint32_t _tx_late_max_ms;    // worst distance past _next_tx_time_ms
+    uint32_t _tx_late_total_ms;  // summed lateness, divide by _tx_count
+#endif
 } NightCANPacket;
 
+#ifdef NIGHTCAN_SEQLOCK
+/**
+ * @brief One of the two copies of an inbox's latest frame.
+ */
+typedef struct {
+    uint8_t data[CAN_MAX_DATA_LEN];
+    uint32_t timestamp_ms;
+    uint64_t timestamp_us;
+} NightCANRxSlot;
+
+/**
+ * @brief A consistent copy of an inbox, from CAN_snapshot.
+ */
+typedef struct {
+    uint8_t data[CAN_MAX_DATA_LEN];
+    uint32_t timestamp_ms;  // can_now_ms() clock, like timestamp_ms
+    uint64_t timestamp_us;  // lib_timer_now_us() clock
+    uint32_t frames;  // frames that arrived since the last snapshot/consume
+    uint32_t missed;  // of those, the ones overwritten unseen (frames - 1)
+} NightCANSnapshot;
+#endif
+
 /**
  * @brief Structure for storing a received CAN packet.
  */
@@ -86,16 +237,249 @@ typedef struct {
     uint32_t id;  // CAN Identifier (Standard or Extended)
     uint8_t ide;  // Identifier Type: CAN_ID_STD or CAN_ID_EXT
     uint8_t rtr;  // Remote Transmission Request: CAN_RTR_DATA or CAN_RTR_REMOTE
-    uint8_t dlc;  // Data Length Code (0-8 bytes)
-    uint8_t data[8];        // Payload data
+    uint8_t dlc;  // Payload length in bytes (0-8, or 0-64 for FD frames)
+    uint8_t data[CAN_MAX_DATA_LEN];  // Payload data
     uint32_t timestamp_ms;  // Timestamp when the packet was received (based on
                             // HAL_GetTick())
+    uint64_t timestamp_us;  // When the frame actually arrived, on the
+                            // lib_timer_now_us() clock (H7: from the FDCAN
+                            // RX timestamp, L4: when its FIFO was read)
     uint32_t timeout_ms;    // after how long to register timeout
     bool is_recent;         // if this packet was received after being consumed
     bool is_timed_out;  // if this packet hasnt been recieved in timeout_ms --
                         // raise fault
+#ifdef NIGHTCAN_SEQLOCK
+    // --- Internal driver state (do not modify directly) ---
+    NightCANRxSlot _slots[2];  // the latest frame is in _slots[_seq & 1]
+    volatile uint32_t _seq;    // frames received, only the driver writes it
+    uint32_t _consumed_seq;    // _seq as of the last snapshot/consume
+#endif
 } NightCANReceivePacket;
 
+struct NightCANInstance;
+
+#ifdef NIGHTCAN_SOA_INBOXES
+/**
+ * @brief Handle to a driver-owned inbox, its index in the instance's inbox
+ * arrays.
+ */
+typedef uint8_t NightCANInbox;
+#define CAN_INBOX_NONE 0xFF  // no such inbox
+
+// rx_flags bits
+#define CAN_INBOX_RECENT 0x01     // received after being consumed
+#define CAN_INBOX_TIMED_OUT 0x02  // not received in timeout_ms
+
+/**
+ * @brief Called when an inbox times out (timed_out = true) and again when
+ * frames for it start arriving after that (timed_out = false).
+ */
+typedef void (*NightCANTimeoutCallback)(struct NightCANInstance *instance,
+                                        NightCANInbox inbox, bool timed_out);
+#else
+/**
+ * @brief Called when an inbox times out (timed_out = true) and again when
+ * frames for it start arriving after that (timed_out = false).
+ */
+typedef void (*NightCANTimeoutCallback)(NightCANReceivePacket *packet,
+                                        bool timed_out);
+#endif
+
+#ifdef NIGHTCAN_GATEWAY
+#define CAN_ROUTE_EXACT 0x1FFFFFFFU  // route mask for a single ID
+
+/**
+ * @brief One gateway rule: frames arriving on the source instance whose ID
+ * matches id under mask are sent out on dest unchanged. Several routes can
+ * match the same frame (fan-out), and the frame still reaches its inbox on
+ * the source if it has one.
+ */
+typedef struct {
+    uint32_t id;    // ID to forward
+    uint32_t mask;  // ID bits that have to match (of all 29, standard and
+                    // extended IDs are one range), CAN_ROUTE_EXACT for one ID
+    struct NightCANInstance *dest;  // instance to send it out on
+    uint32_t min_interval_ms;  // forward at most one frame per interval (0 for
+                               // every frame), the ones in between are skipped
+    // --- Internal driver state (do not modify directly) ---
+    uint32_t _last_forward_ms;
+    bool _has_forwarded;
+    uint32_t _forwarded;  // frames handed to dest
+    uint32_t _skipped;    // frames held back by min_interval_ms
+    uint32_t _dropped;    // frames dest had no room for
+} NightCANRoute;
+#endif
+
+#ifdef NIGHTCAN_HISTORY
+/**
+ * @brief How a signal's raw value is stored in the payload.
+ */
+typedef enum {
+    CAN_SIGNAL_U8,
+    CAN_SIGNAL_I8,
+    CAN_SIGNAL_U16,
+    CAN_SIGNAL_I16,
+    CAN_SIGNAL_U32,
+    CAN_SIGNAL_I32,
+    CAN_SIGNAL_F32,
+} NightCANSignalType;
+
+/**
+ * @brief What a history does with the frames between two samples.
+ */
+typedef enum {
+    CAN_HISTORY_DECIMATE,  // keep every factor-th frame's value
+    CAN_HISTORY_AVERAGE,   // keep the mean of each factor frames
+} NightCANHistoryMode;
+
+/**
+ * @brief A ring of the last capacity samples of one signal of an inbox, in
+ * caller-owned arrays (values and their arrival times, oldest to newest as
+ * the ring goes round). Make one with CAN_create_history and hook it to its
+ * inbox with CAN_AttachHistory. Several histories can hang off one inbox.
+ */
+typedef struct NightCANHistory {
+    // signal, decoded like CAN_readFloatOrdered
+    uint8_t start_byte;
+    NightCANSignalType type;
+    uint8_t order;    // CAN_LITTLE_ENDIAN or CAN_BIG_ENDIAN
+    float precision;  // value = raw * precision
+
+    NightCANHistoryMode mode;
+    uint16_t factor;  // frames per sample, 1 keeps them all
+
+    float *values;            // capacity entries
+    uint64_t *timestamps_us;  // capacity entries, lib_timer_now_us() of the
+                              // (last) frame behind each sample
+    uint32_t capacity;
+
+    // --- Internal driver state (do not modify directly) ---
+    uint32_t _head;     // where the next sample goes
+    uint32_t _count;    // samples held, up to capacity
+    uint16_t _pending;  // frames seen towards the next sample
+    float _sum;         // of the pending frames, CAN_HISTORY_AVERAGE
+    struct NightCANHistory *_next;  // next history on the same inbox
+} NightCANHistory;
+
+/**
+ * @brief A run of consecutive samples, straight out of a history's arrays.
+ */
+typedef struct {
+    const float *values;
+    const uint64_t *timestamps_us;
+    uint32_t count;
+} NightCANSpan;
+#endif
+
+/**
+ * @brief When an inbox's timeout was last armed to expire.
+ */
+typedef struct {
+    uint32_t deadline_ms;  // timestamp_ms + timeout_ms as of arming
+    uint8_t rx_idx;        // which rx_buffer entry
+} NightCANTimeoutEntry;
+
+/**
+ * @brief A raw frame as it came off the hardware, before it is sorted into an
+ * inbox.
+ */
+typedef struct {
+    uint32_t id;      // CAN Identifier (Standard or Extended)
+    uint8_t flags;    // EXT / FD / BRS, as the driver's TX_FRAME_* bits
+    uint8_t len;      // Number of payload bytes received
+    uint8_t data[CAN_MAX_DATA_LEN];  // Payload data
+    uint64_t timestamp_us;  // arrival time on the lib_timer_now_us() clock
+} NightCANFrame;
+
+/**
+ * @brief A frame waiting in the software TX queue for the hardware to free up.
+ */
+typedef struct {
+    NightCANPacket frame;       // copy of the packet as it was when queued
+    NightCANPacket *source;     // packet it was copied from (for coalescing)
+    uint32_t enqueue_time_ms;   // when it was queued
+    uint32_t seq;               // keeps equal IDs in FIFO order
+} NightCANTxEntry;
+
+/**
+ * @brief Receive statistics for one registered inbox. Gaps are the time
+ * between consecutive frames of that ID.
+ */
+typedef struct {
+    uint32_t id;
+    uint32_t rx_count;     // frames received
+    uint32_t gap_min_us;   // shortest gap seen
+    uint32_t gap_max_us;   // longest gap seen
+    uint32_t jitter_us;    // smoothed |gap - previous gap| (RFC 3550 style)
+    uint32_t _last_gap_us;
+    uint32_t _last_rx_us;
+} NightCANRxStats;
+
+/**
+ * @brief Transmit statistics for one scheduled packet.
+ */
+typedef struct {
+    uint32_t id;
+    uint32_t tx_count;       // times it was sent (or queued) off the schedule
+    uint32_t late_max_ms;    // worst lateness against its deadline
+    uint32_t late_total_ms;  // summed lateness, divide by tx_count
+} NightCANTxStats;
+
+/**
+ * @brief Instance-wide counters.
+ */
+typedef struct {
+    uint32_t rx_frames;        // frames pulled off the hardware
+    uint32_t rx_unknown_id;    // frames with no registered inbox
+    uint32_t tx_frames;        // frames accepted by the hardware
+    uint32_t tx_busy;          // hardware full, frame had to wait or drop
+    uint32_t tx_errors;        // other HAL transmit failures
+    uint32_t timeouts_raised;  // inboxes that went into timeout
+    uint32_t loop_count;       // CAN_periodic calls measured
+    uint32_t loop_min_us;
+    uint32_t loop_max_us;
+    // loop_hist[0] counts calls under 1us, loop_hist[b] calls in
+    // [2^(b-1), 2^b) us, the last bucket takes everything longer
+    uint32_t loop_hist[CAN_STATS_LOOP_BUCKETS];
+} NightCANStats;
+
+/**
+ * @brief Everything CAN_GetStats copies out, ready to be packed up and sent
+ * over CAN or USB.
+ */
+typedef struct {
+    NightCANStats totals;
+    uint32_t rx_count;  // valid entries in rx
+    NightCANRxStats rx[CAN_RX_BUFFER_SIZE];
+    uint32_t tx_count;  // valid entries in tx
+    NightCANTxStats tx[CAN_TX_SCHEDULE_SIZE];
+} NightCANStatsSnapshot;
+
+#ifdef NIGHTCAN_STATIC_CONFIG
+/**
+ * @brief One inbox of the generated board configuration.
+ */
+typedef struct {
+    uint32_t id;
+    uint32_t timeout_ms;  // 0 to never time out
+    uint8_t dlc;
+} NightCANRxConfig;
+
+/**
+ * @brief One TX packet of the generated board configuration.
+ */
+typedef struct {
+    uint32_t id;
+    uint32_t interval_ms;  // 0 for packets the application sends itself
+    uint32_t phase_ms;     // already staggered by the generator
+    uint8_t dlc;
+} NightCANTxConfig;
+
+// night_can_boards.c, both sorted by ID (so standard IDs come first)
+extern const NightCANRxConfig night_can_board_rx[];
+extern const NightCANTxConfig night_can_board_tx[];
+#endif
+
 /**
  * @brief CAN Driver Status Codes
  */
@@ -116,24 +500,114 @@ typedef enum {
  * @brief Structure to hold all state information for a single CAN driver
  * instance.
  */
-typedef struct {
+typedef struct NightCANInstance {
     NIGHTCAN_HANDLE_TYPEDEF
     *hcan;  // Pointer to the HAL CAN handle for this instance
 
+#if defined(NIGHTCAN_SOA_INBOXES)
+    // driver-owned inboxes, one array per field and indexed by NightCANInbox.
+    // The ones every frame or timeout check touches come first.
+    uint32_t rx_ids[CAN_RX_BUFFER_SIZE];
+    uint32_t rx_timestamp_ms[CAN_RX_BUFFER_SIZE];  // can_now_ms() at arrival
+    uint32_t rx_timeout_ms[CAN_RX_BUFFER_SIZE];    // 0 to never time out
+    uint8_t rx_flags[CAN_RX_BUFFER_SIZE];  // CAN_INBOX_RECENT / _TIMED_OUT
+    uint8_t rx_dlc[CAN_RX_BUFFER_SIZE];
+    uint64_t rx_timestamp_us[CAN_RX_BUFFER_SIZE];  // lib_timer_now_us() clock
+    uint8_t rx_data[CAN_RX_BUFFER_SIZE][CAN_MAX_DATA_LEN];
+#ifdef NIGHTCAN_SEQLOCK
+    NightCANRxSlot rx_slots[CAN_RX_BUFFER_SIZE][2];  // see NightCANReceivePacket
+    volatile uint32_t rx_seq[CAN_RX_BUFFER_SIZE];
+    uint32_t rx_consumed_seq[CAN_RX_BUFFER_SIZE];
+#endif
+#elif defined(NIGHTCAN_STATIC_CONFIG)
+    // the board's inboxes, parallel to night_can_board_rx. The lookup is a
+    // search of that table.
+    NightCANReceivePacket rx_inboxes[CAN_RX_BUFFER_SIZE];
+#else
     NightCANReceivePacket
         *rx_buffer[CAN_RX_BUFFER_SIZE];  // buffer of pointers to user-defined
                                          // packet "inboxes"
+#endif
+#ifdef NIGHTCAN_STATIC_CONFIG
+    NightCANPacket tx_packets[CAN_BOARD_TX_SIZE];  // parallel to
+                                                   // night_can_board_tx
+#else
+    // open-addressed hash of ID -> (inbox index + 1), 0 marks an empty
+    // slot. Filled as inboxes are added so RX dispatch doesn't scan.
+    uint8_t rx_index[CAN_RX_INDEX_SIZE];
+#endif
     uint32_t rx_buffer_count;
 
-    // Transmit schedule buffer
+    // min-heap of inbox timeout deadlines. Entries are only refreshed when
+    // they reach the top, so a frame arriving costs nothing here.
+    NightCANTimeoutEntry timeout_heap[CAN_RX_BUFFER_SIZE];
+    uint32_t timeout_heap_count;
+    bool timeout_armed[CAN_RX_BUFFER_SIZE];  // rx_buffer entry is in the heap
+    NightCANTimeoutCallback timeout_callback;
+
+    // Transmit schedule, kept as a binary min-heap on _next_tx_time_ms so
+    // tx_schedule[0] is always the next packet due
     NightCANPacket *
         tx_schedule[CAN_TX_SCHEDULE_SIZE];  // Array of pointers to user packets
     uint32_t tx_schedule_count;
 
+    // tx_on_change packets, their payload is compared every CAN_Service
+    NightCANPacket *tx_watch[CAN_TX_WATCH_SIZE];
+    uint32_t tx_watch_count;
+
+    // software TX queue in front of the HAL, a min-heap on (id, seq) so the
+    // lowest ID goes out first just like arbitration would pick it
+    NightCANTxEntry tx_queue[CAN_TX_QUEUE_SIZE];
+    volatile uint32_t tx_queue_count;
+    uint32_t tx_queue_seq;
+    uint32_t tx_queue_enqueued;      // frames that had to wait in the queue
+    uint32_t tx_queue_dropped;       // frames lost because the queue was full
+    uint32_t tx_queue_high_water;    // most frames ever waiting at once
+    uint32_t tx_queue_time_total_ms; // summed time dequeued frames waited
+    uint32_t tx_queue_time_max_ms;   // longest any frame waited
+
+#ifdef NIGHTCAN_RX_INTERRUPT
+    // single-producer (RX ISR) / single-consumer (CAN_PollReceive) ring.
+    // head and tail are free-running, masked on access.
+    NightCANFrame rx_ring[CAN_RX_RING_SIZE];
+    volatile uint32_t rx_ring_head;  // only written by the ISR
+    volatile uint32_t rx_ring_tail;  // only written by the main loop
+    uint32_t rx_ring_high_water;     // most frames ever waiting in the ring
+    uint32_t rx_ring_drops;          // frames dropped because the ring was full
+    uint32_t rx_fifo_overruns;       // hardware FIFO "message lost" events
+#endif
+
     // Add any other instance-specific state if needed (e.g., error flags)
     bool initialized;
 
+#if defined(STM32H733xx)
+    uint32_t tsc_hz;  // timestamp counter ticks per second, set by CAN_Init
+#endif
+
     bool bus_silence; // for flashing over CAN, we set the whole bus to SILENCE.
+
+    bool rx_filters_dirty;  // inbox set changed since filters were programmed
+    uint8_t rx_filter_banks_used;  // bxCAN banks CAN_ApplyReceiveFilters took
+
+#ifdef NIGHTCAN_GATEWAY
+    NightCANRoute *routes;  // frames received here to forward elsewhere
+    uint32_t route_count;
+#endif
+
+#ifdef NIGHTCAN_STATS
+    NightCANStats stats;
+    NightCANRxStats rx_stats[CAN_RX_BUFFER_SIZE];  // parallel to rx_buffer
+#endif
+
+#ifdef NIGHTCAN_HISTORY
+    // parallel to rx_buffer, first of each inbox's histories or NULL
+    NightCANHistory *rx_history[CAN_RX_BUFFER_SIZE];
+#endif
+
+#ifdef NIGHTCAN_LOG
+    CanLogWriter *log;  // where frames are recorded, NULL for nowhere
+    uint8_t log_bus;    // the bus number they're recorded with
+#endif
 } NightCANInstance;
 
 // --- Function Prototypes ---
@@ -144,7 +618,9 @@ typedef struct {
  * peripheral.
  * @param hcan Pointer to the HAL CAN handle (e.g., &hfdcan1 for H7, &hcan1 for
  * L4). This handle must be initialized by the STM32CubeMX generated code or
- * manually before calling this function.
+ * manually before calling this function. On H7 receive times are worked out
+ * from its nominal bit timing and the FDCAN kernel clock, so CAN_ERROR if
+ * those aren't set.
  * @param default_filter_id Optional default filter ID (set to 0 if not needed).
  * @param default_filter_mask Optional default filter mask (set to 0 if not
  * needed).
@@ -159,7 +635,10 @@ CANDriverStatus CAN_Init(NightCANInstance *instance,
 
 /**
  * @brief Adds a CAN packet to the transmission schedule or sends it immediately
- * for a specific instance.
+ * for a specific instance. A tx_on_change packet goes out right away, then
+ * again every time CAN_Service sees its data change (no sooner than
+ * tx_min_interval_ms apart) and at least every tx_interval_ms if that isn't
+ * 0.
  * @param instance Pointer to the driver instance.
  * @param packet Pointer to the NightCANPacket structure containing the message
  * details.
@@ -179,6 +658,7 @@ CANDriverStatus CAN_AddTxPacket(NightCANInstance *instance,
 CANDriverStatus CAN_RemoveScheduledTxPacket(NightCANInstance *instance,
                                             NightCANPacket *packet);
 
+#ifndef NIGHTCAN_SOA_INBOXES
 /**
  * @brief Retrieves the oldest received CAN packet from the buffer for a
  * specific instance.
@@ -189,10 +669,20 @@ CANDriverStatus CAN_RemoveScheduledTxPacket(NightCANInstance *instance,
  */
 NightCANReceivePacket *CAN_GetReceivedPacket(NightCANInstance *instance,
                                              uint32_t id);
+#endif
 
+#ifdef NIGHTCAN_STATIC_CONFIG
+/**
+ * @brief Finds the board config TX packet with a specific ID, to fill in its
+ * payload (and, for packets without an interval, hand to CAN_AddTxPacket).
+ * @retval The packet, or NULL if the board doesn't send that ID.
+ */
+NightCANPacket *CAN_GetTxPacket(NightCANInstance *instance, uint32_t id);
+#elif !defined(NIGHTCAN_SOA_INBOXES)
 NightCANReceivePacket CAN_create_receive_packet(uint32_t id,
                                                 uint32_t timeout_ms,
                                                 uint8_t dlc);
+#endif
 
 CANDriverStatus CAN_PollReceive(NightCANInstance *instance);
 
@@ -206,9 +696,34 @@ NightCANInstance CAN_new_instance();
  */
 void CAN_Service(NightCANInstance *instance);
 
+/**
+ * @brief DLC code (0-15) to payload length. Codes past 8 only mean more than
+ * 8 bytes on FD frames, a classic frame tops out at 8.
+ */
+static inline uint8_t CAN_dlc_to_len(uint8_t dlc, bool fd) {
+    static const uint8_t fd_lengths[16] = {0,  1,  2,  3,  4,  5,  6,  7,
+                                           8,  12, 16, 20, 24, 32, 48, 64};
+    dlc &= 0xF;
+    if (!fd) return (dlc > 8) ? 8 : dlc;
+    return fd_lengths[dlc];
+}
+
+/**
+ * @brief Payload length to the smallest DLC code that holds it. FD frames can
+ * only carry 12/16/20/24/32/48/64 bytes past 8, so the frame gets padded up.
+ */
+static inline uint8_t CAN_len_to_dlc(uint8_t len) {
+    if (len <= 8) return len;
+    if (len <= 24) return (uint8_t)(8 + (len - 8 + 3) / 4);  // 12,16,20,24
+    if (len <= 32) return 13;
+    if (len <= 48) return 14;
+    return 15;
+}
+
 /**
  * @brief Creates a CAN packet that you can then use in your code. Pass in the
- * parameters as described.
+ * parameters as described. With NIGHTCAN_FD a dlc over 8 makes it an FD frame
+ * with BRS.
  * @param id
  * @param interval_ms
  * @param dlc
@@ -229,51 +744,362 @@ CANDriverStatus CAN_ConfigFilter(NightCANInstance *instance,
                                  uint32_t filter_bank, uint32_t filter_id,
                                  uint32_t filter_mask);
 
+/**
+ * @brief Programs the hardware acceptance filters so only IDs the driver
+ * cares about (registered inboxes, the bootloader packet, bus enable/disable)
+ * ever reach the RX FIFOs. On H7 these become dual-ID FDCAN filter elements
+ * with non-matching frames rejected, so CubeMX needs StdFiltersNbr >= half the
+ * standard IDs (ExtFiltersNbr likewise). The controller is briefly stopped to
+ * change the global filter. On L4 they become 16-bit (standard) / 32-bit
+ * (extended) list-mode banks. Call after registering inboxes, or define
+ * NIGHTCAN_AUTO_FILTER to have CAN_periodic do it.
+ * @param instance Pointer to the driver instance.
+ * @retval CAN_OK, or CAN_BUFFER_FULL if the IDs don't fit in the available
+ * filters (the filters are then left accepting everything).
+ */
+CANDriverStatus CAN_ApplyReceiveFilters(NightCANInstance *instance);
+
+#ifdef NIGHTCAN_STATS
+/**
+ * @brief Copies the instance counters, per-inbox receive stats and per
+ * scheduled packet lateness into out. Safe to call while the RX/TX interrupts
+ * are running.
+ * @param instance Pointer to the driver instance.
+ * @param out Where to put the snapshot.
+ * @retval CAN_OK, or CAN_INSTANCE_NULL.
+ */
+CANDriverStatus CAN_GetStats(NightCANInstance *instance,
+                             NightCANStatsSnapshot *out);
+
+/**
+ * @brief Zeroes every statistic for the instance (including the ones kept on
+ * its scheduled packets).
+ * @param instance Pointer to the driver instance.
+ */
+void CAN_ResetStats(NightCANInstance *instance);
+#endif
+
+#ifdef NIGHTCAN_GATEWAY
+/**
+ * @brief Sets the routing table for frames received on source. The table is
+ * used in place (its internal fields keep the rate limiting state and
+ * counters), so it has to outlive the instance. The routed IDs are added to
+ * the acceptance filters (masked routes become mask filters). Call before
+ * frames start arriving, it isn't safe against the RX ISR.
+ * @param source Instance the frames arrive on.
+ * @param routes Table of up to CAN_MAX_ROUTES routes, or NULL to stop
+ * forwarding.
+ * @param count Number of routes.
+ * @retval CAN_OK, CAN_INVALID_PARAM if a route has no destination or points
+ * back at source, CAN_BUFFER_FULL if there are too many.
+ */
+CANDriverStatus CAN_SetRoutes(NightCANInstance *source, NightCANRoute *routes,
+                              uint32_t count);
+#endif
+
+#ifdef NIGHTCAN_LOG
+/**
+ * @brief Records every frame the instance receives (before any filtering,
+ * like the telemetry) or sends into log, tagged with bus. Several instances
+ * can share one log. Times are lib_timer_now_us. Sent frames are recorded
+ * where they go to the hardware, which can be an interrupt (the TX refill,
+ * a gateway forward), so the log's write function should only copy into a
+ * buffer the main loop empties onto the card.
+ * @param log An open writer, or NULL to stop.
+ */
+void CAN_SetLog(NightCANInstance *instance, CanLogWriter *log, uint8_t bus);
+#endif
+
+#ifdef NIGHTCAN_HISTORY
+/**
+ * @brief Makes an empty history of a signal.
+ * Example, the front left wheel speed (int16 at byte 0, 0.1 rpm) averaged
+ * over every 2 frames into 64 samples:
+ *   static float fl_values[64];
+ *   static uint64_t fl_times[64];
+ *   fl_history = CAN_create_history(0, CAN_SIGNAL_I16, CAN_LITTLE_ENDIAN,
+ *       0.1f, CAN_HISTORY_AVERAGE, 2, fl_values, fl_times, 64);
+ * @param factor Frames per sample, 0 is taken as 1.
+ * @param values, timestamps_us Storage for capacity samples, has to outlive
+ * the history.
+ */
+NightCANHistory CAN_create_history(uint8_t start_byte, NightCANSignalType type,
+                                   uint8_t order, float precision,
+                                   NightCANHistoryMode mode, uint16_t factor,
+                                   float *values, uint64_t *timestamps_us,
+                                   uint32_t capacity);
+
+/**
+ * @brief Starts filling history from every frame the inbox for id receives
+ * (the inbox has to be added first). Frames too short to hold the signal are
+ * left out. The ring is filled by CAN_PollReceive, so read it from that same
+ * context; nothing is locked.
+ * @retval CAN_OK, CAN_NOT_FOUND if there's no inbox for id,
+ * CAN_INVALID_PARAM if the history has no storage or doesn't fit the payload.
+ */
+CANDriverStatus CAN_AttachHistory(NightCANInstance *instance, uint32_t id,
+                                  NightCANHistory *history);
+
+/**
+ * @brief Number of samples a history holds right now (at most capacity).
+ */
+static inline uint32_t CAN_history_count(const NightCANHistory *history) {
+    return history->_count;
+}
+
+/**
+ * @brief Points at the newest n samples (fewer if it doesn't hold that many)
+ * in place: the ring only wraps once, so that's at most two runs, oldest
+ * first. Valid until CAN_PollReceive next runs.
+ * Example:
+ *   NightCANSpan spans[2];
+ *   uint32_t runs = CAN_history_spans(&fl_history, 16, spans);
+ *   for (uint32_t i = 0; i < runs; i++) fir_feed(spans[i].values, spans[i].count);
+ * @retval The number of spans filled in (0 to 2).
+ */
+uint32_t CAN_history_spans(const NightCANHistory *history, uint32_t n,
+                           NightCANSpan spans[2]);
+
+/**
+ * @brief Forgets all samples (and the partly collected next one).
+ */
+void CAN_history_clear(NightCANHistory *history);
+#endif
+
+/**
+ * @brief Registers a function to hear about inbox timeouts and recoveries.
+ * Runs from CAN_periodic / CAN_PollReceive, not from an interrupt.
+ * @param instance Pointer to the driver instance.
+ * @param callback Function to call, or NULL to stop.
+ */
+void CAN_SetTimeoutCallback(NightCANInstance *instance,
+                            NightCANTimeoutCallback callback);
+
 /* Periodic function to be called */
 void CAN_periodic(NightCANInstance *instance);
 
+#ifdef NIGHTCAN_SOA_INBOXES
+#ifndef NIGHTCAN_STATIC_CONFIG
+/**
+ * @brief Creates a driver-owned inbox for an ID.
+ * @param instance Pointer to the driver instance.
+ * @param id CAN ID to receive.
+ * @param timeout_ms After how long without a frame it times out, 0 for never.
+ * @param dlc Payload bytes to keep.
+ * @retval Its handle (the existing one if the ID already has an inbox), or
+ * CAN_INBOX_NONE if all CAN_RX_BUFFER_SIZE are taken.
+ */
+NightCANInbox CAN_AddInbox(NightCANInstance *instance, uint32_t id,
+                           uint32_t timeout_ms, uint8_t dlc);
+#endif
+
+/**
+ * @brief Looks up the inbox for an ID. Do this once at startup and keep the
+ * handle, it stays valid for the life of the instance.
+ * @retval The handle, or CAN_INBOX_NONE if the ID has no inbox.
+ */
+NightCANInbox CAN_FindInbox(NightCANInstance *instance, uint32_t id);
+
+/* Latest payload of an inbox (CAN_MAX_DATA_LEN bytes) */
+static inline uint8_t *CAN_inbox_data(NightCANInstance *instance,
+                                      NightCANInbox inbox) {
+    return instance->rx_data[inbox];
+}
+
+/* If a frame arrived since the inbox was last consumed */
+static inline bool CAN_inbox_is_recent(const NightCANInstance *instance,
+                                       NightCANInbox inbox) {
+    return (instance->rx_flags[inbox] & CAN_INBOX_RECENT) != 0;
+}
+
+/* If nothing has arrived in the inbox's timeout_ms */
+static inline bool CAN_inbox_is_timed_out(const NightCANInstance *instance,
+                                          NightCANInbox inbox) {
+    return (instance->rx_flags[inbox] & CAN_INBOX_TIMED_OUT) != 0;
+}
+
+/* When the latest frame arrived, on the lib_timer_now_us() clock */
+static inline uint64_t CAN_inbox_timestamp_us(const NightCANInstance *instance,
+                                              NightCANInbox inbox) {
+    return instance->rx_timestamp_us[inbox];
+}
+
+static inline void CAN_inbox_consume(NightCANInstance *instance,
+                                     NightCANInbox inbox) {
+    instance->rx_flags[inbox] &= (uint8_t)~CAN_INBOX_RECENT;
+#ifdef NIGHTCAN_SEQLOCK
+    instance->rx_consumed_seq[inbox] = instance->rx_seq[inbox];
+#endif
+}
+
+#ifdef NIGHTCAN_SEQLOCK
+/**
+ * @brief CAN_snapshot for a driver-owned inbox.
+ */
+bool CAN_inbox_snapshot(NightCANInstance *instance, NightCANInbox inbox,
+                        NightCANSnapshot *out);
+#endif
+#else
 void CAN_consume_packet(NightCANReceivePacket *packet);
 
+#ifdef NIGHTCAN_SEQLOCK
+/**
+ * @brief Copies an inbox's latest frame without tearing, from any context
+ * and without blocking the receive path (it only retries if two frames
+ * landed while it was copying), and consumes it. Only one context should
+ * snapshot/consume a given inbox.
+ * @param packet The inbox.
+ * @param out Where the copy goes, with how many frames arrived since the
+ * last snapshot/consume and how many of those were never seen.
+ * @retval true if anything arrived since the last snapshot/consume.
+ */
+bool CAN_snapshot(NightCANReceivePacket *packet, NightCANSnapshot *out);
+#endif
+
+#ifndef NIGHTCAN_STATIC_CONFIG
 void CAN_addReceivePacket(NightCANInstance *instance,
                           NightCANReceivePacket *packet);
+#endif
+#endif
 
 void CAN_bootload_init(uint8_t BOOTLOAD_PACKET_ID);
 
+// --- Payload Accessors ---
+//
+// Every accessor goes through CAN_copyOrdered(), a fixed-size memcpy the
+// compiler folds into a single LDR/LDRH/STR (unaligned on Cortex-M4/M7 is fine
+// for these) or byte loads when built with -mno-unaligned-access. No pointer
+// casts, so no alignment faults and no strict-aliasing UB. Big-endian
+// (Motorola / DBC "@0") signals add a REV. The core is little-endian, which is
+// also the default byte order on our bus. The type-generic macros use GCC
+// statement expressions.
+
+#define CAN_LITTLE_ENDIAN 0  // Intel byte order, what our boards send
+#define CAN_BIG_ENDIAN 1     // Motorola byte order
+
+/**
+ * @brief Copies an n-byte scalar between a payload and a variable, swapping
+ * byte order if asked. n and order are almost always constants, so this
+ * inlines down to a load/store (plus REV for big-endian).
+ * @param dst Destination (variable or payload position).
+ * @param src Source (payload position or variable).
+ * @param n Size of the scalar in bytes.
+ * @param order CAN_LITTLE_ENDIAN or CAN_BIG_ENDIAN.
+ */
+static inline void CAN_copyOrdered(void *dst, const void *src, uint32_t n,
+                                   uint8_t order) {
+    if (order == CAN_LITTLE_ENDIAN || n == 1) {
+        memcpy(dst, src, n);
+        return;
+    }
+
+    switch (n) {
+        case 2: {
+            uint16_t v;
+            memcpy(&v, src, 2);
+            v = __builtin_bswap16(v);
+            memcpy(dst, &v, 2);
+            return;
+        }
+        case 4: {
+            uint32_t v;
+            memcpy(&v, src, 4);
+            v = __builtin_bswap32(v);
+            memcpy(dst, &v, 4);
+            return;
+        }
+        case 8: {
+            uint64_t v;
+            memcpy(&v, src, 8);
+            v = __builtin_bswap64(v);
+            memcpy(dst, &v, 8);
+            return;
+        }
+        default:
+            for (uint32_t i = 0; i < n; i++) {
+                ((uint8_t *)dst)[i] = ((const uint8_t *)src)[n - 1 - i];
+            }
+            return;
+    }
+}
+
+/**
+ * @brief Read a value of type T at start_byte in the given byte order.
+ * @param T Any scalar type (e.g., int16_t, uint32_t, float).
+ * @param packet_ptr Pointer to a NightCANReceivePacket or NightCANPacket.
+ * @param start_byte The starting byte index within the 'data' buffer. Any
+ * offset is fine, it doesn't need to be aligned.
+ * @param order CAN_LITTLE_ENDIAN or CAN_BIG_ENDIAN.
+ * Example: int16_t speed = CAN_readIntOrdered(int16_t, &pkt, 3, CAN_BIG_ENDIAN);
+ */
+#define CAN_readIntOrdered(T, packet_ptr, start_byte, order)                \
+    __extension__({                                                         \
+        T _can_value;                                                       \
+        CAN_copyOrdered(&_can_value,                                        \
+                        (const uint8_t *)((packet_ptr)->data) + (start_byte), \
+                        sizeof(T), (order));                                \
+        _can_value;                                                         \
+    })
+
+/**
+ * @brief Write value as type T at start_byte in the given byte order. Does
+ * NOT update packet_ptr->dlc. Evaluates to the value written.
+ */
+#define CAN_writeIntOrdered(T, packet_ptr, start_byte, value, order)         \
+    __extension__({                                                          \
+        T _can_value = (T)(value);                                           \
+        CAN_copyOrdered((uint8_t *)((packet_ptr)->data) + (start_byte),      \
+                        &_can_value, sizeof(T), (order));                    \
+        _can_value;                                                          \
+    })
+
+/**
+ * @brief Read a scaled integer of type T in the given byte order and convert
+ * it to float (raw * precision).
+ */
+#define CAN_readFloatOrdered(T, packet_ptr, start_byte, precision, order) \
+    ((float)CAN_readIntOrdered(T, packet_ptr, start_byte, order) * (precision))
+
+/**
+ * @brief Scale a float by 1/precision and write it as type T in the given
+ * byte order. Does NOT update packet_ptr->dlc.
+ */
+#define CAN_writeFloatOrdered(T, packet_ptr, start_byte, value, precision, \
+                              order)                                       \
+    CAN_writeIntOrdered(T, packet_ptr, start_byte, (T)((value) / (precision)), \
+                        order)
+
 /**
  * @brief Read an integral value (e.g., int16_t, uint32_t) from a CAN packet's
- * data buffer. Performs direct memory access via pointer casting.
+ * data buffer (little-endian).
  * @param T The integer type (e.g., int8_t, uint16_t, int32_t) to read as.
  * @param packet_ptr Pointer to the CAN packet structure (e.g.,
  * NightCANReceivePacket* or NightCANPacket*).
  * @param start_byte The starting byte index (0-7) within the 'data' buffer.
  * @return The value read from the buffer, interpreted as type T.
- * @warning See general warnings in file header regarding safety and alignment.
  * Example: uint16_t status = can_readInt(uint16_t, &myReceivedPacket, 2);
  */
 #define CAN_readInt(T, packet_ptr, start_byte) \
-    (*((T *)((uint8_t *)((packet_ptr)->data) + (start_byte))))
+    CAN_readIntOrdered(T, packet_ptr, start_byte, CAN_LITTLE_ENDIAN)
 
 #define CAN_readInt_with_default(T, packet_ptr, start_byte, default) \
-    ((packet_ptr)->is_recent)                                        \
-        ? (*((T *)((uint8_t *)((packet_ptr)->data) + (start_byte)))) \
-        : default  // Cast data to uint8_t* for pointer arithmetic
+    (((packet_ptr)->is_recent) ? CAN_readInt(T, packet_ptr, start_byte)  \
+                               : (default))
 
 /**
  * @brief Write an integral value (e.g., int16_t, uint32_t) to a CAN packet's
- * data buffer. Performs direct memory access via pointer casting. Typically
- * used with NightCANPacket*.
+ * data buffer (little-endian). Typically used with NightCANPacket*.
  * @param T The integer type (e.g., int8_t, uint16_t, int32_t) to write as.
  * @param packet_ptr Pointer to the CAN packet structure (e.g.,
  * NightCANPacket*).
  * @param start_byte The starting byte index (0-7) within the 'data' buffer.
  * @param value The integral value to write into the buffer.
- * @warning See general warnings in file header. Does NOT update
- * packet_ptr->dlc. Example: can_writeInt(int8_t, &myTxPacket, 0, -10);
+ * @warning Does NOT update packet_ptr->dlc.
+ * Example: can_writeInt(int8_t, &myTxPacket, 0, -10);
  * myTxPacket.dlc = 1; // Manually set DLC
  */
-#define CAN_writeInt(T, packet_ptr, start_byte, value)          \
-    (*((T *)((uint8_t *)((packet_ptr)->data) + (start_byte))) = \
-         (value))  // Cast data to uint8_t*
+#define CAN_writeInt(T, packet_ptr, start_byte, value) \
+    CAN_writeIntOrdered(T, packet_ptr, start_byte, value, CAN_LITTLE_ENDIAN)
 
 #define CAN_setBit(packet_ptr, start_byte, bitfield_index)                    \
     do {                                                                      \
@@ -297,7 +1123,7 @@ void CAN_bootload_init(uint8_t BOOTLOAD_PACKET_ID);
 /**
  * @brief Write a floating point value to a CAN packet's data buffer after
  * scaling and conversion. Scales the float by the inverse of precision,
- * converts to integer type T, and writes it using direct memory access.
+ * converts to integer type T, and writes it little-endian.
  * Typically used with NightCANPacket*.
  * @param T The target integer type (e.g., int16_t, uint16_t) to store the value
  * as in the buffer.
@@ -310,12 +1136,11 @@ void CAN_bootload_init(uint8_t BOOTLOAD_PACKET_ID);
  * uint16_t at byte 2: can_writeFloat(uint16_t, &myTxPacket, 2, 4.85f, 0.01f);
  * // Stored integer value will be (uint16_t)(4.85 / 0.01) = 485
  * myTxPacket.dlc = 4; // Manually set DLC (assuming bytes 0,1 also used)
- * @warning See general warnings in file header. Does NOT update
- * packet_ptr->dlc. Ensure 'precision' is not zero.
+ * @warning Does NOT update packet_ptr->dlc. Ensure 'precision' is not zero.
  */
 #define CAN_writeFloat(T, packet_ptr, start_byte, value, precision) \
-    (*((T *)((uint8_t *)((packet_ptr)->data) + (start_byte))) =     \
-         (T)((value) / (precision)))  // Cast data to uint8_t*
+    CAN_writeFloatOrdered(T, packet_ptr, start_byte, value, precision, \
+                          CAN_LITTLE_ENDIAN)
 
 /**
  * @brief Read a floating-point value from a CAN packet's data buffer, assuming
@@ -333,20 +1158,48 @@ void CAN_bootload_init(uint8_t BOOTLOAD_PACKET_ID);
  * &myReceivedPacket, 2, 0.01f);
  * // If stored value was 485, result = (float)485 * 0.01f = 4.85f.
  * @return The reconstructed floating-point value.
- * @warning See general warnings in file header regarding safety and alignment.
  */
-#define CAN_readFloat(T, packet_ptr, start_byte, precision)             \
-    ((float)(*((T *)((uint8_t *)((packet_ptr)->data) + (start_byte))) * \
-             (precision)))  // Cast data to uint8_t*
+#define CAN_readFloat(T, packet_ptr, start_byte, precision) \
+    CAN_readFloatOrdered(T, packet_ptr, start_byte, precision, CAN_LITTLE_ENDIAN)
 
-#define CAN_readFloat_with_default(T, packet_ptr, start_byte, precision,      \
-                                   default)                                   \
-    ((packet_ptr)->is_recent)                                                 \
-        ? ((float)(*((T *)((uint8_t *)((packet_ptr)->data) + (start_byte))) * \
-                   (precision)))                                              \
-        : default  // Cast data to uint8_t*
+#define CAN_readFloat_with_default(T, packet_ptr, start_byte, precision,   \
+                                   default)                                \
+    (((packet_ptr)->is_recent)                                             \
+         ? CAN_readFloat(T, packet_ptr, start_byte, precision)             \
+         : (default))
 
 #define CAN_readBitfield(packet_ptr, start_byte, bitfield_index) \
     (bool)(( (*(((uint8_t *)((packet_ptr)->data) + (start_byte)))) >> (bitfield_index) ) & 1)
 
+#ifdef NIGHTCAN_SOA_INBOXES
+/**
+ * @brief CAN_readInt / CAN_readFloat and friends for a driver-owned inbox.
+ * Example: int16_t rpm = CAN_readInboxInt(int16_t, &can, rpm_inbox, 0);
+ */
+#define CAN_readInboxIntOrdered(T, instance, inbox, start_byte, order)      \
+    __extension__({                                                         \
+        T _can_value;                                                       \
+        CAN_copyOrdered(&_can_value,                                        \
+                        CAN_inbox_data((instance), (inbox)) + (start_byte), \
+                        sizeof(T), (order));                                \
+        _can_value;                                                         \
+    })
+
+#define CAN_readInboxInt(T, instance, inbox, start_byte) \
+    CAN_readInboxIntOrdered(T, instance, inbox, start_byte, CAN_LITTLE_ENDIAN)
+
+#define CAN_readInboxFloat(T, instance, inbox, start_byte, precision) \
+    ((float)CAN_readInboxInt(T, instance, inbox, start_byte) * (precision))
+
+#define CAN_readInboxFloat_with_default(T, instance, inbox, start_byte,    \
+                                        precision, default)                \
+    (CAN_inbox_is_recent((instance), (inbox))                              \
+         ? CAN_readInboxFloat(T, instance, inbox, start_byte, precision)   \
+         : (default))
+
+#define CAN_readInboxBitfield(instance, inbox, start_byte, bitfield_index) \
+    (bool)((CAN_inbox_data((instance), (inbox))[start_byte] >>             \
+            (bitfield_index)) & 1)
+#endif
+
 #endif  // CAN_DRIVER_H
@@ -0,0 +1,298 @@
+// Auto-generated per-board CAN configuration tables
+// Generated from: can_packets.json
+// DO NOT EDIT MANUALLY
+//
+// Both tables are sorted by ID. RX timeouts are 5 periods of the packet, 0 (off) for
+// packets without a rate. TX phases are staggered the same way
+// CAN_TX_PHASE_AUTO would have done it at runtime.
+
+#include "night_can.h"
+
+#ifdef NIGHTCAN_STATIC_CONFIG
+#if defined(NIGHTCAN_BOARD_PI)
+
+const NightCANRxConfig night_can_board_rx[] = {
+    {.id = 0x032, .timeout_ms = 0, .dlc = 7},  // Firmware Update Ack
+    {.id = 0x100, .timeout_ms = 15, .dlc = 6},  // BSE Voltages
+    {.id = 0x101, .timeout_ms = 500, .dlc = 8},  // GPS
+    {.id = 0x102, .timeout_ms = 50, .dlc = 8},  // Motor Cooling
+    {.id = 0x103, .timeout_ms = 50, .dlc = 6},  // Battery Cooling
+    {.id = 0x104, .timeout_ms = 50, .dlc = 8},  // Temps
+    {.id = 0x106, .timeout_ms = 15, .dlc = 1},  // VCU Shutdown Status
+    {.id = 0x107, .timeout_ms = 15, .dlc = 2},  // VCU Fuses
+    {.id = 0x108, .timeout_ms = 15, .dlc = 5},  // VCU Current Sense
+    {.id = 0x200, .timeout_ms = 50, .dlc = 8},  // Battery Pack Status
+    {.id = 0x201, .timeout_ms = 500, .dlc = 8},  // Battery Temperature Status
+    {.id = 0x202, .timeout_ms = 500, .dlc = 6},  // Indicators + Shutdown Status
+    {.id = 0x203, .timeout_ms = 500, .dlc = 3},  // Contactor Status
+    {.id = 0x210, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [0]
+    {.id = 0x211, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [1]
+    {.id = 0x212, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [2]
+    {.id = 0x213, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [3]
+    {.id = 0x214, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [4]
+    {.id = 0x215, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [5]
+    {.id = 0x216, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [6]
+    {.id = 0x217, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [7]
+    {.id = 0x218, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [8]
+    {.id = 0x219, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [9]
+    {.id = 0x21A, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [10]
+    {.id = 0x21B, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [11]
+    {.id = 0x21C, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [12]
+    {.id = 0x21D, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [13]
+    {.id = 0x21E, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [14]
+    {.id = 0x21F, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [15]
+    {.id = 0x220, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [16]
+    {.id = 0x221, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [17]
+    {.id = 0x222, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [18]
+    {.id = 0x223, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [19]
+    {.id = 0x224, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [20]
+    {.id = 0x225, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [21]
+    {.id = 0x226, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [22]
+    {.id = 0x227, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [23]
+    {.id = 0x228, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [24]
+    {.id = 0x229, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [25]
+    {.id = 0x22A, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [26]
+    {.id = 0x22B, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [27]
+    {.id = 0x22C, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [28]
+    {.id = 0x22D, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [29]
+    {.id = 0x22E, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [30]
+    {.id = 0x22F, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [31]
+    {.id = 0x230, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [32]
+    {.id = 0x231, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [33]
+    {.id = 0x232, .timeout_ms = 5000, .dlc = 8},  // Cell Voltages [34]
+    {.id = 0x240, .timeout_ms = 5000, .dlc = 8},  // Cell Temperatures [0]
+    {.id = 0x241, .timeout_ms = 5000, .dlc = 8},  // Cell Temperatures [1]
+    {.id = 0x242, .timeout_ms = 5000, .dlc = 8},  // Cell Temperatures [2]
+    {.id = 0x243, .timeout_ms = 5000, .dlc = 8},  // Cell Temperatures [3]
+    {.id = 0x244, .timeout_ms = 5000, .dlc = 8},  // Cell Temperatures [4]
+    {.id = 0x245, .timeout_ms = 5000, .dlc = 8},  // Cell Temperatures [5]
+    {.id = 0x246, .timeout_ms = 5000, .dlc = 8},  // Cell Temperatures [6]
+    {.id = 0x247, .timeout_ms = 5000, .dlc = 8},  // Cell Temperatures [7]
+    {.id = 0x248, .timeout_ms = 5000, .dlc = 8},  // Cell Temperatures [8]
+    {.id = 0x249, .timeout_ms = 5000, .dlc = 8},  // Cell Temperatures [9]
+    {.id = 0x24A, .timeout_ms = 5000, .dlc = 8},  // Cell Temperatures [10]
+    {.id = 0x24B, .timeout_ms = 5000, .dlc = 8},  // Cell Temperatures [11]
+    {.id = 0x24C, .timeout_ms = 5000, .dlc = 8},  // Cell Temperatures [12]
+    {.id = 0x24D, .timeout_ms = 5000, .dlc = 8},  // Cell Temperatures [13]
+    {.id = 0x24E, .timeout_ms = 5000, .dlc = 8},  // Cell Temperatures [14]
+    {.id = 0x24F, .timeout_ms = 5000, .dlc = 8},  // Cell Temperatures [15]
+    {.id = 0x250, .timeout_ms = 5000, .dlc = 8},  // Cell Temperatures [16]
+    {.id = 0x251, .timeout_ms = 5000, .dlc = 8},  // Cell Temperatures [17]
+    {.id = 0x252, .timeout_ms = 5000, .dlc = 8},  // Cell Temperatures [18]
+    {.id = 0x253, .timeout_ms = 5000, .dlc = 8},  // Cell Temperatures [19]
+    {.id = 0x254, .timeout_ms = 5000, .dlc = 8},  // Cell Temperatures [20]
+    {.id = 0x255, .timeout_ms = 5000, .dlc = 8},  // Cell Temperatures [21]
+    {.id = 0x256, .timeout_ms = 5000, .dlc = 8},  // Cell Temperatures [22]
+    {.id = 0x400, .timeout_ms = 15, .dlc = 2},  // FL Steering
+    {.id = 0x401, .timeout_ms = 15, .dlc = 2},  // FR Steering
+    {.id = 0x402, .timeout_ms = 50, .dlc = 6},  // Acceleration Vector Unsprung FL
+    {.id = 0x403, .timeout_ms = 50, .dlc = 6},  // Acceleration Vector Unsprung FR
+    {.id = 0x404, .timeout_ms = 50, .dlc = 6},  // Acceleration Vector Unsprung RL
+    {.id = 0x405, .timeout_ms = 50, .dlc = 6},  // Acceleration Vector Unsprung RR
+    {.id = 0x406, .timeout_ms = 50, .dlc = 8},  // Wheel Speed + Strain Gauge + Pushrod + Spring Disp. FL
+    {.id = 0x407, .timeout_ms = 50, .dlc = 8},  // Wheel Speed + Strain Gauge + Pushrod + Spring Disp. FR
+    {.id = 0x408, .timeout_ms = 50, .dlc = 8},  // Wheel Speed + Strain Gauge + Pushrod + Spring Disp. RL
+    {.id = 0x409, .timeout_ms = 50, .dlc = 8},  // Wheel Speed + Strain Gauge + Pushrod + Spring Disp. RR
+    {.id = 0x500, .timeout_ms = 50, .dlc = 8},  // Acceleration Vector Sprung + Ride Height FL
+    {.id = 0x501, .timeout_ms = 50, .dlc = 8},  // Acceleration Vector Sprung + Ride Height FR
+    {.id = 0x502, .timeout_ms = 50, .dlc = 8},  // Acceleration Vector Sprung + Ride Height RL
+    {.id = 0x503, .timeout_ms = 50, .dlc = 8},  // Acceleration Vector Sprung + Ride Height RR
+    {.id = 0x504, .timeout_ms = 50, .dlc = 6},  // Angular Rate Vector FL Sprung
+    {.id = 0x505, .timeout_ms = 50, .dlc = 6},  // Angular Rate Vector FR Sprung
+    {.id = 0x506, .timeout_ms = 50, .dlc = 6},  // Angular Rate Vector BL Sprung
+    {.id = 0x507, .timeout_ms = 50, .dlc = 6},  // Angular Rate Vector BR Sprung
+    {.id = 0xA04, .timeout_ms = 15, .dlc = 8},  // Brakes
+    {.id = 0xA05, .timeout_ms = 15, .dlc = 2},  // Rack Steering
+};
+
+const NightCANTxConfig night_can_board_tx[] = {
+    {.id = 0x022, .interval_ms = 0, .phase_ms = 0, .dlc = 1},  // VCU Enter Bootloader
+    {.id = 0x023, .interval_ms = 0, .phase_ms = 0, .dlc = 1},  // Undertray Enter Bootloader
+    {.id = 0x024, .interval_ms = 0, .phase_ms = 0, .dlc = 1},  // HVC Enter Bootloader
+    {.id = 0x025, .interval_ms = 0, .phase_ms = 0, .dlc = 1},  // Upright Enter Bootloader
+    {.id = 0x026, .interval_ms = 0, .phase_ms = 0, .dlc = 0},  // Rack Enter Bootloader
+    {.id = 0x600, .interval_ms = 0, .phase_ms = 0, .dlc = 0},  // HVC Bounds Parameters
+};
+
+#elif defined(NIGHTCAN_BOARD_HVC)
+
+const NightCANRxConfig night_can_board_rx[] = {
+    {.id = 0x024, .timeout_ms = 0, .dlc = 1},  // HVC Enter Bootloader
+    {.id = 0x105, .timeout_ms = 0, .dlc = 0},  // Allow Balance Command
+    {.id = 0x600, .timeout_ms = 0, .dlc = 0},  // HVC Bounds Parameters
+};
+
+const NightCANTxConfig night_can_board_tx[] = {
+    {.id = 0x200, .interval_ms = 10, .phase_ms = 0, .dlc = 8},  // Battery Pack Status
+    {.id = 0x201, .interval_ms = 100, .phase_ms = 3, .dlc = 8},  // Battery Temperature Status
+    {.id = 0x202, .interval_ms = 100, .phase_ms = 6, .dlc = 6},  // Indicators + Shutdown Status
+    {.id = 0x203, .interval_ms = 100, .phase_ms = 9, .dlc = 3},  // Contactor Status
+    {.id = 0x210, .interval_ms = 1000, .phase_ms = 31, .dlc = 8},  // Cell Voltages [0]
+    {.id = 0x211, .interval_ms = 1000, .phase_ms = 62, .dlc = 8},  // Cell Voltages [1]
+    {.id = 0x212, .interval_ms = 1000, .phase_ms = 93, .dlc = 8},  // Cell Voltages [2]
+    {.id = 0x213, .interval_ms = 1000, .phase_ms = 124, .dlc = 8},  // Cell Voltages [3]
+    {.id = 0x214, .interval_ms = 1000, .phase_ms = 155, .dlc = 8},  // Cell Voltages [4]
+    {.id = 0x215, .interval_ms = 1000, .phase_ms = 186, .dlc = 8},  // Cell Voltages [5]
+    {.id = 0x216, .interval_ms = 1000, .phase_ms = 217, .dlc = 8},  // Cell Voltages [6]
+    {.id = 0x217, .interval_ms = 1000, .phase_ms = 248, .dlc = 8},  // Cell Voltages [7]
+    {.id = 0x218, .interval_ms = 1000, .phase_ms = 279, .dlc = 8},  // Cell Voltages [8]
+    {.id = 0x219, .interval_ms = 1000, .phase_ms = 341, .dlc = 8},  // Cell Voltages [9]
+    {.id = 0x21A, .interval_ms = 1000, .phase_ms = 372, .dlc = 8},  // Cell Voltages [10]
+    {.id = 0x21B, .interval_ms = 1000, .phase_ms = 434, .dlc = 8},  // Cell Voltages [11]
+    {.id = 0x21C, .interval_ms = 1000, .phase_ms = 465, .dlc = 8},  // Cell Voltages [12]
+    {.id = 0x21D, .interval_ms = 1000, .phase_ms = 496, .dlc = 8},  // Cell Voltages [13]
+    {.id = 0x21E, .interval_ms = 1000, .phase_ms = 527, .dlc = 8},  // Cell Voltages [14]
+    {.id = 0x21F, .interval_ms = 1000, .phase_ms = 558, .dlc = 8},  // Cell Voltages [15]
+    {.id = 0x220, .interval_ms = 1000, .phase_ms = 589, .dlc = 8},  // Cell Voltages [16]
+    {.id = 0x221, .interval_ms = 1000, .phase_ms = 651, .dlc = 8},  // Cell Voltages [17]
+    {.id = 0x222, .interval_ms = 1000, .phase_ms = 682, .dlc = 8},  // Cell Voltages [18]
+    {.id = 0x223, .interval_ms = 1000, .phase_ms = 713, .dlc = 8},  // Cell Voltages [19]
+    {.id = 0x224, .interval_ms = 1000, .phase_ms = 744, .dlc = 8},  // Cell Voltages [20]
+    {.id = 0x225, .interval_ms = 1000, .phase_ms = 775, .dlc = 8},  // Cell Voltages [21]
+    {.id = 0x226, .interval_ms = 1000, .phase_ms = 837, .dlc = 8},  // Cell Voltages [22]
+    {.id = 0x227, .interval_ms = 1000, .phase_ms = 868, .dlc = 8},  // Cell Voltages [23]
+    {.id = 0x228, .interval_ms = 1000, .phase_ms = 899, .dlc = 8},  // Cell Voltages [24]
+    {.id = 0x229, .interval_ms = 1000, .phase_ms = 961, .dlc = 8},  // Cell Voltages [25]
+    {.id = 0x22A, .interval_ms = 1000, .phase_ms = 0, .dlc = 8},  // Cell Voltages [26]
+    {.id = 0x22B, .interval_ms = 1000, .phase_ms = 31, .dlc = 8},  // Cell Voltages [27]
+    {.id = 0x22C, .interval_ms = 1000, .phase_ms = 62, .dlc = 8},  // Cell Voltages [28]
+    {.id = 0x22D, .interval_ms = 1000, .phase_ms = 93, .dlc = 8},  // Cell Voltages [29]
+    {.id = 0x22E, .interval_ms = 1000, .phase_ms = 124, .dlc = 8},  // Cell Voltages [30]
+    {.id = 0x22F, .interval_ms = 1000, .phase_ms = 155, .dlc = 8},  // Cell Voltages [31]
+    {.id = 0x230, .interval_ms = 1000, .phase_ms = 186, .dlc = 8},  // Cell Voltages [32]
+    {.id = 0x231, .interval_ms = 1000, .phase_ms = 217, .dlc = 8},  // Cell Voltages [33]
+    {.id = 0x232, .interval_ms = 1000, .phase_ms = 248, .dlc = 8},  // Cell Voltages [34]
+    {.id = 0x240, .interval_ms = 1000, .phase_ms = 279, .dlc = 8},  // Cell Temperatures [0]
+    {.id = 0x241, .interval_ms = 1000, .phase_ms = 310, .dlc = 8},  // Cell Temperatures [1]
+    {.id = 0x242, .interval_ms = 1000, .phase_ms = 341, .dlc = 8},  // Cell Temperatures [2]
+    {.id = 0x243, .interval_ms = 1000, .phase_ms = 372, .dlc = 8},  // Cell Temperatures [3]
+    {.id = 0x244, .interval_ms = 1000, .phase_ms = 403, .dlc = 8},  // Cell Temperatures [4]
+    {.id = 0x245, .interval_ms = 1000, .phase_ms = 434, .dlc = 8},  // Cell Temperatures [5]
+    {.id = 0x246, .interval_ms = 1000, .phase_ms = 465, .dlc = 8},  // Cell Temperatures [6]
+    {.id = 0x247, .interval_ms = 1000, .phase_ms = 496, .dlc = 8},  // Cell Temperatures [7]
+    {.id = 0x248, .interval_ms = 1000, .phase_ms = 527, .dlc = 8},  // Cell Temperatures [8]
+    {.id = 0x249, .interval_ms = 1000, .phase_ms = 558, .dlc = 8},  // Cell Temperatures [9]
+    {.id = 0x24A, .interval_ms = 1000, .phase_ms = 589, .dlc = 8},  // Cell Temperatures [10]
+    {.id = 0x24B, .interval_ms = 1000, .phase_ms = 620, .dlc = 8},  // Cell Temperatures [11]
+    {.id = 0x24C, .interval_ms = 1000, .phase_ms = 651, .dlc = 8},  // Cell Temperatures [12]
+    {.id = 0x24D, .interval_ms = 1000, .phase_ms = 682, .dlc = 8},  // Cell Temperatures [13]
+    {.id = 0x24E, .interval_ms = 1000, .phase_ms = 713, .dlc = 8},  // Cell Temperatures [14]
+    {.id = 0x24F, .interval_ms = 1000, .phase_ms = 744, .dlc = 8},  // Cell Temperatures [15]
+    {.id = 0x250, .interval_ms = 1000, .phase_ms = 775, .dlc = 8},  // Cell Temperatures [16]
+    {.id = 0x251, .interval_ms = 1000, .phase_ms = 806, .dlc = 8},  // Cell Temperatures [17]
+    {.id = 0x252, .interval_ms = 1000, .phase_ms = 837, .dlc = 8},  // Cell Temperatures [18]
+    {.id = 0x253, .interval_ms = 1000, .phase_ms = 868, .dlc = 8},  // Cell Temperatures [19]
+    {.id = 0x254, .interval_ms = 1000, .phase_ms = 899, .dlc = 8},  // Cell Temperatures [20]
+    {.id = 0x255, .interval_ms = 1000, .phase_ms = 930, .dlc = 8},  // Cell Temperatures [21]
+    {.id = 0x256, .interval_ms = 1000, .phase_ms = 961, .dlc = 8},  // Cell Temperatures [22]
+};
+
+#elif defined(NIGHTCAN_BOARD_VCU)
+
+const NightCANRxConfig night_can_board_rx[] = {
+    {.id = 0x022, .timeout_ms = 0, .dlc = 1},  // VCU Enter Bootloader
+    {.id = 0x0A0, .timeout_ms = 500, .dlc = 8},  // Inverter Temps
+    {.id = 0x0A2, .timeout_ms = 500, .dlc = 8},  // Inverter Temps 2
+    {.id = 0x0A5, .timeout_ms = 50, .dlc = 8},  // Inverter Status
+    {.id = 0x0A6, .timeout_ms = 50, .dlc = 8},  // Inverter Current
+    {.id = 0x0A7, .timeout_ms = 50, .dlc = 8},  // Inverter Voltage
+    {.id = 0x0AA, .timeout_ms = 50, .dlc = 8},  // Inverter Details
+    {.id = 0x0AB, .timeout_ms = 50, .dlc = 8},  // Inverter Faults
+    {.id = 0x0AC, .timeout_ms = 50, .dlc = 8},  // Inverter TSO
+    {.id = 0x0B0, .timeout_ms = 15, .dlc = 8},  // Inverter Speed
+    {.id = 0x0C2, .timeout_ms = 0, .dlc = 8},  // Inverter Parameter Response
+    {.id = 0x0D1, .timeout_ms = 50, .dlc = 4},  // Wheel Speed, Ride height
+    {.id = 0x0F0, .timeout_ms = 15, .dlc = 8},  // APPS Voltages
+    {.id = 0x0F1, .timeout_ms = 15, .dlc = 3},  // Accelerator Pedal
+    {.id = 0x0F2, .timeout_ms = 15, .dlc = 8},  // BPPS Voltages
+    {.id = 0x0F3, .timeout_ms = 15, .dlc = 3},  // Brake Pedal
+};
+
+const NightCANTxConfig night_can_board_tx[] = {
+    {.id = 0x0C0, .interval_ms = 3, .phase_ms = 0, .dlc = 8},  // Inverter Torque Command
+    {.id = 0x0C1, .interval_ms = 0, .phase_ms = 0, .dlc = 8},  // Inverter Parameter Request
+    {.id = 0x100, .interval_ms = 3, .phase_ms = 1, .dlc = 6},  // BSE Voltages
+    {.id = 0x101, .interval_ms = 100, .phase_ms = 0, .dlc = 8},  // GPS
+    {.id = 0x102, .interval_ms = 10, .phase_ms = 1, .dlc = 8},  // Motor Cooling
+    {.id = 0x103, .interval_ms = 10, .phase_ms = 2, .dlc = 6},  // Battery Cooling
+    {.id = 0x104, .interval_ms = 10, .phase_ms = 3, .dlc = 8},  // Temps
+    {.id = 0x105, .interval_ms = 0, .phase_ms = 0, .dlc = 0},  // Allow Balance Command
+    {.id = 0x106, .interval_ms = 3, .phase_ms = 2, .dlc = 1},  // VCU Shutdown Status
+    {.id = 0x107, .interval_ms = 3, .phase_ms = 0, .dlc = 2},  // VCU Fuses
+    {.id = 0x108, .interval_ms = 3, .phase_ms = 1, .dlc = 5},  // VCU Current Sense
+};
+
+#elif defined(NIGHTCAN_BOARD_UPRIGHT)
+
+const NightCANRxConfig night_can_board_rx[] = {
+    {.id = 0x025, .timeout_ms = 0, .dlc = 1},  // Upright Enter Bootloader
+};
+
+const NightCANTxConfig night_can_board_tx[] = {
+    {.id = 0x0D1, .interval_ms = 10, .phase_ms = 0, .dlc = 4},  // Wheel Speed, Ride height
+    {.id = 0x400, .interval_ms = 3, .phase_ms = 0, .dlc = 2},  // FL Steering
+    {.id = 0x401, .interval_ms = 3, .phase_ms = 1, .dlc = 2},  // FR Steering
+    {.id = 0x402, .interval_ms = 10, .phase_ms = 1, .dlc = 6},  // Acceleration Vector Unsprung FL
+    {.id = 0x403, .interval_ms = 10, .phase_ms = 2, .dlc = 6},  // Acceleration Vector Unsprung FR
+    {.id = 0x404, .interval_ms = 10, .phase_ms = 3, .dlc = 6},  // Acceleration Vector Unsprung RL
+    {.id = 0x405, .interval_ms = 10, .phase_ms = 4, .dlc = 6},  // Acceleration Vector Unsprung RR
+    {.id = 0x406, .interval_ms = 10, .phase_ms = 5, .dlc = 8},  // Wheel Speed + Strain Gauge + Pushrod + Spring Disp. FL
+    {.id = 0x407, .interval_ms = 10, .phase_ms = 6, .dlc = 8},  // Wheel Speed + Strain Gauge + Pushrod + Spring Disp. FR
+    {.id = 0x408, .interval_ms = 10, .phase_ms = 7, .dlc = 8},  // Wheel Speed + Strain Gauge + Pushrod + Spring Disp. RL
+    {.id = 0x409, .interval_ms = 10, .phase_ms = 8, .dlc = 8},  // Wheel Speed + Strain Gauge + Pushrod + Spring Disp. RR
+};
+
+#elif defined(NIGHTCAN_BOARD_UNDERTRAY)
+
+const NightCANRxConfig night_can_board_rx[] = {
+    {.id = 0x023, .timeout_ms = 0, .dlc = 1},  // Undertray Enter Bootloader
+};
+
+const NightCANTxConfig night_can_board_tx[] = {
+    {.id = 0x500, .interval_ms = 10, .phase_ms = 0, .dlc = 8},  // Acceleration Vector Sprung + Ride Height FL
+    {.id = 0x501, .interval_ms = 10, .phase_ms = 1, .dlc = 8},  // Acceleration Vector Sprung + Ride Height FR
+    {.id = 0x502, .interval_ms = 10, .phase_ms = 2, .dlc = 8},  // Acceleration Vector Sprung + Ride Height RL
+    {.id = 0x503, .interval_ms = 10, .phase_ms = 3, .dlc = 8},  // Acceleration Vector Sprung + Ride Height RR
+    {.id = 0x504, .interval_ms = 10, .phase_ms = 4, .dlc = 6},  // Angular Rate Vector FL Sprung
+    {.id = 0x505, .interval_ms = 10, .phase_ms = 5, .dlc = 6},  // Angular Rate Vector FR Sprung
+    {.id = 0x506, .interval_ms = 10, .phase_ms = 6, .dlc = 6},  // Angular Rate Vector BL Sprung
+    {.id = 0x507, .interval_ms = 10, .phase_ms = 7, .dlc = 6},  // Angular Rate Vector BR Sprung
+};
+
+#elif defined(NIGHTCAN_BOARD_INVERTER)
+
+const NightCANRxConfig night_can_board_rx[] = {
+    {.id = 0x0C0, .timeout_ms = 15, .dlc = 8},  // Inverter Torque Command
+    {.id = 0x0C1, .timeout_ms = 0, .dlc = 8},  // Inverter Parameter Request
+};
+
+const NightCANTxConfig night_can_board_tx[] = {
+    {.id = 0x0A0, .interval_ms = 100, .phase_ms = 0, .dlc = 8},  // Inverter Temps
+    {.id = 0x0A2, .interval_ms = 100, .phase_ms = 3, .dlc = 8},  // Inverter Temps 2
+    {.id = 0x0A5, .interval_ms = 10, .phase_ms = 1, .dlc = 8},  // Inverter Status
+    {.id = 0x0A6, .interval_ms = 10, .phase_ms = 2, .dlc = 8},  // Inverter Current
+    {.id = 0x0A7, .interval_ms = 10, .phase_ms = 4, .dlc = 8},  // Inverter Voltage
+    {.id = 0x0AA, .interval_ms = 10, .phase_ms = 5, .dlc = 8},  // Inverter Details
+    {.id = 0x0AB, .interval_ms = 10, .phase_ms = 6, .dlc = 8},  // Inverter Faults
+    {.id = 0x0AC, .interval_ms = 10, .phase_ms = 7, .dlc = 8},  // Inverter TSO
+    {.id = 0x0B0, .interval_ms = 3, .phase_ms = 0, .dlc = 8},  // Inverter Speed
+    {.id = 0x0C2, .interval_ms = 0, .phase_ms = 0, .dlc = 8},  // Inverter Parameter Response
+};
+
+#elif defined(NIGHTCAN_BOARD_RACK)
+
+const NightCANRxConfig night_can_board_rx[] = {
+    {.id = 0x026, .timeout_ms = 0, .dlc = 0},  // Rack Enter Bootloader
+};
+
+const NightCANTxConfig night_can_board_tx[] = {
+    {.id = 0x0F0, .interval_ms = 3, .phase_ms = 0, .dlc = 8},  // APPS Voltages
+    {.id = 0x0F1, .interval_ms = 3, .phase_ms = 1, .dlc = 3},  // Accelerator Pedal
+    {.id = 0x0F2, .interval_ms = 3, .phase_ms = 2, .dlc = 8},  // BPPS Voltages
+    {.id = 0x0F3, .interval_ms = 3, .phase_ms = 0, .dlc = 3},  // Brake Pedal
+    {.id = 0xA04, .interval_ms = 3, .phase_ms = 1, .dlc = 8},  // Brakes
+    {.id = 0xA05, .interval_ms = 3, .phase_ms = 2, .dlc = 2},  // Rack Steering
+};
+
+#endif
+#endif // NIGHTCAN_STATIC_CONFIG
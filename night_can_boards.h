@@ -0,0 +1,57 @@
+#ifndef NIGHT_CAN_BOARDS_H
+#define NIGHT_CAN_BOARDS_H
+
+// Auto-generated per-board CAN configuration sizes
+// Generated from: can_packets.json
+// DO NOT EDIT MANUALLY
+//
+// With NIGHTCAN_STATIC_CONFIG, define one NIGHTCAN_BOARD_<NODE> to pick
+// the board. Its tables are in night_can_boards.c.
+
+#if defined(NIGHTCAN_BOARD_PI)
+#define NIGHTCAN_BOARD_NAME "Pi"
+#define NIGHTCAN_BOARD_RX_COUNT 91
+#define NIGHTCAN_BOARD_RX_STD_COUNT 89
+#define NIGHTCAN_BOARD_TX_COUNT 6
+#define NIGHTCAN_BOARD_TX_PERIODIC_COUNT 0
+#elif defined(NIGHTCAN_BOARD_HVC)
+#define NIGHTCAN_BOARD_NAME "HVC"
+#define NIGHTCAN_BOARD_RX_COUNT 3
+#define NIGHTCAN_BOARD_RX_STD_COUNT 3
+#define NIGHTCAN_BOARD_TX_COUNT 62
+#define NIGHTCAN_BOARD_TX_PERIODIC_COUNT 62
+#elif defined(NIGHTCAN_BOARD_VCU)
+#define NIGHTCAN_BOARD_NAME "VCU"
+#define NIGHTCAN_BOARD_RX_COUNT 16
+#define NIGHTCAN_BOARD_RX_STD_COUNT 16
+#define NIGHTCAN_BOARD_TX_COUNT 11
+#define NIGHTCAN_BOARD_TX_PERIODIC_COUNT 9
+#elif defined(NIGHTCAN_BOARD_UPRIGHT)
+#define NIGHTCAN_BOARD_NAME "Upright"
+#define NIGHTCAN_BOARD_RX_COUNT 1
+#define NIGHTCAN_BOARD_RX_STD_COUNT 1
+#define NIGHTCAN_BOARD_TX_COUNT 11
+#define NIGHTCAN_BOARD_TX_PERIODIC_COUNT 11
+#elif defined(NIGHTCAN_BOARD_UNDERTRAY)
+#define NIGHTCAN_BOARD_NAME "Undertray"
+#define NIGHTCAN_BOARD_RX_COUNT 1
+#define NIGHTCAN_BOARD_RX_STD_COUNT 1
+#define NIGHTCAN_BOARD_TX_COUNT 8
+#define NIGHTCAN_BOARD_TX_PERIODIC_COUNT 8
+#elif defined(NIGHTCAN_BOARD_INVERTER)
+#define NIGHTCAN_BOARD_NAME "Inverter"
+#define NIGHTCAN_BOARD_RX_COUNT 2
+#define NIGHTCAN_BOARD_RX_STD_COUNT 2
+#define NIGHTCAN_BOARD_TX_COUNT 10
+#define NIGHTCAN_BOARD_TX_PERIODIC_COUNT 9
+#elif defined(NIGHTCAN_BOARD_RACK)
+#define NIGHTCAN_BOARD_NAME "Rack"
+#define NIGHTCAN_BOARD_RX_COUNT 1
+#define NIGHTCAN_BOARD_RX_STD_COUNT 1
+#define NIGHTCAN_BOARD_TX_COUNT 6
+#define NIGHTCAN_BOARD_TX_PERIODIC_COUNT 6
+#elif defined(NIGHTCAN_STATIC_CONFIG)
+#error "NIGHTCAN_STATIC_CONFIG needs one of: NIGHTCAN_BOARD_PI, NIGHTCAN_BOARD_HVC, NIGHTCAN_BOARD_VCU, NIGHTCAN_BOARD_UPRIGHT, NIGHTCAN_BOARD_UNDERTRAY, NIGHTCAN_BOARD_INVERTER, NIGHTCAN_BOARD_RACK"
+#endif
+
+#endif // NIGHT_CAN_BOARDS_H
@@ -0,0 +1,3855 @@
+#ifndef NIGHT_CAN_CODEC_H
+#define NIGHT_CAN_CODEC_H
+
+// Auto-generated CAN packet codec
+// Generated from: can_packets.json
+// DO NOT EDIT MANUALLY
+//
+// <packet>_unpack() decodes a payload into <packet>_t, <packet>_pack()
+// encodes one. Scaled signals are floats in engineering units and are
+// rounded to the nearest step when packed. Payloads are little-endian.
+// Packets with two or more 16-bit signals also get <packet>_unpack_f32(),
+// see Batch decode below.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h> // memcpy, folds into a plain load/store
+
+// --- Batch decode ---
+// <packet>_unpack_f32() converts all of a packet's 16-bit signals to floats
+// in one pass, into a vector laid out by the packet's <PACKET>_F32_* indices
+// and scaled by <packet>_f32_scale. The kernels below load two signals per
+// 32-bit word and split them with SXTH/ASR (UXTH/LSR unsigned), the run
+// lengths are constants so they unroll into straight line code. Define
+// NIGHTCAN_CMSIS_DSP to do the signed runs with arm_q15_to_float and
+// arm_mult_f32 instead (the scale entries of signed signals then carry the
+// 2^15 that arm_q15_to_float divides out).
+#ifdef NIGHTCAN_CMSIS_DSP
+#include "arm_math.h"
+#define CAN_BATCH_SCALE(precision) ((precision) * 32768.0f)  // signed only
+#else
+#define CAN_BATCH_SCALE(precision) (precision)
+#endif
+
+// n back to back little-endian int16 signals at data, times scale
+static inline void can_batch_i16_to_f32(float *out, const uint8_t *data,
+                                        uint32_t n, const float *scale) {
+#ifdef NIGHTCAN_CMSIS_DSP
+    arm_q15_to_float((const q15_t *)data, out, n);
+    arm_mult_f32(out, scale, out, n);
+#else
+    uint32_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        uint32_t word;
+        memcpy(&word, data + 2 * i, sizeof(word));
+        out[i] = (float)(int16_t)word * scale[i];
+        out[i + 1] = (float)((int32_t)word >> 16) * scale[i + 1];
+    }
+    if (i < n) {
+        int16_t raw;
+        memcpy(&raw, data + 2 * i, sizeof(raw));
+        out[i] = (float)raw * scale[i];
+    }
+#endif
+}
+
+// the same for uint16 signals (CMSIS-DSP has no unsigned q15)
+static inline void can_batch_u16_to_f32(float *out, const uint8_t *data,
+                                        uint32_t n, const float *scale) {
+    uint32_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        uint32_t word;
+        memcpy(&word, data + 2 * i, sizeof(word));
+        out[i] = (float)(word & 0xFFFFU) * scale[i];
+        out[i + 1] = (float)(word >> 16) * scale[i + 1];
+    }
+    if (i < n) {
+        uint16_t raw;
+        memcpy(&raw, data + 2 * i, sizeof(raw));
+        out[i] = (float)raw * scale[i];
+    }
+}
+
+// Packet: Write Memory Data -- Firmware Update
+typedef struct {
+    uint8_t field_0;
+    uint8_t field_1;
+    uint8_t field_2;
+    uint8_t field_3;
+    uint8_t field_4;
+    uint8_t field_5;
+    uint8_t field_6;
+    uint8_t field_7;
+} write_memory_data_firmware_update_t;
+
+static inline void write_memory_data_firmware_update_unpack(write_memory_data_firmware_update_t *out, const uint8_t *data) {
+    memcpy(&out->field_0, data + 0, sizeof(out->field_0));
+    memcpy(&out->field_1, data + 1, sizeof(out->field_1));
+    memcpy(&out->field_2, data + 2, sizeof(out->field_2));
+    memcpy(&out->field_3, data + 3, sizeof(out->field_3));
+    memcpy(&out->field_4, data + 4, sizeof(out->field_4));
+    memcpy(&out->field_5, data + 5, sizeof(out->field_5));
+    memcpy(&out->field_6, data + 6, sizeof(out->field_6));
+    memcpy(&out->field_7, data + 7, sizeof(out->field_7));
+}
+
+static inline void write_memory_data_firmware_update_pack(const write_memory_data_firmware_update_t *in, uint8_t *data) {
+    memcpy(data + 0, &in->field_0, sizeof(in->field_0));
+    memcpy(data + 1, &in->field_1, sizeof(in->field_1));
+    memcpy(data + 2, &in->field_2, sizeof(in->field_2));
+    memcpy(data + 3, &in->field_3, sizeof(in->field_3));
+    memcpy(data + 4, &in->field_4, sizeof(in->field_4));
+    memcpy(data + 5, &in->field_5, sizeof(in->field_5));
+    memcpy(data + 6, &in->field_6, sizeof(in->field_6));
+    memcpy(data + 7, &in->field_7, sizeof(in->field_7));
+}
+
+// End Packet: Write Memory Data -- Firmware Update
+
+// Packet: Bus Enable/Disable
+typedef struct {
+    uint8_t field_0;
+} bus_enable_disable_t;
+
+static inline void bus_enable_disable_unpack(bus_enable_disable_t *out, const uint8_t *data) {
+    memcpy(&out->field_0, data + 0, sizeof(out->field_0));
+}
+
+static inline void bus_enable_disable_pack(const bus_enable_disable_t *in, uint8_t *data) {
+    memcpy(data + 0, &in->field_0, sizeof(in->field_0));
+}
+
+// End Packet: Bus Enable/Disable
+
+// Packet: (Meta Data for Write Memory -- Firmware Update, 256B max)
+typedef struct {
+    uint8_t field_0;
+    uint8_t field_1;
+    uint8_t field_2;
+    uint8_t field_3;
+    uint8_t field_4;
+    uint16_t field_5;
+    uint8_t field_6;
+} meta_data_for_write_memory_firmware_update_256b_max_t;
+
+static inline void meta_data_for_write_memory_firmware_update_256b_max_unpack(meta_data_for_write_memory_firmware_update_256b_max_t *out, const uint8_t *data) {
+    memcpy(&out->field_0, data + 0, sizeof(out->field_0));
+    memcpy(&out->field_1, data + 1, sizeof(out->field_1));
+    memcpy(&out->field_2, data + 2, sizeof(out->field_2));
+    memcpy(&out->field_3, data + 3, sizeof(out->field_3));
+    memcpy(&out->field_4, data + 4, sizeof(out->field_4));
+    memcpy(&out->field_5, data + 5, sizeof(out->field_5));
+    memcpy(&out->field_6, data + 7, sizeof(out->field_6));
+}
+
+static inline void meta_data_for_write_memory_firmware_update_256b_max_pack(const meta_data_for_write_memory_firmware_update_256b_max_t *in, uint8_t *data) {
+    memcpy(data + 0, &in->field_0, sizeof(in->field_0));
+    memcpy(data + 1, &in->field_1, sizeof(in->field_1));
+    memcpy(data + 2, &in->field_2, sizeof(in->field_2));
+    memcpy(data + 3, &in->field_3, sizeof(in->field_3));
+    memcpy(data + 4, &in->field_4, sizeof(in->field_4));
+    memcpy(data + 5, &in->field_5, sizeof(in->field_5));
+    memcpy(data + 7, &in->field_6, sizeof(in->field_6));
+}
+
+// End Packet: (Meta Data for Write Memory -- Firmware Update, 256B max)
+
+// Packet: Firmware Update Ack
+typedef struct {
+    uint8_t field_0;
+    uint8_t field_1;
+    uint8_t field_2;
+    uint8_t field_3;
+    uint8_t field_4;
+    uint8_t field_5;
+    uint8_t field_6;
+} firmware_update_ack_t;
+
+static inline void firmware_update_ack_unpack(firmware_update_ack_t *out, const uint8_t *data) {
+    memcpy(&out->field_0, data + 0, sizeof(out->field_0));
+    memcpy(&out->field_1, data + 1, sizeof(out->field_1));
+    memcpy(&out->field_2, data + 2, sizeof(out->field_2));
+    memcpy(&out->field_3, data + 3, sizeof(out->field_3));
+    memcpy(&out->field_4, data + 4, sizeof(out->field_4));
+    memcpy(&out->field_5, data + 5, sizeof(out->field_5));
+    memcpy(&out->field_6, data + 6, sizeof(out->field_6));
+}
+
+static inline void firmware_update_ack_pack(const firmware_update_ack_t *in, uint8_t *data) {
+    memcpy(data + 0, &in->field_0, sizeof(in->field_0));
+    memcpy(data + 1, &in->field_1, sizeof(in->field_1));
+    memcpy(data + 2, &in->field_2, sizeof(in->field_2));
+    memcpy(data + 3, &in->field_3, sizeof(in->field_3));
+    memcpy(data + 4, &in->field_4, sizeof(in->field_4));
+    memcpy(data + 5, &in->field_5, sizeof(in->field_5));
+    memcpy(data + 6, &in->field_6, sizeof(in->field_6));
+}
+
+// End Packet: Firmware Update Ack
+
+// Packet: Inverter Temps
+typedef struct {
+    float module_a_temp;
+    int16_t module_b_temp;
+    int16_t module_c_temp;
+    int16_t gate_driver_temp;
+} inverter_temps_t;
+
+static inline void inverter_temps_unpack(inverter_temps_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->module_a_temp = (float)raw * 0.1f;
+    }
+    memcpy(&out->module_b_temp, data + 2, sizeof(out->module_b_temp));
+    memcpy(&out->module_c_temp, data + 4, sizeof(out->module_c_temp));
+    memcpy(&out->gate_driver_temp, data + 6, sizeof(out->gate_driver_temp));
+}
+
+static inline void inverter_temps_pack(const inverter_temps_t *in, uint8_t *data) {
+    {
+        float scaled = in->module_a_temp * 10.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    memcpy(data + 2, &in->module_b_temp, sizeof(in->module_b_temp));
+    memcpy(data + 4, &in->module_c_temp, sizeof(in->module_c_temp));
+    memcpy(data + 6, &in->gate_driver_temp, sizeof(in->gate_driver_temp));
+}
+
+// inverter_temps_unpack_f32() vector layout
+enum {
+    INVERTER_TEMPS_F32_MODULE_A_TEMP = 0,
+    INVERTER_TEMPS_F32_MODULE_B_TEMP = 1,
+    INVERTER_TEMPS_F32_MODULE_C_TEMP = 2,
+    INVERTER_TEMPS_F32_GATE_DRIVER_TEMP = 3,
+    INVERTER_TEMPS_F32_COUNT = 4
+};
+
+static const float inverter_temps_f32_scale[INVERTER_TEMPS_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.1f),
+    CAN_BATCH_SCALE(1.0f),
+    CAN_BATCH_SCALE(1.0f),
+    CAN_BATCH_SCALE(1.0f),
+};
+
+static inline void inverter_temps_unpack_f32(float out[INVERTER_TEMPS_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 4, inverter_temps_f32_scale + 0);
+}
+
+// End Packet: Inverter Temps
+
+// Packet: Inverter Temps 2
+typedef struct {
+    int16_t rtd_4_temp;
+    int16_t rtd_5_temp;
+    int16_t motor_temp;
+    float torque_shudder;
+} inverter_temps_2_t;
+
+static inline void inverter_temps_2_unpack(inverter_temps_2_t *out, const uint8_t *data) {
+    memcpy(&out->rtd_4_temp, data + 0, sizeof(out->rtd_4_temp));
+    memcpy(&out->rtd_5_temp, data + 2, sizeof(out->rtd_5_temp));
+    memcpy(&out->motor_temp, data + 4, sizeof(out->motor_temp));
+    {
+        int16_t raw;
+        memcpy(&raw, data + 6, sizeof(raw));
+        out->torque_shudder = (float)raw * 0.1f;
+    }
+}
+
+static inline void inverter_temps_2_pack(const inverter_temps_2_t *in, uint8_t *data) {
+    memcpy(data + 0, &in->rtd_4_temp, sizeof(in->rtd_4_temp));
+    memcpy(data + 2, &in->rtd_5_temp, sizeof(in->rtd_5_temp));
+    memcpy(data + 4, &in->motor_temp, sizeof(in->motor_temp));
+    {
+        float scaled = in->torque_shudder * 10.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 6, &raw, sizeof(raw));
+    }
+}
+
+// inverter_temps_2_unpack_f32() vector layout
+enum {
+    INVERTER_TEMPS_2_F32_RTD_4_TEMP = 0,
+    INVERTER_TEMPS_2_F32_RTD_5_TEMP = 1,
+    INVERTER_TEMPS_2_F32_MOTOR_TEMP = 2,
+    INVERTER_TEMPS_2_F32_TORQUE_SHUDDER = 3,
+    INVERTER_TEMPS_2_F32_COUNT = 4
+};
+
+static const float inverter_temps_2_f32_scale[INVERTER_TEMPS_2_F32_COUNT] = {
+    CAN_BATCH_SCALE(1.0f),
+    CAN_BATCH_SCALE(1.0f),
+    CAN_BATCH_SCALE(1.0f),
+    CAN_BATCH_SCALE(0.1f),
+};
+
+static inline void inverter_temps_2_unpack_f32(float out[INVERTER_TEMPS_2_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 4, inverter_temps_2_f32_scale + 0);
+}
+
+// End Packet: Inverter Temps 2
+
+// Packet: Inverter Status
+typedef struct {
+    float motor_angle;
+    int16_t motor_speed;
+    float inverter_frequency;
+    float delta_resolver_angle;
+} inverter_status_t;
+
+static inline void inverter_status_unpack(inverter_status_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->motor_angle = (float)raw * 0.1f;
+    }
+    memcpy(&out->motor_speed, data + 2, sizeof(out->motor_speed));
+    {
+        int16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->inverter_frequency = (float)raw * 0.1f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 6, sizeof(raw));
+        out->delta_resolver_angle = (float)raw * 0.1f;
+    }
+}
+
+static inline void inverter_status_pack(const inverter_status_t *in, uint8_t *data) {
+    {
+        float scaled = in->motor_angle * 10.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    memcpy(data + 2, &in->motor_speed, sizeof(in->motor_speed));
+    {
+        float scaled = in->inverter_frequency * 10.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->delta_resolver_angle * 10.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 6, &raw, sizeof(raw));
+    }
+}
+
+// inverter_status_unpack_f32() vector layout
+enum {
+    INVERTER_STATUS_F32_MOTOR_ANGLE = 0,
+    INVERTER_STATUS_F32_MOTOR_SPEED = 1,
+    INVERTER_STATUS_F32_INVERTER_FREQUENCY = 2,
+    INVERTER_STATUS_F32_DELTA_RESOLVER_ANGLE = 3,
+    INVERTER_STATUS_F32_COUNT = 4
+};
+
+static const float inverter_status_f32_scale[INVERTER_STATUS_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.1f),
+    CAN_BATCH_SCALE(1.0f),
+    CAN_BATCH_SCALE(0.1f),
+    CAN_BATCH_SCALE(0.1f),
+};
+
+static inline void inverter_status_unpack_f32(float out[INVERTER_STATUS_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 4, inverter_status_f32_scale + 0);
+}
+
+// End Packet: Inverter Status
+
+// Packet: Inverter Current
+typedef struct {
+    float phase_a_current;
+    int16_t phase_b_current;
+    int16_t phase_c_current;
+    int16_t dc_bus_current;
+} inverter_current_t;
+
+static inline void inverter_current_unpack(inverter_current_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->phase_a_current = (float)raw * 0.1f;
+    }
+    memcpy(&out->phase_b_current, data + 2, sizeof(out->phase_b_current));
+    memcpy(&out->phase_c_current, data + 4, sizeof(out->phase_c_current));
+    memcpy(&out->dc_bus_current, data + 6, sizeof(out->dc_bus_current));
+}
+
+static inline void inverter_current_pack(const inverter_current_t *in, uint8_t *data) {
+    {
+        float scaled = in->phase_a_current * 10.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    memcpy(data + 2, &in->phase_b_current, sizeof(in->phase_b_current));
+    memcpy(data + 4, &in->phase_c_current, sizeof(in->phase_c_current));
+    memcpy(data + 6, &in->dc_bus_current, sizeof(in->dc_bus_current));
+}
+
+// inverter_current_unpack_f32() vector layout
+enum {
+    INVERTER_CURRENT_F32_PHASE_A_CURRENT = 0,
+    INVERTER_CURRENT_F32_PHASE_B_CURRENT = 1,
+    INVERTER_CURRENT_F32_PHASE_C_CURRENT = 2,
+    INVERTER_CURRENT_F32_DC_BUS_CURRENT = 3,
+    INVERTER_CURRENT_F32_COUNT = 4
+};
+
+static const float inverter_current_f32_scale[INVERTER_CURRENT_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.1f),
+    CAN_BATCH_SCALE(1.0f),
+    CAN_BATCH_SCALE(1.0f),
+    CAN_BATCH_SCALE(1.0f),
+};
+
+static inline void inverter_current_unpack_f32(float out[INVERTER_CURRENT_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 4, inverter_current_f32_scale + 0);
+}
+
+// End Packet: Inverter Current
+
+// Packet: Inverter Voltage
+typedef struct {
+    float dc_bus_voltage;
+    int16_t neutral_output_voltage;
+    int16_t vab_vq_voltage;
+    int16_t vbc_vd_voltage;
+} inverter_voltage_t;
+
+static inline void inverter_voltage_unpack(inverter_voltage_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->dc_bus_voltage = (float)raw * 0.1f;
+    }
+    memcpy(&out->neutral_output_voltage, data + 2, sizeof(out->neutral_output_voltage));
+    memcpy(&out->vab_vq_voltage, data + 4, sizeof(out->vab_vq_voltage));
+    memcpy(&out->vbc_vd_voltage, data + 6, sizeof(out->vbc_vd_voltage));
+}
+
+static inline void inverter_voltage_pack(const inverter_voltage_t *in, uint8_t *data) {
+    {
+        float scaled = in->dc_bus_voltage * 10.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    memcpy(data + 2, &in->neutral_output_voltage, sizeof(in->neutral_output_voltage));
+    memcpy(data + 4, &in->vab_vq_voltage, sizeof(in->vab_vq_voltage));
+    memcpy(data + 6, &in->vbc_vd_voltage, sizeof(in->vbc_vd_voltage));
+}
+
+// inverter_voltage_unpack_f32() vector layout
+enum {
+    INVERTER_VOLTAGE_F32_DC_BUS_VOLTAGE = 0,
+    INVERTER_VOLTAGE_F32_NEUTRAL_OUTPUT_VOLTAGE = 1,
+    INVERTER_VOLTAGE_F32_VAB_VQ_VOLTAGE = 2,
+    INVERTER_VOLTAGE_F32_VBC_VD_VOLTAGE = 3,
+    INVERTER_VOLTAGE_F32_COUNT = 4
+};
+
+static const float inverter_voltage_f32_scale[INVERTER_VOLTAGE_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.1f),
+    CAN_BATCH_SCALE(1.0f),
+    CAN_BATCH_SCALE(1.0f),
+    CAN_BATCH_SCALE(1.0f),
+};
+
+static inline void inverter_voltage_unpack_f32(float out[INVERTER_VOLTAGE_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 4, inverter_voltage_f32_scale + 0);
+}
+
+// End Packet: Inverter Voltage
+
+// Packet: Inverter Details
+typedef struct {
+    uint8_t vsm;
+    uint8_t pwm_freq;
+    uint8_t inverter;
+    uint8_t relay;
+    uint8_t misc_1;
+    uint8_t misc_2;
+    uint8_t misc_3;
+    uint8_t misc_4;
+} inverter_details_t;
+
+static inline void inverter_details_unpack(inverter_details_t *out, const uint8_t *data) {
+    memcpy(&out->vsm, data + 0, sizeof(out->vsm));
+    memcpy(&out->pwm_freq, data + 1, sizeof(out->pwm_freq));
+    memcpy(&out->inverter, data + 2, sizeof(out->inverter));
+    memcpy(&out->relay, data + 3, sizeof(out->relay));
+    memcpy(&out->misc_1, data + 4, sizeof(out->misc_1));
+    memcpy(&out->misc_2, data + 5, sizeof(out->misc_2));
+    memcpy(&out->misc_3, data + 6, sizeof(out->misc_3));
+    memcpy(&out->misc_4, data + 7, sizeof(out->misc_4));
+}
+
+static inline void inverter_details_pack(const inverter_details_t *in, uint8_t *data) {
+    memcpy(data + 0, &in->vsm, sizeof(in->vsm));
+    memcpy(data + 1, &in->pwm_freq, sizeof(in->pwm_freq));
+    memcpy(data + 2, &in->inverter, sizeof(in->inverter));
+    memcpy(data + 3, &in->relay, sizeof(in->relay));
+    memcpy(data + 4, &in->misc_1, sizeof(in->misc_1));
+    memcpy(data + 5, &in->misc_2, sizeof(in->misc_2));
+    memcpy(data + 6, &in->misc_3, sizeof(in->misc_3));
+    memcpy(data + 7, &in->misc_4, sizeof(in->misc_4));
+}
+
+// End Packet: Inverter Details
+
+// Packet: Inverter Faults
+typedef struct {
+    uint32_t post_faults;
+    uint32_t run_faults;
+} inverter_faults_t;
+
+static inline void inverter_faults_unpack(inverter_faults_t *out, const uint8_t *data) {
+    memcpy(&out->post_faults, data + 0, sizeof(out->post_faults));
+    memcpy(&out->run_faults, data + 4, sizeof(out->run_faults));
+}
+
+static inline void inverter_faults_pack(const inverter_faults_t *in, uint8_t *data) {
+    memcpy(data + 0, &in->post_faults, sizeof(in->post_faults));
+    memcpy(data + 4, &in->run_faults, sizeof(in->run_faults));
+}
+
+// End Packet: Inverter Faults
+
+// Packet: Inverter TSO
+typedef struct {
+    float commanded_torque;
+    int16_t torque_feedback;
+    uint32_t time_since_turned_on;
+} inverter_tso_t;
+
+static inline void inverter_tso_unpack(inverter_tso_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->commanded_torque = (float)raw * 0.1f;
+    }
+    memcpy(&out->torque_feedback, data + 2, sizeof(out->torque_feedback));
+    memcpy(&out->time_since_turned_on, data + 4, sizeof(out->time_since_turned_on));
+}
+
+static inline void inverter_tso_pack(const inverter_tso_t *in, uint8_t *data) {
+    {
+        float scaled = in->commanded_torque * 10.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    memcpy(data + 2, &in->torque_feedback, sizeof(in->torque_feedback));
+    memcpy(data + 4, &in->time_since_turned_on, sizeof(in->time_since_turned_on));
+}
+
+// inverter_tso_unpack_f32() vector layout
+enum {
+    INVERTER_TSO_F32_COMMANDED_TORQUE = 0,
+    INVERTER_TSO_F32_TORQUE_FEEDBACK = 1,
+    INVERTER_TSO_F32_COUNT = 2
+};
+
+static const float inverter_tso_f32_scale[INVERTER_TSO_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.1f),
+    CAN_BATCH_SCALE(1.0f),
+};
+
+static inline void inverter_tso_unpack_f32(float out[INVERTER_TSO_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 2, inverter_tso_f32_scale + 0);
+}
+
+// End Packet: Inverter TSO
+
+// Packet: Inverter Speed
+typedef struct {
+    int16_t commanded_torque;
+    int16_t torque_feedback;
+    int16_t motor_speed;
+    uint16_t bus_voltage;
+} inverter_speed_t;
+
+static inline void inverter_speed_unpack(inverter_speed_t *out, const uint8_t *data) {
+    memcpy(&out->commanded_torque, data + 0, sizeof(out->commanded_torque));
+    memcpy(&out->torque_feedback, data + 2, sizeof(out->torque_feedback));
+    memcpy(&out->motor_speed, data + 4, sizeof(out->motor_speed));
+    memcpy(&out->bus_voltage, data + 6, sizeof(out->bus_voltage));
+}
+
+static inline void inverter_speed_pack(const inverter_speed_t *in, uint8_t *data) {
+    memcpy(data + 0, &in->commanded_torque, sizeof(in->commanded_torque));
+    memcpy(data + 2, &in->torque_feedback, sizeof(in->torque_feedback));
+    memcpy(data + 4, &in->motor_speed, sizeof(in->motor_speed));
+    memcpy(data + 6, &in->bus_voltage, sizeof(in->bus_voltage));
+}
+
+// inverter_speed_unpack_f32() vector layout
+enum {
+    INVERTER_SPEED_F32_COMMANDED_TORQUE = 0,
+    INVERTER_SPEED_F32_TORQUE_FEEDBACK = 1,
+    INVERTER_SPEED_F32_MOTOR_SPEED = 2,
+    INVERTER_SPEED_F32_BUS_VOLTAGE = 3,
+    INVERTER_SPEED_F32_COUNT = 4
+};
+
+static const float inverter_speed_f32_scale[INVERTER_SPEED_F32_COUNT] = {
+    CAN_BATCH_SCALE(1.0f),
+    CAN_BATCH_SCALE(1.0f),
+    CAN_BATCH_SCALE(1.0f),
+    1.0f,
+};
+
+static inline void inverter_speed_unpack_f32(float out[INVERTER_SPEED_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 3, inverter_speed_f32_scale + 0);
+    can_batch_u16_to_f32(out + 3, data + 6, 1, inverter_speed_f32_scale + 3);
+}
+
+// End Packet: Inverter Speed
+
+// Packet: Inverter Torque Command
+typedef struct {
+    float torque_request;
+    int16_t rpm_request;
+    uint8_t direction;
+    uint8_t enable;
+    float torque_limit;
+} inverter_torque_command_t;
+
+static inline void inverter_torque_command_unpack(inverter_torque_command_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->torque_request = (float)raw * 0.1f;
+    }
+    memcpy(&out->rpm_request, data + 2, sizeof(out->rpm_request));
+    memcpy(&out->direction, data + 4, sizeof(out->direction));
+    memcpy(&out->enable, data + 5, sizeof(out->enable));
+    {
+        int16_t raw;
+        memcpy(&raw, data + 6, sizeof(raw));
+        out->torque_limit = (float)raw * 0.1f;
+    }
+}
+
+static inline void inverter_torque_command_pack(const inverter_torque_command_t *in, uint8_t *data) {
+    {
+        float scaled = in->torque_request * 10.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    memcpy(data + 2, &in->rpm_request, sizeof(in->rpm_request));
+    memcpy(data + 4, &in->direction, sizeof(in->direction));
+    memcpy(data + 5, &in->enable, sizeof(in->enable));
+    {
+        float scaled = in->torque_limit * 10.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 6, &raw, sizeof(raw));
+    }
+}
+
+// inverter_torque_command_unpack_f32() vector layout
+enum {
+    INVERTER_TORQUE_COMMAND_F32_TORQUE_REQUEST = 0,
+    INVERTER_TORQUE_COMMAND_F32_RPM_REQUEST = 1,
+    INVERTER_TORQUE_COMMAND_F32_TORQUE_LIMIT = 2,
+    INVERTER_TORQUE_COMMAND_F32_COUNT = 3
+};
+
+static const float inverter_torque_command_f32_scale[INVERTER_TORQUE_COMMAND_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.1f),
+    CAN_BATCH_SCALE(1.0f),
+    CAN_BATCH_SCALE(0.1f),
+};
+
+static inline void inverter_torque_command_unpack_f32(float out[INVERTER_TORQUE_COMMAND_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 2, inverter_torque_command_f32_scale + 0);
+    can_batch_i16_to_f32(out + 2, data + 6, 1, inverter_torque_command_f32_scale + 2);
+}
+
+// End Packet: Inverter Torque Command
+
+// Packet: Inverter Parameter Request
+// Warning: skipped r/w: unknown conversion type '0/1'
+typedef struct {
+    uint16_t parameter_address;
+} inverter_parameter_request_t;
+
+static inline void inverter_parameter_request_unpack(inverter_parameter_request_t *out, const uint8_t *data) {
+    memcpy(&out->parameter_address, data + 0, sizeof(out->parameter_address));
+}
+
+static inline void inverter_parameter_request_pack(const inverter_parameter_request_t *in, uint8_t *data) {
+    memcpy(data + 0, &in->parameter_address, sizeof(in->parameter_address));
+}
+
+// End Packet: Inverter Parameter Request
+
+// Packet: Inverter Parameter Response
+typedef struct {
+    uint16_t parameter_address;
+    uint8_t success;
+} inverter_parameter_response_t;
+
+static inline void inverter_parameter_response_unpack(inverter_parameter_response_t *out, const uint8_t *data) {
+    memcpy(&out->parameter_address, data + 0, sizeof(out->parameter_address));
+    memcpy(&out->success, data + 2, sizeof(out->success));
+}
+
+static inline void inverter_parameter_response_pack(const inverter_parameter_response_t *in, uint8_t *data) {
+    memcpy(data + 0, &in->parameter_address, sizeof(in->parameter_address));
+    memcpy(data + 2, &in->success, sizeof(in->success));
+}
+
+// End Packet: Inverter Parameter Response
+
+// Packet: Wheel Speed, Ride height
+typedef struct {
+    float wheel_speed;
+    float ride_height;
+} wheel_speed_ride_height_t;
+
+static inline void wheel_speed_ride_height_unpack(wheel_speed_ride_height_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->wheel_speed = (float)raw * 0.0078125f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->ride_height = (float)raw * 0.0625f;
+    }
+}
+
+static inline void wheel_speed_ride_height_pack(const wheel_speed_ride_height_t *in, uint8_t *data) {
+    {
+        float scaled = in->wheel_speed * 128.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->ride_height * 16.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+}
+
+// wheel_speed_ride_height_unpack_f32() vector layout
+enum {
+    WHEEL_SPEED_RIDE_HEIGHT_F32_WHEEL_SPEED = 0,
+    WHEEL_SPEED_RIDE_HEIGHT_F32_RIDE_HEIGHT = 1,
+    WHEEL_SPEED_RIDE_HEIGHT_F32_COUNT = 2
+};
+
+static const float wheel_speed_ride_height_f32_scale[WHEEL_SPEED_RIDE_HEIGHT_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.0078125f),
+    0.0625f,
+};
+
+static inline void wheel_speed_ride_height_unpack_f32(float out[WHEEL_SPEED_RIDE_HEIGHT_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 1, wheel_speed_ride_height_f32_scale + 0);
+    can_batch_u16_to_f32(out + 1, data + 2, 1, wheel_speed_ride_height_f32_scale + 1);
+}
+
+// End Packet: Wheel Speed, Ride height
+
+// Packet: APPS Voltages
+typedef struct {
+    float apps1_voltage;
+    float apps2_voltage;
+    float apps1_travel;
+    float apps2_travel;
+} apps_voltages_t;
+
+static inline void apps_voltages_unpack(apps_voltages_t *out, const uint8_t *data) {
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->apps1_voltage = (float)raw * 0.0001f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->apps2_voltage = (float)raw * 0.0001f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->apps1_travel = (float)raw * 0.0001f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 6, sizeof(raw));
+        out->apps2_travel = (float)raw * 0.0001f;
+    }
+}
+
+static inline void apps_voltages_pack(const apps_voltages_t *in, uint8_t *data) {
+    {
+        float scaled = in->apps1_voltage * 10000.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->apps2_voltage * 10000.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->apps1_travel * 10000.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->apps2_travel * 10000.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 6, &raw, sizeof(raw));
+    }
+}
+
+// apps_voltages_unpack_f32() vector layout
+enum {
+    APPS_VOLTAGES_F32_APPS1_VOLTAGE = 0,
+    APPS_VOLTAGES_F32_APPS2_VOLTAGE = 1,
+    APPS_VOLTAGES_F32_APPS1_TRAVEL = 2,
+    APPS_VOLTAGES_F32_APPS2_TRAVEL = 3,
+    APPS_VOLTAGES_F32_COUNT = 4
+};
+
+static const float apps_voltages_f32_scale[APPS_VOLTAGES_F32_COUNT] = {
+    0.0001f,
+    0.0001f,
+    0.0001f,
+    0.0001f,
+};
+
+static inline void apps_voltages_unpack_f32(float out[APPS_VOLTAGES_F32_COUNT], const uint8_t *data) {
+    can_batch_u16_to_f32(out + 0, data + 0, 4, apps_voltages_f32_scale + 0);
+}
+
+// End Packet: APPS Voltages
+
+// Packet: Accelerator Pedal
+typedef struct {
+    float accelerator_pedal_travel;
+    struct {
+        bool apps1_disconnect;
+        bool apps2_disconnect;
+        bool apps1_out_range;
+        bool apps2_out_range;
+        bool apps_mismatch;
+        bool apps_implause;
+    } apps_faults;
+} accelerator_pedal_t;
+
+static inline void accelerator_pedal_unpack(accelerator_pedal_t *out, const uint8_t *data) {
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->accelerator_pedal_travel = (float)raw * 0.0001f;
+    }
+    {
+        uint8_t bits = data[2];
+        out->apps_faults.apps1_disconnect = (bits >> 0) & 1U;
+        out->apps_faults.apps2_disconnect = (bits >> 1) & 1U;
+        out->apps_faults.apps1_out_range = (bits >> 2) & 1U;
+        out->apps_faults.apps2_out_range = (bits >> 3) & 1U;
+        out->apps_faults.apps_mismatch = (bits >> 4) & 1U;
+        out->apps_faults.apps_implause = (bits >> 5) & 1U;
+    }
+}
+
+static inline void accelerator_pedal_pack(const accelerator_pedal_t *in, uint8_t *data) {
+    {
+        float scaled = in->accelerator_pedal_travel * 10000.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    data[2] = (uint8_t)(
+        ((uint8_t)in->apps_faults.apps1_disconnect << 0) |
+        ((uint8_t)in->apps_faults.apps2_disconnect << 1) |
+        ((uint8_t)in->apps_faults.apps1_out_range << 2) |
+        ((uint8_t)in->apps_faults.apps2_out_range << 3) |
+        ((uint8_t)in->apps_faults.apps_mismatch << 4) |
+        ((uint8_t)in->apps_faults.apps_implause << 5));
+}
+
+// End Packet: Accelerator Pedal
+
+// Packet: BPPS Voltages
+typedef struct {
+    float bpps1_voltage;
+    float bpps2_voltage;
+    float bpps1_travel;
+    float bpps2_travel;
+} bpps_voltages_t;
+
+static inline void bpps_voltages_unpack(bpps_voltages_t *out, const uint8_t *data) {
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->bpps1_voltage = (float)raw * 0.0001f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->bpps2_voltage = (float)raw * 0.0001f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->bpps1_travel = (float)raw * 0.0001f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 6, sizeof(raw));
+        out->bpps2_travel = (float)raw * 0.0001f;
+    }
+}
+
+static inline void bpps_voltages_pack(const bpps_voltages_t *in, uint8_t *data) {
+    {
+        float scaled = in->bpps1_voltage * 10000.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->bpps2_voltage * 10000.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->bpps1_travel * 10000.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->bpps2_travel * 10000.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 6, &raw, sizeof(raw));
+    }
+}
+
+// bpps_voltages_unpack_f32() vector layout
+enum {
+    BPPS_VOLTAGES_F32_BPPS1_VOLTAGE = 0,
+    BPPS_VOLTAGES_F32_BPPS2_VOLTAGE = 1,
+    BPPS_VOLTAGES_F32_BPPS1_TRAVEL = 2,
+    BPPS_VOLTAGES_F32_BPPS2_TRAVEL = 3,
+    BPPS_VOLTAGES_F32_COUNT = 4
+};
+
+static const float bpps_voltages_f32_scale[BPPS_VOLTAGES_F32_COUNT] = {
+    0.0001f,
+    0.0001f,
+    0.0001f,
+    0.0001f,
+};
+
+static inline void bpps_voltages_unpack_f32(float out[BPPS_VOLTAGES_F32_COUNT], const uint8_t *data) {
+    can_batch_u16_to_f32(out + 0, data + 0, 4, bpps_voltages_f32_scale + 0);
+}
+
+// End Packet: BPPS Voltages
+
+// Packet: Brake Pedal
+typedef struct {
+    float brake_pedal_travel;
+    struct {
+        bool bpps1_disconnect;
+        bool bpps2_disconnect;
+        bool bpps1_out_range;
+        bool bpps2_out_range;
+        bool bpps_mismatch;
+    } bpps_faults;
+} brake_pedal_t;
+
+static inline void brake_pedal_unpack(brake_pedal_t *out, const uint8_t *data) {
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->brake_pedal_travel = (float)raw * 0.0001f;
+    }
+    {
+        uint8_t bits = data[2];
+        out->bpps_faults.bpps1_disconnect = (bits >> 0) & 1U;
+        out->bpps_faults.bpps2_disconnect = (bits >> 1) & 1U;
+        out->bpps_faults.bpps1_out_range = (bits >> 2) & 1U;
+        out->bpps_faults.bpps2_out_range = (bits >> 3) & 1U;
+        out->bpps_faults.bpps_mismatch = (bits >> 4) & 1U;
+    }
+}
+
+static inline void brake_pedal_pack(const brake_pedal_t *in, uint8_t *data) {
+    {
+        float scaled = in->brake_pedal_travel * 10000.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    data[2] = (uint8_t)(
+        ((uint8_t)in->bpps_faults.bpps1_disconnect << 0) |
+        ((uint8_t)in->bpps_faults.bpps2_disconnect << 1) |
+        ((uint8_t)in->bpps_faults.bpps1_out_range << 2) |
+        ((uint8_t)in->bpps_faults.bpps2_out_range << 3) |
+        ((uint8_t)in->bpps_faults.bpps_mismatch << 4));
+}
+
+// End Packet: Brake Pedal
+
+// Packet: BSE Voltages
+typedef struct {
+    float bse_front_voltage;
+    float bse_rear_voltage;
+    float bse_line_lock_voltage;
+} bse_voltages_t;
+
+static inline void bse_voltages_unpack(bse_voltages_t *out, const uint8_t *data) {
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->bse_front_voltage = (float)raw * 0.0001f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->bse_rear_voltage = (float)raw * 0.0001f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->bse_line_lock_voltage = (float)raw * 0.0001f;
+    }
+}
+
+static inline void bse_voltages_pack(const bse_voltages_t *in, uint8_t *data) {
+    {
+        float scaled = in->bse_front_voltage * 10000.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->bse_rear_voltage * 10000.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->bse_line_lock_voltage * 10000.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+}
+
+// bse_voltages_unpack_f32() vector layout
+enum {
+    BSE_VOLTAGES_F32_BSE_FRONT_VOLTAGE = 0,
+    BSE_VOLTAGES_F32_BSE_REAR_VOLTAGE = 1,
+    BSE_VOLTAGES_F32_BSE_LINE_LOCK_VOLTAGE = 2,
+    BSE_VOLTAGES_F32_COUNT = 3
+};
+
+static const float bse_voltages_f32_scale[BSE_VOLTAGES_F32_COUNT] = {
+    0.0001f,
+    0.0001f,
+    0.0001f,
+};
+
+static inline void bse_voltages_unpack_f32(float out[BSE_VOLTAGES_F32_COUNT], const uint8_t *data) {
+    can_batch_u16_to_f32(out + 0, data + 0, 3, bse_voltages_f32_scale + 0);
+}
+
+// End Packet: BSE Voltages
+
+// Packet: Brakes
+typedef struct {
+    float brake_pressure_front;
+    float brake_pressure_rear_pre_lock;
+    float brake_pressure_rear_post_lock;
+    float brake_bias;
+    struct {
+        bool bse1_disconnect;
+        bool bse2_disconnect;
+        bool bse1_out_range;
+        bool bse2_out_range;
+    } bse_faults;
+} brakes_t;
+
+static inline void brakes_unpack(brakes_t *out, const uint8_t *data) {
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->brake_pressure_front = (float)raw * 0.05f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->brake_pressure_rear_pre_lock = (float)raw * 0.05f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->brake_pressure_rear_post_lock = (float)raw * 0.05f;
+    }
+    {
+        uint8_t raw;
+        memcpy(&raw, data + 6, sizeof(raw));
+        out->brake_bias = (float)raw * 0.01f;
+    }
+    {
+        uint8_t bits = data[7];
+        out->bse_faults.bse1_disconnect = (bits >> 0) & 1U;
+        out->bse_faults.bse2_disconnect = (bits >> 1) & 1U;
+        out->bse_faults.bse1_out_range = (bits >> 2) & 1U;
+        out->bse_faults.bse2_out_range = (bits >> 3) & 1U;
+    }
+}
+
+static inline void brakes_pack(const brakes_t *in, uint8_t *data) {
+    {
+        float scaled = in->brake_pressure_front * 20.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->brake_pressure_rear_pre_lock * 20.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->brake_pressure_rear_post_lock * 20.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->brake_bias * 100.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 255.0f) scaled = 255.0f;
+        uint8_t raw = (uint8_t)(scaled + 0.5f);
+        memcpy(data + 6, &raw, sizeof(raw));
+    }
+    data[7] = (uint8_t)(
+        ((uint8_t)in->bse_faults.bse1_disconnect << 0) |
+        ((uint8_t)in->bse_faults.bse2_disconnect << 1) |
+        ((uint8_t)in->bse_faults.bse1_out_range << 2) |
+        ((uint8_t)in->bse_faults.bse2_out_range << 3));
+}
+
+// brakes_unpack_f32() vector layout
+enum {
+    BRAKES_F32_BRAKE_PRESSURE_FRONT = 0,
+    BRAKES_F32_BRAKE_PRESSURE_REAR_PRE_LOCK = 1,
+    BRAKES_F32_BRAKE_PRESSURE_REAR_POST_LOCK = 2,
+    BRAKES_F32_COUNT = 3
+};
+
+static const float brakes_f32_scale[BRAKES_F32_COUNT] = {
+    0.05f,
+    0.05f,
+    0.05f,
+};
+
+static inline void brakes_unpack_f32(float out[BRAKES_F32_COUNT], const uint8_t *data) {
+    can_batch_u16_to_f32(out + 0, data + 0, 3, brakes_f32_scale + 0);
+}
+
+// End Packet: Brakes
+
+// Packet: Rack Steering
+typedef struct {
+    float steering_column_angle;
+} rack_steering_t;
+
+static inline void rack_steering_unpack(rack_steering_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->steering_column_angle = (float)raw * 0.004f;
+    }
+}
+
+static inline void rack_steering_pack(const rack_steering_t *in, uint8_t *data) {
+    {
+        float scaled = in->steering_column_angle * 250.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+}
+
+// End Packet: Rack Steering
+
+// Packet: FL Steering
+typedef struct {
+    float fl_est_steering_angle;
+} fl_steering_t;
+
+static inline void fl_steering_unpack(fl_steering_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->fl_est_steering_angle = (float)raw * 0.001f;
+    }
+}
+
+static inline void fl_steering_pack(const fl_steering_t *in, uint8_t *data) {
+    {
+        float scaled = in->fl_est_steering_angle * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+}
+
+// End Packet: FL Steering
+
+// Packet: FR Steering
+typedef struct {
+    float fr_est_steering_angle;
+} fr_steering_t;
+
+static inline void fr_steering_unpack(fr_steering_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->fr_est_steering_angle = (float)raw * 0.001f;
+    }
+}
+
+static inline void fr_steering_pack(const fr_steering_t *in, uint8_t *data) {
+    {
+        float scaled = in->fr_est_steering_angle * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+}
+
+// End Packet: FR Steering
+
+// Packet: Acceleration Vector Unsprung FL
+typedef struct {
+    float x;
+    float y;
+    float z;
+} acceleration_vector_unsprung_fl_t;
+
+static inline void acceleration_vector_unsprung_fl_unpack(acceleration_vector_unsprung_fl_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->x = (float)raw * 0.001f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->y = (float)raw * 0.001f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->z = (float)raw * 0.001f;
+    }
+}
+
+static inline void acceleration_vector_unsprung_fl_pack(const acceleration_vector_unsprung_fl_t *in, uint8_t *data) {
+    {
+        float scaled = in->x * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->y * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->z * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+}
+
+// acceleration_vector_unsprung_fl_unpack_f32() vector layout
+enum {
+    ACCELERATION_VECTOR_UNSPRUNG_FL_F32_X = 0,
+    ACCELERATION_VECTOR_UNSPRUNG_FL_F32_Y = 1,
+    ACCELERATION_VECTOR_UNSPRUNG_FL_F32_Z = 2,
+    ACCELERATION_VECTOR_UNSPRUNG_FL_F32_COUNT = 3
+};
+
+static const float acceleration_vector_unsprung_fl_f32_scale[ACCELERATION_VECTOR_UNSPRUNG_FL_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.001f),
+    CAN_BATCH_SCALE(0.001f),
+    CAN_BATCH_SCALE(0.001f),
+};
+
+static inline void acceleration_vector_unsprung_fl_unpack_f32(float out[ACCELERATION_VECTOR_UNSPRUNG_FL_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 3, acceleration_vector_unsprung_fl_f32_scale + 0);
+}
+
+// End Packet: Acceleration Vector Unsprung FL
+
+// Packet: Acceleration Vector Unsprung FR
+typedef struct {
+    float x;
+    float y;
+    float z;
+} acceleration_vector_unsprung_fr_t;
+
+static inline void acceleration_vector_unsprung_fr_unpack(acceleration_vector_unsprung_fr_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->x = (float)raw * 0.001f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->y = (float)raw * 0.001f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->z = (float)raw * 0.001f;
+    }
+}
+
+static inline void acceleration_vector_unsprung_fr_pack(const acceleration_vector_unsprung_fr_t *in, uint8_t *data) {
+    {
+        float scaled = in->x * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->y * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->z * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+}
+
+// acceleration_vector_unsprung_fr_unpack_f32() vector layout
+enum {
+    ACCELERATION_VECTOR_UNSPRUNG_FR_F32_X = 0,
+    ACCELERATION_VECTOR_UNSPRUNG_FR_F32_Y = 1,
+    ACCELERATION_VECTOR_UNSPRUNG_FR_F32_Z = 2,
+    ACCELERATION_VECTOR_UNSPRUNG_FR_F32_COUNT = 3
+};
+
+static const float acceleration_vector_unsprung_fr_f32_scale[ACCELERATION_VECTOR_UNSPRUNG_FR_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.001f),
+    CAN_BATCH_SCALE(0.001f),
+    CAN_BATCH_SCALE(0.001f),
+};
+
+static inline void acceleration_vector_unsprung_fr_unpack_f32(float out[ACCELERATION_VECTOR_UNSPRUNG_FR_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 3, acceleration_vector_unsprung_fr_f32_scale + 0);
+}
+
+// End Packet: Acceleration Vector Unsprung FR
+
+// Packet: Acceleration Vector Unsprung RL
+typedef struct {
+    float x;
+    float y;
+    float z;
+} acceleration_vector_unsprung_rl_t;
+
+static inline void acceleration_vector_unsprung_rl_unpack(acceleration_vector_unsprung_rl_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->x = (float)raw * 0.001f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->y = (float)raw * 0.001f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->z = (float)raw * 0.001f;
+    }
+}
+
+static inline void acceleration_vector_unsprung_rl_pack(const acceleration_vector_unsprung_rl_t *in, uint8_t *data) {
+    {
+        float scaled = in->x * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->y * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->z * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+}
+
+// acceleration_vector_unsprung_rl_unpack_f32() vector layout
+enum {
+    ACCELERATION_VECTOR_UNSPRUNG_RL_F32_X = 0,
+    ACCELERATION_VECTOR_UNSPRUNG_RL_F32_Y = 1,
+    ACCELERATION_VECTOR_UNSPRUNG_RL_F32_Z = 2,
+    ACCELERATION_VECTOR_UNSPRUNG_RL_F32_COUNT = 3
+};
+
+static const float acceleration_vector_unsprung_rl_f32_scale[ACCELERATION_VECTOR_UNSPRUNG_RL_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.001f),
+    CAN_BATCH_SCALE(0.001f),
+    CAN_BATCH_SCALE(0.001f),
+};
+
+static inline void acceleration_vector_unsprung_rl_unpack_f32(float out[ACCELERATION_VECTOR_UNSPRUNG_RL_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 3, acceleration_vector_unsprung_rl_f32_scale + 0);
+}
+
+// End Packet: Acceleration Vector Unsprung RL
+
+// Packet: Acceleration Vector Unsprung RR
+typedef struct {
+    float x;
+    float y;
+    float z;
+} acceleration_vector_unsprung_rr_t;
+
+static inline void acceleration_vector_unsprung_rr_unpack(acceleration_vector_unsprung_rr_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->x = (float)raw * 0.001f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->y = (float)raw * 0.001f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->z = (float)raw * 0.001f;
+    }
+}
+
+static inline void acceleration_vector_unsprung_rr_pack(const acceleration_vector_unsprung_rr_t *in, uint8_t *data) {
+    {
+        float scaled = in->x * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->y * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->z * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+}
+
+// acceleration_vector_unsprung_rr_unpack_f32() vector layout
+enum {
+    ACCELERATION_VECTOR_UNSPRUNG_RR_F32_X = 0,
+    ACCELERATION_VECTOR_UNSPRUNG_RR_F32_Y = 1,
+    ACCELERATION_VECTOR_UNSPRUNG_RR_F32_Z = 2,
+    ACCELERATION_VECTOR_UNSPRUNG_RR_F32_COUNT = 3
+};
+
+static const float acceleration_vector_unsprung_rr_f32_scale[ACCELERATION_VECTOR_UNSPRUNG_RR_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.001f),
+    CAN_BATCH_SCALE(0.001f),
+    CAN_BATCH_SCALE(0.001f),
+};
+
+static inline void acceleration_vector_unsprung_rr_unpack_f32(float out[ACCELERATION_VECTOR_UNSPRUNG_RR_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 3, acceleration_vector_unsprung_rr_f32_scale + 0);
+}
+
+// End Packet: Acceleration Vector Unsprung RR
+
+// Packet: Acceleration Vector Sprung + Ride Height FL
+typedef struct {
+    float x;
+    float y;
+    float z;
+    float ride_height;
+} acceleration_vector_sprung_ride_height_fl_t;
+
+static inline void acceleration_vector_sprung_ride_height_fl_unpack(acceleration_vector_sprung_ride_height_fl_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->x = (float)raw * 0.001f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->y = (float)raw * 0.001f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->z = (float)raw * 0.001f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 6, sizeof(raw));
+        out->ride_height = (float)raw * 0.002f;
+    }
+}
+
+static inline void acceleration_vector_sprung_ride_height_fl_pack(const acceleration_vector_sprung_ride_height_fl_t *in, uint8_t *data) {
+    {
+        float scaled = in->x * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->y * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->z * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->ride_height * 500.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 6, &raw, sizeof(raw));
+    }
+}
+
+// acceleration_vector_sprung_ride_height_fl_unpack_f32() vector layout
+enum {
+    ACCELERATION_VECTOR_SPRUNG_RIDE_HEIGHT_FL_F32_X = 0,
+    ACCELERATION_VECTOR_SPRUNG_RIDE_HEIGHT_FL_F32_Y = 1,
+    ACCELERATION_VECTOR_SPRUNG_RIDE_HEIGHT_FL_F32_Z = 2,
+    ACCELERATION_VECTOR_SPRUNG_RIDE_HEIGHT_FL_F32_RIDE_HEIGHT = 3,
+    ACCELERATION_VECTOR_SPRUNG_RIDE_HEIGHT_FL_F32_COUNT = 4
+};
+
+static const float acceleration_vector_sprung_ride_height_fl_f32_scale[ACCELERATION_VECTOR_SPRUNG_RIDE_HEIGHT_FL_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.001f),
+    CAN_BATCH_SCALE(0.001f),
+    CAN_BATCH_SCALE(0.001f),
+    0.002f,
+};
+
+static inline void acceleration_vector_sprung_ride_height_fl_unpack_f32(float out[ACCELERATION_VECTOR_SPRUNG_RIDE_HEIGHT_FL_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 3, acceleration_vector_sprung_ride_height_fl_f32_scale + 0);
+    can_batch_u16_to_f32(out + 3, data + 6, 1, acceleration_vector_sprung_ride_height_fl_f32_scale + 3);
+}
+
+// End Packet: Acceleration Vector Sprung + Ride Height FL
+
+// Packet: Acceleration Vector Sprung + Ride Height FR
+typedef struct {
+    float x;
+    float y;
+    float z;
+    float ride_height;
+} acceleration_vector_sprung_ride_height_fr_t;
+
+static inline void acceleration_vector_sprung_ride_height_fr_unpack(acceleration_vector_sprung_ride_height_fr_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->x = (float)raw * 0.001f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->y = (float)raw * 0.001f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->z = (float)raw * 0.001f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 6, sizeof(raw));
+        out->ride_height = (float)raw * 0.002f;
+    }
+}
+
+static inline void acceleration_vector_sprung_ride_height_fr_pack(const acceleration_vector_sprung_ride_height_fr_t *in, uint8_t *data) {
+    {
+        float scaled = in->x * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->y * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->z * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->ride_height * 500.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 6, &raw, sizeof(raw));
+    }
+}
+
+// acceleration_vector_sprung_ride_height_fr_unpack_f32() vector layout
+enum {
+    ACCELERATION_VECTOR_SPRUNG_RIDE_HEIGHT_FR_F32_X = 0,
+    ACCELERATION_VECTOR_SPRUNG_RIDE_HEIGHT_FR_F32_Y = 1,
+    ACCELERATION_VECTOR_SPRUNG_RIDE_HEIGHT_FR_F32_Z = 2,
+    ACCELERATION_VECTOR_SPRUNG_RIDE_HEIGHT_FR_F32_RIDE_HEIGHT = 3,
+    ACCELERATION_VECTOR_SPRUNG_RIDE_HEIGHT_FR_F32_COUNT = 4
+};
+
+static const float acceleration_vector_sprung_ride_height_fr_f32_scale[ACCELERATION_VECTOR_SPRUNG_RIDE_HEIGHT_FR_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.001f),
+    CAN_BATCH_SCALE(0.001f),
+    CAN_BATCH_SCALE(0.001f),
+    0.002f,
+};
+
+static inline void acceleration_vector_sprung_ride_height_fr_unpack_f32(float out[ACCELERATION_VECTOR_SPRUNG_RIDE_HEIGHT_FR_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 3, acceleration_vector_sprung_ride_height_fr_f32_scale + 0);
+    can_batch_u16_to_f32(out + 3, data + 6, 1, acceleration_vector_sprung_ride_height_fr_f32_scale + 3);
+}
+
+// End Packet: Acceleration Vector Sprung + Ride Height FR
+
+// Packet: Acceleration Vector Sprung + Ride Height RL
+typedef struct {
+    float x;
+    float y;
+    float z;
+    float ride_height;
+} acceleration_vector_sprung_ride_height_rl_t;
+
+static inline void acceleration_vector_sprung_ride_height_rl_unpack(acceleration_vector_sprung_ride_height_rl_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->x = (float)raw * 0.001f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->y = (float)raw * 0.001f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->z = (float)raw * 0.001f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 6, sizeof(raw));
+        out->ride_height = (float)raw * 0.002f;
+    }
+}
+
+static inline void acceleration_vector_sprung_ride_height_rl_pack(const acceleration_vector_sprung_ride_height_rl_t *in, uint8_t *data) {
+    {
+        float scaled = in->x * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->y * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->z * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->ride_height * 500.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 6, &raw, sizeof(raw));
+    }
+}
+
+// acceleration_vector_sprung_ride_height_rl_unpack_f32() vector layout
+enum {
+    ACCELERATION_VECTOR_SPRUNG_RIDE_HEIGHT_RL_F32_X = 0,
+    ACCELERATION_VECTOR_SPRUNG_RIDE_HEIGHT_RL_F32_Y = 1,
+    ACCELERATION_VECTOR_SPRUNG_RIDE_HEIGHT_RL_F32_Z = 2,
+    ACCELERATION_VECTOR_SPRUNG_RIDE_HEIGHT_RL_F32_RIDE_HEIGHT = 3,
+    ACCELERATION_VECTOR_SPRUNG_RIDE_HEIGHT_RL_F32_COUNT = 4
+};
+
+static const float acceleration_vector_sprung_ride_height_rl_f32_scale[ACCELERATION_VECTOR_SPRUNG_RIDE_HEIGHT_RL_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.001f),
+    CAN_BATCH_SCALE(0.001f),
+    CAN_BATCH_SCALE(0.001f),
+    0.002f,
+};
+
+static inline void acceleration_vector_sprung_ride_height_rl_unpack_f32(float out[ACCELERATION_VECTOR_SPRUNG_RIDE_HEIGHT_RL_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 3, acceleration_vector_sprung_ride_height_rl_f32_scale + 0);
+    can_batch_u16_to_f32(out + 3, data + 6, 1, acceleration_vector_sprung_ride_height_rl_f32_scale + 3);
+}
+
+// End Packet: Acceleration Vector Sprung + Ride Height RL
+
+// Packet: Acceleration Vector Sprung + Ride Height RR
+typedef struct {
+    float x;
+    float y;
+    float z;
+    float ride_height;
+} acceleration_vector_sprung_ride_height_rr_t;
+
+static inline void acceleration_vector_sprung_ride_height_rr_unpack(acceleration_vector_sprung_ride_height_rr_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->x = (float)raw * 0.001f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->y = (float)raw * 0.001f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->z = (float)raw * 0.001f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 6, sizeof(raw));
+        out->ride_height = (float)raw * 0.002f;
+    }
+}
+
+static inline void acceleration_vector_sprung_ride_height_rr_pack(const acceleration_vector_sprung_ride_height_rr_t *in, uint8_t *data) {
+    {
+        float scaled = in->x * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->y * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->z * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->ride_height * 500.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 6, &raw, sizeof(raw));
+    }
+}
+
+// acceleration_vector_sprung_ride_height_rr_unpack_f32() vector layout
+enum {
+    ACCELERATION_VECTOR_SPRUNG_RIDE_HEIGHT_RR_F32_X = 0,
+    ACCELERATION_VECTOR_SPRUNG_RIDE_HEIGHT_RR_F32_Y = 1,
+    ACCELERATION_VECTOR_SPRUNG_RIDE_HEIGHT_RR_F32_Z = 2,
+    ACCELERATION_VECTOR_SPRUNG_RIDE_HEIGHT_RR_F32_RIDE_HEIGHT = 3,
+    ACCELERATION_VECTOR_SPRUNG_RIDE_HEIGHT_RR_F32_COUNT = 4
+};
+
+static const float acceleration_vector_sprung_ride_height_rr_f32_scale[ACCELERATION_VECTOR_SPRUNG_RIDE_HEIGHT_RR_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.001f),
+    CAN_BATCH_SCALE(0.001f),
+    CAN_BATCH_SCALE(0.001f),
+    0.002f,
+};
+
+static inline void acceleration_vector_sprung_ride_height_rr_unpack_f32(float out[ACCELERATION_VECTOR_SPRUNG_RIDE_HEIGHT_RR_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 3, acceleration_vector_sprung_ride_height_rr_f32_scale + 0);
+    can_batch_u16_to_f32(out + 3, data + 6, 1, acceleration_vector_sprung_ride_height_rr_f32_scale + 3);
+}
+
+// End Packet: Acceleration Vector Sprung + Ride Height RR
+
+// Packet: Angular Rate Vector FL Sprung
+typedef struct {
+    float x;
+    float y;
+    float z;
+} angular_rate_vector_fl_sprung_t;
+
+static inline void angular_rate_vector_fl_sprung_unpack(angular_rate_vector_fl_sprung_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->x = (float)raw * 0.03f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->y = (float)raw * 0.03f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->z = (float)raw * 0.03f;
+    }
+}
+
+static inline void angular_rate_vector_fl_sprung_pack(const angular_rate_vector_fl_sprung_t *in, uint8_t *data) {
+    {
+        float scaled = in->x * 33.333333333333336f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->y * 33.333333333333336f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->z * 33.333333333333336f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+}
+
+// angular_rate_vector_fl_sprung_unpack_f32() vector layout
+enum {
+    ANGULAR_RATE_VECTOR_FL_SPRUNG_F32_X = 0,
+    ANGULAR_RATE_VECTOR_FL_SPRUNG_F32_Y = 1,
+    ANGULAR_RATE_VECTOR_FL_SPRUNG_F32_Z = 2,
+    ANGULAR_RATE_VECTOR_FL_SPRUNG_F32_COUNT = 3
+};
+
+static const float angular_rate_vector_fl_sprung_f32_scale[ANGULAR_RATE_VECTOR_FL_SPRUNG_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.03f),
+    CAN_BATCH_SCALE(0.03f),
+    CAN_BATCH_SCALE(0.03f),
+};
+
+static inline void angular_rate_vector_fl_sprung_unpack_f32(float out[ANGULAR_RATE_VECTOR_FL_SPRUNG_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 3, angular_rate_vector_fl_sprung_f32_scale + 0);
+}
+
+// End Packet: Angular Rate Vector FL Sprung
+
+// Packet: Angular Rate Vector FR Sprung
+typedef struct {
+    float x;
+    float y;
+    float z;
+} angular_rate_vector_fr_sprung_t;
+
+static inline void angular_rate_vector_fr_sprung_unpack(angular_rate_vector_fr_sprung_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->x = (float)raw * 0.03f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->y = (float)raw * 0.03f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->z = (float)raw * 0.03f;
+    }
+}
+
+static inline void angular_rate_vector_fr_sprung_pack(const angular_rate_vector_fr_sprung_t *in, uint8_t *data) {
+    {
+        float scaled = in->x * 33.333333333333336f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->y * 33.333333333333336f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->z * 33.333333333333336f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+}
+
+// angular_rate_vector_fr_sprung_unpack_f32() vector layout
+enum {
+    ANGULAR_RATE_VECTOR_FR_SPRUNG_F32_X = 0,
+    ANGULAR_RATE_VECTOR_FR_SPRUNG_F32_Y = 1,
+    ANGULAR_RATE_VECTOR_FR_SPRUNG_F32_Z = 2,
+    ANGULAR_RATE_VECTOR_FR_SPRUNG_F32_COUNT = 3
+};
+
+static const float angular_rate_vector_fr_sprung_f32_scale[ANGULAR_RATE_VECTOR_FR_SPRUNG_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.03f),
+    CAN_BATCH_SCALE(0.03f),
+    CAN_BATCH_SCALE(0.03f),
+};
+
+static inline void angular_rate_vector_fr_sprung_unpack_f32(float out[ANGULAR_RATE_VECTOR_FR_SPRUNG_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 3, angular_rate_vector_fr_sprung_f32_scale + 0);
+}
+
+// End Packet: Angular Rate Vector FR Sprung
+
+// Packet: Angular Rate Vector BL Sprung
+typedef struct {
+    float x;
+    float y;
+    float z;
+} angular_rate_vector_bl_sprung_t;
+
+static inline void angular_rate_vector_bl_sprung_unpack(angular_rate_vector_bl_sprung_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->x = (float)raw * 0.03f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->y = (float)raw * 0.03f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->z = (float)raw * 0.03f;
+    }
+}
+
+static inline void angular_rate_vector_bl_sprung_pack(const angular_rate_vector_bl_sprung_t *in, uint8_t *data) {
+    {
+        float scaled = in->x * 33.333333333333336f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->y * 33.333333333333336f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->z * 33.333333333333336f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+}
+
+// angular_rate_vector_bl_sprung_unpack_f32() vector layout
+enum {
+    ANGULAR_RATE_VECTOR_BL_SPRUNG_F32_X = 0,
+    ANGULAR_RATE_VECTOR_BL_SPRUNG_F32_Y = 1,
+    ANGULAR_RATE_VECTOR_BL_SPRUNG_F32_Z = 2,
+    ANGULAR_RATE_VECTOR_BL_SPRUNG_F32_COUNT = 3
+};
+
+static const float angular_rate_vector_bl_sprung_f32_scale[ANGULAR_RATE_VECTOR_BL_SPRUNG_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.03f),
+    CAN_BATCH_SCALE(0.03f),
+    CAN_BATCH_SCALE(0.03f),
+};
+
+static inline void angular_rate_vector_bl_sprung_unpack_f32(float out[ANGULAR_RATE_VECTOR_BL_SPRUNG_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 3, angular_rate_vector_bl_sprung_f32_scale + 0);
+}
+
+// End Packet: Angular Rate Vector BL Sprung
+
+// Packet: Angular Rate Vector BR Sprung
+typedef struct {
+    float x;
+    float y;
+    float z;
+} angular_rate_vector_br_sprung_t;
+
+static inline void angular_rate_vector_br_sprung_unpack(angular_rate_vector_br_sprung_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->x = (float)raw * 0.03f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->y = (float)raw * 0.03f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->z = (float)raw * 0.03f;
+    }
+}
+
+static inline void angular_rate_vector_br_sprung_pack(const angular_rate_vector_br_sprung_t *in, uint8_t *data) {
+    {
+        float scaled = in->x * 33.333333333333336f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->y * 33.333333333333336f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->z * 33.333333333333336f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+}
+
+// angular_rate_vector_br_sprung_unpack_f32() vector layout
+enum {
+    ANGULAR_RATE_VECTOR_BR_SPRUNG_F32_X = 0,
+    ANGULAR_RATE_VECTOR_BR_SPRUNG_F32_Y = 1,
+    ANGULAR_RATE_VECTOR_BR_SPRUNG_F32_Z = 2,
+    ANGULAR_RATE_VECTOR_BR_SPRUNG_F32_COUNT = 3
+};
+
+static const float angular_rate_vector_br_sprung_f32_scale[ANGULAR_RATE_VECTOR_BR_SPRUNG_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.03f),
+    CAN_BATCH_SCALE(0.03f),
+    CAN_BATCH_SCALE(0.03f),
+};
+
+static inline void angular_rate_vector_br_sprung_unpack_f32(float out[ANGULAR_RATE_VECTOR_BR_SPRUNG_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 3, angular_rate_vector_br_sprung_f32_scale + 0);
+}
+
+// End Packet: Angular Rate Vector BR Sprung
+
+// Packet: Wheel Speed + Strain Gauge + Pushrod + Spring Disp. FL
+typedef struct {
+    float speed;
+    float strain_gauge_voltage;
+    float pushrod;
+    float spring_displacement;
+} wheel_speed_strain_gauge_pushrod_spring_disp_fl_t;
+
+static inline void wheel_speed_strain_gauge_pushrod_spring_disp_fl_unpack(wheel_speed_strain_gauge_pushrod_spring_disp_fl_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->speed = (float)raw * 0.01f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->strain_gauge_voltage = (float)raw * 0.0002f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->pushrod = (float)raw * 0.5f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 6, sizeof(raw));
+        out->spring_displacement = (float)raw * 0.001f;
+    }
+}
+
+static inline void wheel_speed_strain_gauge_pushrod_spring_disp_fl_pack(const wheel_speed_strain_gauge_pushrod_spring_disp_fl_t *in, uint8_t *data) {
+    {
+        float scaled = in->speed * 100.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->strain_gauge_voltage * 5000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->pushrod * 2.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->spring_displacement * 1000.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 6, &raw, sizeof(raw));
+    }
+}
+
+// wheel_speed_strain_gauge_pushrod_spring_disp_fl_unpack_f32() vector layout
+enum {
+    WHEEL_SPEED_STRAIN_GAUGE_PUSHROD_SPRING_DISP_FL_F32_SPEED = 0,
+    WHEEL_SPEED_STRAIN_GAUGE_PUSHROD_SPRING_DISP_FL_F32_STRAIN_GAUGE_VOLTAGE = 1,
+    WHEEL_SPEED_STRAIN_GAUGE_PUSHROD_SPRING_DISP_FL_F32_PUSHROD = 2,
+    WHEEL_SPEED_STRAIN_GAUGE_PUSHROD_SPRING_DISP_FL_F32_SPRING_DISPLACEMENT = 3,
+    WHEEL_SPEED_STRAIN_GAUGE_PUSHROD_SPRING_DISP_FL_F32_COUNT = 4
+};
+
+static const float wheel_speed_strain_gauge_pushrod_spring_disp_fl_f32_scale[WHEEL_SPEED_STRAIN_GAUGE_PUSHROD_SPRING_DISP_FL_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.01f),
+    CAN_BATCH_SCALE(0.0002f),
+    CAN_BATCH_SCALE(0.5f),
+    0.001f,
+};
+
+static inline void wheel_speed_strain_gauge_pushrod_spring_disp_fl_unpack_f32(float out[WHEEL_SPEED_STRAIN_GAUGE_PUSHROD_SPRING_DISP_FL_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 3, wheel_speed_strain_gauge_pushrod_spring_disp_fl_f32_scale + 0);
+    can_batch_u16_to_f32(out + 3, data + 6, 1, wheel_speed_strain_gauge_pushrod_spring_disp_fl_f32_scale + 3);
+}
+
+// End Packet: Wheel Speed + Strain Gauge + Pushrod + Spring Disp. FL
+
+// Packet: Wheel Speed + Strain Gauge + Pushrod + Spring Disp. FR
+typedef struct {
+    float speed;
+    float strain_gauge_voltage;
+    float pushrod;
+    float spring_displacement;
+} wheel_speed_strain_gauge_pushrod_spring_disp_fr_t;
+
+static inline void wheel_speed_strain_gauge_pushrod_spring_disp_fr_unpack(wheel_speed_strain_gauge_pushrod_spring_disp_fr_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->speed = (float)raw * 0.01f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->strain_gauge_voltage = (float)raw * 0.0002f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->pushrod = (float)raw * 0.5f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 6, sizeof(raw));
+        out->spring_displacement = (float)raw * 0.001f;
+    }
+}
+
+static inline void wheel_speed_strain_gauge_pushrod_spring_disp_fr_pack(const wheel_speed_strain_gauge_pushrod_spring_disp_fr_t *in, uint8_t *data) {
+    {
+        float scaled = in->speed * 100.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->strain_gauge_voltage * 5000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->pushrod * 2.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->spring_displacement * 1000.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 6, &raw, sizeof(raw));
+    }
+}
+
+// wheel_speed_strain_gauge_pushrod_spring_disp_fr_unpack_f32() vector layout
+enum {
+    WHEEL_SPEED_STRAIN_GAUGE_PUSHROD_SPRING_DISP_FR_F32_SPEED = 0,
+    WHEEL_SPEED_STRAIN_GAUGE_PUSHROD_SPRING_DISP_FR_F32_STRAIN_GAUGE_VOLTAGE = 1,
+    WHEEL_SPEED_STRAIN_GAUGE_PUSHROD_SPRING_DISP_FR_F32_PUSHROD = 2,
+    WHEEL_SPEED_STRAIN_GAUGE_PUSHROD_SPRING_DISP_FR_F32_SPRING_DISPLACEMENT = 3,
+    WHEEL_SPEED_STRAIN_GAUGE_PUSHROD_SPRING_DISP_FR_F32_COUNT = 4
+};
+
+static const float wheel_speed_strain_gauge_pushrod_spring_disp_fr_f32_scale[WHEEL_SPEED_STRAIN_GAUGE_PUSHROD_SPRING_DISP_FR_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.01f),
+    CAN_BATCH_SCALE(0.0002f),
+    CAN_BATCH_SCALE(0.5f),
+    0.001f,
+};
+
+static inline void wheel_speed_strain_gauge_pushrod_spring_disp_fr_unpack_f32(float out[WHEEL_SPEED_STRAIN_GAUGE_PUSHROD_SPRING_DISP_FR_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 3, wheel_speed_strain_gauge_pushrod_spring_disp_fr_f32_scale + 0);
+    can_batch_u16_to_f32(out + 3, data + 6, 1, wheel_speed_strain_gauge_pushrod_spring_disp_fr_f32_scale + 3);
+}
+
+// End Packet: Wheel Speed + Strain Gauge + Pushrod + Spring Disp. FR
+
+// Packet: Wheel Speed + Strain Gauge + Pushrod + Spring Disp. RL
+typedef struct {
+    float speed;
+    float strain_gauge_voltage;
+    float pushrod;
+    float spring_displacement;
+} wheel_speed_strain_gauge_pushrod_spring_disp_rl_t;
+
+static inline void wheel_speed_strain_gauge_pushrod_spring_disp_rl_unpack(wheel_speed_strain_gauge_pushrod_spring_disp_rl_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->speed = (float)raw * 0.01f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->strain_gauge_voltage = (float)raw * 0.0002f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->pushrod = (float)raw * 0.5f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 6, sizeof(raw));
+        out->spring_displacement = (float)raw * 0.001f;
+    }
+}
+
+static inline void wheel_speed_strain_gauge_pushrod_spring_disp_rl_pack(const wheel_speed_strain_gauge_pushrod_spring_disp_rl_t *in, uint8_t *data) {
+    {
+        float scaled = in->speed * 100.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->strain_gauge_voltage * 5000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->pushrod * 2.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->spring_displacement * 1000.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 6, &raw, sizeof(raw));
+    }
+}
+
+// wheel_speed_strain_gauge_pushrod_spring_disp_rl_unpack_f32() vector layout
+enum {
+    WHEEL_SPEED_STRAIN_GAUGE_PUSHROD_SPRING_DISP_RL_F32_SPEED = 0,
+    WHEEL_SPEED_STRAIN_GAUGE_PUSHROD_SPRING_DISP_RL_F32_STRAIN_GAUGE_VOLTAGE = 1,
+    WHEEL_SPEED_STRAIN_GAUGE_PUSHROD_SPRING_DISP_RL_F32_PUSHROD = 2,
+    WHEEL_SPEED_STRAIN_GAUGE_PUSHROD_SPRING_DISP_RL_F32_SPRING_DISPLACEMENT = 3,
+    WHEEL_SPEED_STRAIN_GAUGE_PUSHROD_SPRING_DISP_RL_F32_COUNT = 4
+};
+
+static const float wheel_speed_strain_gauge_pushrod_spring_disp_rl_f32_scale[WHEEL_SPEED_STRAIN_GAUGE_PUSHROD_SPRING_DISP_RL_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.01f),
+    CAN_BATCH_SCALE(0.0002f),
+    CAN_BATCH_SCALE(0.5f),
+    0.001f,
+};
+
+static inline void wheel_speed_strain_gauge_pushrod_spring_disp_rl_unpack_f32(float out[WHEEL_SPEED_STRAIN_GAUGE_PUSHROD_SPRING_DISP_RL_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 3, wheel_speed_strain_gauge_pushrod_spring_disp_rl_f32_scale + 0);
+    can_batch_u16_to_f32(out + 3, data + 6, 1, wheel_speed_strain_gauge_pushrod_spring_disp_rl_f32_scale + 3);
+}
+
+// End Packet: Wheel Speed + Strain Gauge + Pushrod + Spring Disp. RL
+
+// Packet: Wheel Speed + Strain Gauge + Pushrod + Spring Disp. RR
+typedef struct {
+    float speed;
+    float strain_gauge_voltage;
+    float pushrod;
+    float spring_displacement;
+} wheel_speed_strain_gauge_pushrod_spring_disp_rr_t;
+
+static inline void wheel_speed_strain_gauge_pushrod_spring_disp_rr_unpack(wheel_speed_strain_gauge_pushrod_spring_disp_rr_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->speed = (float)raw * 0.01f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->strain_gauge_voltage = (float)raw * 0.0002f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->pushrod = (float)raw * 0.5f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 6, sizeof(raw));
+        out->spring_displacement = (float)raw * 0.001f;
+    }
+}
+
+static inline void wheel_speed_strain_gauge_pushrod_spring_disp_rr_pack(const wheel_speed_strain_gauge_pushrod_spring_disp_rr_t *in, uint8_t *data) {
+    {
+        float scaled = in->speed * 100.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->strain_gauge_voltage * 5000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->pushrod * 2.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->spring_displacement * 1000.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 6, &raw, sizeof(raw));
+    }
+}
+
+// wheel_speed_strain_gauge_pushrod_spring_disp_rr_unpack_f32() vector layout
+enum {
+    WHEEL_SPEED_STRAIN_GAUGE_PUSHROD_SPRING_DISP_RR_F32_SPEED = 0,
+    WHEEL_SPEED_STRAIN_GAUGE_PUSHROD_SPRING_DISP_RR_F32_STRAIN_GAUGE_VOLTAGE = 1,
+    WHEEL_SPEED_STRAIN_GAUGE_PUSHROD_SPRING_DISP_RR_F32_PUSHROD = 2,
+    WHEEL_SPEED_STRAIN_GAUGE_PUSHROD_SPRING_DISP_RR_F32_SPRING_DISPLACEMENT = 3,
+    WHEEL_SPEED_STRAIN_GAUGE_PUSHROD_SPRING_DISP_RR_F32_COUNT = 4
+};
+
+static const float wheel_speed_strain_gauge_pushrod_spring_disp_rr_f32_scale[WHEEL_SPEED_STRAIN_GAUGE_PUSHROD_SPRING_DISP_RR_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.01f),
+    CAN_BATCH_SCALE(0.0002f),
+    CAN_BATCH_SCALE(0.5f),
+    0.001f,
+};
+
+static inline void wheel_speed_strain_gauge_pushrod_spring_disp_rr_unpack_f32(float out[WHEEL_SPEED_STRAIN_GAUGE_PUSHROD_SPRING_DISP_RR_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 3, wheel_speed_strain_gauge_pushrod_spring_disp_rr_f32_scale + 0);
+    can_batch_u16_to_f32(out + 3, data + 6, 1, wheel_speed_strain_gauge_pushrod_spring_disp_rr_f32_scale + 3);
+}
+
+// End Packet: Wheel Speed + Strain Gauge + Pushrod + Spring Disp. RR
+
+// Packet: GPS
+typedef struct {
+    float rear_longitude;
+    float rear_latitude;
+    float rear_speed;
+    float rear_heading;
+} gps_t;
+
+static inline void gps_unpack(gps_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->rear_longitude = (float)raw * 0.001f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->rear_latitude = (float)raw * 0.001f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->rear_speed = (float)raw * 0.001f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 6, sizeof(raw));
+        out->rear_heading = (float)raw * 0.001f;
+    }
+}
+
+static inline void gps_pack(const gps_t *in, uint8_t *data) {
+    {
+        float scaled = in->rear_longitude * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->rear_latitude * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->rear_speed * 1000.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->rear_heading * 1000.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 6, &raw, sizeof(raw));
+    }
+}
+
+// gps_unpack_f32() vector layout
+enum {
+    GPS_F32_REAR_LONGITUDE = 0,
+    GPS_F32_REAR_LATITUDE = 1,
+    GPS_F32_REAR_SPEED = 2,
+    GPS_F32_REAR_HEADING = 3,
+    GPS_F32_COUNT = 4
+};
+
+static const float gps_f32_scale[GPS_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.001f),
+    CAN_BATCH_SCALE(0.001f),
+    0.001f,
+    0.001f,
+};
+
+static inline void gps_unpack_f32(float out[GPS_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 2, gps_f32_scale + 0);
+    can_batch_u16_to_f32(out + 2, data + 4, 2, gps_f32_scale + 2);
+}
+
+// End Packet: GPS
+
+// Packet: Motor Cooling
+typedef struct {
+    float loop_temp_after_motor;
+    float loop_temp_after_inverter;
+    float temp_after_radiator;
+    float radiator_fan_speed;
+} motor_cooling_t;
+
+static inline void motor_cooling_unpack(motor_cooling_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->loop_temp_after_motor = (float)raw * 0.01f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->loop_temp_after_inverter = (float)raw * 0.01f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->temp_after_radiator = (float)raw * 0.01f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 6, sizeof(raw));
+        out->radiator_fan_speed = (float)raw * 0.2f;
+    }
+}
+
+static inline void motor_cooling_pack(const motor_cooling_t *in, uint8_t *data) {
+    {
+        float scaled = in->loop_temp_after_motor * 100.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->loop_temp_after_inverter * 100.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->temp_after_radiator * 100.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->radiator_fan_speed * 5.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 6, &raw, sizeof(raw));
+    }
+}
+
+// motor_cooling_unpack_f32() vector layout
+enum {
+    MOTOR_COOLING_F32_LOOP_TEMP_AFTER_MOTOR = 0,
+    MOTOR_COOLING_F32_LOOP_TEMP_AFTER_INVERTER = 1,
+    MOTOR_COOLING_F32_TEMP_AFTER_RADIATOR = 2,
+    MOTOR_COOLING_F32_RADIATOR_FAN_SPEED = 3,
+    MOTOR_COOLING_F32_COUNT = 4
+};
+
+static const float motor_cooling_f32_scale[MOTOR_COOLING_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.01f),
+    CAN_BATCH_SCALE(0.01f),
+    CAN_BATCH_SCALE(0.01f),
+    0.2f,
+};
+
+static inline void motor_cooling_unpack_f32(float out[MOTOR_COOLING_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 3, motor_cooling_f32_scale + 0);
+    can_batch_u16_to_f32(out + 3, data + 6, 1, motor_cooling_f32_scale + 3);
+}
+
+// End Packet: Motor Cooling
+
+// Packet: Battery Cooling
+typedef struct {
+    float temp_after_battery;
+    float temp_after_radiator;
+    float radiator_fan_speed;
+} battery_cooling_t;
+
+static inline void battery_cooling_unpack(battery_cooling_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->temp_after_battery = (float)raw * 0.01f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->temp_after_radiator = (float)raw * 0.01f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->radiator_fan_speed = (float)raw * 0.2f;
+    }
+}
+
+static inline void battery_cooling_pack(const battery_cooling_t *in, uint8_t *data) {
+    {
+        float scaled = in->temp_after_battery * 100.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->temp_after_radiator * 100.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->radiator_fan_speed * 5.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+}
+
+// battery_cooling_unpack_f32() vector layout
+enum {
+    BATTERY_COOLING_F32_TEMP_AFTER_BATTERY = 0,
+    BATTERY_COOLING_F32_TEMP_AFTER_RADIATOR = 1,
+    BATTERY_COOLING_F32_RADIATOR_FAN_SPEED = 2,
+    BATTERY_COOLING_F32_COUNT = 3
+};
+
+static const float battery_cooling_f32_scale[BATTERY_COOLING_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.01f),
+    CAN_BATCH_SCALE(0.01f),
+    0.2f,
+};
+
+static inline void battery_cooling_unpack_f32(float out[BATTERY_COOLING_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 2, battery_cooling_f32_scale + 0);
+    can_batch_u16_to_f32(out + 2, data + 4, 1, battery_cooling_f32_scale + 2);
+}
+
+// End Packet: Battery Cooling
+
+// Packet: Temps
+typedef struct {
+    float inverter;
+    float motor;
+    float ambient;
+    float discharge_resistor_temp;
+} temps_t;
+
+static inline void temps_unpack(temps_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->inverter = (float)raw * 0.01f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->motor = (float)raw * 0.01f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->ambient = (float)raw * 0.01f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 6, sizeof(raw));
+        out->discharge_resistor_temp = (float)raw * 0.01f;
+    }
+}
+
+static inline void temps_pack(const temps_t *in, uint8_t *data) {
+    {
+        float scaled = in->inverter * 100.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->motor * 100.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->ambient * 100.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->discharge_resistor_temp * 100.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 6, &raw, sizeof(raw));
+    }
+}
+
+// temps_unpack_f32() vector layout
+enum {
+    TEMPS_F32_INVERTER = 0,
+    TEMPS_F32_MOTOR = 1,
+    TEMPS_F32_AMBIENT = 2,
+    TEMPS_F32_DISCHARGE_RESISTOR_TEMP = 3,
+    TEMPS_F32_COUNT = 4
+};
+
+static const float temps_f32_scale[TEMPS_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.01f),
+    CAN_BATCH_SCALE(0.01f),
+    CAN_BATCH_SCALE(0.01f),
+    CAN_BATCH_SCALE(0.01f),
+};
+
+static inline void temps_unpack_f32(float out[TEMPS_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 4, temps_f32_scale + 0);
+}
+
+// End Packet: Temps
+
+// Packet: Battery Pack Status
+typedef struct {
+    float pack_voltage;
+    float tractive_current;
+    float state_of_charge;
+    uint8_t cell_top_temp;
+    uint8_t cell_bottom_temp;
+} battery_pack_status_t;
+
+static inline void battery_pack_status_unpack(battery_pack_status_t *out, const uint8_t *data) {
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->pack_voltage = (float)raw * 0.01f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->tractive_current = (float)raw * 0.01f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->state_of_charge = (float)raw * 0.01f;
+    }
+    memcpy(&out->cell_top_temp, data + 6, sizeof(out->cell_top_temp));
+    memcpy(&out->cell_bottom_temp, data + 7, sizeof(out->cell_bottom_temp));
+}
+
+static inline void battery_pack_status_pack(const battery_pack_status_t *in, uint8_t *data) {
+    {
+        float scaled = in->pack_voltage * 100.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->tractive_current * 100.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->state_of_charge * 100.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+    memcpy(data + 6, &in->cell_top_temp, sizeof(in->cell_top_temp));
+    memcpy(data + 7, &in->cell_bottom_temp, sizeof(in->cell_bottom_temp));
+}
+
+// battery_pack_status_unpack_f32() vector layout
+enum {
+    BATTERY_PACK_STATUS_F32_PACK_VOLTAGE = 0,
+    BATTERY_PACK_STATUS_F32_TRACTIVE_CURRENT = 1,
+    BATTERY_PACK_STATUS_F32_STATE_OF_CHARGE = 2,
+    BATTERY_PACK_STATUS_F32_COUNT = 3
+};
+
+static const float battery_pack_status_f32_scale[BATTERY_PACK_STATUS_F32_COUNT] = {
+    0.01f,
+    0.01f,
+    0.01f,
+};
+
+static inline void battery_pack_status_unpack_f32(float out[BATTERY_PACK_STATUS_F32_COUNT], const uint8_t *data) {
+    can_batch_u16_to_f32(out + 0, data + 0, 3, battery_pack_status_f32_scale + 0);
+}
+
+// End Packet: Battery Pack Status
+
+// Packet: Battery Temperature Status
+typedef struct {
+    float bus_bar_1_temp;
+    float bus_bar_2_temp;
+    float bus_bar_3_temp;
+    float precharge_resistor_temp;
+} battery_temperature_status_t;
+
+static inline void battery_temperature_status_unpack(battery_temperature_status_t *out, const uint8_t *data) {
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->bus_bar_1_temp = (float)raw * 0.1f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->bus_bar_2_temp = (float)raw * 0.1f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->bus_bar_3_temp = (float)raw * 0.1f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 6, sizeof(raw));
+        out->precharge_resistor_temp = (float)raw * 0.1f;
+    }
+}
+
+static inline void battery_temperature_status_pack(const battery_temperature_status_t *in, uint8_t *data) {
+    {
+        float scaled = in->bus_bar_1_temp * 10.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->bus_bar_2_temp * 10.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->bus_bar_3_temp * 10.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->precharge_resistor_temp * 10.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 6, &raw, sizeof(raw));
+    }
+}
+
+// battery_temperature_status_unpack_f32() vector layout
+enum {
+    BATTERY_TEMPERATURE_STATUS_F32_BUS_BAR_1_TEMP = 0,
+    BATTERY_TEMPERATURE_STATUS_F32_BUS_BAR_2_TEMP = 1,
+    BATTERY_TEMPERATURE_STATUS_F32_BUS_BAR_3_TEMP = 2,
+    BATTERY_TEMPERATURE_STATUS_F32_PRECHARGE_RESISTOR_TEMP = 3,
+    BATTERY_TEMPERATURE_STATUS_F32_COUNT = 4
+};
+
+static const float battery_temperature_status_f32_scale[BATTERY_TEMPERATURE_STATUS_F32_COUNT] = {
+    0.1f,
+    0.1f,
+    0.1f,
+    0.1f,
+};
+
+static inline void battery_temperature_status_unpack_f32(float out[BATTERY_TEMPERATURE_STATUS_F32_COUNT], const uint8_t *data) {
+    can_batch_u16_to_f32(out + 0, data + 0, 4, battery_temperature_status_f32_scale + 0);
+}
+
+// End Packet: Battery Temperature Status
+
+// Packet: Indicators + Shutdown Status
+typedef struct {
+    uint8_t bms_error;
+    uint8_t imd_error;
+    uint8_t shutdown_leg_1;
+    uint8_t shutdown_leg_2;
+    uint8_t shutdown_leg_3;
+    uint8_t shutdown_leg_4;
+} indicators_shutdown_status_t;
+
+static inline void indicators_shutdown_status_unpack(indicators_shutdown_status_t *out, const uint8_t *data) {
+    memcpy(&out->bms_error, data + 0, sizeof(out->bms_error));
+    memcpy(&out->imd_error, data + 1, sizeof(out->imd_error));
+    memcpy(&out->shutdown_leg_1, data + 2, sizeof(out->shutdown_leg_1));
+    memcpy(&out->shutdown_leg_2, data + 3, sizeof(out->shutdown_leg_2));
+    memcpy(&out->shutdown_leg_3, data + 4, sizeof(out->shutdown_leg_3));
+    memcpy(&out->shutdown_leg_4, data + 5, sizeof(out->shutdown_leg_4));
+}
+
+static inline void indicators_shutdown_status_pack(const indicators_shutdown_status_t *in, uint8_t *data) {
+    memcpy(data + 0, &in->bms_error, sizeof(in->bms_error));
+    memcpy(data + 1, &in->imd_error, sizeof(in->imd_error));
+    memcpy(data + 2, &in->shutdown_leg_1, sizeof(in->shutdown_leg_1));
+    memcpy(data + 3, &in->shutdown_leg_2, sizeof(in->shutdown_leg_2));
+    memcpy(data + 4, &in->shutdown_leg_3, sizeof(in->shutdown_leg_3));
+    memcpy(data + 5, &in->shutdown_leg_4, sizeof(in->shutdown_leg_4));
+}
+
+// End Packet: Indicators + Shutdown Status
+
+// Packet: Contactor Status
+typedef struct {
+    uint8_t hvc_state_machine;
+    uint8_t positive_hv_contactor;
+    uint8_t negative_hv_contactor;
+} contactor_status_t;
+
+static inline void contactor_status_unpack(contactor_status_t *out, const uint8_t *data) {
+    memcpy(&out->hvc_state_machine, data + 0, sizeof(out->hvc_state_machine));
+    memcpy(&out->positive_hv_contactor, data + 1, sizeof(out->positive_hv_contactor));
+    memcpy(&out->negative_hv_contactor, data + 2, sizeof(out->negative_hv_contactor));
+}
+
+static inline void contactor_status_pack(const contactor_status_t *in, uint8_t *data) {
+    memcpy(data + 0, &in->hvc_state_machine, sizeof(in->hvc_state_machine));
+    memcpy(data + 1, &in->positive_hv_contactor, sizeof(in->positive_hv_contactor));
+    memcpy(data + 2, &in->negative_hv_contactor, sizeof(in->negative_hv_contactor));
+}
+
+// End Packet: Contactor Status
+
+// Packet: Cell Voltages
+typedef struct {
+    float voltage_i;
+    float voltage_i_1;
+    float voltage_i_2;
+    float voltage_i_3;
+} cell_voltages_t;
+
+static inline void cell_voltages_unpack(cell_voltages_t *out, const uint8_t *data) {
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->voltage_i = (float)raw * 0.0001f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->voltage_i_1 = (float)raw * 0.0001f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->voltage_i_2 = (float)raw * 0.0001f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 6, sizeof(raw));
+        out->voltage_i_3 = (float)raw * 0.0001f;
+    }
+}
+
+static inline void cell_voltages_pack(const cell_voltages_t *in, uint8_t *data) {
+    {
+        float scaled = in->voltage_i * 10000.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->voltage_i_1 * 10000.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->voltage_i_2 * 10000.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->voltage_i_3 * 10000.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 6, &raw, sizeof(raw));
+    }
+}
+
+// cell_voltages_unpack_f32() vector layout
+enum {
+    CELL_VOLTAGES_F32_VOLTAGE_I = 0,
+    CELL_VOLTAGES_F32_VOLTAGE_I_1 = 1,
+    CELL_VOLTAGES_F32_VOLTAGE_I_2 = 2,
+    CELL_VOLTAGES_F32_VOLTAGE_I_3 = 3,
+    CELL_VOLTAGES_F32_COUNT = 4
+};
+
+static const float cell_voltages_f32_scale[CELL_VOLTAGES_F32_COUNT] = {
+    0.0001f,
+    0.0001f,
+    0.0001f,
+    0.0001f,
+};
+
+static inline void cell_voltages_unpack_f32(float out[CELL_VOLTAGES_F32_COUNT], const uint8_t *data) {
+    can_batch_u16_to_f32(out + 0, data + 0, 4, cell_voltages_f32_scale + 0);
+}
+
+// End Packet: Cell Voltages
+
+// Packet: Cell Temperatures
+typedef struct {
+    float temp_i;
+    float temp_i_1;
+    float temp_i_2;
+    float temp_i_3;
+} cell_temperatures_t;
+
+static inline void cell_temperatures_unpack(cell_temperatures_t *out, const uint8_t *data) {
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->temp_i = (float)raw * 0.1f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->temp_i_1 = (float)raw * 0.1f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->temp_i_2 = (float)raw * 0.1f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 6, sizeof(raw));
+        out->temp_i_3 = (float)raw * 0.1f;
+    }
+}
+
+static inline void cell_temperatures_pack(const cell_temperatures_t *in, uint8_t *data) {
+    {
+        float scaled = in->temp_i * 10.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->temp_i_1 * 10.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->temp_i_2 * 10.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->temp_i_3 * 10.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 6, &raw, sizeof(raw));
+    }
+}
+
+// cell_temperatures_unpack_f32() vector layout
+enum {
+    CELL_TEMPERATURES_F32_TEMP_I = 0,
+    CELL_TEMPERATURES_F32_TEMP_I_1 = 1,
+    CELL_TEMPERATURES_F32_TEMP_I_2 = 2,
+    CELL_TEMPERATURES_F32_TEMP_I_3 = 3,
+    CELL_TEMPERATURES_F32_COUNT = 4
+};
+
+static const float cell_temperatures_f32_scale[CELL_TEMPERATURES_F32_COUNT] = {
+    0.1f,
+    0.1f,
+    0.1f,
+    0.1f,
+};
+
+static inline void cell_temperatures_unpack_f32(float out[CELL_TEMPERATURES_F32_COUNT], const uint8_t *data) {
+    can_batch_u16_to_f32(out + 0, data + 0, 4, cell_temperatures_f32_scale + 0);
+}
+
+// End Packet: Cell Temperatures
+
+// Packet: VCU Shutdown Status
+typedef struct {
+    struct {
+        bool shutdown_bspd_status;
+        bool shutdown_emeter_status;
+    } vcu_shutdown_status;
+} vcu_shutdown_status_t;
+
+static inline void vcu_shutdown_status_unpack(vcu_shutdown_status_t *out, const uint8_t *data) {
+    {
+        uint8_t bits = data[0];
+        out->vcu_shutdown_status.shutdown_bspd_status = (bits >> 0) & 1U;
+        out->vcu_shutdown_status.shutdown_emeter_status = (bits >> 1) & 1U;
+    }
+}
+
+static inline void vcu_shutdown_status_pack(const vcu_shutdown_status_t *in, uint8_t *data) {
+    data[0] = (uint8_t)(
+        ((uint8_t)in->vcu_shutdown_status.shutdown_bspd_status << 0) |
+        ((uint8_t)in->vcu_shutdown_status.shutdown_emeter_status << 1));
+}
+
+// End Packet: VCU Shutdown Status
+
+// Packet: VCU Fuses
+typedef struct {
+    struct {
+        bool batt_pump_fuse;
+        bool tssi_green_fuse;
+        bool tssi_red_fuse;
+        bool batt_fans_fuse;
+        bool shtdn_fuse;
+        bool ll_fuse;
+        bool motor_pump_fuse;
+        bool boards_fuse;
+    } vcu_fuses_1;
+    struct {
+        bool brake_light_fuse;
+        bool rtd_fuse;
+        bool spare_fuse;
+    } vcu_fuses_2;
+} vcu_fuses_t;
+
+static inline void vcu_fuses_unpack(vcu_fuses_t *out, const uint8_t *data) {
+    {
+        uint8_t bits = data[0];
+        out->vcu_fuses_1.batt_pump_fuse = (bits >> 0) & 1U;
+        out->vcu_fuses_1.tssi_green_fuse = (bits >> 1) & 1U;
+        out->vcu_fuses_1.tssi_red_fuse = (bits >> 2) & 1U;
+        out->vcu_fuses_1.batt_fans_fuse = (bits >> 3) & 1U;
+        out->vcu_fuses_1.shtdn_fuse = (bits >> 4) & 1U;
+        out->vcu_fuses_1.ll_fuse = (bits >> 5) & 1U;
+        out->vcu_fuses_1.motor_pump_fuse = (bits >> 6) & 1U;
+        out->vcu_fuses_1.boards_fuse = (bits >> 7) & 1U;
+    }
+    {
+        uint8_t bits = data[1];
+        out->vcu_fuses_2.brake_light_fuse = (bits >> 0) & 1U;
+        out->vcu_fuses_2.rtd_fuse = (bits >> 1) & 1U;
+        out->vcu_fuses_2.spare_fuse = (bits >> 2) & 1U;
+    }
+}
+
+static inline void vcu_fuses_pack(const vcu_fuses_t *in, uint8_t *data) {
+    data[0] = (uint8_t)(
+        ((uint8_t)in->vcu_fuses_1.batt_pump_fuse << 0) |
+        ((uint8_t)in->vcu_fuses_1.tssi_green_fuse << 1) |
+        ((uint8_t)in->vcu_fuses_1.tssi_red_fuse << 2) |
+        ((uint8_t)in->vcu_fuses_1.batt_fans_fuse << 3) |
+        ((uint8_t)in->vcu_fuses_1.shtdn_fuse << 4) |
+        ((uint8_t)in->vcu_fuses_1.ll_fuse << 5) |
+        ((uint8_t)in->vcu_fuses_1.motor_pump_fuse << 6) |
+        ((uint8_t)in->vcu_fuses_1.boards_fuse << 7));
+    data[1] = (uint8_t)(
+        ((uint8_t)in->vcu_fuses_2.brake_light_fuse << 0) |
+        ((uint8_t)in->vcu_fuses_2.rtd_fuse << 1) |
+        ((uint8_t)in->vcu_fuses_2.spare_fuse << 2));
+}
+
+// End Packet: VCU Fuses
+
+// Packet: VCU Current Sense
+typedef struct {
+    float lv_boards_current;
+    float shutdown_current;
+    float battery_cooling_current;
+    float motor_cooling_current;
+    float lights_current_current;
+} vcu_current_sense_t;
+
+static inline void vcu_current_sense_unpack(vcu_current_sense_t *out, const uint8_t *data) {
+    {
+        uint8_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->lv_boards_current = (float)raw * 0.04f;
+    }
+    {
+        uint8_t raw;
+        memcpy(&raw, data + 1, sizeof(raw));
+        out->shutdown_current = (float)raw * 0.04f;
+    }
+    {
+        uint8_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->battery_cooling_current = (float)raw * 0.04f;
+    }
+    {
+        uint8_t raw;
+        memcpy(&raw, data + 3, sizeof(raw));
+        out->motor_cooling_current = (float)raw * 0.04f;
+    }
+    {
+        uint8_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->lights_current_current = (float)raw * 0.04f;
+    }
+}
+
+static inline void vcu_current_sense_pack(const vcu_current_sense_t *in, uint8_t *data) {
+    {
+        float scaled = in->lv_boards_current * 25.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 255.0f) scaled = 255.0f;
+        uint8_t raw = (uint8_t)(scaled + 0.5f);
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->shutdown_current * 25.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 255.0f) scaled = 255.0f;
+        uint8_t raw = (uint8_t)(scaled + 0.5f);
+        memcpy(data + 1, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->battery_cooling_current * 25.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 255.0f) scaled = 255.0f;
+        uint8_t raw = (uint8_t)(scaled + 0.5f);
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->motor_cooling_current * 25.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 255.0f) scaled = 255.0f;
+        uint8_t raw = (uint8_t)(scaled + 0.5f);
+        memcpy(data + 3, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->lights_current_current * 25.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 255.0f) scaled = 255.0f;
+        uint8_t raw = (uint8_t)(scaled + 0.5f);
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+}
+
+// End Packet: VCU Current Sense
+
+// Packet: FD Acceleration Vectors Sprung + Ride Height
+typedef struct {
+    float fl_x;
+    float fl_y;
+    float fl_z;
+    float fl_ride_height;
+    float fr_x;
+    float fr_y;
+    float fr_z;
+    float fr_ride_height;
+    float rl_x;
+    float rl_y;
+    float rl_z;
+    float rl_ride_height;
+    float rr_x;
+    float rr_y;
+    float rr_z;
+    float rr_ride_height;
+} fd_acceleration_vectors_sprung_ride_height_t;
+
+static inline void fd_acceleration_vectors_sprung_ride_height_unpack(fd_acceleration_vectors_sprung_ride_height_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->fl_x = (float)raw * 0.001f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->fl_y = (float)raw * 0.001f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->fl_z = (float)raw * 0.001f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 6, sizeof(raw));
+        out->fl_ride_height = (float)raw * 0.002f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 8, sizeof(raw));
+        out->fr_x = (float)raw * 0.001f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 10, sizeof(raw));
+        out->fr_y = (float)raw * 0.001f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 12, sizeof(raw));
+        out->fr_z = (float)raw * 0.001f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 14, sizeof(raw));
+        out->fr_ride_height = (float)raw * 0.002f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 16, sizeof(raw));
+        out->rl_x = (float)raw * 0.001f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 18, sizeof(raw));
+        out->rl_y = (float)raw * 0.001f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 20, sizeof(raw));
+        out->rl_z = (float)raw * 0.001f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 22, sizeof(raw));
+        out->rl_ride_height = (float)raw * 0.002f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 24, sizeof(raw));
+        out->rr_x = (float)raw * 0.001f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 26, sizeof(raw));
+        out->rr_y = (float)raw * 0.001f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 28, sizeof(raw));
+        out->rr_z = (float)raw * 0.001f;
+    }
+    {
+        uint16_t raw;
+        memcpy(&raw, data + 30, sizeof(raw));
+        out->rr_ride_height = (float)raw * 0.002f;
+    }
+}
+
+static inline void fd_acceleration_vectors_sprung_ride_height_pack(const fd_acceleration_vectors_sprung_ride_height_t *in, uint8_t *data) {
+    {
+        float scaled = in->fl_x * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->fl_y * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->fl_z * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->fl_ride_height * 500.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 6, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->fr_x * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 8, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->fr_y * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 10, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->fr_z * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 12, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->fr_ride_height * 500.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 14, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->rl_x * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 16, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->rl_y * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 18, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->rl_z * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 20, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->rl_ride_height * 500.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 22, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->rr_x * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 24, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->rr_y * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 26, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->rr_z * 1000.0f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 28, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->rr_ride_height * 500.0f;
+        if (!(scaled > 0.0f)) scaled = 0.0f;
+        else if (scaled > 65535.0f) scaled = 65535.0f;
+        uint16_t raw = (uint16_t)(scaled + 0.5f);
+        memcpy(data + 30, &raw, sizeof(raw));
+    }
+}
+
+// fd_acceleration_vectors_sprung_ride_height_unpack_f32() vector layout
+enum {
+    FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_F32_FL_X = 0,
+    FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_F32_FL_Y = 1,
+    FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_F32_FL_Z = 2,
+    FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_F32_FL_RIDE_HEIGHT = 3,
+    FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_F32_FR_X = 4,
+    FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_F32_FR_Y = 5,
+    FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_F32_FR_Z = 6,
+    FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_F32_FR_RIDE_HEIGHT = 7,
+    FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_F32_RL_X = 8,
+    FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_F32_RL_Y = 9,
+    FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_F32_RL_Z = 10,
+    FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_F32_RL_RIDE_HEIGHT = 11,
+    FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_F32_RR_X = 12,
+    FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_F32_RR_Y = 13,
+    FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_F32_RR_Z = 14,
+    FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_F32_RR_RIDE_HEIGHT = 15,
+    FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_F32_COUNT = 16
+};
+
+static const float fd_acceleration_vectors_sprung_ride_height_f32_scale[FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.001f),
+    CAN_BATCH_SCALE(0.001f),
+    CAN_BATCH_SCALE(0.001f),
+    0.002f,
+    CAN_BATCH_SCALE(0.001f),
+    CAN_BATCH_SCALE(0.001f),
+    CAN_BATCH_SCALE(0.001f),
+    0.002f,
+    CAN_BATCH_SCALE(0.001f),
+    CAN_BATCH_SCALE(0.001f),
+    CAN_BATCH_SCALE(0.001f),
+    0.002f,
+    CAN_BATCH_SCALE(0.001f),
+    CAN_BATCH_SCALE(0.001f),
+    CAN_BATCH_SCALE(0.001f),
+    0.002f,
+};
+
+static inline void fd_acceleration_vectors_sprung_ride_height_unpack_f32(float out[FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 3, fd_acceleration_vectors_sprung_ride_height_f32_scale + 0);
+    can_batch_u16_to_f32(out + 3, data + 6, 1, fd_acceleration_vectors_sprung_ride_height_f32_scale + 3);
+    can_batch_i16_to_f32(out + 4, data + 8, 3, fd_acceleration_vectors_sprung_ride_height_f32_scale + 4);
+    can_batch_u16_to_f32(out + 7, data + 14, 1, fd_acceleration_vectors_sprung_ride_height_f32_scale + 7);
+    can_batch_i16_to_f32(out + 8, data + 16, 3, fd_acceleration_vectors_sprung_ride_height_f32_scale + 8);
+    can_batch_u16_to_f32(out + 11, data + 22, 1, fd_acceleration_vectors_sprung_ride_height_f32_scale + 11);
+    can_batch_i16_to_f32(out + 12, data + 24, 3, fd_acceleration_vectors_sprung_ride_height_f32_scale + 12);
+    can_batch_u16_to_f32(out + 15, data + 30, 1, fd_acceleration_vectors_sprung_ride_height_f32_scale + 15);
+}
+
+// End Packet: FD Acceleration Vectors Sprung + Ride Height
+
+// Packet: FD Angular Rate Vectors Sprung
+typedef struct {
+    float fl_x;
+    float fl_y;
+    float fl_z;
+    float fr_x;
+    float fr_y;
+    float fr_z;
+    float bl_x;
+    float bl_y;
+    float bl_z;
+    float br_x;
+    float br_y;
+    float br_z;
+} fd_angular_rate_vectors_sprung_t;
+
+static inline void fd_angular_rate_vectors_sprung_unpack(fd_angular_rate_vectors_sprung_t *out, const uint8_t *data) {
+    {
+        int16_t raw;
+        memcpy(&raw, data + 0, sizeof(raw));
+        out->fl_x = (float)raw * 0.03f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 2, sizeof(raw));
+        out->fl_y = (float)raw * 0.03f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 4, sizeof(raw));
+        out->fl_z = (float)raw * 0.03f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 6, sizeof(raw));
+        out->fr_x = (float)raw * 0.03f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 8, sizeof(raw));
+        out->fr_y = (float)raw * 0.03f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 10, sizeof(raw));
+        out->fr_z = (float)raw * 0.03f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 12, sizeof(raw));
+        out->bl_x = (float)raw * 0.03f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 14, sizeof(raw));
+        out->bl_y = (float)raw * 0.03f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 16, sizeof(raw));
+        out->bl_z = (float)raw * 0.03f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 18, sizeof(raw));
+        out->br_x = (float)raw * 0.03f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 20, sizeof(raw));
+        out->br_y = (float)raw * 0.03f;
+    }
+    {
+        int16_t raw;
+        memcpy(&raw, data + 22, sizeof(raw));
+        out->br_z = (float)raw * 0.03f;
+    }
+}
+
+static inline void fd_angular_rate_vectors_sprung_pack(const fd_angular_rate_vectors_sprung_t *in, uint8_t *data) {
+    {
+        float scaled = in->fl_x * 33.333333333333336f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 0, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->fl_y * 33.333333333333336f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 2, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->fl_z * 33.333333333333336f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 4, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->fr_x * 33.333333333333336f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 6, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->fr_y * 33.333333333333336f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 8, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->fr_z * 33.333333333333336f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 10, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->bl_x * 33.333333333333336f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 12, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->bl_y * 33.333333333333336f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 14, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->bl_z * 33.333333333333336f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 16, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->br_x * 33.333333333333336f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 18, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->br_y * 33.333333333333336f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 20, &raw, sizeof(raw));
+    }
+    {
+        float scaled = in->br_z * 33.333333333333336f;
+        if (!(scaled > -32768.0f)) scaled = -32768.0f;
+        else if (scaled > 32767.0f) scaled = 32767.0f;
+        int16_t raw = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        memcpy(data + 22, &raw, sizeof(raw));
+    }
+}
+
+// fd_angular_rate_vectors_sprung_unpack_f32() vector layout
+enum {
+    FD_ANGULAR_RATE_VECTORS_SPRUNG_F32_FL_X = 0,
+    FD_ANGULAR_RATE_VECTORS_SPRUNG_F32_FL_Y = 1,
+    FD_ANGULAR_RATE_VECTORS_SPRUNG_F32_FL_Z = 2,
+    FD_ANGULAR_RATE_VECTORS_SPRUNG_F32_FR_X = 3,
+    FD_ANGULAR_RATE_VECTORS_SPRUNG_F32_FR_Y = 4,
+    FD_ANGULAR_RATE_VECTORS_SPRUNG_F32_FR_Z = 5,
+    FD_ANGULAR_RATE_VECTORS_SPRUNG_F32_BL_X = 6,
+    FD_ANGULAR_RATE_VECTORS_SPRUNG_F32_BL_Y = 7,
+    FD_ANGULAR_RATE_VECTORS_SPRUNG_F32_BL_Z = 8,
+    FD_ANGULAR_RATE_VECTORS_SPRUNG_F32_BR_X = 9,
+    FD_ANGULAR_RATE_VECTORS_SPRUNG_F32_BR_Y = 10,
+    FD_ANGULAR_RATE_VECTORS_SPRUNG_F32_BR_Z = 11,
+    FD_ANGULAR_RATE_VECTORS_SPRUNG_F32_COUNT = 12
+};
+
+static const float fd_angular_rate_vectors_sprung_f32_scale[FD_ANGULAR_RATE_VECTORS_SPRUNG_F32_COUNT] = {
+    CAN_BATCH_SCALE(0.03f),
+    CAN_BATCH_SCALE(0.03f),
+    CAN_BATCH_SCALE(0.03f),
+    CAN_BATCH_SCALE(0.03f),
+    CAN_BATCH_SCALE(0.03f),
+    CAN_BATCH_SCALE(0.03f),
+    CAN_BATCH_SCALE(0.03f),
+    CAN_BATCH_SCALE(0.03f),
+    CAN_BATCH_SCALE(0.03f),
+    CAN_BATCH_SCALE(0.03f),
+    CAN_BATCH_SCALE(0.03f),
+    CAN_BATCH_SCALE(0.03f),
+};
+
+static inline void fd_angular_rate_vectors_sprung_unpack_f32(float out[FD_ANGULAR_RATE_VECTORS_SPRUNG_F32_COUNT], const uint8_t *data) {
+    can_batch_i16_to_f32(out + 0, data + 0, 12, fd_angular_rate_vectors_sprung_f32_scale + 0);
+}
+
+// End Packet: FD Angular Rate Vectors Sprung
+
+#endif // NIGHT_CAN_CODEC_H
@@ -76,7 +76,7 @@
 // From: Pi
 // To:   \*
 #define META_DATA_FOR_WRITE_MEMORY_FIRMWARE_UPDATE_256B_MAX_ID 49
-#define META_DATA_FOR_WRITE_MEMORY_FIRMWARE_UPDATE_256B_MAX_DLC 5
+#define META_DATA_FOR_WRITE_MEMORY_FIRMWARE_UPDATE_256B_MAX_DLC 8
 #define META_DATA_FOR_WRITE_MEMORY_FIRMWARE_UPDATE_256B_MAX_FREQ 0
 #define META_DATA_FOR_WRITE_MEMORY_FIRMWARE_UPDATE_256B_MAX_QUANTITY 0
 
@@ -105,8 +105,63 @@
 #define META_DATA_FOR_WRITE_MEMORY_FIRMWARE_UPDATE_256B_MAX_FIELD_4_TYPE uint8_t
 #define META_DATA_FOR_WRITE_MEMORY_FIRMWARE_UPDATE_256B_MAX_FIELD_4_PREC 1.0f
 
+#define META_DATA_FOR_WRITE_MEMORY_FIRMWARE_UPDATE_256B_MAX_FIELD_5_BYTE 5
+#define META_DATA_FOR_WRITE_MEMORY_FIRMWARE_UPDATE_256B_MAX_FIELD_5_LENGTH 2
+#define META_DATA_FOR_WRITE_MEMORY_FIRMWARE_UPDATE_256B_MAX_FIELD_5_TYPE uint16_t
+#define META_DATA_FOR_WRITE_MEMORY_FIRMWARE_UPDATE_256B_MAX_FIELD_5_PREC 1.0f
+
+#define META_DATA_FOR_WRITE_MEMORY_FIRMWARE_UPDATE_256B_MAX_FIELD_6_BYTE 7
+#define META_DATA_FOR_WRITE_MEMORY_FIRMWARE_UPDATE_256B_MAX_FIELD_6_LENGTH 1
+#define META_DATA_FOR_WRITE_MEMORY_FIRMWARE_UPDATE_256B_MAX_FIELD_6_TYPE uint8_t
+#define META_DATA_FOR_WRITE_MEMORY_FIRMWARE_UPDATE_256B_MAX_FIELD_6_PREC 1.0f
+
 // End Packet: (Meta Data for Write Memory -- Firmware Update, 256B max)
 
+// Packet: Firmware Update Ack
+// From: \*
+// To:   Pi
+#define FIRMWARE_UPDATE_ACK_ID 50
+#define FIRMWARE_UPDATE_ACK_DLC 7
+#define FIRMWARE_UPDATE_ACK_FREQ 0
+#define FIRMWARE_UPDATE_ACK_QUANTITY 1
+
+#define FIRMWARE_UPDATE_ACK_FIELD_0_BYTE 0
+#define FIRMWARE_UPDATE_ACK_FIELD_0_LENGTH 1
+#define FIRMWARE_UPDATE_ACK_FIELD_0_TYPE uint8_t
+#define FIRMWARE_UPDATE_ACK_FIELD_0_PREC 1.0f
+
+#define FIRMWARE_UPDATE_ACK_FIELD_1_BYTE 1
+#define FIRMWARE_UPDATE_ACK_FIELD_1_LENGTH 1
+#define FIRMWARE_UPDATE_ACK_FIELD_1_TYPE uint8_t
+#define FIRMWARE_UPDATE_ACK_FIELD_1_PREC 1.0f
+
+#define FIRMWARE_UPDATE_ACK_FIELD_2_BYTE 2
+#define FIRMWARE_UPDATE_ACK_FIELD_2_LENGTH 1
+#define FIRMWARE_UPDATE_ACK_FIELD_2_TYPE uint8_t
+#define FIRMWARE_UPDATE_ACK_FIELD_2_PREC 1.0f
+
+#define FIRMWARE_UPDATE_ACK_FIELD_3_BYTE 3
+#define FIRMWARE_UPDATE_ACK_FIELD_3_LENGTH 1
+#define FIRMWARE_UPDATE_ACK_FIELD_3_TYPE uint8_t
+#define FIRMWARE_UPDATE_ACK_FIELD_3_PREC 1.0f
+
+#define FIRMWARE_UPDATE_ACK_FIELD_4_BYTE 4
+#define FIRMWARE_UPDATE_ACK_FIELD_4_LENGTH 1
+#define FIRMWARE_UPDATE_ACK_FIELD_4_TYPE uint8_t
+#define FIRMWARE_UPDATE_ACK_FIELD_4_PREC 1.0f
+
+#define FIRMWARE_UPDATE_ACK_FIELD_5_BYTE 5
+#define FIRMWARE_UPDATE_ACK_FIELD_5_LENGTH 1
+#define FIRMWARE_UPDATE_ACK_FIELD_5_TYPE uint8_t
+#define FIRMWARE_UPDATE_ACK_FIELD_5_PREC 1.0f
+
+#define FIRMWARE_UPDATE_ACK_FIELD_6_BYTE 6
+#define FIRMWARE_UPDATE_ACK_FIELD_6_LENGTH 1
+#define FIRMWARE_UPDATE_ACK_FIELD_6_TYPE uint8_t
+#define FIRMWARE_UPDATE_ACK_FIELD_6_PREC 1.0f
+
+// End Packet: Firmware Update Ack
+
 // Packet: Inverter Temps
 // From: Inverter
 // To:   VCU
@@ -1589,4 +1644,170 @@
 
 // End Packet: Rack Enter Bootloader
 
+// Packet: FD Acceleration Vectors Sprung + Ride Height
+// CAN FD frame combining: 0x500, 0x501, 0x502, 0x503
+// From: Undertray
+// To:   Pi
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_ID 1288
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_DLC 32
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FREQ 10
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_QUANTITY 1
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FD 1
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_BRS 1
+
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FL_X_BYTE 0
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FL_X_LENGTH 2
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FL_X_TYPE int16_t
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FL_X_PREC 0.001f
+
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FL_Y_BYTE 2
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FL_Y_LENGTH 2
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FL_Y_TYPE int16_t
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FL_Y_PREC 0.001f
+
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FL_Z_BYTE 4
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FL_Z_LENGTH 2
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FL_Z_TYPE int16_t
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FL_Z_PREC 0.001f
+
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FL_RIDE_HEIGHT_BYTE 6
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FL_RIDE_HEIGHT_LENGTH 2
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FL_RIDE_HEIGHT_TYPE uint16_t
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FL_RIDE_HEIGHT_PREC 0.002f
+
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FR_X_BYTE 8
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FR_X_LENGTH 2
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FR_X_TYPE int16_t
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FR_X_PREC 0.001f
+
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FR_Y_BYTE 10
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FR_Y_LENGTH 2
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FR_Y_TYPE int16_t
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FR_Y_PREC 0.001f
+
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FR_Z_BYTE 12
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FR_Z_LENGTH 2
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FR_Z_TYPE int16_t
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FR_Z_PREC 0.001f
+
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FR_RIDE_HEIGHT_BYTE 14
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FR_RIDE_HEIGHT_LENGTH 2
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FR_RIDE_HEIGHT_TYPE uint16_t
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_FR_RIDE_HEIGHT_PREC 0.002f
+
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RL_X_BYTE 16
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RL_X_LENGTH 2
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RL_X_TYPE int16_t
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RL_X_PREC 0.001f
+
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RL_Y_BYTE 18
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RL_Y_LENGTH 2
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RL_Y_TYPE int16_t
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RL_Y_PREC 0.001f
+
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RL_Z_BYTE 20
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RL_Z_LENGTH 2
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RL_Z_TYPE int16_t
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RL_Z_PREC 0.001f
+
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RL_RIDE_HEIGHT_BYTE 22
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RL_RIDE_HEIGHT_LENGTH 2
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RL_RIDE_HEIGHT_TYPE uint16_t
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RL_RIDE_HEIGHT_PREC 0.002f
+
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RR_X_BYTE 24
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RR_X_LENGTH 2
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RR_X_TYPE int16_t
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RR_X_PREC 0.001f
+
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RR_Y_BYTE 26
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RR_Y_LENGTH 2
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RR_Y_TYPE int16_t
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RR_Y_PREC 0.001f
+
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RR_Z_BYTE 28
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RR_Z_LENGTH 2
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RR_Z_TYPE int16_t
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RR_Z_PREC 0.001f
+
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RR_RIDE_HEIGHT_BYTE 30
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RR_RIDE_HEIGHT_LENGTH 2
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RR_RIDE_HEIGHT_TYPE uint16_t
+#define FD_ACCELERATION_VECTORS_SPRUNG_RIDE_HEIGHT_RR_RIDE_HEIGHT_PREC 0.002f
+
+// End Packet: FD Acceleration Vectors Sprung + Ride Height
+
+// Packet: FD Angular Rate Vectors Sprung
+// CAN FD frame combining: 0x504, 0x505, 0x506, 0x507
+// From: Undertray
+// To:   Pi
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_ID 1289
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_DLC 24
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_FREQ 10
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_QUANTITY 1
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_FD 1
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_BRS 1
+
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_FL_X_BYTE 0
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_FL_X_LENGTH 2
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_FL_X_TYPE int16_t
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_FL_X_PREC 0.03f
+
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_FL_Y_BYTE 2
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_FL_Y_LENGTH 2
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_FL_Y_TYPE int16_t
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_FL_Y_PREC 0.03f
+
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_FL_Z_BYTE 4
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_FL_Z_LENGTH 2
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_FL_Z_TYPE int16_t
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_FL_Z_PREC 0.03f
+
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_FR_X_BYTE 6
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_FR_X_LENGTH 2
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_FR_X_TYPE int16_t
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_FR_X_PREC 0.03f
+
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_FR_Y_BYTE 8
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_FR_Y_LENGTH 2
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_FR_Y_TYPE int16_t
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_FR_Y_PREC 0.03f
+
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_FR_Z_BYTE 10
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_FR_Z_LENGTH 2
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_FR_Z_TYPE int16_t
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_FR_Z_PREC 0.03f
+
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_BL_X_BYTE 12
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_BL_X_LENGTH 2
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_BL_X_TYPE int16_t
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_BL_X_PREC 0.03f
+
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_BL_Y_BYTE 14
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_BL_Y_LENGTH 2
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_BL_Y_TYPE int16_t
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_BL_Y_PREC 0.03f
+
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_BL_Z_BYTE 16
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_BL_Z_LENGTH 2
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_BL_Z_TYPE int16_t
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_BL_Z_PREC 0.03f
+
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_BR_X_BYTE 18
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_BR_X_LENGTH 2
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_BR_X_TYPE int16_t
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_BR_X_PREC 0.03f
+
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_BR_Y_BYTE 20
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_BR_Y_LENGTH 2
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_BR_Y_TYPE int16_t
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_BR_Y_PREC 0.03f
+
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_BR_Z_BYTE 22
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_BR_Z_LENGTH 2
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_BR_Z_TYPE int16_t
+#define FD_ANGULAR_RATE_VECTORS_SPRUNG_BR_Z_PREC 0.03f
+
+// End Packet: FD Angular Rate Vectors Sprung
+
 #endif // NIGHT_CAN_IDS_H
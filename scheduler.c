@@ -0,0 +1,179 @@
+#include "scheduler.h"
+
+#include <stddef.h>
+
+#include "main.h"
+
+// added tasks, sorted by priority (stable), so the first ready one wins
+static LibSchedTask *tasks[LIB_SCHED_MAX_TASKS];
+static uint32_t task_count;
+
+static LibSchedOverrunCallback overrun_callback;
+
+static uint64_t stats_start_cycles;
+static uint64_t busy_cycles;  // cycles spent in tasks since then
+
+void lib_sched_init() {
+    task_count = 0;
+    overrun_callback = NULL;
+    stats_start_cycles = lib_timer_cycles64();
+    busy_cycles = 0;
+}
+
+LibSchedTask lib_sched_task(const char *name, LibSchedTaskFn fn, void *arg,
+                            uint8_t priority, uint32_t period_us,
+                            uint32_t deadline_us, uint32_t budget_us) {
+    LibSchedTask task = {.name = name, .fn = fn, .arg = arg,
+                         .priority = priority, .period_us = period_us,
+                         .deadline_us = deadline_us, .budget_us = budget_us};
+    return task;
+}
+
+bool lib_sched_add(LibSchedTask *task) {
+    if (!task || !task->fn || task_count >= LIB_SCHED_MAX_TASKS) return false;
+    for (uint32_t i = 0; i < task_count; i++) {
+        if (tasks[i] == task) return false;
+    }
+
+    task->_release_us = lib_timer_now_us();
+    task->_triggered = false;
+
+    // after every task of the same or higher priority
+    uint32_t pos = task_count;
+    while (pos > 0 && tasks[pos - 1]->priority > task->priority) {
+        tasks[pos] = tasks[pos - 1];
+        pos--;
+    }
+    tasks[pos] = task;
+    task_count++;
+    return true;
+}
+
+void lib_sched_remove(LibSchedTask *task) {
+    for (uint32_t i = 0; i < task_count; i++) {
+        if (tasks[i] != task) continue;
+        for (uint32_t j = i + 1; j < task_count; j++) tasks[j - 1] = tasks[j];
+        task_count--;
+        return;
+    }
+}
+
+void lib_sched_trigger(LibSchedTask *task) {
+    if (!task || task->_triggered) return;
+    task->_trigger_us = lib_timer_now_us();
+    task->_triggered = true;
+}
+
+void lib_sched_set_overrun_callback(LibSchedOverrunCallback callback) {
+    overrun_callback = callback;
+}
+
+/**
+ * Where task's current release was, if it's due at now. A periodic release
+ * counts before a trigger since it's the older one.
+ */
+static bool task_due(const LibSchedTask *task, uint64_t now,
+                     uint64_t *release) {
+    if (task->period_us && task->_release_us <= now) {
+        *release = task->_release_us;
+        return true;
+    }
+    if (task->_triggered) {
+        *release = task->_trigger_us;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Moves a periodic task to its next release, phase locked to the first. If
+ * it's so late that more releases already passed those are skipped, there's
+ * no point running back to back to catch up.
+ */
+static void task_advance(LibSchedTask *task, uint64_t now) {
+    task->_release_us += task->period_us;
+    if (task->_release_us <= now) {
+        uint64_t behind = (now - task->_release_us) / task->period_us + 1;
+        task->skipped += (uint32_t)behind;
+        task->_release_us += behind * task->period_us;
+    }
+}
+
+bool lib_sched_run_once() {
+    uint64_t now = lib_timer_now_us();
+
+    LibSchedTask *task = NULL;
+    uint64_t release = 0;
+    for (uint32_t i = 0; i < task_count; i++) {
+        if (task_due(tasks[i], now, &release)) {
+            task = tasks[i];
+            break;
+        }
+    }
+    if (!task) return false;
+
+    // it's the periodic release if that one is due, else the trigger
+    bool periodic = task->period_us && task->_release_us <= now;
+    if (periodic) {
+        task_advance(task, now);
+    } else {
+        task->_triggered = false;
+    }
+
+    uint32_t latency_us = (uint32_t)(now - release);
+    if (latency_us > task->max_latency_us) task->max_latency_us = latency_us;
+
+    lib_timer_section_begin(&task->time);
+    task->fn(task->arg);
+    lib_timer_section_end(&task->time);
+    task->runs++;
+    busy_cycles += task->time.last;
+
+    uint32_t run_us = lib_timer_cycles_to_us(task->time.last);
+    if (task->budget_us && run_us > task->budget_us) {
+        task->budget_overruns++;
+        if (overrun_callback) {
+            overrun_callback(task, LIB_SCHED_BUDGET_OVERRUN,
+                             run_us - task->budget_us);
+        }
+    }
+
+    uint32_t deadline_us = task->deadline_us ? task->deadline_us
+                                             : task->period_us;
+    uint32_t finish_us = latency_us + run_us;  // after the release
+    if (deadline_us && finish_us > deadline_us) {
+        task->deadline_misses++;
+        if (overrun_callback) {
+            overrun_callback(task, LIB_SCHED_DEADLINE_MISS,
+                             finish_us - deadline_us);
+        }
+    }
+
+    return true;
+}
+
+float lib_sched_cpu_share(const LibSchedTask *task) {
+    uint64_t elapsed = lib_timer_cycles64() - stats_start_cycles;
+    if (!task || elapsed == 0) return 0.0f;
+    return (float)task->time.total / (float)elapsed;
+}
+
+float lib_sched_idle_share() {
+    uint64_t elapsed = lib_timer_cycles64() - stats_start_cycles;
+    if (elapsed == 0) return 0.0f;
+    return 1.0f - (float)busy_cycles / (float)elapsed;
+}
+
+void lib_sched_reset_stats() {
+    for (uint32_t i = 0; i < task_count; i++) {
+        LibSchedTask *task = tasks[i];
+        task->runs = 0;
+        task->deadline_misses = 0;
+        task->budget_overruns = 0;
+        task->skipped = 0;
+        task->max_latency_us = 0;
+        lib_timer_section_reset(&task->time);
+    }
+    stats_start_cycles = lib_timer_cycles64();
+    busy_cycles = 0;
+}
@@ -0,0 +1,130 @@
+//
+// Cooperative run-to-completion task scheduler on the timer.c timebase.
+//
+// Replaces the superloop: each piece of periodic work (CAN servicing, USB
+// logging, LED effects, control) is a task with its own rate and priority,
+// and the main loop just calls lib_sched_run_once. Whenever several tasks
+// are due the most important one goes first, so a task waits at most for
+// the task already running, which the budgets bound. Nothing is preempted:
+// a task that runs over its budget or finishes after its deadline is only
+// counted (and reported to the overrun callback).
+//
+// Example:
+//   static LibSchedTask can_task, usb_task;
+//   static void can_run(void *arg) { CAN_periodic(arg); }
+//   static void usb_run(void *arg) { receive_periodic(); }
+//
+//   lib_timer_init();
+//   lib_sched_init();
+//   can_task = lib_sched_task("can", can_run, &can, 0, 1000, 0, 100);
+//   usb_task = lib_sched_task("usb", usb_run, NULL, 5, 10000, 0, 0);
+//   lib_sched_add(&can_task);
+//   lib_sched_add(&usb_task);
+//   while (1) lib_sched_run_once();
+//
+
+#ifndef LONGHORN_LIBRARY_2025_SCHEDULER_H
+#define LONGHORN_LIBRARY_2025_SCHEDULER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "timer.h"
+
+#define LIB_SCHED_MAX_TASKS 16
+
+typedef void (*LibSchedTaskFn)(void *arg);
+
+typedef struct LibSchedTask {
+    const char *name;
+    LibSchedTaskFn fn;
+    void *arg;
+    uint8_t priority;      // 0 is the most important
+    uint32_t period_us;    // time between releases, 0 for a task that only
+                           // runs when lib_sched_trigger asks
+    uint32_t deadline_us;  // has to finish this long after its release, 0
+                           // takes the period (0 with neither: no deadline)
+    uint32_t budget_us;    // run time it should stay under, 0 for no limit
+
+    // --- Statistics (reset by lib_sched_reset_stats) ---
+    uint32_t runs;
+    uint32_t deadline_misses;  // finished after release + deadline
+    uint32_t budget_overruns;  // ran longer than budget_us
+    uint32_t skipped;          // releases that passed while it was still late
+    uint32_t max_latency_us;   // longest wait from release to starting
+    LibTimerSection time;      // cycles per run, time.total is its CPU time
+
+    // --- Internal scheduler state (do not modify directly) ---
+    uint64_t _release_us;         // the release it runs for next
+    volatile bool _triggered;     // lib_sched_trigger was called
+    volatile uint64_t _trigger_us;  // when, the release of a triggered run
+} LibSchedTask;
+
+typedef enum {
+    LIB_SCHED_DEADLINE_MISS,
+    LIB_SCHED_BUDGET_OVERRUN,
+} LibSchedOverrun;
+
+typedef void (*LibSchedOverrunCallback)(LibSchedTask *task,
+                                        LibSchedOverrun kind,
+                                        uint32_t us);  // how far over
+
+/**
+ * Forgets all tasks and starts the statistics. Call after lib_timer_init.
+ */
+void lib_sched_init();
+
+/**
+ * Makes a task, see LibSchedTask for the fields.
+ */
+LibSchedTask lib_sched_task(const char *name, LibSchedTaskFn fn, void *arg,
+                            uint8_t priority, uint32_t period_us,
+                            uint32_t deadline_us, uint32_t budget_us);
+
+/**
+ * Adds a task, first released now. The scheduler keeps the pointer, so the
+ * task has to outlive it. Tasks of the same priority go in the order added.
+ * @return false if LIB_SCHED_MAX_TASKS are already added (or it is).
+ */
+bool lib_sched_add(LibSchedTask *task);
+
+/**
+ * Takes a task out, it won't run again.
+ */
+void lib_sched_remove(LibSchedTask *task);
+
+/**
+ * Asks for a run of the task as soon as its priority allows, on top of its
+ * period if it has one. Safe from interrupts, for deferring work out of an
+ * ISR. Triggering again before it ran still gives one run.
+ */
+void lib_sched_trigger(LibSchedTask *task);
+
+/**
+ * Runs the most important task that is due, if any.
+ * @return true if one ran, false if nothing was due.
+ */
+bool lib_sched_run_once();
+
+/**
+ * Registers a function to hear about deadline misses and budget overruns,
+ * called right after the task that caused them.
+ */
+void lib_sched_set_overrun_callback(LibSchedOverrunCallback callback);
+
+/**
+ * Fraction of the time since the statistics started that the task ran.
+ */
+float lib_sched_cpu_share(const LibSchedTask *task);
+
+/**
+ * Fraction of the time since the statistics started that no task ran.
+ */
+float lib_sched_idle_share();
+
+/**
+ * Zeroes every task's statistics and starts counting again.
+ */
+void lib_sched_reset_stats();
+
+#endif  // LONGHORN_LIBRARY_2025_SCHEDULER_H
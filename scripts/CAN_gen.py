@@ -1,4 +1,6 @@
+import argparse
 import csv
+import io
 import json
 import re
 import math
@@ -8,6 +10,12 @@ import os
 CAN_CSV_FILENAME = "NCAN_packets.csv"
 BITFIELD_CSV_FILENAME = "NCAN_bitfields.csv"
 JSON_FILENAME = "can_packets.json"
+CAN_BITRATE = 1000000  # bit/s, the nominal rate the boards are set up for
+MAX_STANDARD_ID = 0x7FF  # night_can sends anything above as an extended frame
+
+# Trailing NCAN_packets.csv columns that --update-csv fills in
+CSV_BINARY_COLUMN = 1
+CSV_ANALYSIS_COLUMNS = ["Frame Bits (worst case)", "Bits/s", "Bus Load"]
 
 # --- Regex Definitions ---
 # Regex for CAN signal: (type, context/precision)
@@ -449,8 +457,202 @@ def process_csv(can_filepath, bitfield_definitions):
     return can_packets
 
 
+# --- Bus Load / Schedulability ---
+# Worst case response times are the CAN analysis from Davis, Burns, Bril and
+# Lukkien, "Controller Area Network (CAN) schedulability analysis: Refuted,
+# revisited and revised" (2007): a frame waits for at most one lower priority
+# frame already on the wire, then for every higher priority frame queued
+# before it wins arbitration. Each ID is assumed to be queued right at the
+# start of its period with no jitter, and to be due before the next one.
+# A packet with a Quantity above 1 is that many frames on consecutive IDs
+# (0x210 x 35 is 0x210 to 0x232), all sent every period.
+
+
+def frame_bits(dlc, extended):
+    """Worst case bits on the wire for a classic data frame, stuff bits and
+    the 3 bit interframe space included."""
+    # 34 (standard) / 54 (extended) bits from SOF to the CRC are stuffed
+    if extended:
+        return 67 + 8 * dlc + (54 + 8 * dlc - 1) // 4
+    return 47 + 8 * dlc + (34 + 8 * dlc - 1) // 4
+
+
+def arbitration_key(packet_id):
+    """Arbitration field as a number, lower wins. A standard frame beats an
+    extended one with the same base ID (its IDE bit is dominant)."""
+    if packet_id > MAX_STANDARD_ID:
+        return ((packet_id >> 18) << 19) | (1 << 18) | (packet_id & 0x3FFFF)
+    return packet_id << 19
+
+
+def build_frames(packets, bitrate):
+    """One entry per ID on the bus, highest priority first."""
+    frames = []
+    for packet in packets:
+        frequency_hz = packet["frequency"]
+        for offset in range(max(packet["quantity"], 1)):
+            frame_id = packet["packet_id"] + offset
+            bits = frame_bits(packet["data_length"], frame_id > MAX_STANDARD_ID)
+            frames.append(
+                {
+                    "packet": packet,
+                    "id": frame_id,
+                    "bits": bits,
+                    "c": bits / bitrate,  # transmission time, seconds
+                    "t": 1.0 / frequency_hz if frequency_hz else None,  # period
+                    "key": arbitration_key(frame_id),
+                }
+            )
+    frames.sort(key=lambda f: f["key"])
+    return frames
+
+
+def response_time(frames, index, bit_time):
+    """Worst case time from queuing frames[index] to the end of its
+    transmission, or None if that isn't bounded."""
+    frame = frames[index]
+    higher = [f for f in frames[:index] if f["t"]]
+    # non-preemptive: a lower priority frame that just started can't be stopped
+    blocking = max((f["c"] for f in frames[index + 1 :]), default=0.0)
+
+    # longest level-m busy period, which bounds the instances to check
+    busy = blocking + frame["c"]
+    while True:
+        demand = blocking + sum(
+            math.ceil(busy / f["t"]) * f["c"] for f in higher + [frame]
+        )
+        if demand > 1000 * frame["t"]:
+            return None
+        if demand <= busy:
+            break
+        busy = demand
+    instances = math.ceil(busy / frame["t"])
+
+    worst = 0.0
+    for q in range(instances):
+        # w: queuing delay before instance q starts transmitting
+        w = blocking + q * frame["c"]
+        while True:
+            interference = sum(
+                math.ceil((w + bit_time) / f["t"]) * f["c"] for f in higher
+            )
+            w_next = blocking + q * frame["c"] + interference
+            if w_next == w:
+                break
+            if w_next - q * frame["t"] + frame["c"] > 1000 * frame["t"]:
+                return None
+            w = w_next
+        worst = max(worst, w - q * frame["t"] + frame["c"])
+    return worst
+
+
+def analyze_bus(packets, bitrate):
+    """Prints the bus load and response time report.
+    @return the frames and whether every periodic ID meets its deadline"""
+    frames = build_frames(packets, bitrate)
+    bit_time = 1.0 / bitrate
+    utilisation = 0.0
+    per_node = {}
+    for f in frames:
+        f["load"] = f["c"] / f["t"] if f["t"] else 0.0
+        utilisation += f["load"]
+        for node in f["packet"]["from"] or ["?"]:
+            per_node[node] = per_node.get(node, 0.0) + f["load"]
+
+    print(f"\nBus load at {bitrate / 1000:g} kbit/s (worst case stuffing):")
+    for node, load in sorted(per_node.items(), key=lambda item: -item[1]):
+        print(f"  {node:<12} {load * 100:6.2f}%")
+    print(f"  {'total':<12} {utilisation * 100:6.2f}%")
+
+    overloaded = utilisation > 1.0
+    if overloaded:
+        print("Error: bus load is over 100%, nothing can be guaranteed.")
+    schedulable = not overloaded
+
+    print("\nWorst case response times (deadline = period):")
+    print(f"  {'ID':>10}  {'from':<10} {'bits':>4} {'period':>9} {'response':>9}")
+    for index, f in enumerate(frames):
+        packet = f["packet"]
+        if not f["t"]:
+            continue  # aperiodic, only counted as blocking
+        response = None if overloaded else response_time(frames, index, bit_time)
+        f["response"] = response
+        missed = response is None or response > f["t"]
+        response_str = "unbounded" if response is None else f"{response * 1e6:7.0f}us"
+        print(
+            f"  {f['id']:#10x}  {','.join(packet['from']):<10} "
+            f"{f['bits']:4d} {f['t'] * 1e6:7.0f}us "
+            f"{response_str:>9}{'  MISSED' if missed else ''}"
+        )
+        if missed:
+            schedulable = False
+
+    if schedulable:
+        print("All periodic packets meet their deadlines.")
+    else:
+        print("Error: the message set is not schedulable at this bit rate.")
+    return frames, schedulable
+
+
+def update_csv_columns(can_filepath, frames, bitrate):
+    """Rewrites the CAN ID binary and trailing bit count / load columns of the
+    CSV from the analysis, keeping its CRLF line endings."""
+    by_id = {f["id"]: f for f in frames}
+    with open(can_filepath, mode="r", encoding="utf-8-sig", newline="") as csvfile:
+        rows = list(csv.reader(csvfile))
+    if not rows:
+        return
+    first = len(rows[0]) - len(CSV_ANALYSIS_COLUMNS)
+    rows[0][first:] = CSV_ANALYSIS_COLUMNS
+    for row in rows[1:]:
+        if not row or not row[0].strip():
+            continue
+        try:
+            packet_id = int(row[0].strip(), 16)
+        except ValueError:
+            continue
+        f = by_id.get(packet_id)
+        if f is None or len(row) < len(rows[0]):
+            continue
+        row[CSV_BINARY_COLUMN] = format(packet_id, "b")
+        quantity = max(f["packet"]["quantity"], 1)
+        bits_per_second = f["bits"] * quantity / f["t"] if f["t"] else 0
+        row[first:] = [
+            str(f["bits"]),
+            str(round(bits_per_second)),
+            f"{bits_per_second / bitrate * 100:.2f}%",
+        ]
+    output = io.StringIO()
+    csv.writer(output, lineterminator="\r\n").writerows(rows)
+    with open(can_filepath, mode="w", encoding="utf-8", newline="") as csvfile:
+        csvfile.write(output.getvalue().rstrip("\r\n"))
+    print(f"Updated the bit count and bus load columns of {can_filepath}")
+
+
 # --- Main Execution ---
 if __name__ == "__main__":
+    parser = argparse.ArgumentParser(
+        description=f"Converts {CAN_CSV_FILENAME} to {JSON_FILENAME} and checks "
+        "that the message set fits on the bus."
+    )
+    parser.add_argument(
+        "--bitrate",
+        type=int,
+        default=CAN_BITRATE,
+        help=f"nominal bus bit rate in bit/s (default {CAN_BITRATE})",
+    )
+    parser.add_argument(
+        "--update-csv",
+        action="store_true",
+        help=f"write the computed bit counts and loads back into {CAN_CSV_FILENAME}",
+    )
+    parser.add_argument(
+        "--no-check",
+        action="store_true",
+        help="write the JSON even if deadlines are missed",
+    )
+    args = parser.parse_args()
+
     print(f"Loading bitfield definitions from: {BITFIELD_CSV_FILENAME}")
     bitfield_defs = load_bitfield_definitions(BITFIELD_CSV_FILENAME)
 
@@ -458,6 +660,13 @@ if __name__ == "__main__":
     processed_packets = process_csv(CAN_CSV_FILENAME, bitfield_defs)
 
     if processed_packets:
+        frames, schedulable = analyze_bus(processed_packets, args.bitrate)
+        if args.update_csv:
+            update_csv_columns(CAN_CSV_FILENAME, frames, args.bitrate)
+        if not schedulable and not args.no_check:
+            print(f"\n{JSON_FILENAME} not written (use --no-check to override).")
+            raise SystemExit(1)
+
         json_output = json.dumps(processed_packets, indent=4)
         try:
             with open(JSON_FILENAME, "w", encoding="utf-8") as outfile:
@@ -1,11 +1,28 @@
 import json
 import argparse
+import math
 import re
 import os
 
 # --- Configuration ---
 DEFAULT_INPUT_FILENAME = "can_packets.json"
 DEFAULT_OUTPUT_FILENAME = "night_can_ids.h"
+DEFAULT_CODEC_FILENAME = "night_can_codec.h"
+DEFAULT_FD_GROUPS_FILENAME = "NCAN_fd_groups.json"
+DEFAULT_BOARDS_BASENAME = "night_can_boards"  # .h with the sizes, .c with the tables
+
+# Packets night_can.c deals with itself before any inbox lookup, so boards
+# never get an inbox for them (macro bases, see update_rx_buffer)
+DRIVER_HANDLED_PACKETS = {
+    "BUS_ENABLE_DISABLE",
+    "WRITE_MEMORY_DATA_FIRMWARE_UPDATE",
+    "META_DATA_FOR_WRITE_MEMORY_FIRMWARE_UPDATE_256B_MAX",
+}
+DEFAULT_TIMEOUT_PERIODS = 5  # inbox timeout, in periods of its packet
+TX_STAGGER_MAX_SLOTS = 32  # same as CAN_TX_STAGGER_MAX_SLOTS
+
+# Payload sizes a CAN FD frame can actually carry
+FD_LENGTHS = [0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64]
 
 
 def to_macro_name(name):
@@ -87,6 +104,11 @@ def generate_header(json_data, input_filename, output_filename=DEFAULT_OUTPUT_FI
             # --- Start Generating Header Lines for Packet ---
             packet_macro_base = to_macro_name(packet_name)
             header_lines.append(f"// Packet: {packet_name}")
+            if packet.get("replaces"):
+                header_lines.append(
+                    "// CAN FD frame combining: "
+                    + ", ".join(f"0x{i:03X}" for i in packet["replaces"])
+                )
             if from_nodes:
                 header_lines.append(f"// From: {', '.join(str(n) for n in from_nodes)}")
             if to_nodes:
@@ -97,6 +119,11 @@ def generate_header(json_data, input_filename, output_filename=DEFAULT_OUTPUT_FI
             header_lines.append(f"#define {packet_macro_base}_DLC {data_length}")
             header_lines.append(f"#define {packet_macro_base}_FREQ {frequency_ms_int}")
             header_lines.append(f"#define {packet_macro_base}_QUANTITY {quantity}")
+            if packet.get("fd"):
+                header_lines.append(f"#define {packet_macro_base}_FD 1")
+                header_lines.append(
+                    f"#define {packet_macro_base}_BRS {1 if packet.get('brs') else 0}"
+                )
             header_lines.append("")
 
             # --- Process Each Byte/Signal in the Packet ---
@@ -261,6 +288,643 @@ def generate_header(json_data, input_filename, output_filename=DEFAULT_OUTPUT_FI
         exit(1)
 
 
+def parse_can_id(value):
+    """Accepts an ID as an int or a "0x..." string."""
+    if isinstance(value, int):
+        return value
+    return int(str(value), 0)
+
+
+def build_fd_groups(json_data, groups):
+    """Builds one CAN FD packet per group out of its member packets.
+
+    Each member's signals are laid out back to back in member order and
+    renamed "<prefix> <signal>", the payload is padded up to the next length
+    an FD frame can carry and the frame goes out at the fastest member rate.
+    The member packets themselves are left alone. Returns the new packets.
+    """
+    by_id = {p.get("packet_id"): p for p in json_data}
+    fd_packets = []
+
+    for group in groups:
+        try:
+            group_name = group["packet_name"]
+            group_id = parse_can_id(group["packet_id"])
+            members = group["members"]
+        except (KeyError, ValueError) as e:
+            print(f"Warning: Skipping FD group with missing/invalid key {e}.")
+            continue
+
+        if group_id in by_id:
+            print(
+                f"Warning: FD group '{group_name}' reuses ID 0x{group_id:03X} of '{by_id[group_id]['packet_name']}'. Skipping."
+            )
+            continue
+
+        offset = 0
+        signals = []
+        from_nodes, to_nodes, member_ids, freqs = [], [], [], []
+        ok = True
+        for member in members:
+            try:
+                member_id = parse_can_id(member["id"])
+            except (KeyError, ValueError) as e:
+                print(f"Warning: Invalid member {e} in FD group '{group_name}'. Skipping group.")
+                ok = False
+                break
+            packet = by_id.get(member_id)
+            if packet is None:
+                print(
+                    f"Warning: FD group '{group_name}' member 0x{member_id:03X} not found. Skipping group."
+                )
+                ok = False
+                break
+
+            prefix = member.get("prefix", packet["packet_name"])
+            for byte_info in packet.get("bytes", []):
+                signal = dict(byte_info)
+                signal["index"] = len(signals)
+                signal["start_byte"] = offset + byte_info.get("start_byte", 0)
+                signal["name"] = f"{prefix} {byte_info.get('name', 'field')}"
+                signals.append(signal)
+            offset += packet.get("data_length", 0)
+
+            for node in packet.get("from", []):
+                if node not in from_nodes:
+                    from_nodes.append(node)
+            for node in packet.get("to", []):
+                if node not in to_nodes:
+                    to_nodes.append(node)
+            member_ids.append(member_id)
+            if packet.get("frequency_ms"):
+                freqs.append(packet["frequency_ms"])
+        if not ok:
+            continue
+
+        if offset > FD_LENGTHS[-1]:
+            print(
+                f"Warning: FD group '{group_name}' needs {offset} bytes, more than one FD frame holds. Skipping."
+            )
+            continue
+        if len(from_nodes) > 1:
+            print(
+                f"Warning: FD group '{group_name}' mixes senders ({', '.join(from_nodes)}), one node has to send the whole frame."
+            )
+
+        fd_packets.append(
+            {
+                "packet_id": group_id,
+                "packet_name": group_name,
+                "from": from_nodes,
+                "to": to_nodes,
+                "data_length": next(n for n in FD_LENGTHS if n >= offset),
+                "frequency_ms": min(freqs) if freqs else None,
+                "quantity": 1,
+                "bytes": signals,
+                "fd": True,
+                "brs": bool(group.get("brs", True)),
+                "replaces": member_ids,
+            }
+        )
+
+    return fd_packets
+
+
+def to_c_identifier(name):
+    """Converts a readable name to a lowercase C identifier."""
+    ident = to_macro_name(name).lower()
+    if not ident or ident[0].isdigit():
+        ident = "_" + ident
+    return ident
+
+
+def format_float_literal(value):
+    """Formats a Python float as a C float literal that round-trips."""
+    text = repr(float(value))
+    if "e" not in text and "." not in text:
+        text += ".0"
+    return text + "f"
+
+
+def raw_range_literals(size, signed):
+    """The float literals a scaled signal saturates to before the cast: its
+    integer type's range, rounded inwards to values a float holds exactly
+    (so a 32-bit one stops short of 2^31 rather than overflowing)."""
+    magnitude_bits = size * 8 - (1 if signed else 0)
+    lo = -(1 << magnitude_bits) if signed else 0
+    hi = (1 << magnitude_bits) - 1
+    if magnitude_bits > 24:  # past a float's 24 bit mantissa
+        hi = (1 << magnitude_bits) - (1 << (magnitude_bits - 24))
+    return format_float_literal(lo), format_float_literal(hi)
+
+
+# Integer signal types the codec knows how to load/store: (C type, byte size)
+CODEC_INT_TYPES = {
+    "uint8": ("uint8_t", 1),
+    "int8": ("int8_t", 1),
+    "uint16": ("uint16_t", 2),
+    "int16": ("int16_t", 2),
+    "uint32": ("uint32_t", 4),
+    "int32": ("int32_t", 4),
+}
+
+
+def build_codec_fields(packet):
+    """Turns a packet's byte list into codec field descriptions.
+
+    Returns a list of dicts with keys: kind ("int", "scaled", "float",
+    "bitfield"), member, byte, and kind-specific extras. Signals that can't be
+    encoded come back as ("skip", reason) so the caller can leave a comment.
+    """
+    fields = []
+    used_members = set()
+    for byte_info in packet.get("bytes", []):
+        name = byte_info.get("name", "field")
+        member = to_c_identifier(name)
+        # a packet can repeat a readable name, keep members unique
+        base, suffix = member, 1
+        while member in used_members:
+            suffix += 1
+            member = f"{base}_{suffix}"
+        used_members.add(member)
+
+        conv_type = byte_info.get("conv_type")
+        start_byte = byte_info.get("start_byte", 0)
+        length = byte_info.get("length", 1)
+        field = {"member": member, "byte": start_byte, "name": name}
+
+        if conv_type == "bitfield":
+            bits = []
+            for bit_spec in byte_info.get("bitfield_encoding") or []:
+                bit_index = bit_spec.get("bit_index")
+                protobuf_field = bit_spec.get("protobuf_field")
+                if not isinstance(bit_index, int) or protobuf_field is None:
+                    continue
+                if bit_index < 0 or bit_index >= length * 8:
+                    continue
+                bits.append((to_c_identifier(protobuf_field), bit_index))
+            if not bits:
+                fields.append(("skip", f"{name}: bitfield has no usable bits"))
+                continue
+            field.update(kind="bitfield", bits=bits, length=length)
+        elif conv_type in ("float", "double"):
+            c_type = "float" if conv_type == "float" else "double"
+            field.update(kind="float", c_type=c_type, size=4 if c_type == "float" else 8)
+        elif conv_type in CODEC_INT_TYPES:
+            c_type, size = CODEC_INT_TYPES[conv_type]
+            try:
+                precision = float(byte_info.get("precision", 1.0))
+            except (TypeError, ValueError):
+                fields.append(("skip", f"{name}: invalid precision"))
+                continue
+            if precision == 0.0:
+                fields.append(("skip", f"{name}: zero precision"))
+                continue
+            field.update(c_type=c_type, size=size, signed=not c_type.startswith("u"))
+            if precision == 1.0:
+                field.update(kind="int")
+            else:
+                field.update(
+                    kind="scaled",
+                    prec=format_float_literal(precision),
+                    recip=format_float_literal(1.0 / precision),
+                    range=raw_range_literals(size, not c_type.startswith("u")),
+                )
+        else:
+            fields.append(("skip", f"{name}: unknown conversion type '{conv_type}'"))
+            continue
+
+        fields.append(field)
+    return fields
+
+
+def batch_runs(fields):
+    """Groups a packet's 16-bit integer signals for <packet>_unpack_f32.
+
+    Returns (signals, runs): the signals in payload order, which is also
+    their order in the float vector, and runs of back to back signals of
+    the same signedness as (signed, first vector index, byte, count). Each
+    run becomes one kernel call.
+    """
+    signals = [
+        f for f in fields
+        if not isinstance(f, tuple) and f["kind"] in ("int", "scaled") and f["size"] == 2
+    ]
+    signals.sort(key=lambda f: f["byte"])
+    runs = []
+    for index, f in enumerate(signals):
+        last = runs[-1] if runs else None
+        if (last and last[0] == f["signed"]
+                and last[2] + 2 * last[3] == f["byte"]):
+            runs[-1] = (last[0], last[1], last[2], last[3] + 1)
+        else:
+            runs.append((f["signed"], index, f["byte"], 1))
+    return signals, runs
+
+
+# Shared by every <packet>_unpack_f32, emitted once at the top of the codec
+BATCH_KERNELS = """\
+// --- Batch decode ---
+// <packet>_unpack_f32() converts all of a packet's 16-bit signals to floats
+// in one pass, into a vector laid out by the packet's <PACKET>_F32_* indices
+// and scaled by <packet>_f32_scale. The kernels below load two signals per
+// 32-bit word and split them with SXTH/ASR (UXTH/LSR unsigned), the run
+// lengths are constants so they unroll into straight line code. Define
+// NIGHTCAN_CMSIS_DSP to do the signed runs with arm_q15_to_float and
+// arm_mult_f32 instead (the scale entries of signed signals then carry the
+// 2^15 that arm_q15_to_float divides out).
+#ifdef NIGHTCAN_CMSIS_DSP
+#include "arm_math.h"
+#define CAN_BATCH_SCALE(precision) ((precision) * 32768.0f)  // signed only
+#else
+#define CAN_BATCH_SCALE(precision) (precision)
+#endif
+
+// n back to back little-endian int16 signals at data, times scale
+static inline void can_batch_i16_to_f32(float *out, const uint8_t *data,
+                                        uint32_t n, const float *scale) {
+#ifdef NIGHTCAN_CMSIS_DSP
+    arm_q15_to_float((const q15_t *)data, out, n);
+    arm_mult_f32(out, scale, out, n);
+#else
+    uint32_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        uint32_t word;
+        memcpy(&word, data + 2 * i, sizeof(word));
+        out[i] = (float)(int16_t)word * scale[i];
+        out[i + 1] = (float)((int32_t)word >> 16) * scale[i + 1];
+    }
+    if (i < n) {
+        int16_t raw;
+        memcpy(&raw, data + 2 * i, sizeof(raw));
+        out[i] = (float)raw * scale[i];
+    }
+#endif
+}
+
+// the same for uint16 signals (CMSIS-DSP has no unsigned q15)
+static inline void can_batch_u16_to_f32(float *out, const uint8_t *data,
+                                        uint32_t n, const float *scale) {
+    uint32_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        uint32_t word;
+        memcpy(&word, data + 2 * i, sizeof(word));
+        out[i] = (float)(word & 0xFFFFU) * scale[i];
+        out[i + 1] = (float)(word >> 16) * scale[i + 1];
+    }
+    if (i < n) {
+        uint16_t raw;
+        memcpy(&raw, data + 2 * i, sizeof(raw));
+        out[i] = (float)raw * scale[i];
+    }
+}
+"""
+
+
+def generate_codec(json_data, input_filename, codec_filename=DEFAULT_CODEC_FILENAME):
+    """Generates typed structs and static inline pack/unpack functions.
+
+    Loads and stores go through fixed-size memcpy into a typed local, which
+    the compiler turns into a single (possibly unaligned) LDR/STR on
+    Cortex-M, and scale factors are emitted as literals so a decode is a
+    convert and a multiply per signal with no runtime division.
+    """
+    lines = []
+    header_guard = os.path.basename(codec_filename).upper().replace(".", "_")
+
+    lines.append(f"#ifndef {header_guard}")
+    lines.append(f"#define {header_guard}")
+    lines.append("")
+    lines.append("// Auto-generated CAN packet codec")
+    lines.append(f"// Generated from: {input_filename}")
+    lines.append("// DO NOT EDIT MANUALLY")
+    lines.append("//")
+    lines.append("// <packet>_unpack() decodes a payload into <packet>_t, <packet>_pack()")
+    lines.append("// encodes one. Scaled signals are floats in engineering units and are")
+    lines.append("// rounded to the nearest step when packed. Payloads are little-endian.")
+    lines.append("// Packets with two or more 16-bit signals also get <packet>_unpack_f32(),")
+    lines.append("// see Batch decode below.")
+    lines.append("")
+    lines.append("#include <stdbool.h>")
+    lines.append("#include <stdint.h>")
+    lines.append("#include <string.h> // memcpy, folds into a plain load/store")
+    lines.append("")
+    lines.extend(BATCH_KERNELS.splitlines())
+    lines.append("")
+
+    for packet in json_data:
+        try:
+            packet_name = packet["packet_name"]
+        except KeyError:
+            continue
+
+        fields = build_codec_fields(packet)
+        usable = [f for f in fields if not isinstance(f, tuple)]
+        if not usable:
+            continue
+
+        ident = to_c_identifier(packet_name)
+        lines.append(f"// Packet: {packet_name}")
+        for f in fields:
+            if isinstance(f, tuple):
+                lines.append(f"// Warning: skipped {f[1]}")
+
+        # --- Typed struct ---
+        lines.append("typedef struct {")
+        for f in usable:
+            if f["kind"] == "bitfield":
+                lines.append("    struct {")
+                for bit_name, _ in f["bits"]:
+                    lines.append(f"        bool {bit_name};")
+                lines.append(f"    }} {f['member']};")
+            elif f["kind"] == "scaled":
+                lines.append(f"    float {f['member']};")
+            else:
+                lines.append(f"    {f['c_type']} {f['member']};")
+        lines.append(f"}} {ident}_t;")
+        lines.append("")
+
+        # --- Unpack ---
+        lines.append(f"static inline void {ident}_unpack({ident}_t *out, const uint8_t *data) {{")
+        for f in usable:
+            if f["kind"] == "bitfield":
+                lines.append(f"    {{")
+                lines.append(f"        uint8_t bits = data[{f['byte']}];")
+                for bit_name, bit_index in f["bits"]:
+                    lines.append(f"        out->{f['member']}.{bit_name} = (bits >> {bit_index}) & 1U;")
+                lines.append(f"    }}")
+            elif f["kind"] == "scaled":
+                lines.append(f"    {{")
+                lines.append(f"        {f['c_type']} raw;")
+                lines.append(f"        memcpy(&raw, data + {f['byte']}, sizeof(raw));")
+                lines.append(f"        out->{f['member']} = (float)raw * {f['prec']};")
+                lines.append(f"    }}")
+            else:
+                lines.append(f"    memcpy(&out->{f['member']}, data + {f['byte']}, sizeof(out->{f['member']}));")
+        lines.append("}")
+        lines.append("")
+
+        # --- Pack ---
+        lines.append(f"static inline void {ident}_pack(const {ident}_t *in, uint8_t *data) {{")
+        for f in usable:
+            if f["kind"] == "bitfield":
+                parts = [f"((uint8_t)in->{f['member']}.{b} << {i})" for b, i in f["bits"]]
+                lines.append(f"    data[{f['byte']}] = (uint8_t)(")
+                for i, part in enumerate(parts):
+                    sep = " |" if i < len(parts) - 1 else ");"
+                    lines.append(f"        {part}{sep}")
+            elif f["kind"] == "scaled":
+                lines.append(f"    {{")
+                lo, hi = f["range"]
+                lines.append(f"        float scaled = in->{f['member']} * {f['recip']};")
+                # saturate, an out of range (or NaN) float to int cast is undefined
+                lines.append(f"        if (!(scaled > {lo})) scaled = {lo};")
+                lines.append(f"        else if (scaled > {hi}) scaled = {hi};")
+                if f["signed"]:
+                    lines.append(f"        {f['c_type']} raw = ({f['c_type']})(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));")
+                else:
+                    lines.append(f"        {f['c_type']} raw = ({f['c_type']})(scaled + 0.5f);")
+                lines.append(f"        memcpy(data + {f['byte']}, &raw, sizeof(raw));")
+                lines.append(f"    }}")
+            else:
+                lines.append(f"    memcpy(data + {f['byte']}, &in->{f['member']}, sizeof(in->{f['member']}));")
+        lines.append("}")
+        lines.append("")
+
+        # --- Batch unpack, for packets with several 16-bit signals ---
+        signals, runs = batch_runs(fields)
+        if len(signals) >= 2:
+            macro = ident.upper()
+            lines.append(f"// {ident}_unpack_f32() vector layout")
+            lines.append("enum {")
+            for index, f in enumerate(signals):
+                lines.append(f"    {macro}_F32_{f['member'].upper()} = {index},")
+            lines.append(f"    {macro}_F32_COUNT = {len(signals)}")
+            lines.append("};")
+            lines.append("")
+            lines.append(f"static const float {ident}_f32_scale[{macro}_F32_COUNT] = {{")
+            for f in signals:
+                prec = f["prec"] if f["kind"] == "scaled" else "1.0f"
+                entry = f"CAN_BATCH_SCALE({prec})" if f["signed"] else prec
+                lines.append(f"    {entry},")
+            lines.append("};")
+            lines.append("")
+            lines.append(f"static inline void {ident}_unpack_f32(float out[{macro}_F32_COUNT], const uint8_t *data) {{")
+            for signed, index, byte, count in runs:
+                kernel = "can_batch_i16_to_f32" if signed else "can_batch_u16_to_f32"
+                lines.append(f"    {kernel}(out + {index}, data + {byte}, {count}, {ident}_f32_scale + {index});")
+            lines.append("}")
+            lines.append("")
+
+        lines.append("// End Packet: " + packet_name)
+        lines.append("")
+
+    lines.append(f"#endif // {header_guard}")
+    lines.append("")
+
+    try:
+        with open(codec_filename, "w") as f:
+            f.write("\n".join(lines))
+        print(f"Successfully generated '{codec_filename}' from '{input_filename}'")
+    except IOError as e:
+        print(f"Error writing to output file '{codec_filename}': {e}")
+        exit(1)
+
+
+def split_nodes(nodes):
+    """Node names out of a from/to list, where one entry can hold several
+    ("HVC, VCU, Upright") and "*" (escaped as "\\*" in the sheet) is
+    everyone."""
+    names = []
+    for entry in nodes:
+        for name in str(entry).split(","):
+            name = name.strip().replace("\\", "")
+            if name and name not in names:
+                names.append(name)
+    return names
+
+
+def board_names(json_data):
+    """Every node the sheet mentions, in order of first appearance."""
+    names = []
+    for packet in json_data:
+        for name in split_nodes(packet.get("from", []) + packet.get("to", [])):
+            if name != "*" and name not in names:
+                names.append(name)
+    return names
+
+
+def expand_packet(packet):
+    """(id, name) of every frame a packet stands for. Quantity N means N
+    consecutive IDs (0x210 x 35 is 0x210 to 0x232)."""
+    quantity = packet.get("quantity") or 1
+    if quantity == 1:
+        return [(packet["packet_id"], packet["packet_name"])]
+    return [
+        (packet["packet_id"] + i, f"{packet['packet_name']} [{i}]")
+        for i in range(quantity)
+    ]
+
+
+def stagger_phases(tx_entries):
+    """Gives every periodic entry the phase CAN_AddTxPacket would have picked
+    with CAN_TX_PHASE_AUTO (tx_pick_phase), adding them in ID order."""
+    placed = []
+    for entry in tx_entries:
+        interval = entry["interval_ms"]
+        if not interval:
+            continue
+        best_phase, best_cost = 0, None
+        slots = min(interval, TX_STAGGER_MAX_SLOTS)
+        for phase in range(0, slots * (interval // slots), interval // slots):
+            cost = 0
+            for other in placed:
+                g = math.gcd(interval, other["interval_ms"])
+                if other["phase_ms"] % g == phase % g:
+                    cost += (g * 1024) // other["interval_ms"]
+            if best_cost is None or cost < best_cost:
+                best_phase, best_cost = phase, cost
+                if cost == 0:
+                    break
+        entry["phase_ms"] = best_phase
+        placed.append(entry)
+
+
+def board_tables(json_data, board, timeout_periods):
+    """The inboxes and TX packets of one board, both sorted by ID (so the
+    standard IDs come first)."""
+    rx, tx = {}, {}
+    for packet in json_data:
+        if packet.get("fd"):
+            continue  # FD groups depend on NIGHTCAN_FD, register those by hand
+        if to_macro_name(packet["packet_name"]) in DRIVER_HANDLED_PACKETS:
+            continue
+        senders = split_nodes(packet.get("from", []))
+        receivers = split_nodes(packet.get("to", []))
+        interval_ms = packet.get("frequency_ms") or 0
+        dlc = packet.get("data_length", 0)
+
+        for frame_id, name in expand_packet(packet):
+            if board in senders:
+                tx[frame_id] = {
+                    "id": frame_id,
+                    "name": name,
+                    "dlc": dlc,
+                    "interval_ms": interval_ms,
+                    "phase_ms": 0,
+                }
+            elif board in receivers or "*" in receivers:
+                rx[frame_id] = {
+                    "id": frame_id,
+                    "name": name,
+                    "dlc": dlc,
+                    "timeout_ms": interval_ms * timeout_periods,
+                }
+
+    rx_entries = [rx[i] for i in sorted(rx)]
+    tx_entries = [tx[i] for i in sorted(tx)]
+    stagger_phases(tx_entries)
+    return rx_entries, tx_entries
+
+
+def generate_boards(json_data, input_filename, basename, timeout_periods):
+    """Generates the per-board constant driver configuration used with
+    NIGHTCAN_STATIC_CONFIG: <basename>.h sizes the driver for the board picked
+    with NIGHTCAN_BOARD_<NODE>, <basename>.c holds its tables in flash."""
+    header_filename = basename + ".h"
+    source_filename = basename + ".c"
+    header_guard = os.path.basename(header_filename).upper().replace(".", "_")
+    boards = board_names(json_data)
+    tables = {b: board_tables(json_data, b, timeout_periods) for b in boards}
+
+    h = []
+    h.append(f"#ifndef {header_guard}")
+    h.append(f"#define {header_guard}")
+    h.append("")
+    h.append("// Auto-generated per-board CAN configuration sizes")
+    h.append(f"// Generated from: {input_filename}")
+    h.append("// DO NOT EDIT MANUALLY")
+    h.append("//")
+    h.append("// With NIGHTCAN_STATIC_CONFIG, define one NIGHTCAN_BOARD_<NODE> to pick")
+    h.append(f"// the board. Its tables are in {os.path.basename(source_filename)}.")
+    h.append("")
+    for i, board in enumerate(boards):
+        rx, tx = tables[board]
+        macro = to_macro_name(board)
+        h.append(f"{'#if' if i == 0 else '#elif'} defined(NIGHTCAN_BOARD_{macro})")
+        h.append(f'#define NIGHTCAN_BOARD_NAME "{board}"')
+        h.append(f"#define NIGHTCAN_BOARD_RX_COUNT {len(rx)}")
+        h.append(
+            f"#define NIGHTCAN_BOARD_RX_STD_COUNT {sum(1 for e in rx if e['id'] <= 0x7FF)}"
+        )
+        h.append(f"#define NIGHTCAN_BOARD_TX_COUNT {len(tx)}")
+        h.append(
+            f"#define NIGHTCAN_BOARD_TX_PERIODIC_COUNT {sum(1 for e in tx if e['interval_ms'])}"
+        )
+    h.append("#elif defined(NIGHTCAN_STATIC_CONFIG)")
+    h.append(
+        '#error "NIGHTCAN_STATIC_CONFIG needs one of: '
+        + ", ".join(f"NIGHTCAN_BOARD_{to_macro_name(b)}" for b in boards)
+        + '"'
+    )
+    h.append("#endif")
+    h.append("")
+    h.append(f"#endif // {header_guard}")
+    h.append("")
+
+    c = []
+    c.append("// Auto-generated per-board CAN configuration tables")
+    c.append(f"// Generated from: {input_filename}")
+    c.append("// DO NOT EDIT MANUALLY")
+    c.append("//")
+    c.append("// Both tables are sorted by ID. RX timeouts are "
+             f"{timeout_periods} periods of the packet, 0 (off) for")
+    c.append("// packets without a rate. TX phases are staggered the same way")
+    c.append("// CAN_TX_PHASE_AUTO would have done it at runtime.")
+    c.append("")
+    c.append('#include "night_can.h"')
+    c.append("")
+    c.append("#ifdef NIGHTCAN_STATIC_CONFIG")
+    for i, board in enumerate(boards):
+        rx, tx = tables[board]
+        c.append(
+            f"{'#if' if i == 0 else '#elif'} defined(NIGHTCAN_BOARD_{to_macro_name(board)})"
+        )
+        c.append("")
+        c.append("const NightCANRxConfig night_can_board_rx[] = {")
+        for e in rx:
+            c.append(
+                f"    {{.id = 0x{e['id']:03X}, .timeout_ms = {e['timeout_ms']}, "
+                f".dlc = {e['dlc']}}},  // {e['name']}"
+            )
+        if not rx:
+            c.append("    {0},  // nothing, the table just can't be empty")
+        c.append("};")
+        c.append("")
+        c.append("const NightCANTxConfig night_can_board_tx[] = {")
+        for e in tx:
+            c.append(
+                f"    {{.id = 0x{e['id']:03X}, .interval_ms = {e['interval_ms']}, "
+                f".phase_ms = {e['phase_ms']}, .dlc = {e['dlc']}}},  // {e['name']}"
+            )
+        if not tx:
+            c.append("    {0},  // nothing, the table just can't be empty")
+        c.append("};")
+        c.append("")
+    c.append("#endif")
+    c.append("#endif // NIGHTCAN_STATIC_CONFIG")
+    c.append("")
+
+    for filename, lines in ((header_filename, h), (source_filename, c)):
+        try:
+            with open(filename, "w") as f:
+                f.write("\n".join(lines))
+            print(f"Successfully generated '{filename}' from '{input_filename}'")
+        except IOError as e:
+            print(f"Error writing to output file '{filename}': {e}")
+            exit(1)
+
+
 # --- Main Execution ---
 if __name__ == "__main__":
     parser = argparse.ArgumentParser(
@@ -272,9 +936,37 @@ if __name__ == "__main__":
         default=DEFAULT_OUTPUT_FILENAME,
         help=f"Path to the output C header file (default: {DEFAULT_OUTPUT_FILENAME})",
     )
+    parser.add_argument(
+        "--codec-output",
+        default=None,
+        help=f"Path to the generated pack/unpack header (default: {DEFAULT_CODEC_FILENAME} next to the ID header)",
+    )
+
+    parser.add_argument(
+        "--boards-output",
+        default=None,
+        help=f"Path without extension of the generated per-board config (default: {DEFAULT_BOARDS_BASENAME}.h/.c next to the ID header)",
+    )
+    parser.add_argument(
+        "--timeout-periods",
+        type=int,
+        default=DEFAULT_TIMEOUT_PERIODS,
+        help=f"Inbox timeout in periods of the packet for the board configs (default: {DEFAULT_TIMEOUT_PERIODS})",
+    )
+    parser.add_argument(
+        "--fd-groups",
+        default=DEFAULT_FD_GROUPS_FILENAME,
+        help=f"JSON list of packets to combine into CAN FD frames (default: {DEFAULT_FD_GROUPS_FILENAME}, skipped if missing)",
+    )
 
     args = parser.parse_args()
     output_file = args.output
+    codec_file = args.codec_output or os.path.join(
+        os.path.dirname(output_file), DEFAULT_CODEC_FILENAME
+    )
+    boards_base = args.boards_output or os.path.join(
+        os.path.dirname(output_file), DEFAULT_BOARDS_BASENAME
+    )
 
     input_file = DEFAULT_INPUT_FILENAME
     try:
@@ -300,4 +992,15 @@ if __name__ == "__main__":
         )
         exit(1)
 
+    if os.path.exists(args.fd_groups):
+        try:
+            with open(args.fd_groups, "r") as f:
+                fd_groups = json.load(f)
+        except (IOError, json.JSONDecodeError) as e:
+            print(f"Error reading FD groups '{args.fd_groups}': {e}")
+            exit(1)
+        can_data = can_data + build_fd_groups(can_data, fd_groups)
+
     generate_header(can_data, input_file, output_file)
+    generate_codec(can_data, input_file, codec_file)
+    generate_boards(can_data, input_file, boards_base, args.timeout_periods)
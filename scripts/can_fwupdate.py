@@ -0,0 +1,189 @@
+"""Sends a firmware image to a board over CAN (can_fwupdate.h, NIGHTCAN_FW_UPDATE).
+
+The image is cut into 256 byte chunks. Each one goes out as a meta frame
+(0x031: address MSB first, length with 0 = 256, CRC-16/CCITT-FALSE MSB first,
+target node) followed by its data frames (0x004, 8 bytes each). The node
+answers on 0x032 (node, status, address MSB first, frames received). The next
+chunk is sent as soon as the last one is RECEIVED; programming it happens on
+the board in the background and is reported later with WRITTEN.
+
+The rest of the bus is silenced (0x020) for the update unless --no-silence.
+--reset sends the reset meta (address 0xFFFFFFFF) once everything is written.
+
+Only the chunks are checked. Nothing here or in the library validates or
+boots the written region, see can_fwupdate.h.
+
+Needs python-can, on the Pi that's SocketCAN:
+  python3 can_fwupdate.py image.bin --address 0x08100000 --node 2 [--reset]
+      [--channel can0] [--interface socketcan]
+"""
+import argparse
+import struct
+import sys
+import time
+
+META_ID = 0x031
+DATA_ID = 0x004
+ACK_ID = 0x032
+BUS_ENABLE_ID = 0x020
+
+CHUNK_SIZE = 256
+ADDR_RESET = 0xFFFFFFFF
+
+ACK_RECEIVED = 0
+ACK_WRITTEN = 1
+ACK_RESEND = 2
+ACK_BUSY = 3
+ACK_REJECTED = 4
+ACK_FLASH_ERROR = 5
+ACK_RESETTING = 6
+
+ACK_TIMEOUT_S = 0.5   # for RECEIVED / RESEND / BUSY after a chunk
+WRITE_TIMEOUT_S = 5   # for WRITTEN, an H7 sector erase alone takes ~2 s
+BUSY_RETRY_S = 0.02   # wait before resending a chunk both buffers refused
+MAX_TRIES = 8         # sends of one chunk before giving up
+
+
+def crc16_ccitt(data):
+    """CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF), same as the board's."""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def meta_frame(address, chunk, node):
+    length = len(chunk) if len(chunk) < CHUNK_SIZE else 0
+    crc = crc16_ccitt(chunk) if chunk else 0
+    return struct.pack(">IBHB", address, length, crc, node)
+
+
+class Updater:
+    def __init__(self, bus, message, node):
+        self.bus = bus
+        self.message = message  # can.Message
+        self.node = node
+        self.unwritten = set()  # addresses RECEIVED but not WRITTEN yet
+
+    def send(self, can_id, data):
+        self.bus.send(self.message(arbitration_id=can_id, data=data,
+                                   is_extended_id=False))
+
+    def wait_ack(self, timeout):
+        """Next ack from our node as (status, address, frames), or None.
+        WRITTEN / FLASH_ERROR for earlier chunks are handled on the way."""
+        deadline = time.monotonic() + timeout
+        while True:
+            left = deadline - time.monotonic()
+            if left <= 0:
+                return None
+            msg = self.bus.recv(left)
+            if msg is None:
+                return None
+            if msg.arbitration_id != ACK_ID or len(msg.data) < 7:
+                continue
+            node, status, address, frames = struct.unpack_from(">BBIB",
+                                                               msg.data)
+            if node != self.node:
+                continue
+            if status == ACK_WRITTEN:
+                self.unwritten.discard(address)
+                continue
+            if status == ACK_FLASH_ERROR:
+                sys.exit(f"0x{address:08X}: flash error on the board")
+            return status, address, frames
+
+    def send_chunk(self, address, chunk):
+        for _ in range(MAX_TRIES):
+            self.send(META_ID, meta_frame(address, chunk, self.node))
+            for i in range(0, len(chunk), 8):
+                self.send(DATA_ID, chunk[i:i + 8])
+
+            ack = self.wait_ack(ACK_TIMEOUT_S)
+            if ack is None:
+                continue  # lost, send it again
+            status, ack_address, frames = ack
+            if ack_address != address:
+                continue  # a late answer to an earlier try
+            if status == ACK_RECEIVED:
+                self.unwritten.add(address)
+                return
+            if status == ACK_REJECTED:
+                sys.exit(f"0x{address:08X}: rejected, outside the board's "
+                         "update region or misaligned")
+            if status == ACK_BUSY:
+                time.sleep(BUSY_RETRY_S)
+            elif status == ACK_RESEND:
+                print(f"0x{address:08X}: {frames} frames arrived, resending",
+                      file=sys.stderr)
+        sys.exit(f"0x{address:08X}: no luck after {MAX_TRIES} tries")
+
+    def wait_written(self):
+        deadline = time.monotonic() + WRITE_TIMEOUT_S
+        while self.unwritten and time.monotonic() < deadline:
+            self.wait_ack(deadline - time.monotonic())
+        if self.unwritten:
+            first = min(self.unwritten)
+            sys.exit(f"{len(self.unwritten)} chunks never reported written, "
+                     f"first at 0x{first:08X}")
+
+    def reset(self):
+        self.send(META_ID, meta_frame(ADDR_RESET, b"", self.node))
+        ack = self.wait_ack(WRITE_TIMEOUT_S)
+        if ack is None or ack[0] != ACK_RESETTING:
+            sys.exit("board didn't confirm the reset")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("image", help="raw binary to write")
+    parser.add_argument("--address", required=True, type=lambda s: int(s, 0),
+                        help="flash address the image starts at")
+    parser.add_argument("--node", required=True, type=int,
+                        help="node number the board passed can_fwupdate_init")
+    parser.add_argument("--channel", default="can0")
+    parser.add_argument("--interface", default="socketcan")
+    parser.add_argument("--reset", action="store_true",
+                        help="reset the board once everything is written")
+    parser.add_argument("--no-silence", action="store_true",
+                        help="leave the rest of the bus running")
+    args = parser.parse_args()
+
+    with open(args.image, "rb") as f:
+        image = f.read()
+    if not image:
+        sys.exit("empty image")
+
+    import can
+
+    with can.Bus(channel=args.channel, interface=args.interface,
+                 receive_own_messages=False) as bus:
+        bus.set_filters([{"can_id": ACK_ID, "can_mask": 0x7FF}])
+        updater = Updater(bus, can.Message, args.node)
+        if not args.no_silence:
+            updater.send(BUS_ENABLE_ID, b"\x01")
+
+        try:
+            start = time.monotonic()
+            for offset in range(0, len(image), CHUNK_SIZE):
+                updater.send_chunk(args.address + offset,
+                                   image[offset:offset + CHUNK_SIZE])
+                print(f"\r{min(offset + CHUNK_SIZE, len(image))}"
+                      f"/{len(image)} bytes", end="", file=sys.stderr)
+            updater.wait_written()
+            elapsed = time.monotonic() - start
+            print(f"\nwritten in {elapsed:.1f} s", file=sys.stderr)
+
+            if args.reset:
+                updater.reset()
+                print("board is resetting", file=sys.stderr)
+        finally:
+            if not args.no_silence:
+                updater.send(BUS_ENABLE_ID, b"\x00")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,425 @@
+"""Reads and writes the binary CAN logs described in can_log.h.
+
+A log is a header, then fixed size frame records in time order with a
+trailer after every block of them (time range and an ID bitmap), so a log
+is opened with mmap and searched without reading it: a time is a binary
+search over the block trailers, and an ID filter skips every block whose
+bitmap doesn't have it. Frames come from a board's own log (NIGHTCAN_LOG,
+e.g. on its SD card), the simulator (night_can_bench --record) or the USB
+telemetry stream, which this converts.
+
+Usage:
+  python3 can_log.py record [PORT] -o out.nclog      # live telemetry
+  python3 can_log.py convert capture.bin -o out.nclog  # can_telemetry.py --save
+  python3 can_log.py info LOG
+  python3 can_log.py dump LOG [--start S] [--end S] [--id ID ...] [--bus N]
+                          [--decode] [--csv out.csv]
+--start / --end are seconds from the start of the log. Replay a log into
+the simulated bus with sim's night_can_replay.
+"""
+import argparse
+import bisect
+import csv
+import json
+import mmap
+import os
+import struct
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import can_telemetry  # the telemetry stream decoder (same flag bits)
+
+VERSION = 1
+BLOCK_RECORDS = 256
+ID_BITS = 2048
+
+FLAG_TX = 0x01
+FLAG_EXT = 0x02
+FLAG_FD = 0x04
+FLAG_BRS = 0x08
+
+HEADER = struct.Struct("<4sHHIIQQ")
+RECORD_HEAD = struct.Struct("<QIBBBB")
+TRAILER_HEAD = struct.Struct("<4sIQQ")
+TRAILER_SIZE = TRAILER_HEAD.size + ID_BITS // 8
+CLASSIC_RECORD = RECORD_HEAD.size + 8
+FD_RECORD = RECORD_HEAD.size + 64
+
+DEFAULT_JSON = can_telemetry.DEFAULT_JSON
+
+
+def id_bit(can_id):
+    """Same as can_log_id_bit() in can_log.h."""
+    if can_id <= 0x7FF:
+        return can_id
+    return (can_id ^ (can_id >> 11) ^ (can_id >> 22)) & (ID_BITS - 1)
+
+
+class LogWriter:
+    """Writes a log the way can_log.c does."""
+
+    def __init__(self, f, fd=False, start_unix_us=0):
+        self.f = f
+        self.record_size = FD_RECORD if fd else CLASSIC_RECORD
+        self.record = struct.Struct(f"<QIBBBB{self.record_size - RECORD_HEAD.size}s")
+        self.frames = 0
+        self.late = 0
+        self.last_us = 0
+        self._new_block()
+        f.write(HEADER.pack(b"NCLG", VERSION, self.record_size, BLOCK_RECORDS,
+                            0, start_unix_us, 0))
+
+    def _new_block(self):
+        self.count = 0
+        self.first_us = 0
+        self.ids = bytearray(ID_BITS // 8)
+
+    def frame(self, time_us, can_id, flags, data, bus=0):
+        if self.frames and time_us < self.last_us:
+            time_us = self.last_us
+            self.late += 1
+        if can_id > 0x7FF:
+            flags |= FLAG_EXT
+        data = bytes(data[:self.record_size - RECORD_HEAD.size])
+        self.f.write(self.record.pack(time_us, can_id, flags, len(data), bus,
+                                      0, data))
+        if self.count == 0:
+            self.first_us = time_us
+        bit = id_bit(can_id)
+        self.ids[bit // 8] |= 1 << (bit % 8)
+        self.last_us = time_us
+        self.frames += 1
+        self.count += 1
+        if self.count == BLOCK_RECORDS:
+            self.f.write(TRAILER_HEAD.pack(b"NCBK", self.count, self.first_us,
+                                           self.last_us) + bytes(self.ids))
+            self._new_block()
+
+
+class CanLog:
+    """A log mapped into memory. Records are indexed from 0 in time order."""
+
+    def __init__(self, path):
+        self.file = open(path, "rb")
+        size = os.fstat(self.file.fileno()).st_size
+        if size < HEADER.size:
+            raise ValueError(f"{path}: not a CAN log")
+        self.map = mmap.mmap(self.file.fileno(), 0, access=mmap.ACCESS_READ)
+        (magic, version, self.record_size, self.block_records, _,
+         self.start_unix_us, _) = HEADER.unpack_from(self.map, 0)
+        if (magic != b"NCLG" or version != VERSION or self.block_records == 0
+                or self.record_size not in (CLASSIC_RECORD, FD_RECORD)):
+            raise ValueError(f"{path}: not a version {VERSION} CAN log")
+
+        self.fd = self.record_size == FD_RECORD
+        self.record = struct.Struct(
+            f"<QIBBBB{self.record_size - RECORD_HEAD.size}s")
+        self.block_bytes = self.block_records * self.record_size + TRAILER_SIZE
+        body = size - HEADER.size
+        self.full_blocks = body // self.block_bytes
+        rest = min((body % self.block_bytes) // self.record_size,
+                   self.block_records)
+
+        # first time of every block, for the binary search. A bad trailer
+        # (a writer that carried on after failing to write one) ends the
+        # log: its block's records are fine, what follows is misaligned
+        self.block_first = []
+        for b in range(self.full_blocks):
+            try:
+                self.block_first.append(self._trailer(b)[1])
+            except ValueError:
+                print(f"{path}: bad trailer after block {b}, "
+                      "reading up to there", file=sys.stderr)
+                self.full_blocks = b
+                rest = self.block_records
+                break
+        self.records = self.full_blocks * self.block_records + rest
+        self.blocks = self.full_blocks + (1 if rest else 0)
+        if rest:
+            self.block_first.append(self._time(self.full_blocks * self.block_records))
+
+    def close(self):
+        self.map.close()
+        self.file.close()
+
+    def _offset(self, index):
+        block, i = divmod(index, self.block_records)
+        return HEADER.size + block * self.block_bytes + i * self.record_size
+
+    def _time(self, index):
+        return struct.unpack_from("<Q", self.map, self._offset(index))[0]
+
+    def _trailer(self, block):
+        offset = (HEADER.size + block * self.block_bytes +
+                  self.block_records * self.record_size)
+        magic, count, first_us, last_us = TRAILER_HEAD.unpack_from(self.map, offset)
+        if magic != b"NCBK":
+            raise ValueError(f"block {block}: bad trailer")
+        ids = self.map[offset + TRAILER_HEAD.size:offset + TRAILER_SIZE]
+        return count, first_us, last_us, ids
+
+    def block_may_have(self, block, id_bits):
+        """False if the block's bitmap rules out all of id_bits."""
+        if block >= self.full_blocks:
+            return True  # still being written, no bitmap yet
+        ids = self._trailer(block)[3]
+        return any(ids[b // 8] >> (b % 8) & 1 for b in id_bits)
+
+    def first_us(self):
+        return self._time(0) if self.records else 0
+
+    def find(self, time_us):
+        """Index of the first record at or after time_us."""
+        block = max(bisect.bisect_right(self.block_first, time_us) - 1, 0)
+        lo = block * self.block_records
+        hi = min(lo + self.block_records, self.records)
+        while lo < hi:
+            mid = (lo + hi) // 2
+            if self._time(mid) < time_us:
+                lo = mid + 1
+            else:
+                hi = mid
+        return lo
+
+    def frames(self, start_us=None, end_us=None, ids=None, bus=None):
+        """Yields (time_us, id, flags, bus, data) in order.
+
+        Whole blocks go through struct.iter_unpack, and with ids set the
+        blocks their bitmaps rule out aren't touched at all.
+        """
+        first = self.find(start_us) if start_us is not None else 0
+        id_set = set(ids) if ids else None
+        id_bits = {id_bit(i) for i in ids} if ids else None
+
+        block = first // self.block_records
+        skip = first % self.block_records
+        while block < self.blocks:
+            if block < len(self.block_first) and end_us is not None \
+                    and self.block_first[block] >= end_us:
+                return
+            begin = block * self.block_records
+            count = min(self.block_records, self.records - begin)
+            if id_bits is None or self.block_may_have(block, id_bits):
+                offset = self._offset(begin)
+                chunk = self.map[offset:offset + count * self.record_size]
+                for i, (t, can_id, flags, length, rec_bus, _, data) in \
+                        enumerate(self.record.iter_unpack(chunk)):
+                    if i < skip:
+                        continue
+                    if end_us is not None and t >= end_us:
+                        return
+                    if id_set is not None and can_id not in id_set:
+                        continue
+                    if bus is not None and rec_bus != bus:
+                        continue
+                    yield t, can_id, flags, rec_bus, data[:length]
+            skip = 0
+            block += 1
+
+
+# --- can_packets.json decoding ---
+
+SIGNAL_FORMATS = {
+    "uint8": "B", "int8": "b", "uint16": "H", "int16": "h",
+    "uint32": "I", "int32": "i", "float": "f", "double": "d",
+}
+
+
+def load_schema(path):
+    """ID -> (packet name, [(signal name, Struct, offset, precision)])."""
+    try:
+        with open(path) as f:
+            packets = json.load(f)
+    except (OSError, ValueError):
+        return {}
+
+    schema = {}
+    for packet in packets:
+        try:
+            can_id = packet["packet_id"]
+            name = packet["packet_name"]
+        except KeyError:
+            continue
+        signals = []
+        for byte_info in packet.get("bytes", []):
+            fmt = SIGNAL_FORMATS.get(byte_info.get("conv_type"))
+            if fmt is None:
+                continue
+            try:
+                precision = float(byte_info.get("precision", 1.0))
+            except (TypeError, ValueError):
+                precision = 1.0
+            signals.append((byte_info.get("name", "field"),
+                            struct.Struct("<" + fmt),
+                            byte_info.get("start_byte", 0), precision))
+        schema[can_id] = (name, signals)
+    return schema
+
+
+def decode(schema, can_id, data):
+    """[(signal name, value)] of a payload, the signals it's long enough for."""
+    entry = schema.get(can_id)
+    if not entry:
+        return []
+    values = []
+    for name, fmt, offset, precision in entry[1]:
+        if offset + fmt.size > len(data):
+            continue
+        raw = fmt.unpack_from(data, offset)[0]
+        values.append((name, raw * precision if precision != 1.0 else raw))
+    return values
+
+
+# --- commands ---
+
+def telemetry_to_log(source, out_path, fd):
+    """Feeds telemetry bytes from source (an iterable of chunks) into a log."""
+    with open(out_path, "wb") as f:
+        writer = LogWriter(f, fd=fd)
+        unix_at_start = None
+
+        def on_frame(t, can_id, flags, data):
+            nonlocal unix_at_start
+            if unix_at_start is None:
+                unix_at_start = int(time.time() * 1e6) - t
+            writer.frame(t, can_id, flags, data)
+
+        decoder = can_telemetry.Decoder(on_frame, lambda line: None)
+        try:
+            for chunk in source:
+                decoder.feed(chunk)
+        except KeyboardInterrupt:
+            pass
+
+        if unix_at_start is not None:
+            f.seek(0)
+            f.write(HEADER.pack(b"NCLG", VERSION, writer.record_size,
+                                BLOCK_RECORDS, 0, unix_at_start, 0))
+    print(f"{writer.frames} frames ({writer.late} stamped late, "
+          f"{decoder.bad} bad records) to {out_path}", file=sys.stderr)
+
+
+def cmd_record(args):
+    def chunks():
+        with can_telemetry.open_port(args.port) as ser:
+            while True:
+                chunk = ser.read(4096)
+                if chunk:
+                    yield chunk
+    telemetry_to_log(chunks(), args.output, args.fd)
+
+
+def cmd_convert(args):
+    with open(args.capture, "rb") as f:
+        data = f.read()
+    telemetry_to_log([data], args.output, args.fd)
+
+
+def cmd_info(args):
+    log = CanLog(args.log)
+    schema = load_schema(args.json)
+    started = time.perf_counter()
+    counts = {}
+    last_us = 0
+    for t, can_id, _, _, _ in log.frames():
+        counts[can_id] = counts.get(can_id, 0) + 1
+        last_us = t
+    took = time.perf_counter() - started
+
+    first_us = log.first_us()
+    span = (last_us - first_us) / 1e6
+    kind = "FD" if log.fd else "classic"
+    print(f"{args.log}: {log.records} {kind} frames in {log.blocks} blocks, "
+          f"{span:.3f} s")
+    if log.start_unix_us:
+        print("started " + time.strftime(
+            "%Y-%m-%d %H:%M:%S", time.localtime(log.start_unix_us / 1e6)))
+    for can_id in sorted(counts):
+        name = schema.get(can_id, ("",))[0]
+        rate = counts[can_id] / span if span > 0 else 0.0
+        print(f"  0x{can_id:03X} {counts[can_id]:9d} frames {rate:8.1f} Hz  {name}")
+    if took > 0:
+        print(f"read in {took:.3f} s, {log.records / took / 1e6:.2f} M frames/s",
+              file=sys.stderr)
+    log.close()
+
+
+def cmd_dump(args):
+    log = CanLog(args.log)
+    schema = load_schema(args.json)
+    first_us = log.first_us()
+    start_us = first_us + int(args.start * 1e6) if args.start is not None else None
+    end_us = first_us + int(args.end * 1e6) if args.end is not None else None
+    ids = [int(i, 0) for i in args.id] if args.id else None
+
+    writer = None
+    csv_file = None
+    if args.csv:
+        csv_file = open(args.csv, "w", newline="")
+        writer = csv.writer(csv_file)
+        writer.writerow(["time_us", "bus", "dir", "id", "name", "flags", "len",
+                         "data", "signals"])
+
+    for t, can_id, flags, bus, data in log.frames(start_us, end_us, ids, args.bus):
+        direction = "TX" if flags & FLAG_TX else "RX"
+        name = schema.get(can_id, ("",))[0]
+        signals = ""
+        if args.decode:
+            signals = " ".join(f"{n}={v:g}" for n, v in decode(schema, can_id, data))
+        if writer:
+            writer.writerow([t, bus, direction, f"0x{can_id:03X}", name, flags,
+                             len(data), data.hex(" "), signals])
+        else:
+            fd = " FD" if flags & FLAG_FD else ""
+            print(f"{(t - first_us) / 1e6:12.6f} {bus} {direction} "
+                  f"0x{can_id:03X}{fd} [{len(data)}] {data.hex(' ')}  {name}"
+                  + (f"  {signals}" if signals else ""))
+
+    if csv_file:
+        csv_file.close()
+    log.close()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--json", default=DEFAULT_JSON,
+                        help="can_packets.json for names and signals")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    p = sub.add_parser("record", help="log the live telemetry stream")
+    p.add_argument("port", nargs="?", help="serial port (default: first)")
+    p.add_argument("-o", "--output", required=True)
+    p.add_argument("--fd", action="store_true", help="keep 64 byte payloads")
+    p.set_defaults(func=cmd_record)
+
+    p = sub.add_parser("convert", help="turn a raw telemetry capture into a log")
+    p.add_argument("capture")
+    p.add_argument("-o", "--output", required=True)
+    p.add_argument("--fd", action="store_true", help="keep 64 byte payloads")
+    p.set_defaults(func=cmd_convert)
+
+    p = sub.add_parser("info", help="summarize a log")
+    p.add_argument("log")
+    p.set_defaults(func=cmd_info)
+
+    p = sub.add_parser("dump", help="print or export frames")
+    p.add_argument("log")
+    p.add_argument("--start", type=float, help="seconds from the start")
+    p.add_argument("--end", type=float, help="seconds from the start")
+    p.add_argument("--id", action="append", help="only this ID (repeatable)")
+    p.add_argument("--bus", type=int, help="only frames from this bus")
+    p.add_argument("--decode", action="store_true",
+                   help="decode signals with can_packets.json")
+    p.add_argument("--csv", help="write to this CSV file instead")
+    p.set_defaults(func=cmd_dump)
+
+    args = parser.parse_args()
+    try:
+        args.func(args)
+    except ValueError as e:
+        sys.exit(str(e))
+
+
+if __name__ == "__main__":
+    main()
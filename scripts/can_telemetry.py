@@ -0,0 +1,192 @@
+"""Decodes the binary telemetry stream from usb_vcp (NIGHTCAN_TELEMETRY).
+
+Records are COBS encoded and end in a 0x00 byte. After decoding, the first
+byte is the record type:
+  0x01 CAN frame: time_us (u32), id (u32), flags (u8), len (u8), data
+  0x02 text: one println line
+Multi-byte fields are little endian.
+
+Usage:
+  python3 can_telemetry.py [PORT] [--csv out.csv] [--save capture.bin]
+  python3 can_telemetry.py --replay capture.bin [--csv out.csv]
+"""
+import argparse
+import csv
+import json
+import os
+import struct
+import sys
+
+RECORD_CAN_FRAME = 0x01
+RECORD_TEXT = 0x02
+
+FLAG_TX = 0x01
+FLAG_EXT = 0x02
+FLAG_FD = 0x04
+FLAG_BRS = 0x08
+
+CAN_HEADER = struct.Struct("<BIIBB")
+
+DEFAULT_JSON = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                            "can_packets.json")
+
+
+def cobs_decode(block):
+    """Decodes one COBS block (delimiter already stripped)."""
+    out = bytearray()
+    i = 0
+    while i < len(block):
+        code = block[i]
+        if code == 0 or i + code > len(block):
+            raise ValueError("bad COBS block")
+        out += block[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(block):
+            out.append(0)
+    return bytes(out)
+
+
+class Unwrapper:
+    """Turns the 32-bit microsecond stamps back into a monotonic time."""
+
+    def __init__(self):
+        self.last = None
+        self.high = 0
+
+    def __call__(self, t):
+        if self.last is not None and t < self.last and self.last - t > 1 << 31:
+            self.high += 1 << 32
+        self.last = t
+        return self.high + t
+
+
+def load_names(path):
+    try:
+        with open(path) as f:
+            return {p["packet_id"]: p["packet_name"] for p in json.load(f)}
+    except (OSError, ValueError, KeyError):
+        return {}
+
+
+class Decoder:
+    def __init__(self, on_frame, on_text):
+        self.buf = bytearray()
+        self.on_frame = on_frame
+        self.on_text = on_text
+        self.unwrap = Unwrapper()
+        self.bad = 0
+
+    def feed(self, data):
+        self.buf += data
+        while True:
+            end = self.buf.find(0)
+            if end < 0:
+                return
+            block = bytes(self.buf[:end])
+            del self.buf[:end + 1]
+            if block:
+                self.record(block)
+
+    def record(self, block):
+        try:
+            rec = cobs_decode(block)
+        except ValueError:
+            self.bad += 1
+            return
+        if not rec:
+            self.bad += 1  # a lone 01 00
+            return
+
+        if rec[0] == RECORD_TEXT:
+            self.on_text(rec[1:].decode(errors="replace"))
+        elif rec[0] == RECORD_CAN_FRAME and len(rec) >= CAN_HEADER.size:
+            _, t, can_id, flags, length = CAN_HEADER.unpack_from(rec)
+            data = rec[CAN_HEADER.size:CAN_HEADER.size + length]
+            if len(data) != length:
+                self.bad += 1
+                return
+            self.on_frame(self.unwrap(t), can_id, flags, data)
+        else:
+            self.bad += 1
+
+
+def open_port(name):
+    import serial
+    import serial.tools.list_ports
+
+    if name is None:
+        ports = serial.tools.list_ports.comports()
+        if not ports:
+            sys.exit("No serial ports found")
+        name = ports[0].device
+        print(f"Using {name}", file=sys.stderr)
+    return serial.Serial(name, baudrate=115200, timeout=0.1)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("port", nargs="?", help="serial port (default: first)")
+    parser.add_argument("--replay", help="decode a saved raw capture instead")
+    parser.add_argument("--save", help="also write the raw stream here")
+    parser.add_argument("--csv", help="write frames to this CSV file")
+    parser.add_argument("--json", default=DEFAULT_JSON,
+                        help="can_packets.json for packet names")
+    parser.add_argument("--quiet", action="store_true",
+                        help="don't print frames (text is still shown)")
+    args = parser.parse_args()
+
+    names = load_names(args.json)
+    writer = None
+    csv_file = None
+    if args.csv:
+        csv_file = open(args.csv, "w", newline="")
+        writer = csv.writer(csv_file)
+        writer.writerow(["time_us", "dir", "id", "name", "flags", "len", "data"])
+
+    frames = 0
+
+    def on_frame(t, can_id, flags, data):
+        nonlocal frames
+        frames += 1
+        direction = "TX" if flags & FLAG_TX else "RX"
+        name = names.get(can_id, "")
+        hex_data = data.hex(" ")
+        if writer:
+            writer.writerow([t, direction, f"0x{can_id:03X}", name, flags,
+                             len(data), hex_data])
+        if not args.quiet:
+            fd = " FD" if flags & FLAG_FD else ""
+            print(f"{t / 1e6:12.6f} {direction} 0x{can_id:03X}{fd} "
+                  f"[{len(data)}] {hex_data}  {name}")
+
+    def on_text(line):
+        print(f"# {line}")
+
+    decoder = Decoder(on_frame, on_text)
+    save = open(args.save, "wb") if args.save else None
+
+    try:
+        if args.replay:
+            with open(args.replay, "rb") as f:
+                decoder.feed(f.read())
+        else:
+            with open_port(args.port) as ser:
+                while True:
+                    chunk = ser.read(4096)
+                    if not chunk:
+                        continue
+                    if save:
+                        save.write(chunk)
+                    decoder.feed(chunk)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if save:
+            save.close()
+        if csv_file:
+            csv_file.close()
+        print(f"{frames} frames, {decoder.bad} bad records", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,527 @@
+//
+// night_can benchmark on the simulated bus.
+//
+// Replays the periodic traffic in NCAN_packets.csv: every sender in the sheet
+// gets a node on the bus that sends its packets at their listed rate (with
+// a random phase), and the board under test, the VCU, runs the real driver:
+// an inbox for each packet it can register and its own periodic packets on
+// the TX schedule. The main loop then times CAN_PollReceive and CAN_Service
+// on the host for every loop period of simulated time.
+//
+// Usage: night_can_bench [--csv FILE] [--seconds S] [--loop-us US]
+//                        [--node NAME] [--max-poll CYCLES]
+//                        [--max-service CYCLES] [--gateway-interval-ms MS]
+//                        [--record FILE]
+// --max-poll / --max-service fail the run (exit 2) if the average host
+// cycles per received frame / per CAN_Service call go over them, so it can
+// gate performance in CI.
+//
+// Built with NIGHTCAN_GATEWAY the board also gets a second bus, and one
+// catch-all route forwards everything it hears onto it (at most one frame
+// per --gateway-interval-ms, 0 for all of them) to a listener node. With
+// NIGHTCAN_STATIC_CONFIG the second instance sends the board's packets too.
+//
+// Built with NIGHTCAN_LOG, --record FILE writes everything the board
+// receives and sends to a can_log.h log, which night_can_replay (and
+// scripts/can_log.py) read.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "night_can.h"
+#include "sim_can.h"
+#include "timer.h"
+
+#ifndef NCAN_PACKETS_CSV
+#define NCAN_PACKETS_CSV "scripts/NCAN_packets.csv"
+#endif
+
+#define MAX_ROWS 128
+#define MAX_SENDERS (SIM_BUS_MAX_NODES - 1)
+#define CSV_MAX_FIELDS 24
+#define CSV_LINE_MAX 1024
+
+typedef struct {
+    uint32_t id;
+    char from[32];
+    float hz;
+    uint8_t dlc;
+    uint32_t quantity;  // frames per period (multiplexed packets)
+} TrafficRow;
+
+typedef struct {
+    const TrafficRow *row;
+    FDCAN_HandleTypeDef *node;
+    uint64_t period_ns;
+    uint64_t next_ns;
+    uint32_t counter;
+} TrafficSource;
+
+static TrafficRow rows[MAX_ROWS];
+static uint32_t row_count = 0;
+
+static SimCanBus bus;
+static FDCAN_HandleTypeDef dut_hfdcan;
+static FDCAN_HandleTypeDef sender_hfdcan[MAX_SENDERS];
+static char sender_names[MAX_SENDERS][32];
+static uint32_t sender_count = 0;
+
+static TrafficSource sources[MAX_ROWS];
+static uint32_t source_count = 0;
+static uint32_t generator_drops = 0;
+
+static NightCANInstance can;
+#ifdef NIGHTCAN_GATEWAY
+static SimCanBus gw_bus;
+static FDCAN_HandleTypeDef gw_hfdcan;  // the board's second FDCAN
+static FDCAN_HandleTypeDef gw_listener_hfdcan;
+static NightCANInstance gw_can;
+static NightCANRoute gw_routes[1];
+static uint32_t gw_interval_ms = 0;
+static uint32_t gw_listener_rx = 0;
+#endif
+#ifndef NIGHTCAN_STATIC_CONFIG
+#ifndef NIGHTCAN_SOA_INBOXES
+static NightCANReceivePacket inboxes[CAN_RX_BUFFER_SIZE];
+#endif
+static NightCANPacket tx_packets[CAN_TX_SCHEDULE_SIZE];
+#endif
+
+#ifdef NIGHTCAN_LOG
+static CanLogWriter recorder;
+
+static bool record_write(void *ctx, const void *data, uint32_t len) {
+    return fwrite(data, 1, len, (FILE *)ctx) == len;
+}
+#endif
+
+// --- Host timing ---
+
+#if defined(__x86_64__) || defined(__i386__)
+#define HOST_TICK_UNIT "cycles"
+static inline uint64_t host_ticks(void) { return __rdtsc(); }
+#else
+#define HOST_TICK_UNIT "ns"
+static inline uint64_t host_ticks(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+typedef struct {
+    uint64_t total;
+    uint64_t max;
+    uint64_t calls;
+} HostTiming;
+
+static inline void timing_add(HostTiming *t, uint64_t ticks) {
+    t->total += ticks;
+    if (ticks > t->max) t->max = ticks;
+    t->calls++;
+}
+
+// --- NCAN_packets.csv ---
+
+/* Splits one CSV line in place, honouring quotes. Returns the field count. */
+static int csv_split(char *line, char **fields, int max_fields) {
+    int n = 0;
+    char *out = line;
+    char *p = line;
+
+    while (n < max_fields) {
+        fields[n++] = out;
+        bool quoted = false;
+        for (;; p++) {
+            if (*p == '"') {
+                if (quoted && p[1] == '"') {
+                    *out++ = '"';
+                    p++;
+                } else {
+                    quoted = !quoted;
+                }
+            } else if ((*p == ',' && !quoted) || *p == '\0' || *p == '\r' ||
+                       *p == '\n') {
+                break;
+            } else {
+                *out++ = *p;
+            }
+        }
+        bool more = *p == ',';
+        *out++ = '\0';
+        if (!more) break;
+        p++;
+    }
+    return n;
+}
+
+/* Reads the periodic packets out of the sheet */
+static bool load_rows(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+
+    char line[CSV_LINE_MAX];
+    bool header = true;
+    while (fgets(line, sizeof(line), f) && row_count < MAX_ROWS) {
+        if (header) {
+            header = false;
+            continue;
+        }
+
+        char *fields[CSV_MAX_FIELDS];
+        int n = csv_split(line, fields, CSV_MAX_FIELDS);
+        if (n < 8) continue;
+
+        char *end;
+        uint32_t id = (uint32_t)strtoul(fields[0], &end, 16);
+        if (end == fields[0]) continue;
+        float hz = strtof(fields[5], &end);
+        if (end == fields[5] || hz <= 0.0f) continue;  // NA: not periodic
+        long dlc = strtol(fields[6], &end, 10);
+        if (end == fields[6] || dlc < 0 || dlc > 8) continue;
+        long quantity = strtol(fields[7], &end, 10);
+        if (end == fields[7] || quantity < 1) quantity = 1;
+
+        TrafficRow *row = &rows[row_count++];
+        row->id = id;
+        snprintf(row->from, sizeof(row->from), "%s", fields[2]);
+        row->hz = hz;
+        row->dlc = (uint8_t)dlc;
+        row->quantity = (uint32_t)quantity;
+    }
+
+    fclose(f);
+    return true;
+}
+
+// --- Setup ---
+
+static FDCAN_HandleTypeDef *sender_node(const char *name) {
+    for (uint32_t i = 0; i < sender_count; i++) {
+        if (!strcmp(sender_names[i], name)) return &sender_hfdcan[i];
+    }
+    if (sender_count >= MAX_SENDERS) return NULL;
+
+    snprintf(sender_names[sender_count], sizeof(sender_names[0]), "%s", name);
+    FDCAN_HandleTypeDef *node = &sender_hfdcan[sender_count];
+    if (!sim_bus_attach(&bus, node, sender_names[sender_count])) return NULL;
+    HAL_FDCAN_Start(node);
+    sender_count++;
+    return node;
+}
+
+static uint32_t rng_state = 12345;
+
+static uint32_t rng_next(void) {
+    rng_state = rng_state * 1664525U + 1013904223U;
+    return rng_state;
+}
+
+static bool setup(const char *dut_name) {
+    sim_clock_reset();
+    sim_bus_init(&bus, SIM_NOMINAL_BITRATE, 2000000);
+    sim_bus_attach(&bus, &dut_hfdcan, dut_name);
+
+    lib_timer_init();
+    can = CAN_new_instance();
+    if (CAN_Init(&can, &dut_hfdcan, 0, 0, 0, 0) != CAN_OK) {
+        fprintf(stderr, "CAN_Init failed\n");
+        return false;
+    }
+
+#ifdef NIGHTCAN_GATEWAY
+    sim_bus_init(&gw_bus, SIM_NOMINAL_BITRATE, 2000000);
+    sim_bus_attach(&gw_bus, &gw_hfdcan, "gateway");
+    sim_bus_attach(&gw_bus, &gw_listener_hfdcan, "listener");
+    HAL_FDCAN_Start(&gw_listener_hfdcan);
+    gw_can = CAN_new_instance();
+    if (CAN_Init(&gw_can, &gw_hfdcan, 0, 0, 0, 0) != CAN_OK) {
+        fprintf(stderr, "CAN_Init failed for the gateway bus\n");
+        return false;
+    }
+    gw_routes[0] = (NightCANRoute){.id = 0, .mask = 0, .dest = &gw_can,
+                                   .min_interval_ms = gw_interval_ms};
+    if (CAN_SetRoutes(&can, gw_routes, 1) != CAN_OK) {
+        fprintf(stderr, "CAN_SetRoutes failed\n");
+        return false;
+    }
+#endif
+
+    uint32_t inbox_count = 0;
+    uint32_t tx_count = 0;
+    for (uint32_t i = 0; i < row_count; i++) {
+        const TrafficRow *row = &rows[i];
+        uint32_t interval_ms = (uint32_t)(1000.0f / row->hz + 0.5f);
+
+        if (strstr(row->from, dut_name)) {
+#ifdef NIGHTCAN_STATIC_CONFIG
+            (void)interval_ms;  // the board config already scheduled it
+            tx_count++;
+#else
+            if (tx_count >= CAN_TX_SCHEDULE_SIZE) continue;
+            NightCANPacket *packet = &tx_packets[tx_count++];
+            *packet = CAN_create_packet(row->id, interval_ms, row->dlc);
+            CAN_AddTxPacket(&can, packet);
+#endif
+            continue;
+        }
+
+        FDCAN_HandleTypeDef *node = sender_node(row->from);
+        if (!node) continue;
+
+        TrafficSource *src = &sources[source_count++];
+        src->row = row;
+        src->node = node;
+        src->period_ns = (uint64_t)(1e9f / row->hz);
+        src->next_ns = rng_next() % src->period_ns;
+
+#if defined(NIGHTCAN_STATIC_CONFIG) && defined(NIGHTCAN_SOA_INBOXES)
+        if (CAN_FindInbox(&can, row->id) != CAN_INBOX_NONE) inbox_count++;
+#elif defined(NIGHTCAN_STATIC_CONFIG)
+        if (CAN_GetReceivedPacket(&can, row->id)) inbox_count++;
+#elif defined(NIGHTCAN_SOA_INBOXES)
+        if (inbox_count < CAN_RX_BUFFER_SIZE &&
+            CAN_AddInbox(&can, row->id, interval_ms * 3, row->dlc) !=
+                CAN_INBOX_NONE) {
+            inbox_count++;
+        }
+#else
+        if (inbox_count < CAN_RX_BUFFER_SIZE) {
+            NightCANReceivePacket *inbox = &inboxes[inbox_count++];
+            *inbox = CAN_create_receive_packet(row->id, interval_ms * 3,
+                                               row->dlc);
+            CAN_addReceivePacket(&can, inbox);
+        }
+#endif
+    }
+
+#ifdef NIGHTCAN_AUTO_FILTER
+    // CAN_periodic would do this on its first call, the loop below doesn't
+    // call it so the two halves can be timed on their own
+    CAN_ApplyReceiveFilters(&can);
+#endif
+
+    printf("%u periodic packets: %u sent by %u simulated nodes, %u by %s, "
+           "%u inboxes\n",
+           row_count, source_count, sender_count, tx_count, dut_name,
+           inbox_count);
+    return true;
+}
+
+/* Queues everything the traffic sources have due by now */
+static void run_sources(void) {
+    uint64_t now = sim_clock_now_ns();
+    for (uint32_t i = 0; i < source_count; i++) {
+        TrafficSource *src = &sources[i];
+        while (src->next_ns <= now) {
+            for (uint32_t q = 0; q < src->row->quantity; q++) {
+                uint8_t data[8];
+                for (uint32_t b = 0; b < 8; b++) {
+                    data[b] = (uint8_t)(src->counter * 31U + b * 17U + q);
+                }
+                src->counter++;
+                if (sim_can_send(src->node, src->row->id, data,
+                                 src->row->dlc) != HAL_OK) {
+                    generator_drops++;
+                }
+            }
+            src->next_ns += src->period_ns;
+        }
+    }
+}
+
+static void print_flags(void) {
+    printf("driver options:");
+#ifdef NIGHTCAN_RX_INTERRUPT
+    printf(" NIGHTCAN_RX_INTERRUPT");
+#endif
+#ifdef NIGHTCAN_TX_INTERRUPT
+    printf(" NIGHTCAN_TX_INTERRUPT");
+#endif
+#ifdef NIGHTCAN_AUTO_FILTER
+    printf(" NIGHTCAN_AUTO_FILTER");
+#endif
+#ifdef NIGHTCAN_STATS
+    printf(" NIGHTCAN_STATS");
+#endif
+#ifdef NIGHTCAN_DWT_TIMEBASE
+    printf(" NIGHTCAN_DWT_TIMEBASE");
+#endif
+#ifdef NIGHTCAN_STATIC_CONFIG
+    printf(" NIGHTCAN_STATIC_CONFIG(" NIGHTCAN_BOARD_NAME ")");
+#endif
+#ifdef NIGHTCAN_SOA_INBOXES
+    printf(" NIGHTCAN_SOA_INBOXES");
+#endif
+#ifdef NIGHTCAN_GATEWAY
+    printf(" NIGHTCAN_GATEWAY");
+#endif
+#ifdef NIGHTCAN_LOG
+    printf(" NIGHTCAN_LOG");
+#endif
+    printf("\n");
+}
+
+int main(int argc, char **argv) {
+    const char *csv_path = NCAN_PACKETS_CSV;
+#ifdef NIGHTCAN_STATIC_CONFIG
+    const char *dut_name = NIGHTCAN_BOARD_NAME;
+#else
+    const char *dut_name = "VCU";
+#endif
+    double seconds = 10.0;
+    uint32_t loop_us = 200;
+    double max_poll = 0.0;
+    double max_service = 0.0;
+#ifdef NIGHTCAN_LOG
+    const char *record_path = NULL;
+#endif
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (!value) {
+            fprintf(stderr, "%s needs a value\n", arg);
+            return 1;
+        }
+        if (!strcmp(arg, "--csv")) {
+            csv_path = value;
+        } else if (!strcmp(arg, "--seconds")) {
+            seconds = atof(value);
+        } else if (!strcmp(arg, "--loop-us")) {
+            loop_us = (uint32_t)atoi(value);
+        } else if (!strcmp(arg, "--node")) {
+            dut_name = value;
+        } else if (!strcmp(arg, "--max-poll")) {
+            max_poll = atof(value);
+        } else if (!strcmp(arg, "--max-service")) {
+            max_service = atof(value);
+#ifdef NIGHTCAN_GATEWAY
+        } else if (!strcmp(arg, "--gateway-interval-ms")) {
+            gw_interval_ms = (uint32_t)atoi(value);
+#endif
+#ifdef NIGHTCAN_LOG
+        } else if (!strcmp(arg, "--record")) {
+            record_path = value;
+#endif
+        } else {
+            fprintf(stderr, "unknown option %s\n", arg);
+            return 1;
+        }
+        i++;
+    }
+    if (loop_us == 0) loop_us = 1;
+
+    if (!load_rows(csv_path) || !setup(dut_name)) return 1;
+    print_flags();
+
+#ifdef NIGHTCAN_LOG
+    FILE *record_file = NULL;
+    if (record_path) {
+        record_file = fopen(record_path, "wb");
+        if (!record_file ||
+            !can_log_open(&recorder, record_write, record_file,
+                          CAN_MAX_DATA_LEN > 8, 0)) {
+            fprintf(stderr, "can't write %s\n", record_path);
+            return 1;
+        }
+        CAN_SetLog(&can, &recorder, 0);
+    }
+#endif
+
+    HostTiming poll = {0};
+    HostTiming service = {0};
+    uint64_t frames_polled = 0;
+    uint32_t rx_seen = 0;
+
+    uint64_t end_ns = (uint64_t)(seconds * 1e9);
+    while (sim_clock_now_ns() < end_ns) {
+        run_sources();
+        sim_clock_advance_us(loop_us);
+
+        // frames that reached the FIFOs since the last poll
+        uint32_t arrived = dut_hfdcan.rx_frames - rx_seen;
+        rx_seen = dut_hfdcan.rx_frames;
+
+        uint64_t t0 = host_ticks();
+        CAN_PollReceive(&can);
+        uint64_t t1 = host_ticks();
+        CAN_Service(&can);
+        uint64_t t2 = host_ticks();
+
+        timing_add(&poll, t1 - t0);
+        timing_add(&service, t2 - t1);
+        frames_polled += arrived;
+
+#ifdef NIGHTCAN_GATEWAY
+        CAN_Service(&gw_can);
+        FDCAN_RxHeaderTypeDef gw_header;
+        uint8_t gw_data[64];
+        while (HAL_FDCAN_GetRxFifoFillLevel(&gw_listener_hfdcan,
+                                            FDCAN_RX_FIFO0) > 0 &&
+               HAL_FDCAN_GetRxMessage(&gw_listener_hfdcan, FDCAN_RX_FIFO0,
+                                      &gw_header, gw_data) == HAL_OK) {
+            gw_listener_rx++;
+        }
+#endif
+    }
+
+    double poll_per_frame =
+        frames_polled ? (double)poll.total / (double)frames_polled : 0.0;
+    double service_per_call =
+        service.calls ? (double)service.total / (double)service.calls : 0.0;
+
+    printf("simulated %.1f s, %u us loop, bus load %.1f%%, %u frames\n",
+           seconds, loop_us, 100.0f * sim_bus_load(&bus), bus.frames);
+    printf("%s: %u received, %u filtered, %u lost to a full FIFO, %u sent, "
+           "%u arbitration losses\n",
+           dut_name, dut_hfdcan.rx_frames, dut_hfdcan.rx_filtered,
+           dut_hfdcan.rx_lost, dut_hfdcan.tx_frames,
+           dut_hfdcan.arbitration_lost);
+    printf("simulated senders: %u frames dropped on a full TX FIFO\n",
+           generator_drops);
+#ifdef NIGHTCAN_GATEWAY
+    printf("gateway: %u forwarded, %u skipped by the rate limit, %u dropped, "
+           "%u received by the listener, bus load %.1f%%\n",
+           gw_routes[0]._forwarded, gw_routes[0]._skipped,
+           gw_routes[0]._dropped, gw_listener_rx,
+           100.0f * sim_bus_load(&gw_bus));
+#endif
+    printf("CAN_PollReceive: %.1f %s/frame, %.1f %s/call avg, %llu max\n",
+           poll_per_frame, HOST_TICK_UNIT,
+           (double)poll.total / (double)poll.calls, HOST_TICK_UNIT,
+           (unsigned long long)poll.max);
+    printf("CAN_Service:     %.1f %s/call avg, %llu max\n", service_per_call,
+           HOST_TICK_UNIT, (unsigned long long)service.max);
+#ifdef NIGHTCAN_LOG
+    if (record_file) {
+        fclose(record_file);
+        printf("recorded %u frames to %s (%u stamped late, %u not written)\n",
+               recorder.frames, record_path, recorder.late,
+               recorder.write_fails);
+    }
+#endif
+
+    int rc = 0;
+    if (max_poll > 0.0 && poll_per_frame > max_poll) {
+        printf("FAIL: CAN_PollReceive over budget (%.1f > %.1f)\n",
+               poll_per_frame, max_poll);
+        rc = 2;
+    }
+    if (max_service > 0.0 && service_per_call > max_service) {
+        printf("FAIL: CAN_Service over budget (%.1f > %.1f)\n",
+               service_per_call, max_service);
+        rc = 2;
+    }
+    return rc;
+}
@@ -0,0 +1 @@
+#include "main.h"
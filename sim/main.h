@@ -0,0 +1,13 @@
+//
+// main.h for host builds: what CubeMX's main.h gives the library on a board,
+// the HAL, comes from the simulator instead. Library options (NIGHTCAN_*)
+// are passed as compile definitions, see LONGHORN_SIM_DEFINES in
+// CMakeLists.txt.
+//
+
+#ifndef LONGHORN_LIBRARY_2025_SIM_MAIN_H
+#define LONGHORN_LIBRARY_2025_SIM_MAIN_H
+
+#include "stm32h7xx_hal.h"
+
+#endif  // LONGHORN_LIBRARY_2025_SIM_MAIN_H
@@ -0,0 +1,371 @@
+//
+// Replays a can_log.h log into the simulated bus.
+//
+// Every frame the log holds is sent at its recorded time (relative to the
+// first one) by a node standing in for the rest of the car, and the board
+// under test runs the real driver against it: an inbox for every ID in the
+// log, with a timeout of three times that ID's average period, polled and
+// serviced every loop period of simulated time. The clock is simulated, so
+// a run is the same every time, and the host time CAN_PollReceive takes is
+// measured like in the benchmark.
+//
+// Frames the logging board sent itself (CAN_LOG_FLAG_TX) are left out by
+// default since the board under test makes its own. A frame the replay
+// node's TX FIFO has no room for goes at the next loop, and is counted.
+//
+// Usage: night_can_replay LOG [--loop-us US] [--bus N] [--with-tx]
+//                             [--max-poll CYCLES]
+// --bus only replays the frames recorded on that bus. --max-poll fails the
+// run (exit 2) if the host cycles per received frame go over it.
+//
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "can_log.h"
+#include "night_can.h"
+#include "sim_can.h"
+#include "timer.h"
+
+#define MAX_IDS 256
+
+// --- Host timing ---
+
+#if defined(__x86_64__) || defined(__i386__)
+#define HOST_TICK_UNIT "cycles"
+static inline uint64_t host_ticks(void) { return __rdtsc(); }
+#else
+#define HOST_TICK_UNIT "ns"
+static inline uint64_t host_ticks(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+// --- Log reading ---
+
+typedef struct {
+    const uint8_t *base;
+    size_t size;
+    const CanLogHeader *header;
+    uint32_t block_bytes;  // records + trailer
+    uint64_t records;
+} LogFile;
+
+static bool log_map(LogFile *log, const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        perror(path);
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(CanLogHeader)) {
+        fprintf(stderr, "%s: not a CAN log\n", path);
+        close(fd);
+        return false;
+    }
+    void *base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        perror(path);
+        return false;
+    }
+
+    log->base = base;
+    log->size = (size_t)st.st_size;
+    log->header = (const CanLogHeader *)log->base;
+    const CanLogHeader *h = log->header;
+    if (memcmp(h->magic, "NCLG", 4) != 0 || h->version != CAN_LOG_VERSION ||
+        (h->record_size != CAN_LOG_RECORD_SIZE(false) &&
+         h->record_size != CAN_LOG_RECORD_SIZE(true)) ||
+        h->block_records == 0) {
+        fprintf(stderr, "%s: not a version %d CAN log\n", path,
+                CAN_LOG_VERSION);
+        return false;
+    }
+
+    log->block_bytes =
+        h->block_records * h->record_size + (uint32_t)sizeof(CanLogTrailer);
+    size_t body = log->size - sizeof(CanLogHeader);
+    uint64_t full = body / log->block_bytes;
+    uint64_t rest = (body % log->block_bytes) / h->record_size;
+    if (rest > h->block_records) rest = h->block_records;  // torn trailer
+    log->records = full * h->block_records + rest;
+    return true;
+}
+
+static const CanLogRecord *log_record(const LogFile *log, uint64_t i) {
+    uint32_t per_block = log->header->block_records;
+    size_t offset = sizeof(CanLogHeader) +
+                    (size_t)(i / per_block) * log->block_bytes +
+                    (size_t)(i % per_block) * log->header->record_size;
+    return (const CanLogRecord *)(log->base + offset);
+}
+
+// --- Board under test ---
+
+typedef struct {
+    uint32_t id;
+    uint32_t count;
+    uint64_t first_us;
+    uint64_t last_us;
+} IdSummary;
+
+static IdSummary ids[MAX_IDS];
+static uint32_t id_count = 0;
+
+static SimCanBus bus;
+static FDCAN_HandleTypeDef dut_hfdcan;
+static FDCAN_HandleTypeDef car_hfdcan;  // plays the log
+static NightCANInstance can;
+#if !defined(NIGHTCAN_STATIC_CONFIG) && !defined(NIGHTCAN_SOA_INBOXES)
+static NightCANReceivePacket inboxes[CAN_RX_BUFFER_SIZE];
+#endif
+static uint32_t timeouts = 0;
+
+#ifdef NIGHTCAN_SOA_INBOXES
+static void on_timeout(NightCANInstance *instance, NightCANInbox inbox,
+                       bool timed_out) {
+    (void)instance;
+    (void)inbox;
+    if (timed_out) timeouts++;
+}
+#else
+static void on_timeout(NightCANReceivePacket *packet, bool timed_out) {
+    (void)packet;
+    if (timed_out) timeouts++;
+}
+#endif
+
+static bool replayed(const CanLogRecord *r, int bus_filter, bool with_tx) {
+    if (!with_tx && (r->flags & CAN_LOG_FLAG_TX)) return false;
+    return bus_filter < 0 || r->bus == (uint8_t)bus_filter;
+}
+
+static void summarize(const LogFile *log, int bus_filter, bool with_tx) {
+    for (uint64_t i = 0; i < log->records; i++) {
+        const CanLogRecord *r = log_record(log, i);
+        if (!replayed(r, bus_filter, with_tx)) continue;
+
+        IdSummary *s = NULL;
+        for (uint32_t k = 0; k < id_count; k++) {
+            if (ids[k].id == r->id) {
+                s = &ids[k];
+                break;
+            }
+        }
+        if (!s) {
+            if (id_count >= MAX_IDS) continue;
+            s = &ids[id_count++];
+            *s = (IdSummary){.id = r->id, .first_us = r->time_us};
+        }
+        s->count++;
+        s->last_us = r->time_us;
+    }
+}
+
+static uint32_t setup(bool fd) {
+    sim_clock_reset();
+    sim_bus_init(&bus, SIM_NOMINAL_BITRATE, 2000000);
+    sim_bus_attach(&bus, &dut_hfdcan, "dut");
+    sim_bus_attach(&bus, &car_hfdcan, "log");
+    if (fd) {
+        dut_hfdcan.Init.FrameFormat = FDCAN_FRAME_FD_BRS;
+        car_hfdcan.Init.FrameFormat = FDCAN_FRAME_FD_BRS;
+    }
+    HAL_FDCAN_Start(&car_hfdcan);
+
+    lib_timer_init();
+    can = CAN_new_instance();
+    if (CAN_Init(&can, &dut_hfdcan, 0, 0, 0, 0) != CAN_OK) {
+        fprintf(stderr, "CAN_Init failed\n");
+        exit(1);
+    }
+    CAN_SetTimeoutCallback(&can, on_timeout);
+
+    uint32_t inbox_count = 0;
+#ifdef NIGHTCAN_STATIC_CONFIG
+    // the board config decides what it listens to
+    for (uint32_t k = 0; k < id_count; k++) {
+#ifdef NIGHTCAN_SOA_INBOXES
+        if (CAN_FindInbox(&can, ids[k].id) != CAN_INBOX_NONE) inbox_count++;
+#else
+        if (CAN_GetReceivedPacket(&can, ids[k].id)) inbox_count++;
+#endif
+    }
+#else
+    for (uint32_t k = 0; k < id_count && inbox_count < CAN_RX_BUFFER_SIZE;
+         k++) {
+        const IdSummary *s = &ids[k];
+        uint32_t period_ms = (s->count > 1)
+            ? (uint32_t)((s->last_us - s->first_us) / (s->count - 1) / 1000)
+            : 0;
+        uint32_t timeout_ms = period_ms ? period_ms * 3 : 0;
+#ifdef NIGHTCAN_SOA_INBOXES
+        if (CAN_AddInbox(&can, s->id, timeout_ms, CAN_MAX_DATA_LEN) !=
+            CAN_INBOX_NONE) {
+            inbox_count++;
+        }
+#else
+        inboxes[inbox_count] =
+            CAN_create_receive_packet(s->id, timeout_ms, CAN_MAX_DATA_LEN);
+        CAN_addReceivePacket(&can, &inboxes[inbox_count]);
+        inbox_count++;
+#endif
+    }
+#endif
+
+#ifdef NIGHTCAN_AUTO_FILTER
+    CAN_ApplyReceiveFilters(&can);
+#endif
+    return inbox_count;
+}
+
+/* Queues a record on the replay node, false if its TX FIFO is full */
+static bool send_record(const CanLogRecord *r) {
+    bool fd = r->flags & CAN_LOG_FLAG_FD;
+    FDCAN_TxHeaderTypeDef header = {
+        .Identifier = r->id,
+        .IdType = (r->flags & CAN_LOG_FLAG_EXT) ? FDCAN_EXTENDED_ID
+                                                : FDCAN_STANDARD_ID,
+        .TxFrameType = FDCAN_DATA_FRAME,
+        .DataLength = fd ? CAN_len_to_dlc(r->len) : (r->len > 8 ? 8 : r->len),
+        .ErrorStateIndicator = FDCAN_ESI_ACTIVE,
+        .BitRateSwitch = (r->flags & CAN_LOG_FLAG_BRS) ? FDCAN_BRS_ON
+                                                       : FDCAN_BRS_OFF,
+        .FDFormat = fd ? FDCAN_FD_CAN : FDCAN_CLASSIC_CAN,
+        .TxEventFifoControl = FDCAN_NO_TX_EVENTS,
+    };
+    uint8_t data[64] = {0};
+    memcpy(data, r->data, r->len > 64 ? 64 : r->len);
+    return HAL_FDCAN_AddMessageToTxFifoQ(&car_hfdcan, &header, data) == HAL_OK;
+}
+
+int main(int argc, char **argv) {
+    const char *path = NULL;
+    uint32_t loop_us = 200;
+    int bus_filter = -1;
+    bool with_tx = false;
+    double max_poll = 0.0;
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if (!strcmp(arg, "--with-tx")) {
+            with_tx = true;
+            continue;
+        }
+        if (arg[0] != '-') {
+            path = arg;
+            continue;
+        }
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (!value) {
+            fprintf(stderr, "%s needs a value\n", arg);
+            return 1;
+        }
+        if (!strcmp(arg, "--loop-us")) {
+            loop_us = (uint32_t)atoi(value);
+        } else if (!strcmp(arg, "--bus")) {
+            bus_filter = atoi(value);
+        } else if (!strcmp(arg, "--max-poll")) {
+            max_poll = atof(value);
+        } else {
+            fprintf(stderr, "unknown option %s\n", arg);
+            return 1;
+        }
+        i++;
+    }
+    if (!path) {
+        fprintf(stderr, "usage: night_can_replay LOG [--loop-us US] [--bus N] "
+                        "[--with-tx] [--max-poll CYCLES]\n");
+        return 1;
+    }
+    if (loop_us == 0) loop_us = 1;
+
+    LogFile log;
+    if (!log_map(&log, path)) return 1;
+    summarize(&log, bus_filter, with_tx);
+    bool fd = log.header->record_size == CAN_LOG_RECORD_SIZE(true);
+    uint32_t inbox_count = setup(fd);
+    printf("%s: %llu records, %u IDs replayed, %u inboxes\n", path,
+           (unsigned long long)log.records, id_count, inbox_count);
+
+    uint64_t next = 0;
+    while (next < log.records && !replayed(log_record(&log, next), bus_filter,
+                                           with_tx)) {
+        next++;
+    }
+    uint64_t t0_us = (next < log.records) ? log_record(&log, next)->time_us : 0;
+
+    uint64_t frames_sent = 0;
+    uint32_t deferred = 0;  // frames that waited a loop for FIFO room
+    uint64_t poll_total = 0, poll_max = 0, frames_polled = 0;
+    uint32_t rx_seen = 0;
+
+    while (next < log.records) {
+        uint64_t now_us = sim_clock_now_ns() / 1000U;
+        bool blocked = false;
+        while (next < log.records) {
+            const CanLogRecord *r = log_record(&log, next);
+            if (!replayed(r, bus_filter, with_tx)) {
+                next++;
+                continue;
+            }
+            if (r->time_us - t0_us > now_us) break;
+            if (!send_record(r)) {
+                blocked = true;
+                break;
+            }
+            frames_sent++;
+            next++;
+        }
+        if (blocked) deferred++;
+
+        sim_clock_advance_us(loop_us);
+
+        uint32_t arrived = dut_hfdcan.rx_frames - rx_seen;
+        rx_seen = dut_hfdcan.rx_frames;
+        uint64_t start = host_ticks();
+        CAN_PollReceive(&can);
+        uint64_t ticks = host_ticks() - start;
+        CAN_Service(&can);
+
+        poll_total += ticks;
+        if (ticks > poll_max) poll_max = ticks;
+        frames_polled += arrived;
+    }
+    // let the last frames land
+    sim_clock_advance_us(10000);
+    CAN_PollReceive(&can);
+
+    double poll_per_frame =
+        frames_polled ? (double)poll_total / (double)frames_polled : 0.0;
+    printf("replayed %llu frames over %.3f s simulated, bus load %.1f%%, "
+           "%u loops waited on a full TX FIFO\n",
+           (unsigned long long)frames_sent, sim_clock_now_ns() / 1e9,
+           100.0f * sim_bus_load(&bus), deferred);
+    printf("dut: %u received, %u filtered, %u lost to a full FIFO, "
+           "%u inbox timeouts\n",
+           dut_hfdcan.rx_frames, dut_hfdcan.rx_filtered, dut_hfdcan.rx_lost,
+           timeouts);
+    printf("CAN_PollReceive: %.1f %s/frame, %llu max\n", poll_per_frame,
+           HOST_TICK_UNIT, (unsigned long long)poll_max);
+
+    if (max_poll > 0.0 && poll_per_frame > max_poll) {
+        printf("FAIL: CAN_PollReceive over budget (%.1f > %.1f)\n",
+               poll_per_frame, max_poll);
+        return 2;
+    }
+    return 0;
+}
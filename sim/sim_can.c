@@ -0,0 +1,569 @@
+//
+// Simulated FDCAN bus and virtual clock, see sim_can.h.
+//
+
+#include "sim_can.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "dfu.h"
+#include "night_can.h"  // CAN_dlc_to_len
+
+uint32_t sim_primask = 0;
+DWT_Type sim_dwt;
+CoreDebug_Type sim_core_debug;
+
+uint32_t sim_reset_requests = 0;
+uint32_t sim_dfu_requests = 0;
+
+static uint64_t now_ns = 0;
+static uint64_t cycles_total = 0;  // DWT cycles so far, CYCCNT follows it
+
+static SimCanBus *buses[SIM_MAX_BUSES];
+static uint32_t bus_count = 0;
+
+// --- Clock ---
+
+void sim_clock_reset(void) {
+    now_ns = 0;
+    cycles_total = 0;
+    sim_dwt.CYCCNT = 0;
+    bus_count = 0;
+}
+
+uint64_t sim_clock_now_ns(void) { return now_ns; }
+
+static void set_now(uint64_t ns) {
+    now_ns = ns;
+    uint64_t cycles = (now_ns * (SIM_CORE_CLOCK_HZ / 1000000U)) / 1000U;
+    // += so a write to CYCCNT (lib_timer_init zeroes it) sticks
+    sim_dwt.CYCCNT += (uint32_t)(cycles - cycles_total);
+    cycles_total = cycles;
+}
+
+uint32_t HAL_GetTick(void) { return (uint32_t)(now_ns / 1000000U); }
+
+void HAL_Delay(uint32_t Delay) { sim_clock_advance_ns((uint64_t)Delay * 1000000U); }
+
+uint32_t HAL_RCC_GetHCLKFreq(void) { return SIM_CORE_CLOCK_HZ; }
+
+uint32_t HAL_RCCEx_GetPeriphCLKFreq(uint64_t PeriphClk) {
+    return (PeriphClk == RCC_PERIPHCLK_FDCAN) ? SIM_FDCAN_KERNEL_HZ : 0;
+}
+
+void HAL_NVIC_SystemReset(void) { sim_reset_requests++; }
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin,
+                       GPIO_PinState PinState) {
+    if (!GPIOx) return;
+    if (PinState == GPIO_PIN_SET) {
+        GPIOx->ODR |= GPIO_Pin;
+    } else {
+        GPIOx->ODR &= ~(uint32_t)GPIO_Pin;
+    }
+}
+
+/* dfu.c needs USB and a real reset, the simulator only counts it */
+void boot_to_dfu() { sim_dfu_requests++; }
+
+// --- Frame timing ---
+
+typedef struct {
+    uint32_t bits;     // bits sent, stuff bits included
+    uint16_t crc;      // CRC-15 over the unstuffed bits
+    uint8_t last;
+    uint8_t run;
+} BitStream;
+
+static void put_bit(BitStream *s, uint8_t bit, bool in_crc) {
+    if (in_crc) {
+        uint8_t next = bit ^ ((s->crc >> 14) & 1);
+        s->crc = (uint16_t)((s->crc << 1) & 0x7FFF);
+        if (next) s->crc ^= 0x4599;
+    }
+
+    s->bits++;
+    if (s->run && bit == s->last) {
+        if (++s->run == 5) {
+            // stuff bit of the other level, which starts a new run
+            s->bits++;
+            s->last = !bit;
+            s->run = 1;
+        }
+    } else {
+        s->last = bit;
+        s->run = 1;
+    }
+}
+
+static void put_bits(BitStream *s, uint32_t value, uint32_t n, bool in_crc) {
+    while (n--) put_bit(s, (value >> n) & 1, in_crc);
+}
+
+uint64_t sim_frame_time_ns(const SimCanBus *bus,
+                           const FDCAN_RxHeaderTypeDef *header,
+                           const uint8_t *data) {
+    bool ext = header->IdType == FDCAN_EXTENDED_ID;
+    bool fd = header->FDFormat == FDCAN_FD_CAN;
+    uint32_t len = CAN_dlc_to_len((uint8_t)header->DataLength, fd);
+    uint64_t nominal_bit_ns = 1000000000ULL / bus->nominal_bitrate;
+
+    if (fd) {
+        // arbitration and ack at the nominal rate, the rest at the data rate
+        // if switching. Stuffing is estimated, not counted.
+        uint32_t nominal_bits = (ext ? 38 : 18) + 2 + 7 + 3;
+        uint32_t crc_bits = (len <= 16) ? 17 : 21;
+        uint32_t data_bits = 1 + 4 + len * 8 + 4 + crc_bits + 1;
+        data_bits += data_bits / 5 + crc_bits / 4;
+        uint64_t data_bit_ns = (header->BitRateSwitch == FDCAN_BRS_ON)
+                                   ? 1000000000ULL / bus->data_bitrate
+                                   : nominal_bit_ns;
+        return nominal_bits * nominal_bit_ns + data_bits * data_bit_ns;
+    }
+
+    bool remote = header->RxFrameType == FDCAN_REMOTE_FRAME;
+    BitStream s = {0};
+    put_bit(&s, 0, true);  // SOF
+    if (ext) {
+        put_bits(&s, header->Identifier >> 18, 11, true);
+        put_bit(&s, 1, true);  // SRR
+        put_bit(&s, 1, true);  // IDE
+        put_bits(&s, header->Identifier & 0x3FFFF, 18, true);
+        put_bit(&s, remote, true);
+        put_bits(&s, 0, 2, true);  // r1 r0
+    } else {
+        put_bits(&s, header->Identifier & 0x7FF, 11, true);
+        put_bit(&s, remote, true);
+        put_bits(&s, 0, 2, true);  // IDE r0
+    }
+    put_bits(&s, header->DataLength & 0xF, 4, true);
+    for (uint32_t i = 0; !remote && i < len; i++) put_bits(&s, data[i], 8, true);
+    put_bits(&s, s.crc, 15, false);
+
+    // CRC delimiter, ACK slot and delimiter, EOF, intermission: never stuffed
+    uint32_t bits = s.bits + 1 + 2 + 7 + 3;
+    return bits * nominal_bit_ns;
+}
+
+// --- Bus ---
+
+void sim_bus_init(SimCanBus *bus, uint32_t nominal_bitrate,
+                  uint32_t data_bitrate) {
+    memset(bus, 0, sizeof(*bus));
+    bus->nominal_bitrate = nominal_bitrate;
+    bus->data_bitrate = data_bitrate;
+    if (bus_count < SIM_MAX_BUSES) buses[bus_count++] = bus;
+}
+
+bool sim_bus_attach(SimCanBus *bus, FDCAN_HandleTypeDef *hfdcan,
+                    const char *name) {
+    if (bus->node_count >= SIM_BUS_MAX_NODES) return false;
+
+    memset(hfdcan, 0, sizeof(*hfdcan));
+    hfdcan->Instance = hfdcan;
+    hfdcan->Init.FrameFormat = FDCAN_FRAME_CLASSIC;
+    hfdcan->Init.AutoRetransmission = ENABLE;
+
+    // 80% sample point, prescaled so the segments fit NTSEG1/NTSEG2
+    uint32_t bit_tq = SIM_FDCAN_KERNEL_HZ / bus->nominal_bitrate;
+    uint32_t prescaler = (bit_tq + 384U) / 385U;
+    bit_tq /= prescaler;
+    hfdcan->Init.NominalPrescaler = prescaler;
+    hfdcan->Init.NominalTimeSeg2 = bit_tq / 5U;
+    hfdcan->Init.NominalTimeSeg1 = bit_tq - 1U - bit_tq / 5U;
+
+    hfdcan->Init.StdFiltersNbr = 32;
+    hfdcan->Init.ExtFiltersNbr = 8;
+    hfdcan->Init.RxFifo0ElmtsNbr = 32;
+    hfdcan->Init.RxFifo0ElmtSize = FDCAN_DLC_BYTES_8;
+    hfdcan->Init.RxFifo1ElmtsNbr = 8;
+    hfdcan->Init.RxFifo1ElmtSize = FDCAN_DLC_BYTES_8;
+    hfdcan->Init.TxFifoQueueElmtsNbr = 32;
+    hfdcan->non_matching_std = FDCAN_ACCEPT_IN_RX_FIFO0;
+    hfdcan->non_matching_ext = FDCAN_ACCEPT_IN_RX_FIFO0;
+    hfdcan->bus = bus;
+    hfdcan->name = name;
+
+    bus->nodes[bus->node_count++] = hfdcan;
+    return true;
+}
+
+float sim_bus_load(const SimCanBus *bus) {
+    if (now_ns == 0) return 0.0f;
+    return (float)bus->busy_ns / (float)now_ns;
+}
+
+/* Arbitration field as a number, lower wins. A standard frame beats an
+ * extended one with the same base ID (its IDE bit is dominant). */
+static uint64_t arbitration_key(const FDCAN_RxHeaderTypeDef *header) {
+    uint64_t rtr = header->RxFrameType == FDCAN_REMOTE_FRAME;
+    if (header->IdType == FDCAN_EXTENDED_ID) {
+        return ((uint64_t)(header->Identifier >> 18) << 21) | (1ULL << 20) |
+               ((uint64_t)(header->Identifier & 0x3FFFF) << 1) | rtr;
+    }
+    return ((uint64_t)(header->Identifier & 0x7FF) << 21) | (rtr << 20);
+}
+
+static uint32_t fifo_depth(FDCAN_HandleTypeDef *hfdcan, uint32_t fifo) {
+    uint32_t n = fifo ? hfdcan->Init.RxFifo1ElmtsNbr : hfdcan->Init.RxFifo0ElmtsNbr;
+    return (n > SIM_FDCAN_FIFO_MAX) ? SIM_FDCAN_FIFO_MAX : n;
+}
+
+static uint32_t tx_depth(FDCAN_HandleTypeDef *hfdcan) {
+    uint32_t n = hfdcan->Init.TxFifoQueueElmtsNbr;
+    return (n > SIM_FDCAN_TX_FIFO_MAX) ? SIM_FDCAN_TX_FIFO_MAX : n;
+}
+
+static inline SimFDCANElement *fifo_at(SimFDCANFifo *fifo, uint32_t i) {
+    return &fifo->elements[(fifo->get + i) % SIM_FDCAN_FIFO_MAX];
+}
+
+static bool filter_matches(const FDCAN_FilterTypeDef *f, uint32_t id) {
+    switch (f->FilterType) {
+        case FDCAN_FILTER_RANGE:
+            return id >= f->FilterID1 && id <= f->FilterID2;
+        case FDCAN_FILTER_DUAL:
+            return id == f->FilterID1 || id == f->FilterID2;
+        case FDCAN_FILTER_MASK:
+            return (id & f->FilterID2) == (f->FilterID1 & f->FilterID2);
+    }
+    return false;
+}
+
+/**
+ * Runs the acceptance filters of a node over a frame.
+ * @return the RX FIFO (0/1) it goes to, -1 if rejected
+ */
+static int accept_frame(FDCAN_HandleTypeDef *hfdcan,
+                        FDCAN_RxHeaderTypeDef *header) {
+    bool ext = header->IdType == FDCAN_EXTENDED_ID;
+
+    if (header->RxFrameType == FDCAN_REMOTE_FRAME &&
+        (ext ? hfdcan->reject_remote_ext : hfdcan->reject_remote_std)) {
+        return -1;
+    }
+
+    const FDCAN_FilterTypeDef *filters =
+        ext ? hfdcan->ext_filters : hfdcan->std_filters;
+    uint32_t n = ext ? hfdcan->Init.ExtFiltersNbr : hfdcan->Init.StdFiltersNbr;
+    uint32_t max = ext ? SIM_FDCAN_EXT_FILTERS : SIM_FDCAN_STD_FILTERS;
+    if (n > max) n = max;
+
+    // first enabled element that matches decides
+    for (uint32_t i = 0; i < n; i++) {
+        const FDCAN_FilterTypeDef *f = &filters[i];
+        if (f->FilterConfig == FDCAN_FILTER_DISABLE) continue;
+        if (!filter_matches(f, header->Identifier)) continue;
+
+        header->FilterIndex = i;
+        header->IsFilterMatchingFrame = 0;
+        switch (f->FilterConfig) {
+            case FDCAN_FILTER_TO_RXFIFO0:
+                return 0;
+            case FDCAN_FILTER_TO_RXFIFO1:
+                return 1;
+            default:
+                return -1;
+        }
+    }
+
+    header->FilterIndex = 0;
+    header->IsFilterMatchingFrame = 1;
+    switch (ext ? hfdcan->non_matching_ext : hfdcan->non_matching_std) {
+        case FDCAN_ACCEPT_IN_RX_FIFO0:
+            return 0;
+        case FDCAN_ACCEPT_IN_RX_FIFO1:
+            return 1;
+        default:
+            return -1;
+    }
+}
+
+static uint16_t tsc_at(FDCAN_HandleTypeDef *hfdcan, uint64_t ns) {
+    if (!hfdcan->tsc_enabled || !hfdcan->bus) return 0;
+    // like the hardware, it counts the node's own nominal bit times
+    uint64_t clocks = ns * (SIM_FDCAN_KERNEL_HZ / 1000000U) / 1000U;
+    uint64_t bit_clocks = (uint64_t)hfdcan->Init.NominalPrescaler *
+                          (1U + hfdcan->Init.NominalTimeSeg1 +
+                           hfdcan->Init.NominalTimeSeg2);
+    if (bit_clocks == 0) return 0;
+    return (uint16_t)(clocks / bit_clocks / hfdcan->tsc_prescaler);
+}
+
+/* Starts the winning frame if the bus is idle and anything is waiting */
+static void bus_arbitrate(SimCanBus *bus) {
+    if (bus->sender) return;
+
+    FDCAN_HandleTypeDef *winner = NULL;
+    uint64_t best = 0;
+    for (uint32_t i = 0; i < bus->node_count; i++) {
+        FDCAN_HandleTypeDef *node = bus->nodes[i];
+        if (!node->started || node->tx_fifo.count == 0) continue;
+        uint64_t key = arbitration_key(&fifo_at(&node->tx_fifo, 0)->header);
+        if (!winner || key < best) {
+            winner = node;
+            best = key;
+        }
+    }
+    if (!winner) return;
+
+    for (uint32_t i = 0; i < bus->node_count; i++) {
+        FDCAN_HandleTypeDef *node = bus->nodes[i];
+        if (node != winner && node->started && node->tx_fifo.count) {
+            node->arbitration_lost++;
+        }
+    }
+
+    SimFDCANElement *frame = fifo_at(&winner->tx_fifo, 0);
+    bus->sender = winner;
+    bus->frame_start_ns = now_ns;
+    bus->frame_end_ns =
+        now_ns + sim_frame_time_ns(bus, &frame->header, frame->data);
+}
+
+/* The frame on the wire is done: hand it to every other node */
+static void bus_complete(SimCanBus *bus) {
+    FDCAN_HandleTypeDef *sender = bus->sender;
+    SimFDCANElement frame = *fifo_at(&sender->tx_fifo, 0);
+    uint32_t tx_index = sender->tx_frames % SIM_FDCAN_TX_FIFO_MAX;
+
+    sender->tx_fifo.get = (sender->tx_fifo.get + 1) % SIM_FDCAN_FIFO_MAX;
+    sender->tx_fifo.count--;
+    sender->tx_frames++;
+    bus->sender = NULL;
+    bus->busy_ns += bus->frame_end_ns - bus->frame_start_ns;
+    bus->frames++;
+
+    for (uint32_t i = 0; i < bus->node_count; i++) {
+        FDCAN_HandleTypeDef *node = bus->nodes[i];
+        if (node == sender || !node->started) continue;
+
+        SimFDCANElement element = frame;
+        int fifo = accept_frame(node, &element.header);
+        if (fifo < 0) {
+            node->rx_filtered++;
+            continue;
+        }
+        element.header.RxTimestamp = tsc_at(node, bus->frame_start_ns);
+
+        SimFDCANFifo *rx = &node->rx_fifo[fifo];
+        uint32_t its;
+        if (rx->count >= fifo_depth(node, (uint32_t)fifo)) {
+            // blocking mode, the new frame is the one lost
+            node->rx_lost++;
+            its = fifo ? FDCAN_IT_RX_FIFO1_MESSAGE_LOST
+                       : FDCAN_IT_RX_FIFO0_MESSAGE_LOST;
+        } else {
+            *fifo_at(rx, rx->count) = element;
+            rx->count++;
+            node->rx_frames++;
+            its = fifo ? FDCAN_IT_RX_FIFO1_NEW_MESSAGE
+                       : FDCAN_IT_RX_FIFO0_NEW_MESSAGE;
+        }
+
+        its &= node->active_its;
+        if (its) {
+            if (fifo) {
+                HAL_FDCAN_RxFifo1Callback(node, its);
+            } else {
+                HAL_FDCAN_RxFifo0Callback(node, its);
+            }
+        }
+    }
+
+    if (sender->active_its & FDCAN_IT_TX_COMPLETE) {
+        HAL_FDCAN_TxBufferCompleteCallback(sender, 1U << tx_index);
+    }
+    if ((sender->active_its & FDCAN_IT_TX_FIFO_EMPTY) &&
+        sender->tx_fifo.count == 0) {
+        HAL_FDCAN_TxFifoEmptyCallback(sender);
+    }
+}
+
+void sim_clock_advance_ns(uint64_t ns) {
+    uint64_t target = now_ns + ns;
+
+    for (;;) {
+        SimCanBus *next = NULL;
+        for (uint32_t i = 0; i < bus_count; i++) {
+            bus_arbitrate(buses[i]);
+            if (buses[i]->sender &&
+                (!next || buses[i]->frame_end_ns < next->frame_end_ns)) {
+                next = buses[i];
+            }
+        }
+        if (!next || next->frame_end_ns > target) break;
+
+        set_now(next->frame_end_ns);
+        bus_complete(next);
+    }
+
+    set_now(target);
+}
+
+HAL_StatusTypeDef sim_can_send(FDCAN_HandleTypeDef *hfdcan, uint32_t id,
+                               const uint8_t *data, uint8_t len) {
+    FDCAN_TxHeaderTypeDef header = {
+        .Identifier = id,
+        .IdType = (id > 0x7FF) ? FDCAN_EXTENDED_ID : FDCAN_STANDARD_ID,
+        .TxFrameType = FDCAN_DATA_FRAME,
+        .DataLength = (len > 8) ? 8 : len,
+        .ErrorStateIndicator = FDCAN_ESI_ACTIVE,
+        .BitRateSwitch = FDCAN_BRS_OFF,
+        .FDFormat = FDCAN_CLASSIC_CAN,
+        .TxEventFifoControl = FDCAN_NO_TX_EVENTS,
+    };
+    return HAL_FDCAN_AddMessageToTxFifoQ(hfdcan, &header, data);
+}
+
+// --- FDCAN HAL ---
+
+HAL_StatusTypeDef HAL_FDCAN_Start(FDCAN_HandleTypeDef *hfdcan) {
+    if (!hfdcan->bus || hfdcan->started) return HAL_ERROR;
+    hfdcan->started = true;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FDCAN_Stop(FDCAN_HandleTypeDef *hfdcan) {
+    if (!hfdcan->started) return HAL_ERROR;
+    hfdcan->started = false;
+    // like the HAL, pending transmissions are cancelled
+    if (hfdcan->bus && hfdcan->bus->sender == hfdcan) {
+        hfdcan->bus->sender = NULL;
+    }
+    hfdcan->tx_fifo.count = 0;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FDCAN_ConfigFilter(FDCAN_HandleTypeDef *hfdcan,
+                                         FDCAN_FilterTypeDef *sFilterConfig) {
+    bool ext = sFilterConfig->IdType == FDCAN_EXTENDED_ID;
+    uint32_t n = ext ? hfdcan->Init.ExtFiltersNbr : hfdcan->Init.StdFiltersNbr;
+    uint32_t max = ext ? SIM_FDCAN_EXT_FILTERS : SIM_FDCAN_STD_FILTERS;
+    if (sFilterConfig->FilterIndex >= n || sFilterConfig->FilterIndex >= max) {
+        return HAL_ERROR;
+    }
+
+    FDCAN_FilterTypeDef *filters = ext ? hfdcan->ext_filters : hfdcan->std_filters;
+    filters[sFilterConfig->FilterIndex] = *sFilterConfig;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FDCAN_ConfigGlobalFilter(FDCAN_HandleTypeDef *hfdcan,
+                                               uint32_t NonMatchingStd,
+                                               uint32_t NonMatchingExt,
+                                               uint32_t RejectRemoteStd,
+                                               uint32_t RejectRemoteExt) {
+    // only allowed in the READY state, as on the chip
+    if (hfdcan->started) return HAL_ERROR;
+    hfdcan->non_matching_std = NonMatchingStd;
+    hfdcan->non_matching_ext = NonMatchingExt;
+    hfdcan->reject_remote_std = RejectRemoteStd;
+    hfdcan->reject_remote_ext = RejectRemoteExt;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FDCAN_ConfigTimestampCounter(FDCAN_HandleTypeDef *hfdcan,
+                                                   uint32_t TimestampPrescaler) {
+    if (hfdcan->started) return HAL_ERROR;
+    hfdcan->tsc_prescaler = (TimestampPrescaler >> 16) + 1;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FDCAN_EnableTimestampCounter(
+    FDCAN_HandleTypeDef *hfdcan, uint32_t TimestampOperation) {
+    if (TimestampOperation != FDCAN_TIMESTAMP_INTERNAL) return HAL_ERROR;
+    if (hfdcan->tsc_prescaler == 0) hfdcan->tsc_prescaler = 1;
+    hfdcan->tsc_enabled = true;
+    return HAL_OK;
+}
+
+uint16_t HAL_FDCAN_GetTimestampCounter(FDCAN_HandleTypeDef *hfdcan) {
+    return tsc_at(hfdcan, now_ns);
+}
+
+HAL_StatusTypeDef HAL_FDCAN_ActivateNotification(FDCAN_HandleTypeDef *hfdcan,
+                                                 uint32_t ActiveITs,
+                                                 uint32_t BufferIndexes) {
+    (void)BufferIndexes;
+    hfdcan->active_its |= ActiveITs;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FDCAN_AddMessageToTxFifoQ(
+    FDCAN_HandleTypeDef *hfdcan, const FDCAN_TxHeaderTypeDef *pTxHeader,
+    const uint8_t *pTxData) {
+    if (!hfdcan->started) return HAL_ERROR;
+    if (hfdcan->tx_fifo.count >= tx_depth(hfdcan)) return HAL_ERROR;
+
+    bool fd = pTxHeader->FDFormat == FDCAN_FD_CAN;
+    if (fd && hfdcan->Init.FrameFormat == FDCAN_FRAME_CLASSIC) return HAL_ERROR;
+
+    SimFDCANElement *element = fifo_at(&hfdcan->tx_fifo, hfdcan->tx_fifo.count);
+    memset(element, 0, sizeof(*element));
+    element->header.Identifier = pTxHeader->Identifier;
+    element->header.IdType = pTxHeader->IdType;
+    element->header.RxFrameType = pTxHeader->TxFrameType;
+    element->header.DataLength = pTxHeader->DataLength;
+    element->header.ErrorStateIndicator = pTxHeader->ErrorStateIndicator;
+    element->header.BitRateSwitch = pTxHeader->BitRateSwitch;
+    element->header.FDFormat = pTxHeader->FDFormat;
+    memcpy(element->data, pTxData,
+           CAN_dlc_to_len((uint8_t)pTxHeader->DataLength, fd));
+    hfdcan->tx_fifo.count++;
+    return HAL_OK;
+}
+
+uint32_t HAL_FDCAN_GetTxFifoFreeLevel(FDCAN_HandleTypeDef *hfdcan) {
+    return tx_depth(hfdcan) - hfdcan->tx_fifo.count;
+}
+
+HAL_StatusTypeDef HAL_FDCAN_GetRxMessage(FDCAN_HandleTypeDef *hfdcan,
+                                         uint32_t RxLocation,
+                                         FDCAN_RxHeaderTypeDef *pRxHeader,
+                                         uint8_t *pRxData) {
+    if (RxLocation != FDCAN_RX_FIFO0 && RxLocation != FDCAN_RX_FIFO1) {
+        return HAL_ERROR;
+    }
+    SimFDCANFifo *fifo = &hfdcan->rx_fifo[RxLocation == FDCAN_RX_FIFO1];
+    if (fifo->count == 0) return HAL_ERROR;
+
+    SimFDCANElement *element = fifo_at(fifo, 0);
+    *pRxHeader = element->header;
+    memcpy(pRxData, element->data,
+           CAN_dlc_to_len((uint8_t)element->header.DataLength,
+                          element->header.FDFormat == FDCAN_FD_CAN));
+    fifo->get = (fifo->get + 1) % SIM_FDCAN_FIFO_MAX;
+    fifo->count--;
+    return HAL_OK;
+}
+
+uint32_t HAL_FDCAN_GetRxFifoFillLevel(FDCAN_HandleTypeDef *hfdcan,
+                                      uint32_t RxFifo) {
+    if (RxFifo != FDCAN_RX_FIFO0 && RxFifo != FDCAN_RX_FIFO1) return 0;
+    return hfdcan->rx_fifo[RxFifo == FDCAN_RX_FIFO1].count;
+}
+
+__attribute__((weak)) void HAL_FDCAN_RxFifo0Callback(
+    FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo0ITs) {
+    (void)hfdcan;
+    (void)RxFifo0ITs;
+}
+
+__attribute__((weak)) void HAL_FDCAN_RxFifo1Callback(
+    FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo1ITs) {
+    (void)hfdcan;
+    (void)RxFifo1ITs;
+}
+
+__attribute__((weak)) void HAL_FDCAN_TxBufferCompleteCallback(
+    FDCAN_HandleTypeDef *hfdcan, uint32_t BufferIndexes) {
+    (void)hfdcan;
+    (void)BufferIndexes;
+}
+
+__attribute__((weak)) void HAL_FDCAN_TxFifoEmptyCallback(
+    FDCAN_HandleTypeDef *hfdcan) {
+    (void)hfdcan;
+}
@@ -0,0 +1,86 @@
+//
+// Simulated FDCAN bus and virtual clock for running the library on a PC.
+//
+// Every FDCAN_HandleTypeDef attached to a SimCanBus is one node. Frames a node
+// queues with HAL_FDCAN_AddMessageToTxFifoQ go out when the clock is advanced:
+// whenever the bus is idle the lowest arbitration field among the nodes' TX
+// FIFO heads wins, holds the bus for its bit time, and is then delivered
+// through each other node's acceptance filters into its RX FIFOs. The HAL
+// RX/TX callbacks of a node run right then if their notifications are active,
+// so from the driver's point of view interrupts land between its calls.
+//
+// Nothing runs on its own: time only moves in sim_clock_advance_* (and
+// HAL_Delay). HAL_GetTick, the DWT cycle counter and the FDCAN timestamp
+// counters all follow it.
+//
+
+#ifndef LONGHORN_LIBRARY_2025_SIM_CAN_H
+#define LONGHORN_LIBRARY_2025_SIM_CAN_H
+
+#include "stm32h7xx_hal.h"
+
+#define SIM_CORE_CLOCK_HZ 550000000U  // what HAL_RCC_GetHCLKFreq reports
+#define SIM_FDCAN_KERNEL_HZ 80000000U  // and HAL_RCCEx_GetPeriphCLKFreq
+#define SIM_NOMINAL_BITRATE 1000000U   // bus speed the bench and replay use
+#define SIM_BUS_MAX_NODES 16
+#define SIM_MAX_BUSES 4
+
+typedef struct SimCanBus {
+    uint32_t nominal_bitrate;
+    uint32_t data_bitrate;  // FD data phase with BRS
+    FDCAN_HandleTypeDef *nodes[SIM_BUS_MAX_NODES];
+    uint32_t node_count;
+
+    // frame on the wire
+    FDCAN_HandleTypeDef *sender;  // NULL while idle
+    uint64_t frame_start_ns;
+    uint64_t frame_end_ns;
+
+    // counters
+    uint64_t busy_ns;  // time spent sending frames
+    uint32_t frames;
+} SimCanBus;
+
+/* Sets the clock back to 0 and forgets all buses */
+void sim_clock_reset(void);
+
+uint64_t sim_clock_now_ns(void);
+
+/* Moves the clock forward, sending and delivering frames on the way */
+void sim_clock_advance_ns(uint64_t ns);
+
+static inline void sim_clock_advance_us(uint64_t us) {
+    sim_clock_advance_ns(us * 1000U);
+}
+
+void sim_bus_init(SimCanBus *bus, uint32_t nominal_bitrate,
+                  uint32_t data_bitrate);
+
+/**
+ * Puts a node on the bus and gives its Init a CubeMX-like setup: nominal bit
+ * timing for the bus rate, 32 element RX FIFO0 and TX FIFO, 8 element RX
+ * FIFO1, 32 standard / 8 extended filters, accept everything into FIFO0.
+ * Change Init afterwards but before starting it.
+ * @return false if the bus is full
+ */
+bool sim_bus_attach(SimCanBus *bus, FDCAN_HandleTypeDef *hfdcan,
+                    const char *name);
+
+/* Fraction of the time since the clock reset the bus spent sending */
+float sim_bus_load(const SimCanBus *bus);
+
+/* Wire time of a frame in ns, stuff bits included (approximate for FD) */
+uint64_t sim_frame_time_ns(const SimCanBus *bus,
+                           const FDCAN_RxHeaderTypeDef *header,
+                           const uint8_t *data);
+
+/* Queues a classic data frame on a node, for traffic that isn't from the
+ * driver. Returns HAL_ERROR if its TX FIFO is full. */
+HAL_StatusTypeDef sim_can_send(FDCAN_HandleTypeDef *hfdcan, uint32_t id,
+                               const uint8_t *data, uint8_t len);
+
+// what the firmware would have done to the board
+extern uint32_t sim_reset_requests;  // HAL_NVIC_SystemReset calls
+extern uint32_t sim_dfu_requests;    // boot_to_dfu calls
+
+#endif  // LONGHORN_LIBRARY_2025_SIM_CAN_H
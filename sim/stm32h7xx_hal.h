@@ -0,0 +1,278 @@
+//
+// Host stand-in for the parts of the STM32H7 HAL the library uses, so
+// night_can.c and timer.c build and run on a PC against a simulated FDCAN bus
+// (see sim_can.h). Only what the library touches is here, with the same
+// names and semantics as the real HAL, so the driver runs its H7 code paths
+// unchanged.
+//
+
+#ifndef LONGHORN_LIBRARY_2025_SIM_STM32H7XX_HAL_H
+#define LONGHORN_LIBRARY_2025_SIM_STM32H7XX_HAL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef NIGHTCAN_RX_MSGRAM
+#error "the simulator has no FDCAN message RAM, build without NIGHTCAN_RX_MSGRAM"
+#endif
+
+#define __IO volatile
+
+typedef enum {
+    HAL_OK = 0x00,
+    HAL_ERROR = 0x01,
+    HAL_BUSY = 0x02,
+    HAL_TIMEOUT = 0x03
+} HAL_StatusTypeDef;
+
+typedef enum { DISABLE = 0U, ENABLE = !DISABLE } FunctionalState;
+
+// --- Core ---
+// Nothing preempts anything on the host: simulated interrupts run from
+// sim_clock_advance_* between calls into the driver, so PRIMASK is just
+// remembered.
+
+extern uint32_t sim_primask;
+
+static inline uint32_t __get_PRIMASK(void) { return sim_primask; }
+static inline void __set_PRIMASK(uint32_t primask) { sim_primask = primask; }
+static inline void __disable_irq(void) { sim_primask = 1; }
+static inline void __enable_irq(void) { sim_primask = 0; }
+static inline void __DMB(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+static inline void __DSB(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+static inline void __ISB(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+
+typedef struct {
+    __IO uint32_t CTRL;
+    __IO uint32_t CYCCNT;
+    __IO uint32_t LAR;
+} DWT_Type;
+
+typedef struct {
+    __IO uint32_t DEMCR;
+} CoreDebug_Type;
+
+extern DWT_Type sim_dwt;  // CYCCNT follows the simulated clock
+extern CoreDebug_Type sim_core_debug;
+#define DWT (&sim_dwt)
+#define CoreDebug (&sim_core_debug)
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24)
+#define DWT_CTRL_CYCCNTENA_Msk (1UL << 0)
+
+static inline void SCB_CleanDCache_by_Addr(void *addr, int32_t size) {
+    (void)addr;
+    (void)size;
+}
+static inline void SCB_InvalidateDCache_by_Addr(void *addr, int32_t size) {
+    (void)addr;
+    (void)size;
+}
+
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t Delay);
+uint32_t HAL_RCC_GetHCLKFreq(void);
+#define RCC_PERIPHCLK_FDCAN 0x00008000U
+uint32_t HAL_RCCEx_GetPeriphCLKFreq(uint64_t PeriphClk);
+void HAL_NVIC_SystemReset(void);
+
+// --- GPIO ---
+typedef struct {
+    __IO uint32_t ODR;
+} GPIO_TypeDef;
+
+typedef enum { GPIO_PIN_RESET = 0, GPIO_PIN_SET } GPIO_PinState;
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin,
+                       GPIO_PinState PinState);
+
+// --- FDCAN ---
+#define FDCAN_STANDARD_ID 0x00000000U
+#define FDCAN_EXTENDED_ID 0x40000000U
+#define FDCAN_DATA_FRAME 0x00000000U
+#define FDCAN_REMOTE_FRAME 0x20000000U
+#define FDCAN_ESI_ACTIVE 0x00000000U
+#define FDCAN_ESI_PASSIVE 0x80000000U
+#define FDCAN_BRS_OFF 0x00000000U
+#define FDCAN_BRS_ON 0x00100000U
+#define FDCAN_CLASSIC_CAN 0x00000000U
+#define FDCAN_FD_CAN 0x00200000U
+#define FDCAN_NO_TX_EVENTS 0x00000000U
+#define FDCAN_STORE_TX_EVENTS 0x00800000U
+
+#define FDCAN_FRAME_CLASSIC 0x00000000U
+#define FDCAN_FRAME_FD_NO_BRS 0x00000100U
+#define FDCAN_FRAME_FD_BRS 0x00000300U
+
+#define FDCAN_RX_FIFO0 0x00000040U
+#define FDCAN_RX_FIFO1 0x00000041U
+
+#define FDCAN_FILTER_RANGE 0x00000000U
+#define FDCAN_FILTER_DUAL 0x00000001U
+#define FDCAN_FILTER_MASK 0x00000002U
+
+#define FDCAN_FILTER_DISABLE 0x00000000U
+#define FDCAN_FILTER_TO_RXFIFO0 0x00000001U
+#define FDCAN_FILTER_TO_RXFIFO1 0x00000002U
+#define FDCAN_FILTER_REJECT 0x00000003U
+
+#define FDCAN_ACCEPT_IN_RX_FIFO0 0x00000000U
+#define FDCAN_ACCEPT_IN_RX_FIFO1 0x00000001U
+#define FDCAN_REJECT 0x00000002U
+#define FDCAN_FILTER_REMOTE 0x00000000U
+#define FDCAN_REJECT_REMOTE 0x00000001U
+
+#define FDCAN_TIMESTAMP_PRESC_1 0x00000000U
+#define FDCAN_TIMESTAMP_INTERNAL 0x00000001U
+
+#define FDCAN_IT_TX_COMPLETE 0x00000200U
+#define FDCAN_IT_TX_FIFO_EMPTY 0x00000800U
+#define FDCAN_IT_RX_FIFO0_NEW_MESSAGE 0x00000001U
+#define FDCAN_IT_RX_FIFO0_FULL 0x00000002U
+#define FDCAN_IT_RX_FIFO0_MESSAGE_LOST 0x00000008U
+#define FDCAN_IT_RX_FIFO1_NEW_MESSAGE 0x00000010U
+#define FDCAN_IT_RX_FIFO1_FULL 0x00000020U
+#define FDCAN_IT_RX_FIFO1_MESSAGE_LOST 0x00000080U
+
+#define FDCAN_DLC_BYTES_0 0x00000000U
+#define FDCAN_DLC_BYTES_8 0x00000008U
+#define FDCAN_DLC_BYTES_64 0x0000000FU
+
+#define SIM_FDCAN_FIFO_MAX 64      // hardware limit for an RX FIFO
+#define SIM_FDCAN_TX_FIFO_MAX 32   // and for the TX FIFO/queue
+#define SIM_FDCAN_STD_FILTERS 128
+#define SIM_FDCAN_EXT_FILTERS 64
+
+typedef struct {
+    uint32_t FrameFormat;
+    uint32_t Mode;
+    uint32_t AutoRetransmission;
+    uint32_t NominalPrescaler;
+    uint32_t NominalTimeSeg1;
+    uint32_t NominalTimeSeg2;
+    uint32_t StdFiltersNbr;
+    uint32_t ExtFiltersNbr;
+    uint32_t RxFifo0ElmtsNbr;
+    uint32_t RxFifo0ElmtSize;
+    uint32_t RxFifo1ElmtsNbr;
+    uint32_t RxFifo1ElmtSize;
+    uint32_t TxFifoQueueElmtsNbr;
+} FDCAN_InitTypeDef;
+
+typedef struct {
+    uint32_t Identifier;
+    uint32_t IdType;
+    uint32_t TxFrameType;
+    uint32_t DataLength;
+    uint32_t ErrorStateIndicator;
+    uint32_t BitRateSwitch;
+    uint32_t FDFormat;
+    uint32_t TxEventFifoControl;
+    uint32_t MessageMarker;
+} FDCAN_TxHeaderTypeDef;
+
+typedef struct {
+    uint32_t Identifier;
+    uint32_t IdType;
+    uint32_t RxFrameType;
+    uint32_t DataLength;
+    uint32_t ErrorStateIndicator;
+    uint32_t BitRateSwitch;
+    uint32_t FDFormat;
+    uint32_t RxTimestamp;
+    uint32_t FilterIndex;
+    uint32_t IsFilterMatchingFrame;
+} FDCAN_RxHeaderTypeDef;
+
+typedef struct {
+    uint32_t IdType;
+    uint32_t FilterIndex;
+    uint32_t FilterType;
+    uint32_t FilterConfig;
+    uint32_t FilterID1;
+    uint32_t FilterID2;
+    uint32_t RxBufferIndex;
+    uint32_t IsCalibrationMsg;
+} FDCAN_FilterTypeDef;
+
+/* One frame in a simulated FIFO, in HAL header form */
+typedef struct {
+    FDCAN_RxHeaderTypeDef header;
+    uint8_t data[64];
+} SimFDCANElement;
+
+typedef struct {
+    SimFDCANElement elements[SIM_FDCAN_FIFO_MAX];
+    uint32_t get;    // index of the oldest element
+    uint32_t count;
+} SimFDCANFifo;
+
+struct SimCanBus;
+
+typedef struct __FDCAN_HandleTypeDef {
+    void *Instance;
+    FDCAN_InitTypeDef Init;
+    __IO uint32_t ErrorCode;
+
+    // --- simulator state, see sim_can.h ---
+    struct SimCanBus *bus;
+    const char *name;
+    bool started;
+    SimFDCANFifo rx_fifo[2];
+    SimFDCANFifo tx_fifo;
+    FDCAN_FilterTypeDef std_filters[SIM_FDCAN_STD_FILTERS];
+    FDCAN_FilterTypeDef ext_filters[SIM_FDCAN_EXT_FILTERS];
+    uint32_t non_matching_std;  // FDCAN_ACCEPT_IN_RX_FIFOx / FDCAN_REJECT
+    uint32_t non_matching_ext;
+    uint32_t reject_remote_std;
+    uint32_t reject_remote_ext;
+    uint32_t active_its;
+    bool tsc_enabled;
+    uint32_t tsc_prescaler;
+
+    // counters
+    uint32_t tx_frames;
+    uint32_t rx_frames;
+    uint32_t rx_filtered;        // dropped by the acceptance filters
+    uint32_t rx_lost;            // arrived with the FIFO full
+    uint32_t arbitration_lost;   // times another node's frame won
+} FDCAN_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_FDCAN_Start(FDCAN_HandleTypeDef *hfdcan);
+HAL_StatusTypeDef HAL_FDCAN_Stop(FDCAN_HandleTypeDef *hfdcan);
+HAL_StatusTypeDef HAL_FDCAN_ConfigFilter(FDCAN_HandleTypeDef *hfdcan,
+                                         FDCAN_FilterTypeDef *sFilterConfig);
+HAL_StatusTypeDef HAL_FDCAN_ConfigGlobalFilter(FDCAN_HandleTypeDef *hfdcan,
+                                               uint32_t NonMatchingStd,
+                                               uint32_t NonMatchingExt,
+                                               uint32_t RejectRemoteStd,
+                                               uint32_t RejectRemoteExt);
+HAL_StatusTypeDef HAL_FDCAN_ConfigTimestampCounter(FDCAN_HandleTypeDef *hfdcan,
+                                                   uint32_t TimestampPrescaler);
+HAL_StatusTypeDef HAL_FDCAN_EnableTimestampCounter(
+    FDCAN_HandleTypeDef *hfdcan, uint32_t TimestampOperation);
+uint16_t HAL_FDCAN_GetTimestampCounter(FDCAN_HandleTypeDef *hfdcan);
+HAL_StatusTypeDef HAL_FDCAN_ActivateNotification(FDCAN_HandleTypeDef *hfdcan,
+                                                 uint32_t ActiveITs,
+                                                 uint32_t BufferIndexes);
+HAL_StatusTypeDef HAL_FDCAN_AddMessageToTxFifoQ(
+    FDCAN_HandleTypeDef *hfdcan, const FDCAN_TxHeaderTypeDef *pTxHeader,
+    const uint8_t *pTxData);
+uint32_t HAL_FDCAN_GetTxFifoFreeLevel(FDCAN_HandleTypeDef *hfdcan);
+HAL_StatusTypeDef HAL_FDCAN_GetRxMessage(FDCAN_HandleTypeDef *hfdcan,
+                                         uint32_t RxLocation,
+                                         FDCAN_RxHeaderTypeDef *pRxHeader,
+                                         uint8_t *pRxData);
+uint32_t HAL_FDCAN_GetRxFifoFillLevel(FDCAN_HandleTypeDef *hfdcan,
+                                      uint32_t RxFifo);
+
+// weak in the simulator like in the HAL, the driver overrides them
+void HAL_FDCAN_RxFifo0Callback(FDCAN_HandleTypeDef *hfdcan,
+                               uint32_t RxFifo0ITs);
+void HAL_FDCAN_RxFifo1Callback(FDCAN_HandleTypeDef *hfdcan,
+                               uint32_t RxFifo1ITs);
+void HAL_FDCAN_TxBufferCompleteCallback(FDCAN_HandleTypeDef *hfdcan,
+                                        uint32_t BufferIndexes);
+void HAL_FDCAN_TxFifoEmptyCallback(FDCAN_HandleTypeDef *hfdcan);
+
+#endif  // LONGHORN_LIBRARY_2025_SIM_STM32H7XX_HAL_H
@@ -0,0 +1,650 @@
+//
+// night_can behaviour tests on the simulated bus.
+//
+// Every test starts a fresh bus with the board under test (dut) and a peer
+// node, runs the driver's main loop over simulated time and checks what went
+// out on the bus and what landed in the inboxes. The driver keeps its
+// instances in a global table with no way to take one out, so each test runs
+// in its own process. CMake registers all of them with ctest, once for every
+// set of driver options it builds them with.
+//
+// Usage: night_can_tests NAME | --list
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "night_can.h"
+#include "sim_can.h"
+#include "timer.h"
+
+#define LOOP_US 100  // main loop period
+#define MAX_SEEN 4096
+
+#define CHECK(cond)                                                     \
+    do {                                                                \
+        if (!(cond)) {                                                  \
+            fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #cond);  \
+            exit(1);                                                    \
+        }                                                               \
+    } while (0)
+
+#define CHECK_EQ(a, b)                                                  \
+    do {                                                                \
+        long long a_ = (long long)(a), b_ = (long long)(b);             \
+        if (a_ != b_) {                                                 \
+            fprintf(stderr, "%s:%d: %s == %s (%lld vs %lld)\n", __FILE__, \
+                    __LINE__, #a, #b, a_, b_);                          \
+            exit(1);                                                    \
+        }                                                               \
+    } while (0)
+
+#define CHECK_NEAR(a, b, tolerance)                                     \
+    do {                                                                \
+        long long a_ = (long long)(a), b_ = (long long)(b);             \
+        if (llabs(a_ - b_) > (long long)(tolerance)) {                  \
+            fprintf(stderr, "%s:%d: %s ~ %s (%lld vs %lld)\n", __FILE__, \
+                    __LINE__, #a, #b, a_, b_);                          \
+            exit(1);                                                    \
+        }                                                               \
+    } while (0)
+
+// --- Fixture ---
+
+typedef struct {
+    uint32_t id;
+    uint8_t len;
+    uint8_t data[8];
+    uint64_t time_us;  // when the sniffer read it, within a loop period
+} SeenFrame;
+
+// a node that keeps everything it hears
+typedef struct {
+    FDCAN_HandleTypeDef *node;
+    SeenFrame frames[MAX_SEEN];
+    uint32_t count;
+} Sniffer;
+
+static SimCanBus bus;
+static FDCAN_HandleTypeDef dut_hfdcan;
+static FDCAN_HandleTypeDef peer_hfdcan;
+static NightCANInstance can;
+static Sniffer peer = {.node = &peer_hfdcan};
+
+// gateway tests: the board's second FDCAN and a listener on its bus
+static SimCanBus gw_bus;
+static FDCAN_HandleTypeDef gw_hfdcan;
+static FDCAN_HandleTypeDef listener_hfdcan;
+static NightCANInstance gw_can;
+static Sniffer listener = {.node = &listener_hfdcan};
+static bool gw_running = false;
+
+static void setup(void) {
+    sim_clock_reset();
+    sim_bus_init(&bus, SIM_NOMINAL_BITRATE, 2000000);
+    sim_bus_attach(&bus, &dut_hfdcan, "dut");
+    sim_bus_attach(&bus, &peer_hfdcan, "peer");
+    CHECK_EQ(HAL_FDCAN_Start(&peer_hfdcan), HAL_OK);
+    lib_timer_init();
+
+    can = CAN_new_instance();
+    CHECK_EQ(CAN_Init(&can, &dut_hfdcan, 0, 0, 0, 0), CAN_OK);
+}
+
+static void setup_gateway(void) {
+    sim_bus_init(&gw_bus, SIM_NOMINAL_BITRATE, 2000000);
+    sim_bus_attach(&gw_bus, &gw_hfdcan, "dut2");
+    sim_bus_attach(&gw_bus, &listener_hfdcan, "listener");
+    CHECK_EQ(HAL_FDCAN_Start(&listener_hfdcan), HAL_OK);
+
+    gw_can = CAN_new_instance();
+    CHECK_EQ(CAN_Init(&gw_can, &gw_hfdcan, 0, 0, 0, 0), CAN_OK);
+    gw_running = true;
+}
+
+static void sniff(Sniffer *sniffer) {
+    FDCAN_RxHeaderTypeDef header;
+    uint8_t data[CAN_MAX_DATA_LEN];
+    while (HAL_FDCAN_GetRxMessage(sniffer->node, FDCAN_RX_FIFO0, &header,
+                                  data) == HAL_OK) {
+        CHECK(sniffer->count < MAX_SEEN);
+        SeenFrame *frame = &sniffer->frames[sniffer->count++];
+        frame->id = header.Identifier;
+        frame->len = CAN_dlc_to_len((uint8_t)header.DataLength, false);
+        memcpy(frame->data, data, sizeof(frame->data));
+        frame->time_us = sim_clock_now_ns() / 1000U;
+    }
+}
+
+/* Runs the board's main loop for ms of simulated time */
+static void run_ms(uint32_t ms) {
+    for (uint32_t us = 0; us < ms * 1000U; us += LOOP_US) {
+        sim_clock_advance_us(LOOP_US);
+        CAN_periodic(&can);
+        if (gw_running) CAN_periodic(&gw_can);
+        sniff(&peer);
+        if (gw_running) sniff(&listener);
+    }
+}
+
+static void peer_send(uint32_t id, const uint8_t *data, uint8_t len) {
+    CHECK_EQ(sim_can_send(&peer_hfdcan, id, data, len), HAL_OK);
+}
+
+static uint32_t seen_count(const Sniffer *sniffer, uint32_t id) {
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < sniffer->count; i++) {
+        if (sniffer->frames[i].id == id) n++;
+    }
+    return n;
+}
+
+/* The n-th frame with id, NULL if there weren't that many */
+static const SeenFrame *seen_nth(const Sniffer *sniffer, uint32_t id,
+                                 uint32_t n) {
+    for (uint32_t i = 0; i < sniffer->count; i++) {
+        if (sniffer->frames[i].id == id && n-- == 0) {
+            return &sniffer->frames[i];
+        }
+    }
+    return NULL;
+}
+
+// --- Receive ---
+
+/* Frames land in the inbox for their ID and nowhere else */
+static void test_rx_inbox(void) {
+    setup();
+    static NightCANReceivePacket a, b;
+    a = CAN_create_receive_packet(0x100, 0, 8);
+    b = CAN_create_receive_packet(0x200, 0, 4);
+    CAN_addReceivePacket(&can, &a);
+    CAN_addReceivePacket(&can, &b);
+
+    uint8_t payload[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    peer_send(0x200, payload, 8);  // longer than the inbox
+    peer_send(0x300, payload, 8);  // nobody's
+    run_ms(1);
+
+    CHECK(b.is_recent);
+    CHECK(!a.is_recent);
+    CHECK(memcmp(b.data, payload, 4) == 0);
+    CHECK_EQ(b.data[4], 0);  // only the inbox's dlc is kept
+    CHECK(CAN_GetReceivedPacket(&can, 0x200) == &b);
+    CHECK(CAN_GetReceivedPacket(&can, 0x300) == NULL);
+
+    CAN_consume_packet(&b);
+    CHECK(!b.is_recent);
+
+    payload[0] = 9;
+    peer_send(0x100, payload, 8);
+    run_ms(1);
+    CHECK(a.is_recent);
+    CHECK_EQ(a.data[0], 9);
+    CHECK(!b.is_recent);
+
+#ifdef NIGHTCAN_STATS
+    NightCANStatsSnapshot stats;
+    CHECK_EQ(CAN_GetStats(&can, &stats), CAN_OK);
+    CHECK_EQ(stats.totals.rx_frames, 3);
+    CHECK_EQ(stats.totals.rx_unknown_id, 1);
+#endif
+}
+
+/* A full set of inboxes, standard and extended, all found through the ID
+ * lookup table, and IDs without one aren't matched to anything */
+static void test_rx_hash_index(void) {
+    setup();
+    static NightCANReceivePacket inboxes[CAN_RX_BUFFER_SIZE];
+    for (uint32_t i = 0; i < CAN_RX_BUFFER_SIZE; i++) {
+        uint32_t id = (i % 2) ? 0x1ABC000U + i * 64U : 0x005U + i * 64U;
+        inboxes[i] = CAN_create_receive_packet(id, 0, 1);
+        CAN_addReceivePacket(&can, &inboxes[i]);
+    }
+
+    for (uint32_t i = 0; i < CAN_RX_BUFFER_SIZE; i++) {
+        CHECK(CAN_GetReceivedPacket(&can, inboxes[i].id) == &inboxes[i]);
+        uint8_t tag = (uint8_t)(i + 1);
+        peer_send(inboxes[i].id, &tag, 1);
+        peer_send(inboxes[i].id + 1, &tag, 1);  // not registered
+        run_ms(1);
+    }
+
+    for (uint32_t i = 0; i < CAN_RX_BUFFER_SIZE; i++) {
+        CHECK(inboxes[i].is_recent);
+        CHECK_EQ(inboxes[i].data[0], i + 1);
+        CHECK(CAN_GetReceivedPacket(&can, inboxes[i].id + 1) == NULL);
+    }
+
+#ifdef NIGHTCAN_STATS
+    NightCANStatsSnapshot stats;
+    CAN_GetStats(&can, &stats);
+    CHECK_EQ(stats.totals.rx_unknown_id, CAN_RX_BUFFER_SIZE);
+#endif
+}
+
+/* The inbox timestamp is when the frame was on the bus, not when it was read */
+static void test_rx_timestamp(void) {
+    setup();
+    static NightCANReceivePacket r;
+    r = CAN_create_receive_packet(0x240, 0, 8);
+    CAN_addReceivePacket(&can, &r);
+
+    run_ms(5);
+    uint8_t payload[8] = {0};
+    uint64_t sent_us = lib_timer_now_us();
+    peer_send(0x240, payload, 8);
+    sim_clock_advance_us(20000);  // nobody polls for a while
+    CAN_PollReceive(&can);
+
+    CHECK(r.is_recent);
+    CHECK(r.timestamp_us >= sent_us);
+    CHECK(r.timestamp_us <= sent_us + 10);  // start of frame, within a tick
+}
+
+static uint32_t timeout_calls;
+static bool last_timed_out;
+
+static void on_timeout(NightCANReceivePacket *packet, bool timed_out) {
+    (void)packet;
+    timeout_calls++;
+    last_timed_out = timed_out;
+}
+
+/* An inbox times out after timeout_ms of silence, and recovers on the next
+ * frame, telling the callback both times */
+static void test_rx_timeout(void) {
+    setup();
+    static NightCANReceivePacket r;
+    r = CAN_create_receive_packet(0x210, 20, 1);
+    CAN_addReceivePacket(&can, &r);
+    CAN_SetTimeoutCallback(&can, on_timeout);
+
+    uint8_t payload = 0;
+    for (int i = 0; i < 10; i++) {
+        peer_send(0x210, &payload, 1);
+        run_ms(5);
+        CHECK(!r.is_timed_out);
+    }
+    CHECK_EQ(timeout_calls, 0);
+
+    run_ms(30);
+    CHECK(r.is_timed_out);
+    CHECK_EQ(timeout_calls, 1);
+    CHECK(last_timed_out);
+
+    peer_send(0x210, &payload, 1);
+    run_ms(1);
+    CHECK(!r.is_timed_out);
+    CHECK_EQ(timeout_calls, 2);
+    CHECK(!last_timed_out);
+
+#ifdef NIGHTCAN_STATS
+    NightCANStatsSnapshot stats;
+    CAN_GetStats(&can, &stats);
+    CHECK_EQ(stats.totals.timeouts_raised, 1);
+#endif
+}
+
+// --- Transmit ---
+
+/* A periodic packet goes out every interval, on its phase */
+static void test_tx_schedule(void) {
+    setup();
+    static NightCANPacket p;
+    p = CAN_create_packet(0x123, 10, 8);
+    CHECK_EQ(CAN_AddTxPacket(&can, &p), CAN_OK);
+    run_ms(1000);
+
+    CHECK_NEAR(seen_count(&peer, 0x123), 100, 1);
+    for (uint32_t n = 0; n + 1 < seen_count(&peer, 0x123); n++) {
+        const SeenFrame *frame = seen_nth(&peer, 0x123, n);
+        const SeenFrame *next = seen_nth(&peer, 0x123, n + 1);
+        CHECK_NEAR(next->time_us - frame->time_us, 10000, LOOP_US);
+        CHECK((frame->time_us % 10000) < 1000);  // phase 0
+    }
+}
+
+/* Packets of many rates share the schedule heap, each keeps its own rate,
+ * and one taken off stops without disturbing the rest */
+static void test_tx_heap(void) {
+    setup();
+    static const uint32_t intervals[] = {1, 3, 7, 10, 50, 2, 25};
+    const uint32_t count = sizeof(intervals) / sizeof(intervals[0]);
+    static NightCANPacket packets[sizeof(intervals) / sizeof(intervals[0])];
+    for (uint32_t i = 0; i < count; i++) {
+        packets[i] = CAN_create_packet(0x300 + i, intervals[i], 8);
+        CHECK_EQ(CAN_AddTxPacket(&can, &packets[i]), CAN_OK);
+    }
+    run_ms(1000);
+    for (uint32_t i = 0; i < count; i++) {
+        CHECK_NEAR(seen_count(&peer, 0x300 + i), 1000 / intervals[i], 1);
+    }
+
+    CHECK_EQ(CAN_RemoveScheduledTxPacket(&can, &packets[2]), CAN_OK);
+    CHECK_EQ(CAN_RemoveScheduledTxPacket(&can, &packets[2]), CAN_NOT_FOUND);
+    peer.count = 0;
+    run_ms(500);
+    CHECK_EQ(seen_count(&peer, 0x302), 0);
+    for (uint32_t i = 0; i < count; i++) {
+        if (i == 2) continue;
+        CHECK_NEAR(seen_count(&peer, 0x300 + i), 500 / intervals[i], 1);
+    }
+}
+
+/* Same-rate packets left to the driver go out on different phases */
+static void test_tx_stagger(void) {
+    setup();
+    enum { PACKETS = 8, INTERVAL = 10 };
+    static NightCANPacket packets[PACKETS];
+    for (uint32_t i = 0; i < PACKETS; i++) {
+        packets[i] = CAN_create_packet(0x400 + i, INTERVAL, 8);
+        packets[i].tx_phase_ms = CAN_TX_PHASE_AUTO;
+        CHECK_EQ(CAN_AddTxPacket(&can, &packets[i]), CAN_OK);
+    }
+    run_ms(100);
+
+    bool taken[INTERVAL] = {false};
+    for (uint32_t i = 0; i < PACKETS; i++) {
+        CHECK_NEAR(seen_count(&peer, 0x400 + i), 100 / INTERVAL, 1);
+        uint32_t phase = (uint32_t)(seen_nth(&peer, 0x400 + i, 0)->time_us /
+                                    1000U) % INTERVAL;
+        CHECK(!taken[phase]);
+        taken[phase] = true;
+    }
+}
+
+/* On-change packets go out when their data changes (no closer than
+ * tx_min_interval_ms), at least every tx_interval_ms, and keep going out on
+ * change when the interval is cleared */
+static void test_tx_on_change(void) {
+    setup();
+    static NightCANPacket p;
+    p = CAN_create_packet(0x150, 0, 2);
+    p.tx_on_change = true;
+    p.tx_min_interval_ms = 5;
+    CHECK_EQ(CAN_AddTxPacket(&can, &p), CAN_OK);
+    run_ms(20);
+    CHECK_EQ(seen_count(&peer, 0x150), 1);  // once when added
+
+    p.data[0] = 1;
+    run_ms(1);
+    CHECK_EQ(seen_count(&peer, 0x150), 2);
+    p.data[0] = 2;
+    run_ms(1);
+    CHECK_EQ(seen_count(&peer, 0x150), 2);  // inside tx_min_interval_ms
+    run_ms(6);
+    CHECK_EQ(seen_count(&peer, 0x150), 3);
+    CHECK_EQ(seen_nth(&peer, 0x150, 2)->data[0], 2);
+
+    // with an interval it's also a heartbeat
+    static NightCANPacket q;
+    q = CAN_create_packet(0x151, 20, 1);
+    q.tx_on_change = true;
+    CHECK_EQ(CAN_AddTxPacket(&can, &q), CAN_OK);
+    run_ms(100);
+    CHECK_NEAR(seen_count(&peer, 0x151), 1 + 100 / 20, 1);
+
+    // interval cleared: off the schedule, still watched
+    q.tx_interval_ms = 0;
+    run_ms(40);
+    peer.count = 0;
+    q.data[0] = 7;
+    run_ms(2);
+    CHECK_EQ(seen_count(&peer, 0x151), 1);
+    CHECK_EQ(seen_nth(&peer, 0x151, 0)->data[0], 7);
+    run_ms(100);
+    CHECK_EQ(seen_count(&peer, 0x151), 1);
+}
+
+/* More frames at once than the hardware holds wait in the TX queue, all get
+ * out in order, and a queued packet sent again just gets its new payload */
+static void test_tx_queue(void) {
+    setup();
+    enum { BURST = 40 };
+    static NightCANPacket burst[BURST];
+    for (uint32_t i = 0; i < BURST; i++) {
+        burst[i] = CAN_create_packet(0x400 + i, 0, 8);
+        burst[i].data[0] = (uint8_t)i;
+        CHECK_EQ(CAN_AddTxPacket(&can, &burst[i]), CAN_OK);
+    }
+    uint32_t queued = can.tx_queue_count;
+    CHECK(queued > 0);
+
+    burst[BURST - 1].data[0] = 0xAA;
+    CHECK_EQ(CAN_AddTxPacket(&can, &burst[BURST - 1]), CAN_OK);
+    CHECK_EQ(can.tx_queue_count, queued);  // coalesced
+
+    run_ms(20);
+    CHECK_EQ(peer.count, BURST);
+    for (uint32_t i = 0; i < BURST; i++) {
+        CHECK_EQ(peer.frames[i].id, 0x400 + i);
+    }
+    CHECK_EQ(peer.frames[BURST - 1].data[0], 0xAA);
+    CHECK_EQ(can.tx_queue_count, 0);
+    CHECK_EQ(can.tx_queue_enqueued, queued);
+    CHECK_EQ(can.tx_queue_dropped, 0);
+}
+
+/* With the hardware full, the TX queue sends lowest ID first, and when it's
+ * full too the least important frame is the one dropped */
+static void test_tx_priority(void) {
+    setup();
+    static NightCANPacket fill[SIM_FDCAN_TX_FIFO_MAX + 1];
+    uint32_t fill_count = 0;
+    while (can.tx_queue_count == 0) {
+        CHECK(fill_count <= SIM_FDCAN_TX_FIFO_MAX);
+        fill[fill_count] = CAN_create_packet(0x600 + fill_count, 0, 8);
+        CHECK_EQ(CAN_AddTxPacket(&can, &fill[fill_count]), CAN_OK);
+        fill_count++;
+    }
+    // the last fill frame is the first one queued, fill the rest of the queue
+    // from the highest ID down
+    static NightCANPacket queued[CAN_TX_QUEUE_SIZE];
+    for (uint32_t i = 0; i < CAN_TX_QUEUE_SIZE - 1; i++) {
+        queued[i] = CAN_create_packet(0x50E - i, 0, 8);
+        CHECK_EQ(CAN_AddTxPacket(&can, &queued[i]), CAN_OK);
+    }
+    CHECK_EQ(can.tx_queue_count, CAN_TX_QUEUE_SIZE);
+
+    static NightCANPacket urgent, unimportant;
+    urgent = CAN_create_packet(0x010, 0, 8);
+    CHECK_EQ(CAN_AddTxPacket(&can, &urgent), CAN_OK);  // evicts the last fill
+    unimportant = CAN_create_packet(0x700, 0, 8);
+    CHECK_EQ(CAN_AddTxPacket(&can, &unimportant), CAN_BUFFER_FULL);
+    CHECK_EQ(can.tx_queue_dropped, 2);
+
+    run_ms(20);
+    uint32_t in_hw = fill_count - 1;
+    CHECK_EQ(peer.count, in_hw + CAN_TX_QUEUE_SIZE);
+    for (uint32_t i = 0; i < in_hw; i++) CHECK_EQ(peer.frames[i].id, 0x600 + i);
+    CHECK_EQ(peer.frames[in_hw].id, 0x010);
+    for (uint32_t i = 1; i < CAN_TX_QUEUE_SIZE; i++) {
+        CHECK_EQ(peer.frames[in_hw + i].id, 0x500 + i - 1);
+    }
+    CHECK_EQ(seen_count(&peer, 0x600 + in_hw), 0);
+    CHECK_EQ(seen_count(&peer, 0x700), 0);
+}
+
+// --- Options ---
+
+#ifdef NIGHTCAN_GATEWAY
+/* Routed frames are forwarded unchanged onto the other bus, rate limited
+ * ones at most once per min_interval_ms, and still reach their inbox */
+static void test_gateway(void) {
+    setup();
+    setup_gateway();
+
+    static NightCANReceivePacket inbox;
+    inbox = CAN_create_receive_packet(0x100, 0, 8);
+    CAN_addReceivePacket(&can, &inbox);
+
+    static NightCANRoute bad[1] = {{.id = 0x100, .mask = CAN_ROUTE_EXACT}};
+    bad[0].dest = &can;
+    CHECK_EQ(CAN_SetRoutes(&can, bad, 1), CAN_INVALID_PARAM);
+
+    static NightCANRoute routes[2] = {
+        {.id = 0x100, .mask = CAN_ROUTE_EXACT},
+        {.id = 0x200, .mask = 0x700, .min_interval_ms = 10},  // 0x200-0x2FF
+    };
+    routes[0].dest = &gw_can;
+    routes[1].dest = &gw_can;
+    CHECK_EQ(CAN_SetRoutes(&can, routes, 2), CAN_OK);
+
+    uint8_t payload[8] = {0xDE, 0xAD, 0xBE, 0xEF, 1, 2, 3, 4};
+    peer_send(0x100, payload, 8);
+    peer_send(0x101, payload, 8);
+    run_ms(2);
+    CHECK_EQ(seen_count(&listener, 0x100), 1);
+    CHECK_EQ(seen_count(&listener, 0x101), 0);
+    CHECK(memcmp(seen_nth(&listener, 0x100, 0)->data, payload, 8) == 0);
+    CHECK(inbox.is_recent);
+    CHECK_EQ(routes[0]._forwarded, 1);
+
+    for (int i = 0; i < 20; i++) {
+        peer_send(0x2AB, payload, 8);
+        run_ms(1);
+    }
+    run_ms(2);
+    CHECK_NEAR(seen_count(&listener, 0x2AB), 2, 1);
+    CHECK_EQ(routes[1]._forwarded, seen_count(&listener, 0x2AB));
+    CHECK_EQ(routes[1]._forwarded + routes[1]._skipped, 20);
+}
+#endif
+
+#ifdef NIGHTCAN_SEQLOCK
+/* A snapshot is the latest frame, with how many arrived and were missed */
+static void test_seqlock(void) {
+    setup();
+    static NightCANReceivePacket r;
+    r = CAN_create_receive_packet(0x220, 0, 2);
+    CAN_addReceivePacket(&can, &r);
+
+    for (uint8_t value = 1; value <= 3; value++) {
+        uint8_t payload[2] = {value, (uint8_t)~value};
+        peer_send(0x220, payload, 2);
+    }
+    run_ms(1);
+
+    NightCANSnapshot snap;
+    CHECK(CAN_snapshot(&r, &snap));
+    CHECK_EQ(snap.frames, 3);
+    CHECK_EQ(snap.missed, 2);
+    CHECK_EQ(snap.data[0], 3);
+    CHECK_EQ(snap.data[1], (uint8_t)~3);
+    CHECK(!r.is_recent);
+    CHECK(!CAN_snapshot(&r, &snap));
+
+    uint8_t payload[2] = {4, (uint8_t)~4};
+    peer_send(0x220, payload, 2);
+    run_ms(1);
+    CHECK(CAN_snapshot(&r, &snap));
+    CHECK_EQ(snap.frames, 1);
+    CHECK_EQ(snap.missed, 0);
+    CHECK_EQ(snap.data[0], 4);
+}
+#endif
+
+#ifdef NIGHTCAN_HISTORY
+/* Histories keep the newest samples in order, decimated or averaged */
+static void test_history(void) {
+    setup();
+    static NightCANReceivePacket r;
+    r = CAN_create_receive_packet(0x230, 0, 2);
+    CAN_addReceivePacket(&can, &r);
+
+    static float raw_values[4], avg_values[8];
+    static uint64_t raw_times[4], avg_times[8];
+    static NightCANHistory raw, avg, orphan;
+    raw = CAN_create_history(0, CAN_SIGNAL_U16, CAN_LITTLE_ENDIAN, 1.0f,
+                             CAN_HISTORY_DECIMATE, 1, raw_values, raw_times, 4);
+    avg = CAN_create_history(0, CAN_SIGNAL_U16, CAN_LITTLE_ENDIAN, 0.5f,
+                             CAN_HISTORY_AVERAGE, 2, avg_values, avg_times, 8);
+    orphan = raw;
+    CHECK_EQ(CAN_AttachHistory(&can, 0x230, &raw), CAN_OK);
+    CHECK_EQ(CAN_AttachHistory(&can, 0x230, &avg), CAN_OK);
+    CHECK_EQ(CAN_AttachHistory(&can, 0x231, &orphan), CAN_NOT_FOUND);
+
+    for (uint16_t value = 1; value <= 6; value++) {
+        uint8_t payload[2] = {(uint8_t)value, 0};
+        peer_send(0x230, payload, 2);
+        run_ms(1);
+    }
+
+    CHECK_EQ(CAN_history_count(&raw), 4);
+    NightCANSpan spans[2];
+    uint32_t runs = CAN_history_spans(&raw, 4, spans);
+    float expect = 3.0f;
+    uint64_t last_us = 0;
+    uint32_t total = 0;
+    for (uint32_t s = 0; s < runs; s++) {
+        for (uint32_t i = 0; i < spans[s].count; i++) {
+            CHECK(spans[s].values[i] == expect);
+            CHECK(spans[s].timestamps_us[i] > last_us);
+            last_us = spans[s].timestamps_us[i];
+            expect += 1.0f;
+            total++;
+        }
+    }
+    CHECK_EQ(total, 4);
+
+    CHECK_EQ(CAN_history_count(&avg), 3);
+    runs = CAN_history_spans(&avg, 8, spans);
+    CHECK_EQ(runs, 1);
+    CHECK(spans[0].values[0] == 0.75f);  // (1 + 2) / 2 * 0.5
+    CHECK(spans[0].values[2] == 2.75f);
+
+    CAN_history_clear(&raw);
+    CHECK_EQ(CAN_history_count(&raw), 0);
+}
+#endif
+
+typedef struct {
+    const char *name;
+    void (*run)(void);
+} Test;
+
+static const Test tests[] = {
+    {"rx_inbox", test_rx_inbox},
+    {"rx_hash_index", test_rx_hash_index},
+    {"rx_timestamp", test_rx_timestamp},
+    {"rx_timeout", test_rx_timeout},
+    {"tx_schedule", test_tx_schedule},
+    {"tx_heap", test_tx_heap},
+    {"tx_stagger", test_tx_stagger},
+    {"tx_on_change", test_tx_on_change},
+    {"tx_queue", test_tx_queue},
+    {"tx_priority", test_tx_priority},
+#ifdef NIGHTCAN_GATEWAY
+    {"gateway", test_gateway},
+#endif
+#ifdef NIGHTCAN_SEQLOCK
+    {"seqlock", test_seqlock},
+#endif
+#ifdef NIGHTCAN_HISTORY
+    {"history", test_history},
+#endif
+};
+
+int main(int argc, char **argv) {
+    const uint32_t count = sizeof(tests) / sizeof(tests[0]);
+    if (argc == 2 && strcmp(argv[1], "--list") == 0) {
+        for (uint32_t i = 0; i < count; i++) printf("%s\n", tests[i].name);
+        return 0;
+    }
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s NAME | --list\n", argv[0]);
+        return 2;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (strcmp(argv[1], tests[i].name) == 0) {
+            tests[i].run();
+            printf("%s: ok\n", tests[i].name);
+            return 0;
+        }
+    }
+    fprintf(stderr, "no test %s in this build\n", argv[1]);
+    return 2;
+}
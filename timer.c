@@ -10,6 +10,11 @@
 static uint64_t lastTickRecorded = 0;
 static uint64_t reload;
 static uint64_t clockFreq;
+static uint32_t cyclesPerUs = 1;
+
+// wrap extension for the DWT counter
+static uint32_t cyclesLast = 0;
+static uint32_t cyclesHigh = 0;
 
 // deprecated
 static uint32_t lib_timer_prevcycle = 0;
@@ -19,6 +24,19 @@ void lib_timer_init()
     lib_timer_prevcycle = HAL_GetTick();
     clockFreq = HAL_RCC_GetHCLKFreq();
     reload = clockFreq / 1000;
+    cyclesPerUs = clockFreq / 1000000;
+    if (cyclesPerUs == 0) cyclesPerUs = 1;
+
+    // start the DWT cycle counter
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#ifdef STM32H7
+    DWT->LAR = 0xC5ACCE55;  // the M7 DWT is locked out of reset
+#endif
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    cyclesLast = 0;
+    cyclesHigh = 0;
+    lastTickRecorded = 0;
 }
 
 uint32_t lib_timer_delta_ms() {
@@ -40,17 +58,65 @@ uint32_t lib_timer_elapsed_ms()
 }
 
 
+// both of these run on the cycle counter now. HAL_GetTick() and SysTick->VAL
+// read separately could tear across a tick, and the float only ever holds a
+// difference so it doesn't lose resolution with uptime.
 float lib_timer_deltaTime() {
-    uint64_t tick = ((uint64_t)(HAL_GetTick()) * reload) + (reload - SysTick->VAL);
+    uint64_t tick = lib_timer_cycles64();
     float deltaTime = ((float)(tick - lastTickRecorded)) / ((float)clockFreq);
-    if(tick < lastTickRecorded) {
-        return 0;
-    }
     lastTickRecorded = tick;
     return deltaTime;
 }
 
+// NOTE: a float in seconds only resolves ~1ms after a few hours, use
+// lib_timer_now_us for anything that needs better
 float lib_timer_currentTime() {
-    uint64_t tick = ((uint64_t)(HAL_GetTick()) * reload) + (reload - SysTick->VAL);
-    return ((float)tick) / ((float)clockFreq);
-}
\ No newline at end of file
+    uint64_t tick = lib_timer_cycles64();
+    return (float)(tick / clockFreq) + ((float)(tick % clockFreq)) / ((float)clockFreq);
+}
+
+uint32_t lib_timer_cycles_to_us(uint32_t cycles) {
+    return cycles / cyclesPerUs;
+}
+
+uint64_t lib_timer_cycles64() {
+    // keep an interrupt from extending it between our read and update
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint32_t now = DWT->CYCCNT;
+    if (now < cyclesLast) cyclesHigh++;
+    cyclesLast = now;
+    uint64_t cycles = ((uint64_t)cyclesHigh << 32) | now;
+
+    __set_PRIMASK(primask);
+    return cycles;
+}
+
+uint64_t lib_timer_now_us() {
+    return lib_timer_cycles64() / cyclesPerUs;
+}
+
+uint64_t lib_timer_now_ns() {
+    uint64_t cycles = lib_timer_cycles64();
+    return (cycles / cyclesPerUs) * 1000 +
+           ((cycles % cyclesPerUs) * 1000) / cyclesPerUs;
+}
+
+void lib_timer_section_end(LibTimerSection *s) {
+    uint32_t cycles = lib_timer_cycles() - s->start;
+    s->last = cycles;
+    if (s->count == 0 || cycles < s->min) s->min = cycles;
+    if (cycles > s->max) s->max = cycles;
+    s->total += cycles;
+    s->count++;
+}
+
+void lib_timer_section_reset(LibTimerSection *s) {
+    s->start = 0;
+    s->last = 0;
+    s->min = 0;
+    s->max = 0;
+    s->total = 0;
+    s->count = 0;
+}
@@ -6,6 +6,8 @@
 #define VCU_FIRMWARE_2025_TIMER_H
 #include <stdint.h>
 
+#include "main.h"  // CMSIS core registers (DWT)
+
 void lib_timer_init();
 
 // deprecated
@@ -15,5 +17,53 @@ uint32_t lib_timer_elapsed_ms();
 float lib_timer_deltaTime();
 float lib_timer_currentTime();
 
+// --- DWT cycle counter timebase ---
+// Counts core clocks from lib_timer_init. The 32-bit counter wraps every 2^32
+// cycles (~7.8s at 550MHz, ~53s at 80MHz), lib_timer_cycles64 extends it, so
+// something has to call it (or anything below built on it) at least once per
+// wrap. The CAN driver and lib_timer_deltaTime do every loop.
+// The us/ns conversions assume a whole-MHz core clock.
+
+// raw 32-bit cycle count, a single register read. Differences of two reads
+// are right as long as less than one wrap passed in between.
+static inline uint32_t lib_timer_cycles() {
+    return DWT->CYCCNT;
+}
+
+uint32_t lib_timer_cycles_to_us(uint32_t cycles);
+
+// monotonic 64-bit cycle count, safe from interrupts
+uint64_t lib_timer_cycles64();
+
+// monotonic time since lib_timer_init
+uint64_t lib_timer_now_us();
+uint64_t lib_timer_now_ns();
+
+// --- section timing ---
+typedef struct {
+    uint32_t start;       // cycle count at the last begin
+    uint32_t last;        // cycles the last section took
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;       // summed cycles, divide by count
+    uint32_t count;
+} LibTimerSection;
+
+static inline void lib_timer_section_begin(LibTimerSection *s) {
+    s->start = lib_timer_cycles();
+}
+
+void lib_timer_section_end(LibTimerSection *s);
+
+void lib_timer_section_reset(LibTimerSection *s);
+
+/**
+ * Times the statement or block after it into section s, e.g.
+ *   LIB_TIMER_SECTION(&can_time) { CAN_periodic(&can); }
+ * Don't break/return out of it or the end is never recorded.
+ */
+#define LIB_TIMER_SECTION(s)                                            \
+    for (uint32_t _lib_timer_once = (lib_timer_section_begin(s), 1);   \
+         _lib_timer_once; _lib_timer_once = 0, lib_timer_section_end(s))
 
 #endif //VCU_FIRMWARE_2025_TIMER_H
@@ -5,100 +5,622 @@
 #include "usb_vcp.h"
 #ifdef USB_VCP
 #include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
 
 #include "dfu.h"
 #include "stdarg.h"
 #include "usb_device.h"
 #include "usbd_cdc_if.h"
 
-#define BUFFER_SIZE 16
 #define OUT_BUFFER_SIZE 256
 
+/* TX ring, must be a power of 2. Override in main.h if the logs need more */
+#ifndef USB_TX_RING_SIZE
+#define USB_TX_RING_SIZE 2048
+#endif
+
+/* Transfers are cut on packet boundaries so the host gets full packets */
+#ifndef USB_TX_PACKET_SIZE
+#ifdef STM32L4
+#define USB_TX_PACKET_SIZE 64
+#elif defined(STM32H7)
+#define USB_TX_PACKET_SIZE 512
+#endif
+#endif
+#define USB_TX_MAX_TRANSFER (USB_TX_RING_SIZE / 2)
+
+_Static_assert((USB_TX_RING_SIZE & (USB_TX_RING_SIZE - 1)) == 0,
+               "USB_TX_RING_SIZE must be a power of 2");
+
+/* Command input. Sizes can be overridden in main.h, table sizes must be a
+ * power of 2 */
+#ifndef USB_CMD_LINE_MAX
+#define USB_CMD_LINE_MAX 64  // longest command line, terminator included
+#endif
+#ifndef USB_CMD_QUEUE_SIZE
+#define USB_CMD_QUEUE_SIZE 4  // lines waiting for receive_periodic
+#endif
+#ifndef USB_CMD_TABLE_SIZE
+#define USB_CMD_TABLE_SIZE 32
+#endif
+#ifndef USB_PARAM_TABLE_SIZE
+#define USB_PARAM_TABLE_SIZE 32
+#endif
+
+_Static_assert((USB_CMD_TABLE_SIZE & (USB_CMD_TABLE_SIZE - 1)) == 0,
+               "USB_CMD_TABLE_SIZE must be a power of 2");
+_Static_assert((USB_PARAM_TABLE_SIZE & (USB_PARAM_TABLE_SIZE - 1)) == 0,
+               "USB_PARAM_TABLE_SIZE must be a power of 2");
+
 #define DRIVE_CMD_TEST "drive."
 #define STOP_CMD_TEST "stop."
 
-static int dfu_enable = 0;
 volatile uint8_t receivedNotRead = 0;
-uint8_t message[BUFFER_SIZE];
-uint8_t idx = 0;
-uint8_t sendMessage[OUT_BUFFER_SIZE];
 
 int drive;
 
-void println(char *buffer) {
-    size_t len = strlen(buffer);
-    char buf[len + 3];
-    buf[len + 1] = '\r';
-    buf[len + 2] = '\n';
-    strcpy(buf, buffer);
+// --- TX ring ---
+//
+// Any context may write: a writer claims space by moving tx_reserved with a
+// CAS, copies its bytes in, and the last writer to leave (tx_writers back to
+// 0) publishes everything claimed so far. That relies on a single core where
+// an interrupt runs to completion before the code it preempted resumes, so
+// when the outermost writer leaves, every claimed byte has been copied.
+// The USB side only reads up to tx_published and only moves tx_tail.
+// Counters are free running, an index is counter % USB_TX_RING_SIZE.
+
+static uint8_t tx_ring[USB_TX_RING_SIZE] __attribute__((aligned(32)));
+static volatile uint32_t tx_reserved;
+static volatile uint32_t tx_published;
+static volatile uint32_t tx_tail;
+static volatile uint32_t tx_writers;
+static volatile uint32_t tx_in_flight;  // bytes handed to CDC_Transmit
+static volatile uint8_t tx_busy;        // a transfer is (being) started
+static volatile uint32_t tx_dropped;
+
+static uint8_t cdc_transmit(uint8_t *buf, uint16_t len) {
 #ifdef STM32L4
-    CDC_Transmit_FS((uint8_t *)buf, len + 3);
+    return CDC_Transmit_FS(buf, len);
 #elif defined(STM32H7)
-    CDC_Transmit_HS((uint8_t *)buf, len + 3);
+    // the OTG DMA reads RAM, not the D-cache
+    uintptr_t start = (uintptr_t)buf & ~(uintptr_t)31;
+    SCB_CleanDCache_by_Addr((uint32_t *)start,
+                            (int32_t)((uintptr_t)buf + len - start));
+    return CDC_Transmit_HS(buf, len);
 #endif
 }
 
+/* Starts a transfer of the published bytes if none is running */
+static void tx_kick() {
+    for (;;) {
+        if (__atomic_exchange_n(&tx_busy, 1, __ATOMIC_ACQUIRE)) return;
+
+        uint32_t tail = tx_tail;
+        uint32_t pending =
+            __atomic_load_n(&tx_published, __ATOMIC_ACQUIRE) - tail;
+        if (pending) {
+            uint32_t offset = tail & (USB_TX_RING_SIZE - 1);
+            uint32_t n = USB_TX_RING_SIZE - offset;
+            if (n > pending) n = pending;
+            if (n > USB_TX_MAX_TRANSFER) n = USB_TX_MAX_TRANSFER;
+            if (n > USB_TX_PACKET_SIZE) n -= n % USB_TX_PACKET_SIZE;
+
+            tx_in_flight = n;
+            if (cdc_transmit(&tx_ring[offset], (uint16_t)n) == USBD_OK) return;
+
+            // endpoint busy or port not open, retried on the next write
+            tx_in_flight = 0;
+            __atomic_store_n(&tx_busy, 0, __ATOMIC_RELEASE);
+            return;
+        }
+
+        __atomic_store_n(&tx_busy, 0, __ATOMIC_RELEASE);
+        // a writer may have published after the check and seen us busy
+        if (__atomic_load_n(&tx_published, __ATOMIC_ACQUIRE) == tail) return;
+    }
+}
+
+/* Claims len bytes of the ring, false if they don't fit */
+static bool tx_reserve(uint32_t len, uint32_t *start) {
+    uint32_t cur = __atomic_load_n(&tx_reserved, __ATOMIC_RELAXED);
+    do {
+        if (USB_TX_RING_SIZE - (cur - tx_tail) < len) return false;
+    } while (!__atomic_compare_exchange_n(&tx_reserved, &cur, cur + len, true,
+                                          __ATOMIC_ACQUIRE,
+                                          __ATOMIC_RELAXED));
+    *start = cur;
+    return true;
+}
+
+static void tx_copy(uint32_t pos, const uint8_t *data, uint32_t len) {
+    uint32_t offset = pos & (USB_TX_RING_SIZE - 1);
+    uint32_t first = USB_TX_RING_SIZE - offset;
+    if (first > len) first = len;
+    memcpy(&tx_ring[offset], data, first);
+    memcpy(tx_ring, data + first, len - first);
+}
+
+static void tx_leave() {
+    if (__atomic_sub_fetch(&tx_writers, 1, __ATOMIC_ACQ_REL) != 0) return;
+
+    // nothing can be mid-copy now, publish all that has been claimed
+    uint32_t reserved = __atomic_load_n(&tx_reserved, __ATOMIC_ACQUIRE);
+    uint32_t cur = __atomic_load_n(&tx_published, __ATOMIC_RELAXED);
+    while ((int32_t)(reserved - cur) > 0 &&
+           !__atomic_compare_exchange_n(&tx_published, &cur, reserved, false,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+    }
+}
+
+/* Queues a and then b as one piece, all or nothing */
+static bool tx_write2(const uint8_t *a, uint32_t alen, const uint8_t *b,
+                      uint32_t blen) {
+    uint32_t start;
+    __atomic_add_fetch(&tx_writers, 1, __ATOMIC_ACQ_REL);
+    bool ok = tx_reserve(alen + blen, &start);
+    if (ok) {
+        tx_copy(start, a, alen);
+        tx_copy(start + alen, b, blen);
+    } else {
+        __atomic_add_fetch(&tx_dropped, 1, __ATOMIC_RELAXED);
+    }
+    tx_leave();
+    tx_kick();
+    return ok;
+}
+
+bool usb_write(const uint8_t *data, uint32_t len) {
+    return tx_write2(data, len, NULL, 0);
+}
+
+void usb_transmit_complete() {
+    tx_tail += tx_in_flight;
+    tx_in_flight = 0;
+    __atomic_store_n(&tx_busy, 0, __ATOMIC_RELEASE);
+    tx_kick();
+}
+
+uint32_t usb_tx_dropped() { return tx_dropped; }
+
+uint32_t usb_tx_pending() {
+    return __atomic_load_n(&tx_published, __ATOMIC_ACQUIRE) - tx_tail;
+}
+
+// --- Binary telemetry ---
+//
+// Every record is COBS encoded and ends in a 0x00, so the host can resync on
+// any zero byte. While telemetry is on, println output is sent as text
+// records too, so the stream never mixes raw text and binary.
+// Multi-byte fields are little endian. scripts/can_telemetry.py decodes it.
+
+static volatile bool telemetry_on = false;
+
+// the worst case record (text), plus COBS overhead and the delimiter
+#define COBS_MAX_ENCODED(n) ((n) + (n) / 254 + 2)
+#define TELEMETRY_MAX_RECORD (1 + OUT_BUFFER_SIZE)
+
+/* Encodes in[0..len) into out, delimiter included, returns the length */
+static uint32_t cobs_encode(const uint8_t *in, uint32_t len, uint8_t *out) {
+    uint32_t code_at = 0;
+    uint32_t o = 1;
+    uint8_t code = 1;
+
+    for (uint32_t i = 0; i < len; i++) {
+        if (in[i] == 0) {
+            out[code_at] = code;
+            code_at = o++;
+            code = 1;
+            continue;
+        }
+        out[o++] = in[i];
+        if (++code == 0xFF) {
+            out[code_at] = code;
+            code_at = o++;
+            code = 1;
+        }
+    }
+    out[code_at] = code;
+    out[o++] = 0;
+    return o;
+}
+
+static bool telemetry_send(const uint8_t *record, uint32_t len) {
+    uint8_t encoded[COBS_MAX_ENCODED(TELEMETRY_MAX_RECORD)];
+    return usb_write(encoded, cobs_encode(record, len, encoded));
+}
+
+void usb_telemetry_enable(bool enable) { telemetry_on = enable; }
+
+bool usb_telemetry_enabled() { return telemetry_on; }
+
+bool usb_telemetry_can(uint32_t time_us, uint32_t id, uint8_t flags,
+                       uint8_t len, const uint8_t *data) {
+    if (!telemetry_on) return false;
+    if (len > USB_TELEMETRY_MAX_PAYLOAD) len = USB_TELEMETRY_MAX_PAYLOAD;
+
+    uint8_t record[11 + USB_TELEMETRY_MAX_PAYLOAD];
+    record[0] = USB_TELEMETRY_CAN_FRAME;
+    memcpy(&record[1], &time_us, 4);
+    memcpy(&record[5], &id, 4);
+    record[9] = flags;
+    record[10] = len;
+    memcpy(&record[11], data, len);
+    return telemetry_send(record, 11 + len);
+}
+
+void println(char *buffer) {
+    uint32_t len = strlen(buffer);
+
+    if (telemetry_on) {
+        uint8_t record[TELEMETRY_MAX_RECORD];
+        if (len > OUT_BUFFER_SIZE) len = OUT_BUFFER_SIZE;
+        record[0] = USB_TELEMETRY_TEXT;
+        memcpy(&record[1], buffer, len);
+        telemetry_send(record, 1 + len);
+        return;
+    }
+
+    tx_write2((const uint8_t *)buffer, len, (const uint8_t *)"\r\n", 2);
+}
+
 void usb_printf(const char *format, ...) {
     va_list args;
     va_start(args, format);
-    vsnprintf(sendMessage, OUT_BUFFER_SIZE, format, args);
+    vusb_printf(format, args);
     va_end(args);
-    println(sendMessage);
 }
 
 void vusb_printf(const char *format, va_list args) {
-    vsnprintf(sendMessage, OUT_BUFFER_SIZE, format, args);
-    println(sendMessage);
+    char buf[OUT_BUFFER_SIZE];  // on the stack so ISRs can log too
+    vsnprintf(buf, OUT_BUFFER_SIZE, format, args);
+    println(buf);
+}
+
+// --- Command input ---
+//
+// receiveData (USB ISR) splits the input into lines and tokens as the bytes
+// arrive, hashing the command name on the way, and queues finished lines.
+// receive_periodic then runs them from the main loop, so the ISR never
+// compares strings and a handler can take its time. A line may arrive
+// across any number of USB packets.
+
+typedef struct {
+    char text[USB_CMD_LINE_MAX];  // tokens, each ended by a \0
+    uint32_t hash;                // FNV-1a of the first token
+    uint8_t argc;
+    uint8_t argv[USB_CMD_MAX_ARGS];  // where each token starts in text
+} UsbCommandLine;
+
+static UsbCommandLine cmd_queue[USB_CMD_QUEUE_SIZE];
+static volatile uint32_t cmd_head;  // written by the ISR only
+static volatile uint32_t cmd_tail;  // written by receive_periodic only
+static volatile uint32_t cmd_dropped;
+
+// ISR state for the line being assembled in cmd_queue[cmd_head]
+static bool rx_started;
+static bool rx_discard;  // too long or no room, skip to the end of line
+static bool rx_in_token;
+static uint8_t rx_len;
+
+typedef struct {
+    const char *name;  // NULL = free slot
+    uint32_t hash;
+    UsbCommandHandler handler;
+    const char *help;
+} UsbCommand;
+
+typedef struct {
+    const char *name;
+    uint32_t hash;
+    UsbParamType type;
+    void *value;
+} UsbParam;
+
+static UsbCommand commands[USB_CMD_TABLE_SIZE];
+static UsbParam params[USB_PARAM_TABLE_SIZE];
+static bool builtins_registered = false;
+
+#define FNV_OFFSET 2166136261u
+#define FNV_PRIME 16777619u
+
+static inline uint32_t fnv1a_step(uint32_t hash, char c) {
+    return (hash ^ (uint8_t)c) * FNV_PRIME;
+}
+
+static uint32_t fnv1a(const char *s) {
+    uint32_t hash = FNV_OFFSET;
+    while (*s) hash = fnv1a_step(hash, (char)tolower((unsigned char)*s++));
+    return hash;
+}
+
+static void rx_end_line() {
+    if (rx_started) {
+        UsbCommandLine *line = &cmd_queue[cmd_head % USB_CMD_QUEUE_SIZE];
+        if (rx_discard) {
+            cmd_dropped++;
+        } else if (line->argc > 0) {
+            // a token ended by a space already has its \0 (and rx_len can
+            // be USB_CMD_LINE_MAX then)
+            if (rx_in_token) line->text[rx_len] = '\0';
+            __atomic_store_n(&cmd_head, cmd_head + 1, __ATOMIC_RELEASE);
+            receivedNotRead = 1;
+        }
+    }
+    rx_started = false;
+    rx_discard = false;
+    rx_in_token = false;
+    rx_len = 0;
 }
 
 void receiveData(uint8_t *data, uint32_t len) {
-    idx = 0;
     for (uint32_t i = 0; i < len; i++) {
-        if (data[i] == '\0' || data[i] == '\n' || data[i] == '\r') {
-            // end of message
-            message[idx] = '\0';
-        } else {
-            message[idx++] = tolower(data[i]);
+        char c = (char)data[i];
+
+        if (c == '\0' || c == '\n' || c == '\r') {
+            rx_end_line();
+            continue;
         }
 
-        if (idx >= BUFFER_SIZE) {
-            idx = 0;
-            // overflow
+        if (!rx_started) {
+            rx_started = true;
+            if (cmd_head - __atomic_load_n(&cmd_tail, __ATOMIC_ACQUIRE) >=
+                USB_CMD_QUEUE_SIZE) {
+                rx_discard = true;  // main loop is behind
+            } else {
+                UsbCommandLine *line =
+                    &cmd_queue[cmd_head % USB_CMD_QUEUE_SIZE];
+                line->argc = 0;
+                line->hash = FNV_OFFSET;
+            }
         }
+        if (rx_discard) continue;
+
+        UsbCommandLine *line = &cmd_queue[cmd_head % USB_CMD_QUEUE_SIZE];
+
+        if (c == ' ' || c == '\t') {
+            if (rx_in_token) {
+                line->text[rx_len++] = '\0';
+                rx_in_token = false;
+            }
+            continue;
+        }
+
+        // room for this char and the \0 that ends the line
+        if (rx_len >= USB_CMD_LINE_MAX - 1 ||
+            (!rx_in_token && line->argc >= USB_CMD_MAX_ARGS)) {
+            rx_discard = true;
+            continue;
+        }
+
+        if (!rx_in_token) {
+            line->argv[line->argc++] = rx_len;
+            rx_in_token = true;
+        }
+        c = (char)tolower((unsigned char)c);
+        if (line->argc == 1) line->hash = fnv1a_step(line->hash, c);
+        line->text[rx_len++] = c;
     }
+}
+
+static const UsbCommand *find_command(const char *name, uint32_t hash) {
+    for (uint32_t n = 0; n < USB_CMD_TABLE_SIZE; n++) {
+        const UsbCommand *cmd = &commands[(hash + n) & (USB_CMD_TABLE_SIZE - 1)];
+        if (!cmd->name) return NULL;
+        if (cmd->hash == hash && !strcasecmp(cmd->name, name)) return cmd;
+    }
+    return NULL;
+}
+
+static UsbParam *find_param(const char *name) {
+    uint32_t hash = fnv1a(name);
+    for (uint32_t n = 0; n < USB_PARAM_TABLE_SIZE; n++) {
+        UsbParam *param = &params[(hash + n) & (USB_PARAM_TABLE_SIZE - 1)];
+        if (!param->name) return NULL;
+        if (param->hash == hash && !strcasecmp(param->name, name)) return param;
+    }
+    return NULL;
+}
+
+static void register_builtins();
 
-    if (!strcmp(message, DFU_COMMAND)) {
-        dfu_enable = 1;
+bool usb_register_command(const char *name, UsbCommandHandler handler,
+                          const char *help) {
+    if (!builtins_registered) register_builtins();
+
+    uint32_t hash = fnv1a(name);
+    for (uint32_t n = 0; n < USB_CMD_TABLE_SIZE; n++) {
+        UsbCommand *cmd = &commands[(hash + n) & (USB_CMD_TABLE_SIZE - 1)];
+        if (!cmd->name || (cmd->hash == hash && !strcasecmp(cmd->name, name))) {
+            cmd->hash = hash;
+            cmd->handler = handler;
+            cmd->help = help;
+            cmd->name = name;
+            return true;
+        }
     }
+    return false;  // table full
+}
 
-    if (!strcmp(message, DRIVE_CMD_TEST)) {
-        drive = 1;
+bool usb_register_param(const char *name, UsbParamType type, void *value) {
+    uint32_t hash = fnv1a(name);
+    for (uint32_t n = 0; n < USB_PARAM_TABLE_SIZE; n++) {
+        UsbParam *param = &params[(hash + n) & (USB_PARAM_TABLE_SIZE - 1)];
+        if (!param->name ||
+            (param->hash == hash && !strcasecmp(param->name, name))) {
+            param->hash = hash;
+            param->type = type;
+            param->value = value;
+            param->name = name;
+            return true;
+        }
     }
+    return false;
+}
 
-    if (!strcmp(message, STOP_CMD_TEST)) {
-        drive = 0;
+static void print_param(const UsbParam *param) {
+    switch (param->type) {
+        case USB_PARAM_FLOAT:
+            usb_printf("%s = %f", param->name, *(float *)param->value);
+            break;
+        case USB_PARAM_INT32:
+            usb_printf("%s = %ld", param->name, (long)*(int32_t *)param->value);
+            break;
+        case USB_PARAM_UINT32:
+            usb_printf("%s = %lu", param->name,
+                       (unsigned long)*(uint32_t *)param->value);
+            break;
+        case USB_PARAM_BOOL:
+            usb_printf("%s = %d", param->name, *(bool *)param->value);
+            break;
     }
+}
 
-    receivedNotRead = 1;
+static bool parse_bool(const char *s, bool *out) {
+    if (!strcmp(s, "1") || !strcmp(s, "on") || !strcmp(s, "true")) {
+        *out = true;
+    } else if (!strcmp(s, "0") || !strcmp(s, "off") || !strcmp(s, "false")) {
+        *out = false;
+    } else {
+        return false;
+    }
+    return true;
 }
 
-void receive_periodic() {
-    if (receivedNotRead) {
-        receivedNotRead = 0;
-        if (dfu_enable) {
+/* Writes text into the parameter, false if it doesn't parse */
+static bool set_param(UsbParam *param, const char *text) {
+    char *end;
+    switch (param->type) {
+        case USB_PARAM_FLOAT: {
+            float v = strtof(text, &end);
+            if (*end) return false;
+            *(float *)param->value = v;
+            return true;
+        }
+        case USB_PARAM_INT32: {
+            long v = strtol(text, &end, 0);
+            if (*end) return false;
+            *(int32_t *)param->value = (int32_t)v;
+            return true;
+        }
+        case USB_PARAM_UINT32: {
+            unsigned long v = strtoul(text, &end, 0);
+            if (*end) return false;
+            *(uint32_t *)param->value = (uint32_t)v;
+            return true;
+        }
+        case USB_PARAM_BOOL:
+            return parse_bool(text, (bool *)param->value);
+    }
+    return false;
+}
+
+// --- Built-in commands ---
+
+static void cmd_help(int argc, char **argv) {
+    for (uint32_t i = 0; i < USB_CMD_TABLE_SIZE; i++) {
+        if (!commands[i].name) continue;
+        usb_printf("%s - %s", commands[i].name,
+                   commands[i].help ? commands[i].help : "");
+    }
+}
+
+static void cmd_get(int argc, char **argv) {
+    if (argc < 2) {
+        for (uint32_t i = 0; i < USB_PARAM_TABLE_SIZE; i++) {
+            if (params[i].name) print_param(&params[i]);
+        }
+        return;
+    }
+    UsbParam *param = find_param(argv[1]);
+    if (!param) {
+        usb_printf("no parameter %s", argv[1]);
+        return;
+    }
+    print_param(param);
+}
+
+static void cmd_set(int argc, char **argv) {
+    if (argc < 3) {
+        println("usage: set <name> <value>");
+        return;
+    }
+    UsbParam *param = find_param(argv[1]);
+    if (!param) {
+        usb_printf("no parameter %s", argv[1]);
+        return;
+    }
+    if (!set_param(param, argv[2])) {
+        usb_printf("bad value %s", argv[2]);
+        return;
+    }
+    print_param(param);
+}
+
+static void cmd_stream(int argc, char **argv) {
+    bool on;
+    if (argc < 2 || !parse_bool(argv[1], &on)) {
+        println("usage: stream on|off");
+        return;
+    }
+    usb_telemetry_enable(on);
+}
+
+static void cmd_update(int argc, char **argv) {
 #ifdef SELF_BOOT_DFU
-            println("Restarting in DFU mode...");
-            boot_to_dfu();
+    println("Restarting in DFU mode...");
+    boot_to_dfu();
 #else
-            println(
-                "Device not configured to enter DFU mode... check the "
-                "code.");
-            dfu_enable = 0;
+    println("Device not configured to enter DFU mode... check the code.");
 #endif
+}
+
+static void cmd_drive(int argc, char **argv) { drive = 1; }
+
+static void cmd_stop(int argc, char **argv) { drive = 0; }
+
+static void register_builtins() {
+    builtins_registered = true;
+    usb_register_command("help", cmd_help, "list commands");
+    usb_register_command("get", cmd_get, "get [name], read a parameter");
+    usb_register_command("set", cmd_set, "set <name> <value>");
+    usb_register_command("stream", cmd_stream, "stream on|off, telemetry");
+    usb_register_command(DFU_COMMAND, cmd_update, "reboot into DFU");
+    usb_register_command(DRIVE_CMD_TEST, cmd_drive, "drive switch on");
+    usb_register_command(STOP_CMD_TEST, cmd_stop, "drive switch off");
+}
+
+void receive_periodic() {
+    tx_kick();  // picks up anything a refused transfer left behind
+    if (!builtins_registered) register_builtins();
+
+    if (!receivedNotRead) return;
+    receivedNotRead = 0;
+
+    uint32_t head = __atomic_load_n(&cmd_head, __ATOMIC_ACQUIRE);
+    while (cmd_tail != head) {
+        UsbCommandLine *line = &cmd_queue[cmd_tail % USB_CMD_QUEUE_SIZE];
+        char *argv[USB_CMD_MAX_ARGS];
+        for (uint8_t i = 0; i < line->argc; i++) {
+            argv[i] = &line->text[line->argv[i]];
         }
+
+        const UsbCommand *cmd = find_command(argv[0], line->hash);
+        if (cmd) {
+            cmd->handler(line->argc, argv);
+        } else {
+            usb_printf("unknown command %s, try help", argv[0]);
+        }
+
+        // only now hand the slot back, the handler was reading it
+        __atomic_store_n(&cmd_tail, cmd_tail + 1, __ATOMIC_RELEASE);
     }
 }
 
+uint32_t usb_cmd_dropped() { return cmd_dropped; }
+
 /**
  * Returns 1 if the DIGITAL drive switch is enabled, 0 otherwise
  * @return
@@ -2,6 +2,7 @@
 // Created by Dhairya Gupta on 1/19/25.
 //
 #include <stdarg.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "main.h"
@@ -14,6 +15,32 @@ void usb_init();
 void println(char *buffer);
 void usb_printf(const char *format, ...);
 void vusb_printf(const char *format, va_list args);
+
+/* Output is queued and sent in the background, none of these block. A line
+ * that doesn't fit in the queue is dropped whole and counted. */
+bool usb_write(const uint8_t *data, uint32_t len);
+uint32_t usb_tx_dropped();
+uint32_t usb_tx_pending();
+
+/* Call from CDC_TransmitCplt_FS/HS in usbd_cdc_if.c, sends the next chunk */
+void usb_transmit_complete();
+
+/* Binary telemetry, see scripts/can_telemetry.py. Off by default */
+#define USB_TELEMETRY_CAN_FRAME 0x01  // time_us u32, id u32, flags, len, data
+#define USB_TELEMETRY_TEXT 0x02       // a println line, no terminator
+#define USB_TELEMETRY_MAX_PAYLOAD 64
+
+// flags of a CAN frame record
+#define USB_TELEMETRY_FLAG_TX 0x01   // sent by this board
+#define USB_TELEMETRY_FLAG_EXT 0x02  // 29 bit ID
+#define USB_TELEMETRY_FLAG_FD 0x04   // CAN FD frame
+#define USB_TELEMETRY_FLAG_BRS 0x08  // FD frame with bit rate switching
+
+void usb_telemetry_enable(bool enable);
+bool usb_telemetry_enabled();
+bool usb_telemetry_can(uint32_t time_us, uint32_t id, uint8_t flags,
+                       uint8_t len, const uint8_t *data);
+
 void receiveData(uint8_t *data, uint32_t len);
 void receive_periodic();
 extern volatile uint8_t receivedNotRead;
@@ -21,5 +48,32 @@ int checkDrive();
 
 #define DFU_COMMAND "update"
 
+/* Commands: one line each, tokens split on spaces, matched case-insensitively.
+ * receiveData only queues the line, the handler runs in receive_periodic.
+ * Built in: help, get [name], set <name> <value>, stream on|off, update,
+ * drive., stop. */
+#ifndef USB_CMD_MAX_ARGS
+#define USB_CMD_MAX_ARGS 6  // name included
+#endif
+
+typedef void (*UsbCommandHandler)(int argc, char **argv);  // argv[0] = name
+
+typedef enum {
+    USB_PARAM_FLOAT,
+    USB_PARAM_INT32,
+    USB_PARAM_UINT32,
+    USB_PARAM_BOOL
+} UsbParamType;
+
+/* name and help are kept by pointer, pass string literals */
+bool usb_register_command(const char *name, UsbCommandHandler handler,
+                          const char *help);
+
+/* Makes a variable readable/writable with get/set, value must outlive it */
+bool usb_register_param(const char *name, UsbParamType type, void *value);
+
+/* Lines thrown away because they were too long or the queue was full */
+uint32_t usb_cmd_dropped();
+
 #endif
 #endif  // VCU_FIRMWARE_2025_USB_VCP_H